@@ -1,8 +1,24 @@
 #include "AddressResolver.h"
+#include <algorithm>
+#include <cwctype>
 #include <iostream>
+#include <unordered_map>
+
+// Compares name with a module name that is already lower-cased
+static bool SameModuleName(const std::wstring &name, const std::wstring &lowerName)
+{
+    if (name.size() != lowerName.size())
+        return false;
+    for (size_t i = 0; i < name.size(); ++i)
+    {
+        if (static_cast<wchar_t>(::towlower(name[i])) != lowerName[i])
+            return false;
+    }
+    return true;
+}
 
 AddressResolver::AddressResolver()
-    : m_moduleRegistry(nullptr)
+    : m_moduleRegistry(nullptr), m_memoryReader(nullptr)
 {
 }
 
@@ -11,6 +27,23 @@ void AddressResolver::SetModuleRegistry(const ModuleRegistry *registry)
     m_moduleRegistry = registry;
 }
 
+void AddressResolver::SetMemoryReader(MemoryReader *reader)
+{
+    m_memoryReader = reader;
+}
+
+uintptr_t AddressResolver::GetBase(const std::wstring &moduleName, const std::wstring &symbol) const
+{
+    uintptr_t moduleBase = m_moduleRegistry->GetModuleBase(moduleName);
+    if (moduleBase == 0 || symbol.empty())
+        return moduleBase;
+
+    uintptr_t symbolRva;
+    if (m_memoryReader == nullptr || !m_moduleRegistry->FindSymbol(moduleName, symbol, *m_memoryReader, symbolRva))
+        return 0;
+    return moduleBase + symbolRva;
+}
+
 bool AddressResolver::ResolveOffset(OffsetEntry &entry)
 {
     if (!m_moduleRegistry || !m_moduleRegistry->IsLoaded())
@@ -19,17 +52,20 @@ bool AddressResolver::ResolveOffset(OffsetEntry &entry)
         return false;
     }
 
-    uintptr_t moduleBase = m_moduleRegistry->GetModuleBase(entry.moduleName);
+    uintptr_t base = GetBase(entry.moduleName, entry.symbol);
 
-    if (moduleBase == 0)
+    if (base == 0)
     {
-        std::wcerr << L"[-] Module '" << entry.moduleName << L"' not found." << std::endl;
+        if (entry.symbol.empty())
+            std::wcerr << L"[-] Module '" << entry.moduleName << L"' not found." << std::endl;
+        else
+            std::wcerr << L"[-] Symbol '" << entry.moduleName << L"!" << entry.symbol << L"' not found." << std::endl;
         entry.isResolved = false;
         entry.resolvedAddress = 0;
         return false;
     }
 
-    entry.resolvedAddress = moduleBase + entry.offset;
+    entry.resolvedAddress = base + entry.offset;
     entry.isResolved = true;
 
     return true;
@@ -43,17 +79,85 @@ int AddressResolver::ResolveAll(OffsetStorage &storage)
         return 0;
     }
 
-    int resolvedCount = 0;
     auto &offsets = storage.GetOffsets();
+    const size_t count = offsets.size();
+
+    // Pass 1: group entries by module name and symbol, one registry lookup per group
+    // Entries cluster by module, so the previous group is checked before hashing
+    std::unordered_map<std::wstring, uint32_t> groupIds;
+    std::vector<uintptr_t> groupBases;
+    std::vector<size_t> groupEntryCounts;
+    std::vector<const OffsetEntry *> groupEntries;
+
+    std::vector<uintptr_t> bases(count);
+    std::vector<uintptr_t> moduleOffsets(count);
 
-    for (auto &entry : offsets)
+    // Module names match case-insensitively, as in ModuleRegistry; symbols match exactly
+    const OffsetEntry *previous = nullptr;
+    std::wstring previousModule;
+    uint32_t groupId = 0;
+
+    for (size_t i = 0; i < count; ++i)
     {
-        if (ResolveOffset(entry))
+        const OffsetEntry &entry = offsets[i];
+
+        if (previous == nullptr || entry.symbol != previous->symbol ||
+            !SameModuleName(entry.moduleName, previousModule))
         {
-            resolvedCount++;
+            std::wstring lowerName = entry.moduleName;
+            std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::towlower);
+            std::wstring groupKey = entry.symbol.empty() ? lowerName : lowerName + L'!' + entry.symbol;
+            auto it = groupIds.find(groupKey);
+            if (it == groupIds.end())
+            {
+                it = groupIds.emplace(groupKey, static_cast<uint32_t>(groupBases.size())).first;
+                groupBases.push_back(GetBase(entry.moduleName, entry.symbol));
+                groupEntryCounts.push_back(0);
+                groupEntries.push_back(&entry);
+            }
+            groupId = it->second;
+            previous = &entry;
+            previousModule = lowerName;
+        }
+
+        groupEntryCounts[groupId]++;
+        bases[i] = groupBases[groupId];
+        moduleOffsets[i] = offsets[i].offset;
+    }
+
+    // Missing modules and symbols are reported once per group, not once per entry
+    for (size_t g = 0; g < groupBases.size(); ++g)
+    {
+        if (groupBases[g] == 0)
+        {
+            const OffsetEntry &entry = *groupEntries[g];
+            if (entry.symbol.empty())
+                std::wcerr << L"[-] Module '" << entry.moduleName;
+            else
+                std::wcerr << L"[-] Symbol '" << entry.moduleName << L"!" << entry.symbol;
+            std::wcerr << L"' not found (" << groupEntryCounts[g] << L" offsets)." << std::endl;
         }
     }
 
+    // Pass 2: branchless add over contiguous arrays (auto-vectorized)
+    // A zero base yields a zero address through the mask
+    std::vector<uintptr_t> resolved(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        uintptr_t mask = static_cast<uintptr_t>(0) - static_cast<uintptr_t>(bases[i] != 0);
+        resolved[i] = (bases[i] + moduleOffsets[i]) & mask;
+    }
+
+    // Pass 3: write results back into the entries
+    int resolvedCount = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        bool isResolved = bases[i] != 0;
+        offsets[i].resolvedAddress = resolved[i];
+        offsets[i].isResolved = isResolved;
+        resolvedCount += isResolved ? 1 : 0;
+    }
+
     if (resolvedCount > 0)
     {
         std::wcout << L"[+] Successfully resolved " << resolvedCount << L"/"
@@ -67,6 +171,92 @@ int AddressResolver::ResolveAll(OffsetStorage &storage)
     return resolvedCount;
 }
 
+int AddressResolver::ResolveAll(const OffsetDatabase &database, std::vector<uintptr_t> &outAddresses)
+{
+    outAddresses.assign(database.EntryCount(), 0);
+
+    if (!m_moduleRegistry || !m_moduleRegistry->IsLoaded())
+    {
+        std::wcerr << L"[-] Module registry is not loaded." << std::endl;
+        return 0;
+    }
+
+    // Active build set: the first whose fingerprint matches the loaded module,
+    // else the default set (same choice as BuildSets::FindMatch)
+    std::vector<std::wstring> moduleBuilds(database.ModuleCount());
+    std::wstring activeBuild;
+    for (uint32_t moduleId = 0; moduleId < moduleBuilds.size(); ++moduleId)
+    {
+        moduleBuilds[moduleId] = database.GetModuleBuild(moduleId);
+        if (activeBuild.empty() && !moduleBuilds[moduleId].empty() &&
+            m_moduleRegistry->MatchesBuildKey(moduleBuilds[moduleId]))
+            activeBuild = moduleBuilds[moduleId];
+    }
+
+    // One registry lookup per module id (module, build, symbol), entries only index into this table
+    // Module ids of other builds keep a zero base and a mismatch mark
+    std::vector<uintptr_t> moduleBases(database.ModuleCount(), 0);
+    std::vector<uint8_t> otherBuild(database.ModuleCount(), 0);
+    for (uint32_t moduleId = 0; moduleId < moduleBases.size(); ++moduleId)
+    {
+        if (moduleBuilds[moduleId] != activeBuild)
+        {
+            otherBuild[moduleId] = 1;
+            continue;
+        }
+
+        std::wstring moduleName = database.GetModuleName(moduleId);
+        std::wstring symbol = database.GetModuleSymbol(moduleId);
+        moduleBases[moduleId] = GetBase(moduleName, symbol);
+        if (moduleBases[moduleId] == 0)
+        {
+            if (symbol.empty())
+                std::wcerr << L"[-] Module '" << moduleName << L"' not found." << std::endl;
+            else
+                std::wcerr << L"[-] Symbol '" << moduleName << L"!" << symbol << L"' not found." << std::endl;
+        }
+    }
+
+    const OffsetDbEntry *entries = database.Entries();
+    const size_t count = database.EntryCount();
+    const size_t moduleCount = moduleBases.size();
+    int resolvedCount = 0;
+    size_t mismatchCount = 0;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t moduleId = entries[i].moduleId;
+        uintptr_t base = moduleId < moduleCount ? moduleBases[moduleId] : 0;
+        if (base != 0)
+        {
+            outAddresses[i] = base + static_cast<uintptr_t>(entries[i].offset);
+            resolvedCount++;
+        }
+        else if (moduleId < moduleCount && otherBuild[moduleId])
+        {
+            mismatchCount++;
+        }
+    }
+
+    if (mismatchCount > 0)
+    {
+        std::wcout << L"[*] Skipped " << mismatchCount << L" offsets recorded for other builds (resolving "
+                   << (activeBuild.empty() ? L"the default set" : activeBuild) << L")." << std::endl;
+    }
+
+    if (resolvedCount > 0)
+    {
+        std::wcout << L"[+] Successfully resolved " << resolvedCount << L"/"
+                   << count - mismatchCount << L" offsets." << std::endl;
+    }
+    else
+    {
+        std::wcerr << L"[-] Failed to resolve any offsets." << std::endl;
+    }
+
+    return resolvedCount;
+}
+
 uintptr_t AddressResolver::CalculateAddress(const std::wstring &moduleName, uintptr_t offset)
 {
     if (!m_moduleRegistry || !m_moduleRegistry->IsLoaded())
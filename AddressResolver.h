@@ -1,17 +1,26 @@
 #pragma once
 #include "ModuleRegistry.h"
 #include "OffsetStorage.h"
+#include "OffsetDatabase.h"
+#include "MemoryReader.h"
+#include <vector>
 
 // ============================================================================
 // AddressResolver: Address resolution
 // Purpose: Recalculate absolute addresses from "module + offset" pairs
 // Automatically handles ASLR on each process launch
+// Symbol-relative entries (module!Symbol+0xDelta) use the registry's cached
+// export tables, read through the memory reader on first use
 // ============================================================================
 
 class AddressResolver
 {
 private:
     const ModuleRegistry *m_moduleRegistry;
+    MemoryReader *m_memoryReader;
+
+    // Base of an entry: module base, plus the symbol RVA if symbol is set (0 = not found)
+    uintptr_t GetBase(const std::wstring &moduleName, const std::wstring &symbol) const;
 
 public:
     AddressResolver();
@@ -19,12 +28,21 @@ public:
     // Set module registry for address resolution
     void SetModuleRegistry(const ModuleRegistry *registry);
 
+    // Set memory reader for export table reads (symbol-relative entries)
+    void SetMemoryReader(MemoryReader *reader);
+
     // Resolve single offset
     bool ResolveOffset(OffsetEntry &entry);
 
     // Resolve all offsets in storage
     int ResolveAll(OffsetStorage &storage);
 
+    // Resolve a mapped binary database in place of parsed entries
+    // Only the build set matching the loaded modules is resolved (the default
+    // set if none matches), entries of other builds are skipped as mismatches
+    // outAddresses[i] = moduleBase + offset, or 0 if the module is missing or the build differs
+    int ResolveAll(const OffsetDatabase &database, std::vector<uintptr_t> &outAddresses);
+
     // Calculate absolute address manually
     uintptr_t CalculateAddress(const std::wstring &moduleName, uintptr_t offset);
 };
@@ -0,0 +1,2265 @@
+#include "Benchmark.h"
+#include "OffsetStorage.h"
+#include "OffsetDatabase.h"
+#include "AddressResolver.h"
+#include "ModuleRegistry.h"
+#include "MemoryReader.h"
+#include "PointerChainResolver.h"
+#include "PointerChainTable.h"
+#include "PointerChainStorage.h"
+#include "ModuleHasher.h"
+#include "SignatureScanner.h"
+#include "SignatureGenerator.h"
+#include "XrefIndex.h"
+#include "PointerScanner.h"
+#include "ChainValidator.h"
+#include "ValueScanner.h"
+#include "ProcessSnapshot.h"
+#include "SnapshotDiff.h"
+#include "ProcessPause.h"
+#include <windows.h>
+#include <atomic>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+using Clock = std::chrono::steady_clock;
+
+static double ElapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static std::wstring TrimLegacy(const std::wstring &str)
+{
+    size_t first = str.find_first_not_of(L" \t\r\n");
+    if (first == std::wstring::npos)
+        return L"";
+
+    size_t last = str.find_last_not_of(L" \t\r\n");
+    return str.substr(first, last - first + 1);
+}
+
+// Reference copy of the wifstream-based OffsetStorage loader, kept as the baseline
+static size_t LegacyLoadOffsets(const std::wstring &filename, std::vector<OffsetEntry> &offsets)
+{
+    std::wifstream file(filename);
+    if (!file.is_open())
+        return 0;
+
+    std::wstring line;
+    while (std::getline(file, line))
+    {
+        line = TrimLegacy(line);
+        if (line.empty() || line[0] == L'#' || line[0] == L';')
+            continue;
+
+        size_t plusPos = line.find(L'+');
+        size_t equalPos = line.find(L'=');
+        if (plusPos == std::wstring::npos)
+            continue;
+
+        OffsetEntry entry;
+        entry.moduleName = TrimLegacy(line.substr(0, plusPos));
+
+        std::wstring offsetStr;
+        if (equalPos != std::wstring::npos)
+        {
+            offsetStr = TrimLegacy(line.substr(plusPos + 1, equalPos - plusPos - 1));
+            entry.description = TrimLegacy(line.substr(equalPos + 1));
+        }
+        else
+        {
+            offsetStr = TrimLegacy(line.substr(plusPos + 1));
+        }
+
+        if (offsetStr.length() >= 2 && (offsetStr.substr(0, 2) == L"0x" || offsetStr.substr(0, 2) == L"0X"))
+            offsetStr = offsetStr.substr(2);
+
+        std::wstringstream ss;
+        ss << std::hex << offsetStr;
+        ss >> entry.offset;
+        if (ss.fail())
+            continue;
+
+        offsets.push_back(entry);
+    }
+    return offsets.size();
+}
+
+static double FileSizeBytes(const std::wstring &filename)
+{
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExW(filename.c_str(), GetFileExInfoStandard, &attributes))
+        return 0.0;
+    return static_cast<double>((static_cast<ULONGLONG>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow);
+}
+
+static std::wstring LegacyHex(uintptr_t value)
+{
+    std::ostringstream oss;
+    oss << "0x" << std::hex << std::uppercase << value;
+    std::string text = oss.str();
+    return std::wstring(text.begin(), text.end());
+}
+
+static uintptr_t LegacyParseHex(const std::wstring &str)
+{
+    try
+    {
+        return std::stoull(std::string(str.begin(), str.end()), nullptr, 16);
+    }
+    catch (...)
+    {
+        return 0;
+    }
+}
+
+static const wchar_t *LegacyTypeName(ValueType type)
+{
+    return type == ValueType::FLOAT ? L"float" : type == ValueType::DOUBLE ? L"double" : L"int";
+}
+
+// Reference copy of the wifstream-based PointerChainStorage loader
+// (iterator pairs over two different temporaries replaced by one substring)
+static size_t LegacyLoadChains(const std::wstring &filename, std::vector<PointerChain> &chains)
+{
+    std::wifstream file(filename);
+    if (!file.is_open())
+        return 0;
+
+    std::wstring line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == L'#')
+            continue;
+
+        size_t pos1 = line.find(L'|');
+        size_t pos2 = pos1 == std::wstring::npos ? pos1 : line.find(L'|', pos1 + 1);
+        size_t pos3 = pos2 == std::wstring::npos ? pos2 : line.find(L'|', pos2 + 1);
+        size_t pos4 = pos3 == std::wstring::npos ? pos3 : line.find(L'|', pos3 + 1);
+        if (pos4 == std::wstring::npos)
+            continue;
+
+        PointerChain chain;
+        chain.moduleName = line.substr(0, pos1);
+        chain.baseOffset = LegacyParseHex(line.substr(pos1 + 1, pos2 - pos1 - 1));
+
+        std::wistringstream offsetStream(line.substr(pos2 + 1, pos3 - pos2 - 1));
+        std::wstring offsetHex;
+        while (std::getline(offsetStream, offsetHex, L','))
+        {
+            chain.offsets.push_back(LegacyParseHex(offsetHex));
+        }
+
+        std::wstring typeName = line.substr(pos3 + 1, pos4 - pos3 - 1);
+        chain.valueType = typeName == L"float" ? ValueType::FLOAT : typeName == L"double" ? ValueType::DOUBLE : ValueType::INT;
+        chain.description = line.substr(pos4 + 1);
+        chains.push_back(chain);
+    }
+    return chains.size();
+}
+
+// Reference copy of the wofstream-based PointerChainStorage saver
+static bool LegacySaveChains(const std::wstring &filename, const std::vector<PointerChain> &chains)
+{
+    std::wofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    file << L"# Pointer Chains Configuration\n";
+    file << L"# Format: moduleName|baseOffset|offsets|valueType|description\n\n";
+
+    for (const auto &chain : chains)
+    {
+        file << chain.moduleName << L"|" << LegacyHex(chain.baseOffset) << L"|";
+        for (size_t i = 0; i < chain.offsets.size(); ++i)
+        {
+            if (i > 0)
+                file << L",";
+            file << LegacyHex(chain.offsets[i]);
+        }
+        file << L"|" << LegacyTypeName(chain.valueType) << L"|" << chain.description << L"\n";
+    }
+    return file.good();
+}
+
+static bool ReadWholeFile(const std::wstring &filename, std::string &out)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        return false;
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    out = oss.str();
+    return true;
+}
+
+// Heap bytes owned by a string (0 when it fits the small string buffer)
+static size_t StringHeapBytes(const std::wstring &str)
+{
+    const char *data = reinterpret_cast<const char *>(str.data());
+    const char *self = reinterpret_cast<const char *>(&str);
+    if (data >= self && data < self + sizeof(str))
+        return 0;
+    return (str.capacity() + 1) * sizeof(wchar_t);
+}
+
+// Approximate heap footprint of one PointerChain including its allocations
+static size_t ChainFootprint(const PointerChain &chain)
+{
+    return sizeof(PointerChain) + chain.offsets.capacity() * sizeof(uintptr_t) +
+           StringHeapBytes(chain.moduleName) + StringHeapBytes(chain.description) +
+           StringHeapBytes(chain.lastError);
+}
+
+void Benchmark::Report(const std::wstring &label, double milliseconds, double bytes)
+{
+    std::wcout << L"  " << std::left << std::setw(36) << label << std::right
+               << std::fixed << std::setprecision(2) << std::setw(10) << milliseconds << L" ms";
+    if (bytes > 0.0 && milliseconds > 0.0)
+    {
+        std::wcout << L"  (" << std::setprecision(1) << bytes / (milliseconds * 1000.0) << L" MB/s)";
+    }
+    std::wcout << std::defaultfloat << std::endl;
+}
+
+bool Benchmark::GenerateOffsetConfig(const std::wstring &filename, size_t entryCount)
+{
+    std::mt19937_64 rng(12345);
+    std::string text;
+    text.reserve(entryCount * 40);
+    text += "# Generated offset database\n";
+
+    char line[128];
+    for (size_t i = 0; i < entryCount; ++i)
+    {
+        unsigned moduleIndex = static_cast<unsigned>(rng() % 32);
+        unsigned long long offset = rng() % 0x8000000;
+        int length = snprintf(line, sizeof(line), "module%u.dll+0x%llX=Entry%zu\n", moduleIndex, offset, i);
+        text.append(line, length);
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open())
+        return false;
+    file.write(text.data(), text.size());
+    return file.good();
+}
+
+void Benchmark::RegisterFakeModules(ModuleRegistry &registry)
+{
+    for (unsigned i = 0; i < 32; ++i)
+    {
+        ModuleInfo info;
+        info.name = L"module" + std::to_wstring(i) + L".dll";
+        info.baseAddress = 0x7FF600000000ULL + static_cast<uintptr_t>(i) * 0x10000000ULL;
+        info.size = 0x8000000;
+        registry.AddModule(info);
+    }
+}
+
+void Benchmark::RunOffsetParser(size_t entryCount)
+{
+    const std::wstring filename = L"bench_offsets.cfg";
+    std::wcout << L"\n=== Offset config parser (" << entryCount << L" entries) ===\n";
+
+    if (!GenerateOffsetConfig(filename, entryCount))
+    {
+        std::wcerr << L"[-] Failed to generate " << filename << std::endl;
+        return;
+    }
+
+    double fileBytes = FileSizeBytes(filename);
+
+    // Best of three runs for each loader
+    const int runs = 3;
+    double legacyMs = 0.0;
+    double mappedMs = 0.0;
+    size_t legacyCount = 0;
+    OffsetStorage storage;
+
+    for (int run = 0; run < runs; ++run)
+    {
+        std::vector<OffsetEntry> legacyEntries;
+        auto start = Clock::now();
+        legacyCount = LegacyLoadOffsets(filename, legacyEntries);
+        double elapsed = ElapsedMs(start);
+        legacyMs = run == 0 ? elapsed : (std::min)(legacyMs, elapsed);
+    }
+
+    for (int run = 0; run < runs; ++run)
+    {
+        auto start = Clock::now();
+        storage.LoadFromFile(filename);
+        double elapsed = ElapsedMs(start);
+        mappedMs = run == 0 ? elapsed : (std::min)(mappedMs, elapsed);
+    }
+
+    Report(L"wifstream loader (baseline)", legacyMs, fileBytes);
+    Report(L"mapped UTF-8 loader", mappedMs, fileBytes);
+    if (mappedMs > 0.0)
+    {
+        std::wcout << L"  Speedup: " << std::fixed << std::setprecision(1) << legacyMs / mappedMs
+                   << L"x" << std::defaultfloat << std::endl;
+    }
+    if (legacyCount != storage.Count())
+    {
+        std::wcerr << L"[!] Entry count mismatch: " << legacyCount << L" vs " << storage.Count() << std::endl;
+    }
+
+    DeleteFileW(filename.c_str());
+}
+
+void Benchmark::RunOffsetDatabase(size_t entryCount)
+{
+    const std::wstring textFile = L"bench_offsets.cfg";
+    const std::wstring binaryFile = L"bench_offsets.ofdb";
+    std::wcout << L"\n=== Binary offset database (" << entryCount << L" entries) ===\n";
+
+    if (!GenerateOffsetConfig(textFile, entryCount))
+    {
+        std::wcerr << L"[-] Failed to generate " << textFile << std::endl;
+        return;
+    }
+
+    {
+        OffsetStorage converter;
+        if (!converter.LoadFromFile(textFile) || !converter.SaveToFile(binaryFile))
+        {
+            DeleteFileW(textFile.c_str());
+            return;
+        }
+    }
+
+    ModuleRegistry registry;
+    RegisterFakeModules(registry);
+
+    AddressResolver resolver;
+    resolver.SetModuleRegistry(&registry);
+
+    OffsetStorage storage;
+    auto start = Clock::now();
+    storage.LoadFromFile(textFile);
+    double textLoadMs = ElapsedMs(start);
+    start = Clock::now();
+    resolver.ResolveAll(storage);
+    double textResolveMs = ElapsedMs(start);
+
+    OffsetDatabase database;
+    std::vector<uintptr_t> addresses;
+    start = Clock::now();
+    database.Open(binaryFile);
+    double mapMs = ElapsedMs(start);
+    start = Clock::now();
+    resolver.ResolveAll(database, addresses);
+    double mappedResolveMs = ElapsedMs(start);
+
+    Report(L"text load", textLoadMs);
+    Report(L"ResolveAll (OffsetStorage)", textResolveMs);
+    Report(L".ofdb map + validate", mapMs);
+    Report(L"ResolveAll (mapped array)", mappedResolveMs);
+
+    double textTotal = textLoadMs + textResolveMs;
+    double mappedTotal = mapMs + mappedResolveMs;
+    if (mappedTotal > 0.0)
+    {
+        std::wcout << L"  Load+resolve speedup: " << std::fixed << std::setprecision(1)
+                   << textTotal / mappedTotal << L"x" << std::defaultfloat << std::endl;
+    }
+
+    database.Close();
+    DeleteFileW(textFile.c_str());
+    DeleteFileW(binaryFile.c_str());
+}
+
+void Benchmark::RunAddressResolver(size_t entryCount)
+{
+    const std::wstring filename = L"bench_offsets.cfg";
+    std::wcout << L"\n=== AddressResolver::ResolveAll (" << entryCount << L" entries) ===\n";
+
+    OffsetStorage storage;
+    if (!GenerateOffsetConfig(filename, entryCount) || !storage.LoadFromFile(filename))
+    {
+        std::wcerr << L"[-] Failed to generate " << filename << std::endl;
+        return;
+    }
+    DeleteFileW(filename.c_str());
+
+    ModuleRegistry registry;
+    RegisterFakeModules(registry);
+    AddressResolver resolver;
+    resolver.SetModuleRegistry(&registry);
+
+    auto start = Clock::now();
+    for (auto &entry : storage.GetOffsets())
+    {
+        resolver.ResolveOffset(entry);
+    }
+    double perEntryMs = ElapsedMs(start);
+
+    start = Clock::now();
+    resolver.ResolveAll(storage);
+    double groupedMs = ElapsedMs(start);
+
+    // Generated entries are shuffled across modules, sort them to also show
+    // the clustered layout real configs have
+    auto &offsets = storage.GetOffsets();
+    std::stable_sort(offsets.begin(), offsets.end(),
+                     [](const OffsetEntry &a, const OffsetEntry &b)
+                     { return a.moduleName < b.moduleName; });
+
+    start = Clock::now();
+    resolver.ResolveAll(storage);
+    double clusteredMs = ElapsedMs(start);
+
+    Report(L"ResolveOffset per entry (baseline)", perEntryMs);
+    Report(L"ResolveAll grouped (shuffled)", groupedMs);
+    Report(L"ResolveAll grouped (clustered)", clusteredMs);
+    if (groupedMs > 0.0)
+    {
+        std::wcout << L"  Speedup: " << std::fixed << std::setprecision(1) << perEntryMs / groupedMs
+                   << L"x" << std::defaultfloat << std::endl;
+    }
+}
+
+void Benchmark::RunChainTable(size_t chainCount)
+{
+    std::wcout << L"\n=== Pointer chain table (" << chainCount << L" chains) ===\n";
+
+    // In-process object graph: root slot -> node+0x18 -> node+0x70 -> value at +0x10
+    const size_t rootCount = 4096;
+    const size_t nodeSize = 0x80;
+    std::vector<uintptr_t> roots(rootCount);
+    std::vector<std::vector<uint8_t>> nodes(rootCount * 3, std::vector<uint8_t>(nodeSize, 0));
+    for (size_t i = 0; i < rootCount; ++i)
+    {
+        uint8_t *first = nodes[i * 3].data();
+        uint8_t *second = nodes[i * 3 + 1].data();
+        uint8_t *leaf = nodes[i * 3 + 2].data();
+        uintptr_t secondAddr = reinterpret_cast<uintptr_t>(second);
+        uintptr_t leafAddr = reinterpret_cast<uintptr_t>(leaf);
+        memcpy(first + 0x18, &secondAddr, sizeof(secondAddr));
+        memcpy(second + 0x70, &leafAddr, sizeof(leafAddr));
+        int32_t value = static_cast<int32_t>(i);
+        memcpy(leaf + 0x10, &value, sizeof(value));
+        roots[i] = reinterpret_cast<uintptr_t>(first);
+    }
+
+    // The roots array stands in for a module's static data
+    ModuleRegistry registry;
+    ModuleInfo module;
+    module.name = L"bench_target.exe";
+    module.baseAddress = reinterpret_cast<uintptr_t>(roots.data());
+    module.size = roots.size() * sizeof(uintptr_t);
+    registry.AddModule(module);
+
+    std::vector<PointerChain> chains(chainCount);
+    for (size_t i = 0; i < chainCount; ++i)
+    {
+        PointerChain &chain = chains[i];
+        chain.moduleName = module.name;
+        chain.baseOffset = (i % rootCount) * sizeof(uintptr_t);
+        chain.offsets = {0x18, 0x70, 0x10};
+        chain.valueType = ValueType::INT;
+        chain.description = L"Benchmark chain " + std::to_wstring(i);
+    }
+
+    MemoryReader reader(GetCurrentProcess());
+    reader.SetLogErrors(false);
+    PointerChainResolver resolver(&registry, &reader);
+
+    auto start = Clock::now();
+    PointerChainTable table;
+    table.Build(chains);
+    double buildMs = ElapsedMs(start);
+
+    // Definition walk without memory reads isolates the layout difference
+    start = Clock::now();
+    uintptr_t vectorSum = 0;
+    for (const auto &chain : chains)
+    {
+        vectorSum += chain.baseOffset + static_cast<uintptr_t>(chain.valueType);
+        for (uintptr_t offset : chain.offsets)
+        {
+            vectorSum += offset;
+        }
+    }
+    double vectorWalkMs = ElapsedMs(start);
+
+    start = Clock::now();
+    uintptr_t tableSum = 0;
+    for (size_t i = 0; i < table.Count(); ++i)
+    {
+        tableSum += table.GetBaseOffset(i) + static_cast<uintptr_t>(table.GetValueType(i));
+        const uintptr_t *offsets = table.GetOffsets(i);
+        for (uint32_t j = 0; j < table.GetOffsetCount(i); ++j)
+        {
+            tableSum += offsets[j];
+        }
+    }
+    double tableWalkMs = ElapsedMs(start);
+
+    start = Clock::now();
+    int vectorResolved = resolver.ResolveAllChains(chains);
+    double vectorMs = ElapsedMs(start);
+
+    start = Clock::now();
+    int tableResolved = resolver.ResolveTable(table);
+    double tableMs = ElapsedMs(start);
+
+    size_t vectorBytes = chains.capacity() * sizeof(PointerChain);
+    for (const auto &chain : chains)
+    {
+        vectorBytes += ChainFootprint(chain) - sizeof(PointerChain);
+    }
+
+    Report(L"Build table", buildMs);
+    Report(L"Walk definitions (vector)", vectorWalkMs);
+    Report(L"Walk definitions (table)", tableWalkMs);
+    Report(L"ResolveAllChains (vector)", vectorMs);
+    Report(L"ResolveTable (table)", tableMs);
+    std::wcout << L"  Resolved: " << vectorResolved << L" (vector), " << tableResolved << L" (table)"
+               << (vectorSum == tableSum ? L"" : L"  [checksum mismatch]") << L"\n";
+    std::wcout << L"  Bytes per chain: " << vectorBytes / chainCount << L" (vector), "
+               << table.MemoryUsage() / chainCount << L" (table)\n";
+    if (tableMs > 0.0)
+    {
+        std::wcout << L"  Speedup: " << std::fixed << std::setprecision(1) << vectorMs / tableMs
+                   << L"x" << std::defaultfloat << std::endl;
+    }
+}
+
+void Benchmark::RunChainStorage(size_t chainCount)
+{
+    const std::wstring newFile = L"bench_chains.txt";
+    const std::wstring legacyFile = L"bench_chains_legacy.txt";
+    std::wcout << L"\n=== Pointer chain file I/O (" << chainCount << L" chains) ===\n";
+
+    std::mt19937_64 rng(12345);
+    PointerChainStorage storage;
+    for (size_t i = 0; i < chainCount; ++i)
+    {
+        PointerChain chain;
+        chain.moduleName = L"module" + std::to_wstring(rng() % 32) + L".dll";
+        chain.baseOffset = rng() % 0x8000000;
+        size_t depth = 1 + rng() % 6;
+        for (size_t j = 0; j < depth; ++j)
+        {
+            chain.offsets.push_back((rng() % 0x200) * 8);
+        }
+        chain.valueType = static_cast<ValueType>(rng() % 3);
+        chain.description = L"Scanned chain " + std::to_wstring(i);
+        storage.AddChain(chain);
+    }
+
+    auto start = Clock::now();
+    bool legacySaved = LegacySaveChains(legacyFile, storage.GetAllChains());
+    double legacySaveMs = ElapsedMs(start);
+
+    start = Clock::now();
+    bool saved = storage.SaveToFile(newFile);
+    double saveMs = ElapsedMs(start);
+
+    if (!legacySaved || !saved)
+    {
+        std::wcerr << L"[-] Failed to write benchmark files" << std::endl;
+        return;
+    }
+
+    std::string legacyBytes;
+    std::string newBytes;
+    bool identical = ReadWholeFile(legacyFile, legacyBytes) && ReadWholeFile(newFile, newBytes) && legacyBytes == newBytes;
+    double fileBytes = FileSizeBytes(newFile);
+
+    // Best of three runs for each loader
+    const int runs = 3;
+    double legacyLoadMs = 0.0;
+    double loadMs = 0.0;
+    std::vector<PointerChain> legacyChains;
+    PointerChainStorage loaded;
+
+    for (int run = 0; run < runs; ++run)
+    {
+        legacyChains.clear();
+        start = Clock::now();
+        LegacyLoadChains(legacyFile, legacyChains);
+        double elapsed = ElapsedMs(start);
+        legacyLoadMs = run == 0 ? elapsed : (std::min)(legacyLoadMs, elapsed);
+    }
+
+    for (int run = 0; run < runs; ++run)
+    {
+        start = Clock::now();
+        loaded.LoadFromFile(newFile);
+        double elapsed = ElapsedMs(start);
+        loadMs = run == 0 ? elapsed : (std::min)(loadMs, elapsed);
+    }
+
+    bool sameChains = legacyChains.size() == loaded.GetChainCount();
+    for (size_t i = 0; sameChains && i < legacyChains.size(); ++i)
+    {
+        const PointerChain &a = legacyChains[i];
+        const PointerChain &b = loaded.GetChain(i);
+        sameChains = a.moduleName == b.moduleName && a.baseOffset == b.baseOffset && a.offsets == b.offsets &&
+                     a.valueType == b.valueType && a.description == b.description;
+    }
+
+    // Same chains through the JSON format
+    const std::wstring jsonFile = L"bench_chains.json";
+    start = Clock::now();
+    storage.SaveToFile(jsonFile);
+    double jsonSaveMs = ElapsedMs(start);
+    double jsonBytes = FileSizeBytes(jsonFile);
+
+    double jsonLoadMs = 0.0;
+    PointerChainStorage jsonLoaded;
+    for (int run = 0; run < runs; ++run)
+    {
+        start = Clock::now();
+        jsonLoaded.LoadFromFile(jsonFile);
+        double elapsed = ElapsedMs(start);
+        jsonLoadMs = run == 0 ? elapsed : (std::min)(jsonLoadMs, elapsed);
+    }
+
+    for (size_t i = 0; sameChains && i < legacyChains.size(); ++i)
+    {
+        const PointerChain &a = legacyChains[i];
+        const PointerChain &b = jsonLoaded.GetChain(i);
+        sameChains = i < jsonLoaded.GetChainCount() && a.moduleName == b.moduleName && a.baseOffset == b.baseOffset &&
+                     a.offsets == b.offsets && a.valueType == b.valueType && a.description == b.description;
+    }
+
+    Report(L"wofstream saver (baseline)", legacySaveMs, fileBytes);
+    Report(L"buffered to_chars saver", saveMs, fileBytes);
+    Report(L"JSON saver", jsonSaveMs, jsonBytes);
+    Report(L"wifstream loader (baseline)", legacyLoadMs, fileBytes);
+    Report(L"mapped chunked loader", loadMs, fileBytes);
+    Report(L"JSON SAX loader", jsonLoadMs, jsonBytes);
+    if (saveMs > 0.0 && loadMs > 0.0)
+    {
+        std::wcout << L"  Speedup: save " << std::fixed << std::setprecision(1) << legacySaveMs / saveMs
+                   << L"x, load " << legacyLoadMs / loadMs << L"x" << std::defaultfloat << std::endl;
+    }
+    std::wcout << L"  Output byte-identical: " << (identical ? L"yes" : L"NO") << L", loaded chains equal: "
+               << (sameChains ? L"yes" : L"NO") << std::endl;
+
+    DeleteFileW(newFile.c_str());
+    DeleteFileW(legacyFile.c_str());
+    DeleteFileW(jsonFile.c_str());
+}
+
+void Benchmark::RunEditJournal(size_t chainCount)
+{
+    const std::wstring file = L"bench_journal.txt";
+    const size_t edits = 10;
+    std::wcout << L"\n=== Edit journal saves (" << chainCount << L" chains, " << edits << L" single-chain edits) ===\n";
+
+    std::mt19937_64 rng(12345);
+    PointerChainStorage storage;
+    auto makeChain = [&rng](size_t i)
+    {
+        PointerChain chain;
+        chain.moduleName = L"module" + std::to_wstring(rng() % 32) + L".dll";
+        chain.baseOffset = rng() % 0x8000000;
+        size_t depth = 1 + rng() % 6;
+        for (size_t j = 0; j < depth; ++j)
+        {
+            chain.offsets.push_back((rng() % 0x200) * 8);
+        }
+        chain.valueType = static_cast<ValueType>(rng() % 3);
+        chain.description = L"Scanned chain " + std::to_wstring(i);
+        return chain;
+    };
+    for (size_t i = 0; i < chainCount; ++i)
+    {
+        storage.AddChain(makeChain(i));
+    }
+
+    if (!storage.SaveToFile(file))
+    {
+        std::wcerr << L"[-] Failed to write benchmark file" << std::endl;
+        return;
+    }
+
+    // Each edit saved through the journal vs. a forced full rewrite
+    double appendMs = 0.0;
+    double rewriteMs = 0.0;
+    for (size_t i = 0; i < edits; ++i)
+    {
+        storage.AddChain(makeChain(chainCount + i));
+        auto start = Clock::now();
+        storage.SaveToFile(file);
+        appendMs += ElapsedMs(start);
+    }
+
+    PointerChainStorage replayed;
+    auto start = Clock::now();
+    replayed.LoadFromFile(file);
+    double replayLoadMs = ElapsedMs(start);
+
+    for (size_t i = 0; i < edits; ++i)
+    {
+        storage.AddChain(makeChain(chainCount + edits + i));
+        storage.GetAllChainsMutable();
+        start = Clock::now();
+        storage.SaveToFile(file);
+        rewriteMs += ElapsedMs(start);
+    }
+
+    PointerChainStorage compacted;
+    start = Clock::now();
+    compacted.LoadFromFile(file);
+    double compactLoadMs = ElapsedMs(start);
+
+    double fileBytes = FileSizeBytes(file);
+    Report(L"full rewrite per edit (baseline)", rewriteMs / edits, fileBytes);
+    Report(L"journal append per edit", appendMs / edits);
+    Report(L"load base + journal", replayLoadMs, fileBytes);
+    Report(L"load compacted file", compactLoadMs, fileBytes);
+    if (appendMs > 0.0)
+    {
+        std::wcout << L"  Speedup: save " << std::fixed << std::setprecision(1) << rewriteMs / appendMs
+                   << L"x" << std::defaultfloat << std::endl;
+    }
+    std::wcout << L"  Chains after replay: " << replayed.GetChainCount() << L" (expected " << chainCount + edits
+               << L"), after compaction: " << compacted.GetChainCount() << L" (expected " << chainCount + 2 * edits
+               << L")" << std::endl;
+
+    DeleteFileW(file.c_str());
+    DeleteFileW(EditJournal::JournalPath(file).c_str());
+}
+
+void Benchmark::RunModuleHasher(size_t megabytes)
+{
+    std::wcout << L"\n=== Module image hashing (" << megabytes << L" MB in 8 fake modules) ===\n";
+
+    // Our own memory stands in for the target, read through ReadProcessMemory like a real one
+    size_t totalBytes = megabytes * 1024 * 1024;
+    std::vector<uint8_t> image(totalBytes);
+    std::mt19937_64 rng(12345);
+    for (size_t i = 0; i + sizeof(uint64_t) <= image.size(); i += sizeof(uint64_t))
+    {
+        uint64_t value = rng();
+        memcpy(&image[i], &value, sizeof(value));
+    }
+
+    std::vector<ModuleInfo> modules;
+    const size_t moduleCount = 8;
+    for (size_t i = 0; i < moduleCount; ++i)
+    {
+        ModuleInfo info;
+        info.name = L"image" + std::to_wstring(i) + L".dll";
+        info.baseAddress = reinterpret_cast<uintptr_t>(image.data()) + i * (totalBytes / moduleCount);
+        info.size = totalBytes / moduleCount;
+        modules.push_back(info);
+    }
+
+    HANDLE self = GetCurrentProcess();
+    unsigned threads = (std::max)(1u, std::thread::hardware_concurrency());
+
+    ModuleHasher hasher;
+    auto start = Clock::now();
+    std::vector<ModuleHash> single = hasher.HashModules(self, modules, 1);
+    double singleMs = ElapsedMs(start);
+
+    hasher.ClearCache();
+    start = Clock::now();
+    std::vector<ModuleHash> parallel = hasher.HashModules(self, modules, threads);
+    double parallelMs = ElapsedMs(start);
+
+    start = Clock::now();
+    std::vector<ModuleHash> cached = hasher.HashModules(self, modules, threads);
+    double cachedMs = ElapsedMs(start);
+
+    bool same = true;
+    for (size_t i = 0; i < modules.size(); ++i)
+    {
+        same = same && single[i].contentHash == parallel[i].contentHash && parallel[i].contentHash == cached[i].contentHash &&
+               cached[i].cached;
+    }
+
+    Report(L"1 thread", singleMs, static_cast<double>(totalBytes));
+    Report(std::to_wstring(threads) + L" threads", parallelMs, static_cast<double>(totalBytes));
+    Report(L"cached (header page only)", cachedMs);
+    if (parallelMs > 0.0)
+    {
+        std::wcout << L"  Throughput: " << std::fixed << std::setprecision(2) << totalBytes / (parallelMs * 1e6)
+                   << L" GB/s (" << threads << L" threads), " << totalBytes / (singleMs * 1e6) << L" GB/s (1 thread)"
+                   << std::defaultfloat << std::endl;
+    }
+    std::wcout << L"  Hashes equal across runs: " << (same ? L"yes" : L"NO") << std::endl;
+}
+
+// Reference scanner: masked compare at every position, one signature at a time
+static size_t NaiveScan(const uint8_t *data, size_t size, const Signature &signature, uintptr_t &firstMatch)
+{
+    size_t matches = 0;
+    const size_t length = signature.bytes.size();
+    for (size_t i = 0; i + length <= size; ++i)
+    {
+        size_t k = 0;
+        while (k < length && (data[i + k] & signature.mask[k]) == (signature.bytes[k] & signature.mask[k]))
+            ++k;
+        if (k == length && matches++ == 0)
+            firstMatch = i;
+    }
+    return matches;
+}
+
+void Benchmark::RunSignatureScanner(size_t megabytes, size_t signatureCount)
+{
+    std::wcout << L"\n=== Signature scan (" << megabytes << L" MB module, " << signatureCount << L" signatures) ===\n";
+
+    // Random bytes with x86-like frequencies: zeros and common opcode bytes dominate
+    size_t totalBytes = megabytes * 1024 * 1024;
+    std::vector<uint8_t> image(totalBytes);
+    std::mt19937_64 rng(4242);
+    const uint8_t common[] = {0x00, 0x48, 0x8B, 0x89, 0xFF, 0xE8, 0x0F, 0x85, 0xC0, 0x24, 0x4C, 0x8D};
+    for (size_t i = 0; i < image.size(); ++i)
+    {
+        uint64_t value = rng();
+        image[i] = (value & 1) ? common[(value >> 8) % sizeof(common)] : static_cast<uint8_t>(value >> 16);
+    }
+
+    // mov rax, [rip + disp32] ; test rax, rax - style signatures, each planted once
+    std::vector<Signature> signatures;
+    std::vector<uintptr_t> planted;
+    for (size_t i = 0; i < signatureCount; ++i)
+    {
+        Signature signature;
+        signature.moduleName = L"bench.dll";
+        signature.description = L"Signature" + std::to_wstring(i);
+        signature.bytes = {0x48, 0x8B, 0x05, 0, 0, 0, 0, 0x48, 0x85, 0xC0, 0x74, static_cast<uint8_t>(0x10 + i),
+                           0xE8, static_cast<uint8_t>(rng()), static_cast<uint8_t>(rng())};
+        signature.mask = {0xFF, 0xFF, 0xFF, 0, 0, 0, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+        signature.extract = SignatureExtract::RipRelative;
+        signature.extractOffset = 3;
+        signature.instructionLength = 7;
+
+        uintptr_t position = (rng() % (totalBytes - 64)) & ~static_cast<uintptr_t>(15);
+        int32_t displacement = static_cast<int32_t>(0x1000 + i * 8);
+        memcpy(&image[position], signature.bytes.data(), signature.bytes.size());
+        memcpy(&image[position + 3], &displacement, sizeof(displacement));
+        planted.push_back(position);
+        signatures.push_back(std::move(signature));
+    }
+
+    // Baseline reads the image directly, no chunking or process reads
+    uintptr_t naiveFirst = 0;
+    size_t naiveFound = 0;
+    auto start = Clock::now();
+    for (const Signature &signature : signatures)
+    {
+        naiveFound += NaiveScan(image.data(), image.size(), signature, naiveFirst) != 0 ? 1 : 0;
+    }
+    double naiveMs = ElapsedMs(start);
+
+    ModuleRegistry registry;
+    ModuleInfo info;
+    info.name = L"bench.dll";
+    info.baseAddress = reinterpret_cast<uintptr_t>(image.data());
+    info.size = totalBytes;
+    registry.AddModule(info);
+
+    SignatureScanner scanner;
+    start = Clock::now();
+    std::vector<SignatureResult> results = scanner.Scan(GetCurrentProcess(), registry, signatures);
+    double scanMs = ElapsedMs(start);
+
+    size_t correct = 0;
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        uintptr_t expected = planted[i] + 7 + 0x1000 + i * 8;
+        if (results[i].IsFound() && results[i].matchOffset == planted[i] && results[i].offset == expected)
+            correct++;
+    }
+
+    Report(L"Masked compare per position", naiveMs, static_cast<double>(totalBytes) * signatureCount);
+    Report(L"SignatureScanner (SSE2 anchors)", scanMs, static_cast<double>(totalBytes) * signatureCount);
+    if (scanMs > 0.0)
+    {
+        std::wcout << L"  Speedup: " << std::fixed << std::setprecision(1) << naiveMs / scanMs << L"x, "
+                   << std::setprecision(2) << totalBytes / (scanMs * 1e6) << L" GB/s of image"
+                   << std::defaultfloat << std::endl;
+    }
+    std::wcout << L"  Signatures found: " << naiveFound << L"/" << signatureCount << L" (baseline), " << correct
+               << L"/" << signatureCount << L" with correct RIP target (scanner)" << std::endl;
+}
+
+void Benchmark::RunSignatureGenerator(size_t megabytes, size_t offsetCount)
+{
+    std::wcout << L"\n=== Signature generation (" << megabytes << L" MB module, " << offsetCount << L" offsets) ===\n";
+
+    // Code-like random bytes, data targets in the last eighth, one mov rax, [rip + x] per target
+    size_t totalBytes = megabytes * 1024 * 1024;
+    size_t codeBytes = totalBytes - totalBytes / 8;
+    std::vector<uint8_t> image(totalBytes);
+    std::mt19937_64 rng(777);
+    const uint8_t common[] = {0x00, 0x48, 0x8B, 0x89, 0xFF, 0xE8, 0x0F, 0x85, 0xC0, 0x24, 0x4C, 0x8D};
+    for (size_t i = 0; i < image.size(); ++i)
+    {
+        uint64_t value = rng();
+        image[i] = (value & 1) ? common[(value >> 8) % sizeof(common)] : static_cast<uint8_t>(value >> 16);
+    }
+
+    std::vector<OffsetEntry> entries(offsetCount);
+    size_t stride = (totalBytes / 8) / offsetCount;
+    for (size_t i = 0; i < offsetCount; ++i)
+    {
+        entries[i].moduleName = L"bench.dll";
+        entries[i].offset = codeBytes + i * stride;
+        entries[i].description = L"Offset" + std::to_wstring(i);
+
+        // One slot per target keeps references from overwriting each other
+        size_t slot = codeBytes / offsetCount;
+        size_t position = i * slot + rng() % (slot - 16);
+        uint8_t instruction[7] = {0x48, 0x8B, 0x05};
+        int32_t displacement = static_cast<int32_t>(entries[i].offset - (position + sizeof(instruction)));
+        memcpy(instruction + 3, &displacement, sizeof(displacement));
+        memcpy(&image[position], instruction, sizeof(instruction));
+    }
+
+    ModuleRegistry registry;
+    ModuleInfo info;
+    info.name = L"bench.dll";
+    info.baseAddress = reinterpret_cast<uintptr_t>(image.data());
+    info.size = totalBytes;
+    registry.AddModule(info);
+
+    SignatureGenerator generator;
+    auto start = Clock::now();
+    generator.LoadImage(GetCurrentProcess(), info);
+    double indexMs = ElapsedMs(start);
+
+    std::vector<const OffsetEntry *> pointers;
+    for (const OffsetEntry &entry : entries)
+    {
+        pointers.push_back(&entry);
+    }
+    start = Clock::now();
+    std::vector<GeneratedSignature> results = generator.GenerateForImage(pointers);
+    double generateMs = ElapsedMs(start);
+
+    std::vector<Signature> signatures;
+    std::vector<size_t> owners;
+    size_t totalLength = 0;
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        if (!results[i].found)
+            continue;
+        results[i].signature.moduleName = L"bench.dll";
+        signatures.push_back(results[i].signature);
+        owners.push_back(i);
+        totalLength += results[i].signature.bytes.size();
+    }
+
+    // Every generated signature must be unique and lead back to its offset
+    SignatureScanner scanner;
+    start = Clock::now();
+    std::vector<SignatureResult> found = scanner.Scan(GetCurrentProcess(), registry, signatures);
+    double scanMs = ElapsedMs(start);
+
+    size_t correct = 0;
+    for (size_t i = 0; i < found.size(); ++i)
+    {
+        if (found[i].matchCount == 1 && found[i].offset == entries[owners[i]].offset)
+            correct++;
+    }
+
+    Report(L"4-gram index build", indexMs, static_cast<double>(totalBytes));
+    Report(L"Generate " + std::to_wstring(offsetCount) + L" signatures", generateMs);
+    Report(L"Scan back generated signatures", scanMs, static_cast<double>(totalBytes));
+    std::wcout << L"  Generated: " << signatures.size() << L"/" << offsetCount << L", average length "
+               << std::fixed << std::setprecision(1)
+               << (signatures.empty() ? 0.0 : static_cast<double>(totalLength) / signatures.size())
+               << std::defaultfloat << L" bytes, unique and correct: " << correct << L"/" << signatures.size()
+               << std::endl;
+}
+
+// Section header of a generated PE image
+struct BenchSection
+{
+    std::string name;
+    uint32_t rva;
+    uint32_t size;
+    uint32_t characteristics;
+};
+
+// Minimal PE32+ headers in the first page of image (SizeOfImage = image size)
+static void WritePeHeaders(std::vector<uint8_t> &image, const std::vector<BenchSection> &sections,
+                           uint32_t exportRva = 0, uint32_t exportSize = 0)
+{
+    memset(image.data(), 0, 0x1000);
+    auto put16 = [&](size_t at, uint16_t value) { memcpy(&image[at], &value, sizeof(value)); };
+    auto put32 = [&](size_t at, uint32_t value) { memcpy(&image[at], &value, sizeof(value)); };
+
+    // DOS header -> "PE\0\0" at 0x80, file header at 0x84, optional header at 0x98
+    put16(0, 0x5A4D);
+    put32(0x3C, 0x80);
+    put32(0x80, 0x00004550);
+    put16(0x84, 0x8664);
+    put16(0x86, static_cast<uint16_t>(sections.size()));
+    put32(0x88, 0x5F3A2B1C);
+    put16(0x94, 0xF0);
+    put16(0x98, 0x20B);
+    put32(0x98 + 56, static_cast<uint32_t>(image.size()));
+    put32(0x98 + 108, 16);
+    put32(0x98 + 112, exportRva);
+    put32(0x98 + 116, exportSize);
+    for (size_t i = 0; i < sections.size(); ++i)
+    {
+        size_t header = 0x98 + 0xF0 + i * 40;
+        memcpy(&image[header], sections[i].name.data(), (std::min)(sections[i].name.size(), static_cast<size_t>(8)));
+        put32(header + 8, sections[i].size);
+        put32(header + 12, sections[i].rva);
+        put32(header + 36, sections[i].characteristics);
+    }
+}
+
+void Benchmark::RunXrefIndex(size_t megabytes)
+{
+    std::wcout << L"\n=== Xref index (" << megabytes << L" MB of generated code in 4 sections) ===\n";
+
+    // PE headers in the first page, then 4 executable sections of random instructions
+    const size_t headerSize = 0x1000;
+    const size_t sectionCount = 4;
+    size_t sectionSize = megabytes * 1024 * 1024 / sectionCount;
+    std::vector<uint8_t> image(headerSize + sectionCount * sectionSize, 0xCC);
+    std::vector<BenchSection> sections;
+    for (size_t i = 0; i < sectionCount; ++i)
+    {
+        sections.push_back({".text" + std::to_string(i), static_cast<uint32_t>(headerSize + i * sectionSize),
+                            static_cast<uint32_t>(sectionSize), 0x60000020});
+    }
+    WritePeHeaders(image, sections);
+
+    // mov rax, [rip+d] / lea rcx, [rip+d] / call rel32 / add rsp, imm8 / jne rel32 / nop padding
+    std::mt19937_64 rng(99);
+    const size_t targetCount = 4096;
+    std::vector<uint64_t> references(targetCount, 0);
+    size_t position = headerSize;
+    while (position + 16 < image.size())
+    {
+        uint64_t value = rng();
+        size_t target = headerSize + (value >> 20) % targetCount * 64;
+        int32_t displacement;
+        switch (value % 5)
+        {
+        case 0:
+        case 1:
+        {
+            const uint8_t opcode[] = {0x48, static_cast<uint8_t>(value % 5 == 0 ? 0x8B : 0x8D), 0x05};
+            memcpy(&image[position], opcode, sizeof(opcode));
+            displacement = static_cast<int32_t>(target - (position + 7));
+            memcpy(&image[position + 3], &displacement, sizeof(displacement));
+            position += 7;
+            references[(target - headerSize) / 64]++;
+            break;
+        }
+        case 2:
+            image[position] = 0xE8;
+            displacement = static_cast<int32_t>(target - (position + 5));
+            memcpy(&image[position + 1], &displacement, sizeof(displacement));
+            position += 5;
+            references[(target - headerSize) / 64]++;
+            break;
+        case 3:
+        {
+            const uint8_t add[] = {0x48, 0x83, 0xC4, 0x28};
+            memcpy(&image[position], add, sizeof(add));
+            position += sizeof(add);
+            break;
+        }
+        default:
+            image[position] = 0x0F;
+            image[position + 1] = 0x85;
+            displacement = static_cast<int32_t>(target - (position + 6));
+            memcpy(&image[position + 2], &displacement, sizeof(displacement));
+            position += 6;
+            references[(target - headerSize) / 64]++;
+            break;
+        }
+    }
+
+    // Instructions may straddle a section end, those references are not counted by the index
+    ModuleImage module;
+    module.LoadFromMemory(L"bench.dll", image.data(), image.size());
+    std::vector<uint8_t>().swap(image);
+
+    XrefIndex index;
+    auto start = Clock::now();
+    index.Build(module, 1);
+    double singleMs = ElapsedMs(start);
+
+    unsigned threads = (std::max)(1u, std::thread::hardware_concurrency());
+    start = Clock::now();
+    index.Build(module, threads);
+    double parallelMs = ElapsedMs(start);
+
+    size_t matching = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < targetCount; ++i)
+    {
+        size_t found = index.FindReferences(headerSize + i * 64).size();
+        if (found + 4 >= references[i] && found <= references[i])
+            matching++;
+    }
+    double lookupMs = ElapsedMs(start);
+
+    double codeBytes = static_cast<double>(index.GetCodeBytes());
+    Report(L"Build, 1 thread", singleMs, codeBytes);
+    Report(L"Build, " + std::to_wstring(threads) + L" threads", parallelMs, codeBytes);
+    Report(L"Lookup " + std::to_wstring(targetCount) + L" targets", lookupMs);
+    std::wcout << L"  " << index.GetInstructionCount() << L" instructions, " << index.GetXrefCount()
+               << L" xrefs; targets with the planted reference count: " << matching << L"/" << targetCount
+               << std::endl;
+}
+
+void Benchmark::RunModuleHeaders(size_t moduleCount, size_t exportCount)
+{
+    std::wcout << L"\n=== Module headers (" << moduleCount << L" modules of 8 MB, " << exportCount
+               << L" exports each) ===\n";
+
+    // Header page, .text (3/4 of the image), .rdata with the export directory at its start
+    const size_t imageSize = 8 * 1024 * 1024;
+    const uint32_t textRva = 0x1000;
+    const uint32_t textSize = static_cast<uint32_t>(imageSize * 3 / 4);
+    const uint32_t rdataRva = textRva + textSize;
+    const uint32_t rdataSize = static_cast<uint32_t>(imageSize) - rdataRva;
+
+    std::vector<std::vector<uint8_t>> images(moduleCount, std::vector<uint8_t>(imageSize));
+    std::mt19937_64 rng(4242);
+    ModuleRegistry registry;
+    for (size_t m = 0; m < moduleCount; ++m)
+    {
+        std::vector<uint8_t> &image = images[m];
+        for (size_t i = textRva; i < imageSize; i += 8)
+        {
+            uint64_t value = rng();
+            memcpy(&image[i], &value, sizeof(value));
+        }
+
+        // IMAGE_EXPORT_DIRECTORY, then functions, names, ordinals and the name strings
+        uint32_t functionsRva = rdataRva + 40;
+        uint32_t namesRva = functionsRva + static_cast<uint32_t>(exportCount) * 4;
+        uint32_t ordinalsRva = namesRva + static_cast<uint32_t>(exportCount) * 4;
+        uint32_t stringRva = ordinalsRva + static_cast<uint32_t>(exportCount) * 2;
+        memset(&image[rdataRva], 0, 40);
+        uint32_t count32 = static_cast<uint32_t>(exportCount);
+        memcpy(&image[rdataRva + 20], &count32, 4);
+        memcpy(&image[rdataRva + 24], &count32, 4);
+        memcpy(&image[rdataRva + 28], &functionsRva, 4);
+        memcpy(&image[rdataRva + 32], &namesRva, 4);
+        memcpy(&image[rdataRva + 36], &ordinalsRva, 4);
+        for (uint32_t i = 0; i < exportCount; ++i)
+        {
+            char name[32];
+            int length = snprintf(name, sizeof(name), "Export_%05u", i);
+            uint32_t functionRva = textRva + i * 64;
+            uint16_t ordinal = static_cast<uint16_t>(i);
+            memcpy(&image[functionsRva + i * 4], &functionRva, 4);
+            memcpy(&image[namesRva + i * 4], &stringRva, 4);
+            memcpy(&image[ordinalsRva + i * 2], &ordinal, 2);
+            memcpy(&image[stringRva], name, length + 1);
+            stringRva += length + 1;
+        }
+
+        WritePeHeaders(image, {{".text", textRva, textSize, 0x60000020}, {".rdata", rdataRva, rdataSize, 0x40000040}},
+                       rdataRva, stringRva - rdataRva);
+
+        ModuleInfo info;
+        info.name = L"bench" + std::to_wstring(m) + L".dll";
+        info.baseAddress = reinterpret_cast<uintptr_t>(image.data());
+        info.size = imageSize;
+        registry.AddModule(info);
+    }
+
+    MemoryReader reader(GetCurrentProcess());
+    auto start = Clock::now();
+    size_t fingerprinted = registry.ReadFingerprints(reader);
+    double headersMs = ElapsedMs(start);
+
+    uintptr_t rva = 0;
+    size_t found = 0;
+    start = Clock::now();
+    for (size_t m = 0; m < moduleCount; ++m)
+    {
+        found += registry.FindSymbol(L"bench" + std::to_wstring(m) + L".dll", L"Export_00000", reader, rva) ? 1 : 0;
+    }
+    double exportsMs = ElapsedMs(start);
+
+    // 200k offsets relative to 100 exports per module, resolved against the cached export tables
+    const size_t entryCount = 200000;
+    OffsetStorage storage;
+    std::vector<uintptr_t> expected;
+    for (size_t i = 0; i < entryCount; ++i)
+    {
+        size_t module = i % moduleCount;
+        uint32_t symbolIndex = static_cast<uint32_t>((i / moduleCount) % (std::min)(exportCount, static_cast<size_t>(100)));
+        wchar_t symbol[32];
+        swprintf(symbol, 32, L"Export_%05u", symbolIndex);
+
+        OffsetEntry entry;
+        entry.moduleName = L"bench" + std::to_wstring(module) + L".dll";
+        entry.symbol = symbol;
+        entry.offset = i % 64;
+        storage.AddOffset(entry);
+        expected.push_back(reinterpret_cast<uintptr_t>(images[module].data()) + textRva + symbolIndex * 64 + i % 64);
+    }
+
+    AddressResolver resolver;
+    resolver.SetModuleRegistry(&registry);
+    resolver.SetMemoryReader(&reader);
+    start = Clock::now();
+    resolver.ResolveAll(storage);
+    double resolveMs = ElapsedMs(start);
+
+    size_t correct = 0;
+    for (size_t i = 0; i < entryCount; ++i)
+    {
+        const OffsetEntry &entry = storage.GetOffsets()[i];
+        correct += entry.isResolved && entry.resolvedAddress == expected[i] ? 1 : 0;
+    }
+
+    // Code signature planted in .text: whole image vs .text only
+    std::vector<Signature> signatures(moduleCount);
+    for (size_t m = 0; m < moduleCount; ++m)
+    {
+        const uint8_t pattern[] = {0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0x48, 0x85, 0xC0, 0x74, 0x1F};
+        memcpy(&images[m][textRva + 0x4000 + m * 16], pattern, sizeof(pattern));
+        signatures[m].moduleName = L"bench" + std::to_wstring(m) + L".dll";
+        signatures[m].bytes.assign(pattern, pattern + sizeof(pattern));
+        signatures[m].mask.assign(sizeof(pattern), 0xFF);
+    }
+
+    SignatureScanner scanner;
+    start = Clock::now();
+    std::vector<SignatureResult> whole = scanner.Scan(GetCurrentProcess(), registry, signatures);
+    double wholeMs = ElapsedMs(start);
+    uint64_t wholeBytes = scanner.GetLastBytesScanned();
+
+    start = Clock::now();
+    std::vector<SignatureResult> text = scanner.Scan(GetCurrentProcess(), registry, signatures, L".text");
+    double textMs = ElapsedMs(start);
+    uint64_t textBytes = scanner.GetLastBytesScanned();
+
+    size_t sameMatches = 0;
+    for (size_t m = 0; m < moduleCount; ++m)
+    {
+        sameMatches += text[m].IsFound() && text[m].matchOffset == whole[m].matchOffset ? 1 : 0;
+    }
+
+    Report(L"Header pages + fingerprints", headersMs);
+    Report(L"Export tables, first lookup", exportsMs);
+    Report(L"Resolve 200k symbol+delta", resolveMs);
+    Report(L"Signature scan, whole image", wholeMs, static_cast<double>(wholeBytes));
+    Report(L"Signature scan, .text only", textMs, static_cast<double>(textBytes));
+    std::wcout << L"  Fingerprinted " << fingerprinted << L"/" << moduleCount << L", symbols found " << found << L"/"
+               << moduleCount << L", resolved correctly " << correct << L"/" << entryCount
+               << L", .text matches equal " << sameMatches << L"/" << moduleCount << std::endl;
+}
+
+void Benchmark::RunPointerScan(size_t objectCount)
+{
+    std::wcout << L"\n=== Pointer scan (" << objectCount << L" heap objects of 256 bytes, this process) ===\n";
+
+    // A "module" of statics and a heap of objects with 4 pointer fields into other objects
+    const size_t objectSize = 256;
+    std::vector<uint64_t> statics(65536, 0);
+    std::vector<uint8_t> heap(objectCount * objectSize, 0);
+    uintptr_t heapBase = reinterpret_cast<uintptr_t>(heap.data());
+    std::mt19937_64 rng(1337);
+    for (size_t o = 0; o < objectCount; ++o)
+    {
+        for (size_t field = 0; field < 4; ++field)
+        {
+            uint64_t pointer = heapBase + (rng() % objectCount) * objectSize;
+            memcpy(&heap[o * objectSize + (rng() % (objectSize / 8)) * 8], &pointer, sizeof(pointer));
+        }
+    }
+    for (size_t i = 0; i < statics.size(); i += 8)
+    {
+        statics[i] = heapBase + (rng() % objectCount) * objectSize;
+    }
+
+    ModuleRegistry registry;
+    ModuleInfo module;
+    module.name = L"bench.exe";
+    module.baseAddress = reinterpret_cast<uintptr_t>(statics.data());
+    module.size = statics.size() * sizeof(uint64_t);
+    registry.AddModule(module);
+
+    // Planted chains: bench.exe+base -> 0x18 -> 0x70 -> 0xD0, objects A, B, C distinct per chain
+    const size_t plantedCount = 16;
+    std::vector<PointerChain> planted;
+    std::vector<uintptr_t> targets;
+    for (size_t i = 0; i < plantedCount; ++i)
+    {
+        size_t slot = 1 + i * 8 * 16;
+        uintptr_t a = heapBase + (i * 3 + 0) * objectSize;
+        uintptr_t b = heapBase + (i * 3 + 1) * objectSize;
+        uintptr_t c = heapBase + (i * 3 + 2) * objectSize;
+        statics[slot] = a;
+        memcpy(&heap[a - heapBase + 0x18], &b, sizeof(b));
+        memcpy(&heap[b - heapBase + 0x70], &c, sizeof(c));
+
+        PointerChain chain;
+        chain.moduleName = module.name;
+        chain.baseOffset = slot * sizeof(uint64_t);
+        chain.offsets = {0x18, 0x70, 0xD0};
+        planted.push_back(chain);
+        targets.push_back(c + 0xD0);
+    }
+
+    const size_t budget = size_t(1) << 30;
+    PointerScanner scanner;
+    auto start = Clock::now();
+    scanner.BuildPointerMap(GetCurrentProcess(), budget, 1);
+    double singleMs = ElapsedMs(start);
+
+    unsigned threads = (std::max)(1u, std::thread::hardware_concurrency());
+    start = Clock::now();
+    scanner.BuildPointerMap(GetCurrentProcess(), budget, threads);
+    double parallelMs = ElapsedMs(start);
+    const PointerScanStats mapStats = scanner.GetStats();
+
+    PointerScanOptions options;
+    options.maxDepth = 4;
+    options.maxOffset = 0x100;
+    options.maxResults = 100000;
+    size_t found = 0;
+    size_t chainCount = 0;
+    uint64_t nodes = 0;
+    std::vector<size_t> liveCounts;
+    start = Clock::now();
+    for (size_t i = 0; i < plantedCount; ++i)
+    {
+        options.target = targets[i];
+        std::vector<PointerChain> chains = scanner.FindChains(registry, options);
+        liveCounts.push_back(chains.size());
+        chainCount += chains.size();
+        nodes += scanner.GetStats().nodesVisited;
+        for (const PointerChain &chain : chains)
+        {
+            if (chain.moduleName == planted[i].moduleName && chain.baseOffset == planted[i].baseOffset &&
+                chain.offsets == planted[i].offsets)
+            {
+                found++;
+                break;
+            }
+        }
+    }
+    double searchMs = ElapsedMs(start);
+
+    Report(L"Pointer map, 1 thread", singleMs, static_cast<double>(mapStats.bytesScanned));
+    Report(L"Pointer map, " + std::to_wstring(threads) + L" threads", parallelMs,
+           static_cast<double>(mapStats.bytesScanned));
+    Report(L"Search " + std::to_wstring(plantedCount) + L" targets, depth 4", searchMs);
+    std::wcout << L"  " << mapStats.regionCount << L" regions, " << scanner.GetPointerCount() << L" pointers ("
+               << (scanner.GetPointerCount() * sizeof(PointerMapEntry) >> 20) << L" MB), " << nodes
+               << L" nodes expanded, " << chainCount << L" chains; planted chains found: " << found << L"/"
+               << plantedCount << std::endl;
+
+    // Saved map: mapped again and searched offline against the stored module bases
+    const std::wstring filename = L"bench_pointers.ptrmap";
+    start = Clock::now();
+    bool saved = scanner.SavePointerMap(filename, registry);
+    double saveMs = ElapsedMs(start);
+    size_t pointerCount = scanner.GetPointerCount();
+
+    PointerScanner offline;
+    start = Clock::now();
+    bool loaded = saved && offline.LoadPointerMap(filename);
+    double loadMs = ElapsedMs(start);
+
+    size_t sameCounts = 0;
+    size_t walked = 0;
+    start = Clock::now();
+    for (size_t i = 0; loaded && i < plantedCount; ++i)
+    {
+        options.target = targets[i];
+        if (offline.FindChains(options).size() == liveCounts[i])
+            sameCounts++;
+    }
+    double offlineMs = ElapsedMs(start);
+
+    // Planted chains walked with pointer reads from the file
+    for (size_t i = 0; loaded && i < plantedCount; ++i)
+    {
+        uint64_t address = module.baseAddress + planted[i].baseOffset;
+        bool ok = offline.GetMapFile().ReadPointer(address, address);
+        for (size_t o = 0; ok && o + 1 < planted[i].offsets.size(); ++o)
+        {
+            ok = offline.GetMapFile().ReadPointer(address + planted[i].offsets[o], address);
+        }
+        if (ok && address + planted[i].offsets.back() == targets[i])
+            walked++;
+    }
+    uint64_t fileSize = loaded ? offline.GetMapFile().FileSize() : 0;
+    offline.Clear();
+    DeleteFileW(filename.c_str());
+
+    Report(L"Save pointer map", saveMs, static_cast<double>(fileSize));
+    Report(L"Open pointer map", loadMs);
+    Report(L"Offline search " + std::to_wstring(plantedCount) + L" targets", offlineMs);
+    std::wcout << L"  File " << (fileSize >> 10) << L" KB (" << std::fixed << std::setprecision(2)
+               << static_cast<double>(fileSize) / (std::max)(pointerCount, size_t(1)) << L" bytes/pointer, both orders)"
+               << std::defaultfloat << L"; offline chain counts equal " << sameCounts << L"/" << plantedCount
+               << L", planted chains walked from file " << walked << L"/" << plantedCount << std::endl;
+}
+
+void Benchmark::RunChainValidator(size_t runCount)
+{
+    // Per run: 4096 static slots and 100k objects with 4 pointer fields, laid out differently in every run
+    const size_t slotCount = 4096;
+    const size_t objectCount = 100000;
+    const uintptr_t fieldOffsets[4] = {0x10, 0x18, 0x20, 0x28};
+
+    // Candidates like pointer scan output: every slot with all depth-3 field paths, 1024 slots also depth 4
+    PointerChainTable table;
+    size_t candidateCount = 0;
+    for (size_t slot = 0; slot < slotCount; ++slot)
+    {
+        size_t depth = slot < 1024 ? 4 : 3;
+        for (size_t depthSet = 3; depthSet <= depth; ++depthSet)
+        {
+            size_t combos = size_t(1) << (2 * depthSet);
+            for (size_t combo = 0; combo < combos; ++combo)
+            {
+                PointerChain chain;
+                chain.moduleName = L"bench.exe";
+                chain.baseOffset = slot * sizeof(uint64_t);
+                for (size_t level = 0; level < depthSet; ++level)
+                {
+                    chain.offsets.push_back(fieldOffsets[(combo >> (2 * level)) & 3]);
+                }
+                table.AddChain(chain);
+                candidateCount++;
+            }
+        }
+    }
+
+    std::wcout << L"\n=== Chain validator (" << candidateCount << L" candidate chains, " << runCount
+               << L" saved runs) ===\n";
+
+    // Stable links: slots i % 4 == 0 and half of the object fields keep their target object in every run
+    auto mix = [](uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDull;
+        value ^= value >> 33;
+        return value;
+    };
+
+    std::mt19937_64 rng(777);
+    std::vector<std::wstring> files;
+    std::vector<std::vector<ModuleInfo>> runModules;
+    std::vector<uint64_t> expected;
+    for (size_t run = 0; run < runCount; ++run)
+    {
+        uint64_t moduleBase = 0x140000000ull + run * 0x1000000ull;
+        uint64_t heapBase = 0x20000000000ull + run * 0x100000000ull;
+        std::vector<uint32_t> placement(objectCount);
+        std::iota(placement.begin(), placement.end(), 0u);
+        std::shuffle(placement.begin(), placement.end(), rng);
+        auto objectAddress = [&](size_t object)
+        { return heapBase + static_cast<uint64_t>(placement[object]) * 0x400; };
+
+        std::vector<PointerMapEntry> entries;
+        for (size_t slot = 0; slot < slotCount; ++slot)
+        {
+            size_t object = slot % 4 == 0 ? mix(slot) % objectCount : rng() % objectCount;
+            entries.push_back({objectAddress(object), moduleBase + slot * sizeof(uint64_t)});
+        }
+        for (size_t object = 0; object < objectCount; ++object)
+        {
+            for (size_t f = 0; f < 4; ++f)
+            {
+                size_t child = (object + f) % 2 == 0 ? mix(object * 4 + f + 1) % objectCount : rng() % objectCount;
+                entries.push_back({objectAddress(child), objectAddress(object) + fieldOffsets[f]});
+            }
+        }
+
+        // Planted: slot 0 -> 0x10 -> 0x18 -> target+0x28 in every run, slot 1 the same path in run 0 only
+        auto setPointer = [&](uint64_t location, size_t object)
+        {
+            for (PointerMapEntry &entry : entries)
+            {
+                if (entry.location == location)
+                    entry.value = objectAddress(object);
+            }
+        };
+        setPointer(moduleBase, 1);
+        if (run == 0)
+            setPointer(moduleBase + sizeof(uint64_t), 1);
+        setPointer(objectAddress(1) + 0x10, 2);
+        setPointer(objectAddress(2) + 0x18, 3);
+        expected.push_back(objectAddress(3) + 0x28);
+
+        std::sort(entries.begin(), entries.end(), [](const PointerMapEntry &a, const PointerMapEntry &b)
+                  { return a.value < b.value || (a.value == b.value && a.location < b.location); });
+
+        ModuleInfo module;
+        module.name = L"bench.exe";
+        module.baseAddress = static_cast<uintptr_t>(moduleBase);
+        module.size = slotCount * sizeof(uint64_t);
+        runModules.push_back({module});
+        files.push_back(L"bench_run" + std::to_wstring(run) + L".ptrmap");
+        PointerMapFile::Write(files.back(), entries, runModules.back(), false);
+    }
+
+    std::deque<PointerMapFile> maps(runCount);
+    std::vector<ChainSnapshot> snapshots;
+    for (size_t run = 0; run < runCount; ++run)
+    {
+        if (!maps[run].Open(files[run]))
+            return;
+        ChainSnapshot snapshot;
+        snapshot.name = files[run];
+        snapshot.pointerMap = &maps[run];
+        snapshot.modules = maps[run].GetModules();
+        snapshot.expectedAddress = expected[run];
+        snapshots.push_back(snapshot);
+    }
+
+    ChainValidator validator;
+    auto start = Clock::now();
+    std::vector<ChainScore> scores = validator.Validate(table, snapshots, 1);
+    double singleMs = ElapsedMs(start);
+
+    unsigned threads = (std::max)(1u, std::thread::hardware_concurrency());
+    start = Clock::now();
+    scores = validator.Validate(table, snapshots, threads);
+    double parallelMs = ElapsedMs(start);
+    const ChainValidationStats &stats = validator.GetStats();
+
+    // Candidate order: slot 0 depth 3 first, combo (0x10, 0x18, 0x28) = 0 | 1 << 2 | 3 << 4
+    const size_t plantedIndex = 0 | (1 << 2) | (3 << 4);
+    const size_t slotChains = 64 + 256;
+    float stableScore = scores.empty() ? 0 : scores[plantedIndex].score;
+    float unstableScore = scores.empty() ? 0 : scores[slotChains + plantedIndex].score;
+
+    Report(L"Validate, 1 thread", singleMs);
+    Report(L"Validate, " + std::to_wstring(threads) + L" threads", parallelMs);
+    std::wcout << L"  " << stats.pointerReads << L" pointer reads, " << stats.reusedReads
+               << L" reused from shared prefixes, sort " << std::fixed << std::setprecision(2) << stats.sortMs
+               << L" ms; kept at score 1.0: " << ChainValidator::CountKept(scores, 1.0f)
+               << L"; planted stable chain " << stableScore << L", run-0-only chain " << unstableScore
+               << std::defaultfloat << std::endl;
+
+    maps.clear();
+    for (const std::wstring &file : files)
+    {
+        DeleteFileW(file.c_str());
+    }
+}
+
+void Benchmark::RunValueScanner(size_t megabytes)
+{
+    std::wcout << L"\n=== Value scan (" << megabytes << L" MB of int values, this process) ===\n";
+
+    // Small random values everywhere, planted values that occur nowhere else
+    const size_t valueCount = (megabytes << 20) / sizeof(int32_t);
+    std::vector<int32_t> values(valueCount);
+    std::mt19937 rng(1337);
+    for (int32_t &value : values)
+    {
+        value = static_cast<int32_t>(rng() % 1000);
+    }
+    const size_t plantedCount = 64;
+    const int32_t plantedValue = 1234567;
+    std::vector<size_t> planted;
+    for (size_t i = 0; i < plantedCount; ++i)
+    {
+        planted.push_back((rng() % (valueCount / plantedCount)) + i * (valueCount / plantedCount));
+        values[planted.back()] = plantedValue;
+    }
+
+    auto countPlanted = [&](const ValueScanner &scanner, size_t first, size_t step)
+    {
+        std::vector<ValueScanResult> results = scanner.GetResults(static_cast<size_t>(scanner.GetResultCount()));
+        size_t found = 0;
+        for (size_t i = first; i < plantedCount; i += step)
+        {
+            uintptr_t address = reinterpret_cast<uintptr_t>(&values[planted[i]]);
+            found += std::any_of(results.begin(), results.end(), [address](const ValueScanResult &result)
+                                 { return result.address == address; });
+        }
+        return found;
+    };
+
+    unsigned threads = (std::max)(1u, std::thread::hardware_concurrency());
+    ScanCondition condition;
+    condition.compare = ScanCompare::Exact;
+    condition.value = plantedValue;
+
+    ValueScanner scanner;
+    auto start = Clock::now();
+    scanner.FirstScan(GetCurrentProcess(), ValueType::INT, condition, true, 1);
+    double singleMs = ElapsedMs(start);
+    start = Clock::now();
+    scanner.FirstScan(GetCurrentProcess(), ValueType::INT, condition, true, threads);
+    double exactMs = ElapsedMs(start);
+    const ValueScanStats exactStats = scanner.GetStats();
+    size_t exactFound = countPlanted(scanner, 0, 1);
+
+    // Every second planted value grows, the rest stay
+    for (size_t i = 0; i < plantedCount; i += 2)
+    {
+        values[planted[i]]++;
+    }
+    condition.compare = ScanCompare::Increased;
+    start = Clock::now();
+    scanner.NextScan(condition, threads);
+    double increasedMs = ElapsedMs(start);
+    const ValueScanStats increasedStats = scanner.GetStats();
+    size_t increasedFound = countPlanted(scanner, 0, 2);
+
+    // Unknown initial value, then next scans with one value in 16 pages written before the
+    // changed and increased passes; run with full reads, then rereading written pages only
+    struct Pass
+    {
+        const wchar_t *name;
+        ScanCompare compare;
+        bool write;
+        double ms[2];
+        ValueScanStats stats[2];
+    };
+    Pass passes[] = {{L"Unknown first scan", ScanCompare::Unknown, false},
+                     {L"Next scan, changed", ScanCompare::Changed, true},
+                     {L"Next scan, unchanged", ScanCompare::Unchanged, false},
+                     {L"Next scan, increased", ScanCompare::Increased, true}};
+    const bool tracking = DirtyPageTracker::IsSupported();
+    for (int mode = 0; mode < (tracking ? 2 : 1); ++mode)
+    {
+        scanner.SetTrackWrites(mode == 1);
+        for (Pass &pass : passes)
+        {
+            for (size_t i = 0; pass.write && i < valueCount; i += 16 * DirtyPageTracker::PAGE_BYTES / sizeof(int32_t))
+            {
+                values[i] += 7;
+            }
+            condition.compare = pass.compare;
+            start = Clock::now();
+            if (pass.compare == ScanCompare::Unknown)
+                scanner.FirstScan(GetCurrentProcess(), ValueType::INT, condition, true, threads);
+            else
+                scanner.NextScan(condition, threads);
+            pass.ms[mode] = ElapsedMs(start);
+            pass.stats[mode] = scanner.GetStats();
+        }
+        scanner.Reset();
+    }
+
+    Report(L"Exact first scan, 1 thread", singleMs, static_cast<double>(exactStats.bytesRead));
+    Report(L"Exact first scan, " + std::to_wstring(threads) + L" threads", exactMs,
+           static_cast<double>(exactStats.bytesRead));
+    Report(L"Next scan after exact, increased", increasedMs, static_cast<double>(increasedStats.bytesRead));
+    std::wcout << L"  " << exactStats.regionCount << L" regions, " << (exactStats.bytesRead >> 20)
+               << L" MB; exact: " << exactStats.resultCount << L" hits, planted found " << exactFound << L"/"
+               << plantedCount << L"; increased: " << increasedStats.resultCount << L" hits, planted found "
+               << increasedFound << L"/" << plantedCount / 2 << std::endl;
+
+    for (const Pass &pass : passes)
+    {
+        Report(pass.name, pass.ms[0], static_cast<double>(pass.stats[0].bytesRead));
+        if (tracking)
+            Report(std::wstring(pass.name) + L", written pages", pass.ms[1], static_cast<double>(pass.stats[1].bytesRead));
+    }
+    for (const Pass &pass : passes)
+    {
+        std::wcout << L"  " << std::left << std::setw(22) << pass.name << std::right << std::setw(10)
+                   << pass.stats[0].resultCount << L" hits, " << std::setw(6) << (pass.stats[0].memoryBytes >> 10)
+                   << L" KB of results, " << (pass.stats[0].bytesRead >> 20) << L" MB read";
+        if (tracking)
+        {
+            std::wcout << L" / tracked: " << pass.stats[1].resultCount << L" hits, " << (pass.stats[1].bytesRead >> 20)
+                       << L" MB read, " << (pass.stats[1].bytesSkipped >> 20) << L" MB skipped";
+        }
+        std::wcout << std::endl;
+    }
+    if (!tracking)
+        std::wcout << L"  [!] No dirty page tracking on this system, next scans reread all hits" << std::endl;
+}
+
+void Benchmark::RunProcessSnapshot(size_t chainCount)
+{
+    std::wcout << L"\n=== Process snapshot (this process, " << chainCount << L" chains resolved offline) ===\n";
+
+    // Object graph as in the chain table benchmark: root slot -> +0x18 -> +0x70 -> value at +0x10
+    const size_t rootCount = 4096;
+    const size_t nodeSize = 0x80;
+    std::vector<uintptr_t> roots(rootCount);
+    std::vector<std::vector<uint8_t>> nodes(rootCount * 3, std::vector<uint8_t>(nodeSize, 0));
+    for (size_t i = 0; i < rootCount; ++i)
+    {
+        uintptr_t secondAddr = reinterpret_cast<uintptr_t>(nodes[i * 3 + 1].data());
+        uintptr_t leafAddr = reinterpret_cast<uintptr_t>(nodes[i * 3 + 2].data());
+        memcpy(nodes[i * 3].data() + 0x18, &secondAddr, sizeof(secondAddr));
+        memcpy(nodes[i * 3 + 1].data() + 0x70, &leafAddr, sizeof(leafAddr));
+        int32_t value = static_cast<int32_t>(i);
+        memcpy(nodes[i * 3 + 2].data() + 0x10, &value, sizeof(value));
+        roots[i] = reinterpret_cast<uintptr_t>(nodes[i * 3].data());
+    }
+
+    // 64 MB of compressible data (small values) next to the graph
+    std::vector<uint32_t> filler((64 << 20) / sizeof(uint32_t));
+    std::mt19937 rng(1337);
+    for (uint32_t &value : filler)
+    {
+        value = rng() % 1000;
+    }
+
+    ModuleInfo module;
+    module.name = L"bench_target.exe";
+    module.baseAddress = reinterpret_cast<uintptr_t>(roots.data());
+    module.size = roots.size() * sizeof(uintptr_t);
+    ModuleRegistry registry;
+    registry.AddModule(module);
+
+    std::vector<PointerChain> chains(chainCount);
+    for (size_t i = 0; i < chainCount; ++i)
+    {
+        chains[i].moduleName = module.name;
+        chains[i].baseOffset = (i % rootCount) * sizeof(uintptr_t);
+        chains[i].offsets = {0x18, 0x70, 0x10};
+        chains[i].valueType = ValueType::INT;
+    }
+
+    const std::wstring filename = L"bench_process.psnap";
+    SnapshotCaptureStats singleStats;
+    auto start = Clock::now();
+    ProcessSnapshot::Capture(GetCurrentProcess(), registry.GetModules(), filename, 1, &singleStats);
+    double singleMs = ElapsedMs(start);
+
+    unsigned threads = (std::max)(1u, std::thread::hardware_concurrency());
+    SnapshotCaptureStats stats;
+    start = Clock::now();
+    bool captured = ProcessSnapshot::Capture(GetCurrentProcess(), registry.GetModules(), filename, threads, &stats);
+    double parallelMs = ElapsedMs(start);
+
+    // Live values change after the capture, offline reads must still see the captured ones
+    for (size_t i = 0; i < rootCount; ++i)
+    {
+        int32_t value = -1;
+        memcpy(nodes[i * 3 + 2].data() + 0x10, &value, sizeof(value));
+    }
+
+    ProcessSnapshot snapshot;
+    start = Clock::now();
+    bool opened = captured && snapshot.Open(filename);
+    double openMs = ElapsedMs(start);
+
+    // Random 8-byte reads over the filler, nearly every read decompresses a chunk
+    const size_t readCount = 20000;
+    size_t readsOk = 0;
+    start = Clock::now();
+    for (size_t i = 0; opened && i < readCount; ++i)
+    {
+        size_t index = rng() % (filler.size() - 1);
+        uint64_t value;
+        if (snapshot.Read(reinterpret_cast<uintptr_t>(&filler[index]), &value, sizeof(value)) &&
+            value == (static_cast<uint64_t>(filler[index + 1]) << 32 | filler[index]))
+            readsOk++;
+    }
+    double randomMs = ElapsedMs(start);
+
+    MemoryReader reader(nullptr);
+    reader.SetLogErrors(false);
+    reader.SetSnapshot(opened ? &snapshot : nullptr);
+    ModuleRegistry offlineRegistry;
+    for (const ModuleInfo &info : snapshot.GetModules())
+    {
+        offlineRegistry.AddModule(info);
+    }
+    PointerChainResolver resolver(&offlineRegistry, &reader);
+    start = Clock::now();
+    int resolved = opened ? resolver.ResolveAllChains(chains) : 0;
+    double resolveMs = ElapsedMs(start);
+
+    size_t matching = 0;
+    for (size_t i = 0; i < chainCount; ++i)
+    {
+        if (chains[i].isResolved && chains[i].currentValue.data.intValue == static_cast<int32_t>(i % rootCount))
+            matching++;
+    }
+    snapshot.Close();
+    DeleteFileW(filename.c_str());
+
+    Report(L"Capture, 1 thread", singleMs, static_cast<double>(singleStats.capturedBytes));
+    Report(L"Capture, " + std::to_wstring(threads) + L" threads", parallelMs, static_cast<double>(stats.capturedBytes));
+    Report(L"Open snapshot", openMs);
+    Report(L"Random 8-byte reads (" + std::to_wstring(readCount) + L")", randomMs);
+    Report(L"Resolve chains offline", resolveMs);
+    std::wcout << L"  " << stats.regionCount << L" regions, " << (stats.capturedBytes >> 20) << L" MB captured, "
+               << (stats.storedBytes >> 20) << L" MB stored (" << std::fixed << std::setprecision(1)
+               << 100.0 * static_cast<double>(stats.storedBytes) / (std::max)(stats.capturedBytes, uint64_t(1))
+               << L"%), " << std::defaultfloat << stats.zeroChunks << L" zero / " << stats.rawChunks << L" raw of "
+               << stats.chunkCount << L" chunks, " << stats.unreadablePages << L" unreadable pages\n";
+    std::wcout << L"  " << std::fixed << std::setprecision(3) << randomMs * 1000.0 / readCount
+               << L" us per random read, " << std::defaultfloat << readsOk << L"/" << readCount
+               << L" correct; chains resolved " << resolved << L"/" << chainCount << L", captured values "
+               << matching << L"/" << chainCount << std::endl;
+}
+
+void Benchmark::RunSnapshotDiff(size_t megabytes)
+{
+    std::wcout << L"\n=== Snapshot diff (this process, " << megabytes << L" MB of values, 192 planted changes) ===\n";
+
+    // Small random values; planted ints, floats and pointers are changed between the captures
+    std::vector<uint32_t> values((megabytes << 20) / sizeof(uint32_t));
+    std::mt19937 rng(1337);
+    for (uint32_t &value : values)
+    {
+        value = rng() % 1000;
+    }
+    const size_t plantedPerKind = 64;
+    const size_t stride = values.size() / (plantedPerKind * 3);
+    struct Planted
+    {
+        size_t index;
+        DiffValueKind kind;
+    };
+    std::vector<Planted> planted;
+    for (size_t i = 0; i < plantedPerKind * 3; ++i)
+    {
+        size_t index = (i * stride + rng() % (stride / 2)) & ~size_t(1); // 8-byte aligned slot
+        DiffValueKind kind = i % 3 == 0 ? DiffValueKind::Int : i % 3 == 1 ? DiffValueKind::Float : DiffValueKind::Pointer;
+        if (kind == DiffValueKind::Float)
+        {
+            float value = 100.0f + i;
+            memcpy(&values[index], &value, sizeof(value));
+        }
+        else if (kind == DiffValueKind::Pointer)
+        {
+            uint64_t pointer = reinterpret_cast<uintptr_t>(&values[rng() % values.size()]);
+            memcpy(&values[index], &pointer, sizeof(pointer));
+        }
+        planted.push_back({index, kind});
+    }
+
+    const std::wstring beforeFile = L"bench_before.psnap";
+    const std::wstring afterFile = L"bench_after.psnap";
+    std::vector<ModuleInfo> modules;
+    bool captured = ProcessSnapshot::Capture(GetCurrentProcess(), modules, beforeFile);
+    for (const Planted &p : planted)
+    {
+        if (p.kind == DiffValueKind::Int)
+        {
+            values[p.index] += 5;
+        }
+        else if (p.kind == DiffValueKind::Float)
+        {
+            float value;
+            memcpy(&value, &values[p.index], sizeof(value));
+            value *= 1.5f;
+            memcpy(&values[p.index], &value, sizeof(value));
+        }
+        else
+        {
+            uint64_t pointer = reinterpret_cast<uintptr_t>(&values[rng() % values.size()]);
+            memcpy(&values[p.index], &pointer, sizeof(pointer));
+        }
+    }
+    captured = captured && ProcessSnapshot::Capture(GetCurrentProcess(), modules, afterFile);
+
+    ProcessSnapshot before;
+    ProcessSnapshot after;
+    SnapshotDiff diff;
+    bool opened = captured && before.Open(beforeFile) && after.Open(afterFile);
+
+    auto start = Clock::now();
+    if (opened)
+        diff.Compare(before, after, 1);
+    double singleMs = ElapsedMs(start);
+
+    unsigned threads = (std::max)(1u, std::thread::hardware_concurrency());
+    start = Clock::now();
+    if (opened)
+        diff.Compare(before, after, threads);
+    double parallelMs = ElapsedMs(start);
+    const SnapshotDiffStats stats = diff.GetStats();
+
+    // Every planted change must overlap one reported range with the right type
+    // (a float may change only its high bytes)
+    size_t found = 0;
+    size_t typed = 0;
+    const std::vector<SnapshotDiffRange> &ranges = diff.GetRanges();
+    for (const Planted &p : planted)
+    {
+        uintptr_t address = reinterpret_cast<uintptr_t>(&values[p.index]);
+        auto it = std::upper_bound(ranges.begin(), ranges.end(), address + 3, [](uintptr_t a, const SnapshotDiffRange &r)
+                                   { return a < r.address; });
+        if (it == ranges.begin())
+            continue;
+        --it;
+        if (it->address + it->size > address)
+        {
+            found++;
+            if (diff.Interpret(*it).kind == p.kind)
+                typed++;
+        }
+    }
+
+    diff.Clear();
+    before.Close();
+    after.Close();
+    DeleteFileW(beforeFile.c_str());
+    DeleteFileW(afterFile.c_str());
+
+    Report(L"Diff, 1 thread", singleMs, static_cast<double>(stats.comparedBytes));
+    Report(L"Diff, " + std::to_wstring(threads) + L" threads", parallelMs, static_cast<double>(stats.comparedBytes));
+    std::wcout << L"  " << (stats.comparedBytes >> 20) << L" MB compared, " << (stats.decodedBytes >> 20)
+               << L" MB decoded (rest identical chunks), " << stats.pieceCount << L" pieces; " << stats.rangeCount
+               << L" ranges, " << stats.changedBytes << L" changed bytes\n";
+    std::wcout << L"  Planted changes found " << found << L"/" << planted.size() << L", typed correctly " << typed
+               << L"/" << planted.size() << std::endl;
+}
+
+void Benchmark::RunConsistentReads(size_t objectCount)
+{
+    std::wcout << L"\n=== Consistent reads (this process, " << objectCount << L" x/y/z triples under a writer) ===\n";
+
+    // root slot -> +0x18 -> leaf with x, y, z at +0x10; the writer keeps y == 2x and z == -3x
+    const size_t nodeSize = 0x40;
+    std::vector<uintptr_t> roots(objectCount);
+    std::vector<std::vector<uint8_t>> nodes(objectCount * 2, std::vector<uint8_t>(nodeSize, 0));
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        uintptr_t leafAddr = reinterpret_cast<uintptr_t>(nodes[i * 2 + 1].data());
+        memcpy(nodes[i * 2].data() + 0x18, &leafAddr, sizeof(leafAddr));
+        roots[i] = reinterpret_cast<uintptr_t>(nodes[i * 2].data());
+    }
+
+    ModuleInfo module;
+    module.name = L"bench_target.exe";
+    module.baseAddress = reinterpret_cast<uintptr_t>(roots.data());
+    module.size = roots.size() * sizeof(uintptr_t);
+    ModuleRegistry registry;
+    registry.AddModule(module);
+
+    std::vector<PointerChain> chains(objectCount * 3);
+    for (size_t i = 0; i < chains.size(); ++i)
+    {
+        chains[i].moduleName = module.name;
+        chains[i].baseOffset = (i / 3) * sizeof(uintptr_t);
+        chains[i].offsets = {0x18, 0x10 + (i % 3) * sizeof(int32_t)};
+        chains[i].valueType = ValueType::INT;
+    }
+    PointerChainTable table;
+    table.Build(chains);
+
+    std::atomic<bool> stop(false);
+    auto write = [&]()
+    {
+        uint32_t counter = 0;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            counter++;
+            for (size_t i = 0; i < objectCount; ++i)
+            {
+                volatile uint32_t *leaf = reinterpret_cast<volatile uint32_t *>(nodes[i * 2 + 1].data() + 0x10);
+                leaf[0] = counter;
+                leaf[1] = counter * 2;
+                leaf[2] = counter * static_cast<uint32_t>(-3);
+            }
+        }
+    };
+    std::thread writer(write);
+
+    MemoryReader reader(GetCurrentProcess());
+    reader.SetLogErrors(false);
+    PointerChainResolver resolver(&registry, &reader);
+
+    // Triples whose three values were not written in the same writer round
+    auto countTorn = [&]()
+    {
+        size_t torn = 0;
+        for (size_t i = 0; i < objectCount; ++i)
+        {
+            uint32_t x = static_cast<uint32_t>(table.GetValue(i * 3).data.intValue);
+            uint32_t y = static_cast<uint32_t>(table.GetValue(i * 3 + 1).data.intValue);
+            uint32_t z = static_cast<uint32_t>(table.GetValue(i * 3 + 2).data.intValue);
+            if (y != x * 2 || z != x * static_cast<uint32_t>(-3))
+                torn++;
+        }
+        return torn;
+    };
+
+    const size_t rounds = 50;
+    size_t liveTorn = 0;
+    int liveResolved = 0;
+    auto start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        liveResolved = resolver.ResolveTable(table);
+        liveTorn += countTorn();
+    }
+    double liveMs = ElapsedMs(start);
+
+    ProcessPause pause;
+    ConsistentReadStats stats;
+    size_t pausedTorn = 0;
+    size_t replanned = 0;
+    size_t unpaused = 0;
+    int pausedResolved = 0;
+    start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        pausedResolved = resolver.ResolveTableConsistent(table, pause, &stats);
+        pausedTorn += countTorn();
+        replanned += stats.replanned;
+        unpaused += stats.unpaused;
+    }
+    double pausedMs = ElapsedMs(start);
+
+    stop = true;
+    writer.join();
+
+    Report(L"Resolve " + std::to_wstring(rounds) + L"x, live", liveMs);
+    Report(L"Resolve " + std::to_wstring(rounds) + L"x, paused", pausedMs);
+    std::wcout << L"  Live: " << liveResolved << L"/" << chains.size() << L" resolved, " << liveTorn << L"/"
+               << objectCount * rounds << L" torn triples\n";
+    std::wcout << L"  Paused: " << pausedResolved << L"/" << chains.size() << L" resolved, " << pausedTorn << L"/"
+               << objectCount * rounds << L" torn triples, " << stats.spanCount << L" spans / " << stats.bytesRead
+               << L" bytes per pass, " << replanned << L" replanned, " << unpaused << L" read unpaused\n";
+    if (pause.GetHistogram().count == 0)
+        std::wcout << L"  [!] This process cannot be paused here, chains were read live\n";
+    pause.GetHistogram().Print();
+}
+
+void Benchmark::RunTornReads(size_t objectCount)
+{
+    std::wcout << L"\n=== Torn-read checks (this process, " << objectCount << L" doubles under a writer) ===\n";
+
+    // root slot -> +0x18 -> leaf: seqlock counter at +0x00, value at +0x08 written as two 32-bit halves
+    const size_t nodeSize = 0x40;
+    std::vector<uintptr_t> roots(objectCount);
+    std::vector<std::vector<uint8_t>> nodes(objectCount * 2, std::vector<uint8_t>(nodeSize, 0));
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        uintptr_t leafAddr = reinterpret_cast<uintptr_t>(nodes[i * 2 + 1].data());
+        memcpy(nodes[i * 2].data() + 0x18, &leafAddr, sizeof(leafAddr));
+        roots[i] = reinterpret_cast<uintptr_t>(nodes[i * 2].data());
+    }
+
+    ModuleInfo module;
+    module.name = L"bench_target.exe";
+    module.baseAddress = reinterpret_cast<uintptr_t>(roots.data());
+    module.size = roots.size() * sizeof(uintptr_t);
+    ModuleRegistry registry;
+    registry.AddModule(module);
+
+    std::vector<PointerChain> chains(objectCount);
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        chains[i].moduleName = module.name;
+        chains[i].baseOffset = i * sizeof(uintptr_t);
+        chains[i].offsets = {0x18, 0x08};
+        chains[i].valueType = ValueType::DOUBLE;
+    }
+
+    std::atomic<bool> stop(false);
+    auto write = [&]()
+    {
+        uint32_t counter = 0;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            counter++;
+            for (size_t i = 0; i < objectCount; ++i)
+            {
+                volatile uint32_t *leaf = reinterpret_cast<volatile uint32_t *>(nodes[i * 2 + 1].data());
+                leaf[0] = leaf[0] + 1; // odd: write in progress
+                std::atomic_thread_fence(std::memory_order_release);
+                leaf[2] = counter;
+                leaf[3] = counter;
+                std::atomic_thread_fence(std::memory_order_release);
+                leaf[0] = leaf[0] + 1;
+            }
+        }
+    };
+    std::thread writer(write);
+
+    MemoryReader reader(GetCurrentProcess());
+    reader.SetLogErrors(false);
+    PointerChainResolver resolver(&registry, &reader);
+
+    struct Config
+    {
+        const wchar_t *label;
+        TornCheck check;
+        size_t every; // Every n-th chain opts in
+    };
+    const Config configs[] = {{L"no checks", TornCheck::None, 1},
+                              {L"reread, 1/8 of chains", TornCheck::Reread, 8},
+                              {L"reread, all chains", TornCheck::Reread, 1},
+                              {L"seqlock, all chains", TornCheck::Sequence, 1}};
+
+    const size_t rounds = 50;
+    for (const Config &config : configs)
+    {
+        for (size_t i = 0; i < objectCount; ++i)
+        {
+            chains[i].tornCheck = i % config.every == 0 ? config.check : TornCheck::None;
+            chains[i].sequenceOffset = 0;
+        }
+        PointerChainTable table;
+        table.Build(chains);
+
+        size_t torn = 0;   // Halves differ and the value was not flagged
+        size_t caught = 0; // Flagged suspect
+        TornReadStats total;
+        auto start = Clock::now();
+        for (size_t r = 0; r < rounds; ++r)
+        {
+            resolver.ResolveTable(table);
+            const TornReadStats &stats = resolver.GetTornReadStats();
+            total.extraReads += stats.extraReads;
+            total.retriedValues += stats.retriedValues;
+            total.checkUs += stats.checkUs;
+            for (size_t i = 0; i < objectCount; ++i)
+            {
+                double value = table.GetValue(i).data.doubleValue;
+                uint32_t halves[2];
+                memcpy(halves, &value, sizeof(halves));
+                if (table.IsSuspect(i))
+                    caught++;
+                else if (halves[0] != halves[1])
+                    torn++;
+            }
+        }
+        double ms = ElapsedMs(start);
+
+        Report(L"Resolve " + std::to_wstring(rounds) + L"x, " + config.label, ms);
+        std::wcout << L"    " << torn << L"/" << objectCount * rounds << L" torn values returned, " << caught
+                   << L" flagged suspect, " << total.retriedValues << L" retried, " << total.extraReads
+                   << L" extra reads, " << std::fixed << std::setprecision(1) << total.checkUs / 1000.0
+                   << L" ms checking" << std::defaultfloat << L"\n";
+    }
+
+    stop = true;
+    writer.join();
+}
+
+void Benchmark::RunFieldGroups(size_t objectCount)
+{
+    const size_t fieldCount = 20;
+    std::wcout << L"\n=== Field groups (this process, " << objectCount << L" objects x " << fieldCount
+               << L" fields) ===\n";
+
+    // root slot -> +0x18 -> object with fieldCount 4-byte fields from +0x40, ints and floats alternating
+    const size_t nodeSize = 0x100;
+    std::vector<uintptr_t> roots(objectCount);
+    std::vector<std::vector<uint8_t>> nodes(objectCount * 2, std::vector<uint8_t>(nodeSize, 0));
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        uintptr_t objectAddr = reinterpret_cast<uintptr_t>(nodes[i * 2 + 1].data());
+        memcpy(nodes[i * 2].data() + 0x18, &objectAddr, sizeof(objectAddr));
+        roots[i] = reinterpret_cast<uintptr_t>(nodes[i * 2].data());
+        for (size_t f = 0; f < fieldCount; ++f)
+        {
+            uint8_t *slot = nodes[i * 2 + 1].data() + 0x40 + f * 4;
+            if (f % 2 == 0)
+            {
+                int32_t value = static_cast<int32_t>(i * fieldCount + f);
+                memcpy(slot, &value, sizeof(value));
+            }
+            else
+            {
+                float value = static_cast<float>(i) + static_cast<float>(f) / 100.0f;
+                memcpy(slot, &value, sizeof(value));
+            }
+        }
+    }
+
+    ModuleInfo module;
+    module.name = L"bench_target.exe";
+    module.baseAddress = reinterpret_cast<uintptr_t>(roots.data());
+    module.size = roots.size() * sizeof(uintptr_t);
+    ModuleRegistry registry;
+    registry.AddModule(module);
+
+    // The same fields as one chain each, and as one field group per object
+    std::vector<PointerChain> singleChains(objectCount * fieldCount);
+    std::vector<PointerChain> groupChains(objectCount);
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        PointerChain &group = groupChains[i];
+        group.moduleName = module.name;
+        group.baseOffset = i * sizeof(uintptr_t);
+        group.offsets = {0x18, 0x0};
+        for (size_t f = 0; f < fieldCount; ++f)
+        {
+            ChainField field;
+            field.offset = 0x40 + f * 4;
+            field.type = f % 2 == 0 ? ValueType::INT : ValueType::FLOAT;
+            field.name = L"field" + std::to_wstring(f);
+            group.fields.push_back(field);
+
+            PointerChain &single = singleChains[i * fieldCount + f];
+            single.moduleName = module.name;
+            single.baseOffset = group.baseOffset;
+            single.offsets = {0x18, field.offset};
+            single.valueType = field.type;
+        }
+        group.valueType = group.fields.front().type;
+    }
+
+    PointerChainTable singleTable;
+    singleTable.Build(singleChains);
+    PointerChainTable groupTable;
+    groupTable.Build(groupChains);
+
+    MemoryReader reader(GetCurrentProcess());
+    reader.SetLogErrors(false);
+    PointerChainResolver resolver(&registry, &reader);
+
+    const size_t rounds = 20;
+    int singleResolved = 0;
+    auto start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        singleResolved = resolver.ResolveTable(singleTable);
+    }
+    double singleMs = ElapsedMs(start);
+
+    int groupResolved = 0;
+    start = Clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        groupResolved = resolver.ResolveTable(groupTable);
+    }
+    double groupMs = ElapsedMs(start);
+
+    size_t matching = 0;
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+        for (uint32_t f = 0; f < fieldCount; ++f)
+        {
+            MemoryValue single = singleTable.GetValue(i * fieldCount + f);
+            MemoryValue grouped = groupTable.GetFieldValue(i, f);
+            if (single.isValid && grouped.isValid && single.type == grouped.type &&
+                memcmp(&single.data, &grouped.data, PointerChainResolver::ValueSize(single.type)) == 0)
+                matching++;
+        }
+    }
+
+    Report(L"Resolve " + std::to_wstring(rounds) + L"x, one chain per field", singleMs);
+    Report(L"Resolve " + std::to_wstring(rounds) + L"x, field groups", groupMs);
+    std::wcout << L"  " << singleResolved << L"/" << singleChains.size() << L" chains vs " << groupResolved << L"/"
+               << groupChains.size() << L" groups resolved, " << objectCount * fieldCount * 3 << L" vs "
+               << objectCount * 3 << L" reads per pass, " << std::fixed << std::setprecision(1)
+               << singleMs / (std::max)(groupMs, 0.001) << L"x faster" << std::defaultfloat << L"\n";
+    std::wcout << L"  Field values matching: " << matching << L"/" << objectCount * fieldCount << std::endl;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <string>
+
+class ModuleRegistry;
+
+// ============================================================================
+// Benchmark: Built-in performance measurements
+// Purpose: Reproducible numbers for the hot paths (parsers, resolvers)
+// Run with 'bench' command in main menu, results go to console
+// ============================================================================
+
+class Benchmark
+{
+public:
+    // Text offset config loader vs. the previous wifstream-based loader
+    static void RunOffsetParser(size_t entryCount);
+
+    // Text load + ResolveAll vs. mapped .ofdb + ResolveAll over the mapped array
+    static void RunOffsetDatabase(size_t entryCount);
+
+    // Grouped AddressResolver::ResolveAll vs. per-entry ResolveOffset
+    static void RunAddressResolver(size_t entryCount);
+
+    // PointerChain vector vs. PointerChainTable: memory per chain and resolve time
+    static void RunChainTable(size_t chainCount);
+
+    // Chain file save/load vs. the previous wofstream/wifstream implementation
+    static void RunChainStorage(size_t chainCount);
+
+    // Single-chain edit saves: journal append vs. full rewrite, load with replay
+    static void RunEditJournal(size_t chainCount);
+
+    // ModuleHasher over in-process fake modules: 1 thread vs. pool vs. cached, GB/s
+    static void RunModuleHasher(size_t megabytes);
+
+    // SignatureScanner over an in-process fake module vs. a plain masked compare per position
+    static void RunSignatureScanner(size_t megabytes, size_t signatureCount);
+
+    // SignatureGenerator: index build, generation for offsetCount planted references, scan-back check
+    static void RunSignatureGenerator(size_t megabytes, size_t offsetCount);
+
+    // XrefIndex over a generated PE image: build with 1 thread vs. pool, lookups per second
+    static void RunXrefIndex(size_t megabytes);
+
+    // Cached PE headers: header/export parse, symbol+delta resolution, section-limited scan
+    static void RunModuleHeaders(size_t moduleCount, size_t exportCount);
+
+    // Pointer scan of this process: map build 1 vs N threads, search for planted chains
+    static void RunPointerScan(size_t objectCount);
+
+    // Chain stability: candidate chains scored against saved pointer maps of several runs
+    static void RunChainValidator(size_t runCount);
+
+    // Value scan of a buffer in this process: exact first scan 1 vs N threads, next scans, unknown value
+    static void RunValueScanner(size_t megabytes);
+
+    // Snapshot of this process: capture 1 vs N threads, compression, random reads, chains resolved offline
+    static void RunProcessSnapshot(size_t chainCount);
+
+    // Two snapshots of this process around planted int/float/pointer changes: diff 1 vs N threads, types found
+    static void RunSnapshotDiff(size_t megabytes);
+
+    // x/y/z triples rewritten by a thread: torn triples with live vs paused resolution, pause histogram
+    static void RunConsistentReads(size_t objectCount);
+
+    // Doubles written as two halves by a thread: no check vs reread vs seqlock, torn values and overhead
+    static void RunTornReads(size_t objectCount);
+
+    // 20 fields per object as 20 chains vs one field group chain: resolve time, values equal
+    static void RunFieldGroups(size_t objectCount);
+
+private:
+    // Write a generated offset config with entryCount entries
+    static bool GenerateOffsetConfig(const std::wstring &filename, size_t entryCount);
+
+    // Register the fake module0.dll..module31.dll used by generated configs
+    static void RegisterFakeModules(ModuleRegistry &registry);
+
+    // Print one result line: label, time in ms, optional throughput
+    static void Report(const std::wstring &label, double milliseconds, double bytes = 0.0);
+};
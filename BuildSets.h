@@ -0,0 +1,185 @@
+#pragma once
+#include "ModuleRegistry.h"
+#include "StringUtils.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// BuildSets: Entry sets for several builds of the target in one storage
+// Purpose: One config file carries offsets for every known build, the set
+// matching the loaded modules is picked on attach
+// - a set is keyed by a module build key ("app.exe@5F3A2B1C-0045E000"),
+//   the empty key is the default set for unknown builds
+// - the active set lives in the storage's own vector, so resolvers and the
+//   UI keep working on a plain list; the other sets are parked here
+// - files list the default set first, then one [key] section per build
+// ============================================================================
+
+// Parsed entries from index first on belong to the set named key
+struct BuildSection
+{
+    size_t first;
+    std::wstring key;
+};
+
+// Section header line "[key]" in text formats, "[]" returns to the default set
+inline bool ParseBuildSection(const char *begin, const char *end, std::wstring &outKey)
+{
+    if (end - begin < 2 || *begin != '[' || end[-1] != ']')
+        return false;
+
+    StringUtils::Utf8ToWide(begin + 1, end - begin - 2, outKey);
+    return true;
+}
+
+inline void AppendBuildSection(const std::wstring &key, std::string &out)
+{
+    out += "\n[";
+    StringUtils::AppendUtf8(key, out);
+    out += "]\n";
+}
+
+template <typename Entry>
+class BuildSets
+{
+public:
+    const std::wstring &GetActiveKey() const { return m_activeKey; }
+
+    // Number of sets including the active one
+    size_t GetSetCount() const { return m_parked.size() + 1; }
+
+    // Make the default set of parsed entries active and park the others
+    void Load(std::vector<Entry> &entries, const std::vector<BuildSection> &sections)
+    {
+        auto sets = Split(std::move(entries), sections);
+        m_activeKey.clear();
+        entries = std::move(sets[m_activeKey]);
+        sets.erase(m_activeKey);
+        m_parked = std::move(sets);
+    }
+
+    // Park re-read entries of the other sets, return the ones for the active set
+    std::vector<Entry> TakeReload(std::vector<Entry> &&entries, const std::vector<BuildSection> &sections)
+    {
+        auto sets = Split(std::move(entries), sections);
+        std::vector<Entry> active = std::move(sets[m_activeKey]);
+        sets.erase(m_activeKey);
+        m_parked = std::move(sets);
+        return active;
+    }
+
+    // Park the active entries and activate the set named key (empty if new)
+    void Switch(std::vector<Entry> &active, const std::wstring &key)
+    {
+        if (key == m_activeKey)
+            return;
+
+        if (!active.empty())
+            m_parked[m_activeKey] = std::move(active);
+
+        auto it = m_parked.find(key);
+        if (it != m_parked.end())
+        {
+            active = std::move(it->second);
+            m_parked.erase(it);
+        }
+        else
+        {
+            active.clear();
+        }
+        m_activeKey = key;
+    }
+
+    // Key of the set that fits the loaded modules
+    // Returns false if the active set already fits
+    bool FindMatch(const ModuleRegistry &registry, std::wstring &outKey) const
+    {
+        if (!m_activeKey.empty() && registry.MatchesBuildKey(m_activeKey))
+            return false;
+
+        for (const auto &set : m_parked)
+        {
+            if (!set.first.empty() && registry.MatchesBuildKey(set.first))
+            {
+                outKey = set.first;
+                return true;
+            }
+        }
+
+        // Unknown build: fall back to the default set
+        outKey.clear();
+        return !m_activeKey.empty();
+    }
+
+    // Attach the active set to key, fails if another set already has it
+    bool Bind(const std::wstring &key)
+    {
+        if (key != m_activeKey && m_parked.count(key) != 0)
+            return false;
+
+        m_activeKey = key;
+        return true;
+    }
+
+    void Clear()
+    {
+        m_parked.clear();
+        m_activeKey.clear();
+    }
+
+    // Visit every set in file order (default first, then by key)
+    template <typename Fn>
+    void ForEachSet(const std::vector<Entry> &active, Fn fn) const
+    {
+        std::vector<std::pair<const std::wstring *, const std::vector<Entry> *>> sets;
+        sets.emplace_back(&m_activeKey, &active);
+        for (const auto &set : m_parked)
+        {
+            sets.emplace_back(&set.first, &set.second);
+        }
+        std::sort(sets.begin(), sets.end(), [](const auto &a, const auto &b)
+                  { return *a.first < *b.first; });
+
+        for (const auto &set : sets)
+        {
+            fn(*set.first, *set.second);
+        }
+    }
+
+private:
+    std::wstring m_activeKey;
+    std::map<std::wstring, std::vector<Entry>> m_parked;
+
+    // Group entries by section key, sections with the same key are concatenated
+    static std::map<std::wstring, std::vector<Entry>> Split(std::vector<Entry> &&entries,
+                                                            const std::vector<BuildSection> &sections)
+    {
+        std::map<std::wstring, std::vector<Entry>> sets;
+        if (sections.empty())
+        {
+            sets[std::wstring()] = std::move(entries);
+            return sets;
+        }
+
+        std::wstring key;
+        size_t begin = 0;
+        for (size_t i = 0; i <= sections.size(); ++i)
+        {
+            size_t end = i < sections.size() ? (std::min)(sections[i].first, entries.size()) : entries.size();
+            if (end > begin)
+            {
+                std::vector<Entry> &set = sets[key];
+                std::move(entries.begin() + begin, entries.begin() + end, std::back_inserter(set));
+                begin = end;
+            }
+            if (i < sections.size())
+                key = sections[i].key;
+        }
+        return sets;
+    }
+};
@@ -0,0 +1,275 @@
+#include "ChainValidator.h"
+#include "MemoryReader.h"
+#include "PointerChainResolver.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <thread>
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool ReadSnapshot(const ChainSnapshot &snapshot, uint64_t address, void *buffer, size_t size)
+{
+    if (snapshot.pointerMap != nullptr)
+    {
+        uint64_t value;
+        if (size != sizeof(value) || !snapshot.pointerMap->ReadPointer(address, value))
+            return false;
+        memcpy(buffer, &value, sizeof(value));
+        return true;
+    }
+
+    if (address < MemoryReader::MIN_VALID_ADDRESS || address > MemoryReader::MAX_VALID_ADDRESS)
+        return false;
+    return MemoryReader::ReadRangePadded(snapshot.process, static_cast<uintptr_t>(address), buffer, size) == 0;
+}
+
+float ChainValidator::Score(const ChainScore &score, size_t snapshotCount, size_t addressSnapshots)
+{
+    if (snapshotCount == 0)
+        return 0;
+
+    float hits = addressSnapshots != 0 ? static_cast<float>(score.addressHits) / addressSnapshots
+                                       : static_cast<float>(score.resolved) / snapshotCount;
+    if (score.valueSamples >= 2)
+        hits *= static_cast<float>(score.valueAgree) / score.valueSamples;
+    return hits;
+}
+
+std::vector<ChainScore> ChainValidator::Validate(const PointerChainTable &table,
+                                                 const std::vector<ChainSnapshot> &snapshots, unsigned threadCount)
+{
+    m_stats = ChainValidationStats();
+    const size_t count = table.Count();
+    const size_t snapshotCount = snapshots.size();
+    m_stats.chainCount = count;
+    m_stats.snapshotCount = snapshotCount;
+
+    if (snapshotCount > MAX_SNAPSHOTS)
+    {
+        std::wcerr << L"[-] At most " << MAX_SNAPSHOTS << L" snapshots can be compared" << std::endl;
+        return {};
+    }
+
+    std::vector<ChainScore> scores(count);
+    if (count == 0 || snapshotCount == 0)
+        return scores;
+
+    // Module base per pooled string id and snapshot (0 = module not in that run), case-insensitive
+    const size_t stringCount = table.GetStringCount();
+    std::vector<std::vector<uint64_t>> bases(snapshotCount, std::vector<uint64_t>(stringCount, 0));
+    for (size_t s = 0; s < snapshotCount; ++s)
+    {
+        std::map<std::wstring, uint64_t> byName;
+        for (const ModuleInfo &module : snapshots[s].modules)
+        {
+            std::wstring name = module.name;
+            std::transform(name.begin(), name.end(), name.begin(), ::towlower);
+            byName.emplace(name, module.baseAddress);
+        }
+        for (uint32_t id = 0; id < stringCount; ++id)
+        {
+            std::wstring name = table.GetString(id);
+            std::transform(name.begin(), name.end(), name.begin(), ::towlower);
+            auto it = byName.find(name);
+            if (it != byName.end())
+                bases[s][id] = it->second;
+        }
+    }
+
+    // Chains with a common root and leading offsets end up next to each other
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&table](uint32_t a, uint32_t b)
+              {
+                  if (table.GetModuleId(a) != table.GetModuleId(b))
+                      return table.GetModuleId(a) < table.GetModuleId(b);
+                  if (table.GetBaseOffset(a) != table.GetBaseOffset(b))
+                      return table.GetBaseOffset(a) < table.GetBaseOffset(b);
+                  return std::lexicographical_compare(table.GetOffsets(a), table.GetOffsets(a) + table.GetOffsetCount(a),
+                                                      table.GetOffsets(b), table.GetOffsets(b) + table.GetOffsetCount(b));
+              });
+    m_stats.sortMs = ElapsedMs(start);
+    start = std::chrono::steady_clock::now();
+
+    const size_t addressSnapshots = static_cast<size_t>(std::count_if(
+        snapshots.begin(), snapshots.end(), [](const ChainSnapshot &snapshot)
+        { return snapshot.expectedAddress != 0; }));
+    const size_t batchCount = (count + BATCH_SIZE - 1) / BATCH_SIZE;
+
+    if (threadCount == 0)
+        threadCount = (std::max)(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<unsigned>((std::min)(static_cast<size_t>(threadCount), batchCount));
+
+    std::atomic<size_t> nextBatch(0);
+    std::atomic<uint64_t> pointerReads(0);
+    std::atomic<uint64_t> reusedReads(0);
+
+    auto worker = [&]()
+    {
+        // Pointers read for the previous chain, pointers[k] depends on the root and offsets[0..k-1]
+        struct Walk
+        {
+            std::vector<uint64_t> pointers;
+            size_t valid = 0;    // Leading pointers that were read
+            bool failed = false; // Reading pointers[valid] failed
+        };
+        std::vector<Walk> walks(snapshotCount);
+        std::vector<uint64_t> values;
+        uint64_t reads = 0;
+        uint64_t reused = 0;
+
+        for (size_t batch = nextBatch++; batch < batchCount; batch = nextBatch++)
+        {
+            for (Walk &walk : walks)
+            {
+                walk.valid = 0;
+                walk.failed = false;
+            }
+
+            size_t end = (std::min)((batch + 1) * BATCH_SIZE, count);
+            uint32_t previous = 0;
+            for (size_t i = batch * BATCH_SIZE; i < end; ++i)
+            {
+                const uint32_t index = order[i];
+                const uint32_t moduleId = table.GetModuleId(index);
+                const uintptr_t *offsets = table.GetOffsets(index);
+                const uint32_t offsetCount = table.GetOffsetCount(index);
+                const size_t needed = offsetCount == 0 ? 1 : offsetCount;
+
+                size_t shared = 0;
+                if (i != batch * BATCH_SIZE && table.GetModuleId(previous) == moduleId &&
+                    table.GetBaseOffset(previous) == table.GetBaseOffset(index))
+                {
+                    const uintptr_t *previousOffsets = table.GetOffsets(previous);
+                    uint32_t common = (std::min)(offsetCount, table.GetOffsetCount(previous));
+                    shared = 1;
+                    while (shared <= common && previousOffsets[shared - 1] == offsets[shared - 1])
+                    {
+                        shared++;
+                    }
+                }
+
+                ChainScore &score = scores[index];
+                values.clear();
+                for (size_t s = 0; s < snapshotCount; ++s)
+                {
+                    const ChainSnapshot &snapshot = snapshots[s];
+                    Walk &walk = walks[s];
+                    const uint64_t moduleBase = bases[s][moduleId];
+                    if (moduleBase == 0)
+                    {
+                        walk.valid = 0;
+                        walk.failed = false;
+                        continue;
+                    }
+
+                    // A failed read whose inputs are shared fails again
+                    bool failed = walk.failed && shared > walk.valid && walk.valid < needed;
+                    reused += (std::min)((std::min)(shared, walk.valid), needed) + (failed ? 1 : 0);
+                    if (!failed)
+                    {
+                        walk.valid = (std::min)(shared, walk.valid);
+                        walk.failed = false;
+                        if (walk.pointers.size() < needed)
+                            walk.pointers.resize(needed);
+                        for (size_t k = walk.valid; k < needed; ++k)
+                        {
+                            uint64_t address = k == 0 ? moduleBase + table.GetBaseOffset(index)
+                                                      : walk.pointers[k - 1] + offsets[k - 1];
+                            reads++;
+                            if (!ReadSnapshot(snapshot, address, &walk.pointers[k], sizeof(uint64_t)))
+                            {
+                                walk.failed = true;
+                                break;
+                            }
+                            walk.valid = k + 1;
+                        }
+                        failed = walk.failed;
+                    }
+                    if (failed)
+                        continue;
+
+                    score.resolved++;
+                    uint64_t finalAddress = offsetCount == 0 ? walk.pointers[0]
+                                                             : walk.pointers[offsetCount - 1] + offsets[offsetCount - 1];
+                    if (snapshot.expectedAddress != 0 && finalAddress == snapshot.expectedAddress)
+                        score.addressHits++;
+
+                    uint64_t raw = 0;
+                    if (snapshot.pointerMap == nullptr &&
+                        ReadSnapshot(snapshot, finalAddress, &raw, PointerChainResolver::ValueSize(table.GetValueType(index))))
+                    {
+                        values.push_back(raw);
+                    }
+                }
+
+                // Most common value, snapshot counts are small
+                score.valueSamples = static_cast<uint16_t>(values.size());
+                for (size_t a = 0; a < values.size(); ++a)
+                {
+                    uint16_t agree = static_cast<uint16_t>(std::count(values.begin(), values.end(), values[a]));
+                    score.valueAgree = (std::max)(score.valueAgree, agree);
+                }
+                score.score = Score(score, snapshotCount, addressSnapshots);
+                previous = index;
+            }
+        }
+        pointerReads += reads;
+        reusedReads += reused;
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    m_stats.pointerReads = pointerReads;
+    m_stats.reusedReads = reusedReads;
+    m_stats.validateMs = ElapsedMs(start);
+
+    DBG_OK(L"Validated " + std::to_wstring(count) + L" chains against " + std::to_wstring(snapshotCount) +
+           L" snapshots, " + std::to_wstring(m_stats.pointerReads) + L" reads");
+    return scores;
+}
+
+size_t ChainValidator::CountKept(const std::vector<ChainScore> &scores, float minScore)
+{
+    return static_cast<size_t>(std::count_if(scores.begin(), scores.end(), [minScore](const ChainScore &score)
+                                             { return score.score >= minScore; }));
+}
+
+void ChainValidator::PrintSummary(const std::vector<ChainScore> &scores)
+{
+    size_t buckets[11] = {};
+    for (const ChainScore &score : scores)
+    {
+        buckets[(std::min)(static_cast<int>(score.score * 10.0f + 0.0001f), 10)]++;
+    }
+
+    std::wcout << L"\n=== Chain Stability (" << scores.size() << L" chains) ===\n";
+    for (int b = 10; b >= 0; --b)
+    {
+        if (buckets[b] == 0)
+            continue;
+        std::wstring range = b == 10 ? L"1.0    " : L"0." + std::to_wstring(b) + L"-" + (b == 9 ? L"1.0" : L"0." + std::to_wstring(b + 1));
+        std::wcout << L"  score " << range << std::setw(10) << buckets[b] << L" chains\n";
+    }
+    std::wcout << std::endl;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ModuleRegistry.h"
+#include "PointerChainTable.h"
+#include "PointerMapFile.h"
+
+// ============================================================================
+// ChainValidator: Scores candidate chains against several runs of the target
+// Purpose: Keep only chains from a pointer scan that reach the same object in
+// every captured run, prune the rest
+// - a snapshot is a saved pointer map (pointer reads) or a live process
+//   (pointer and value reads) with its module bases and, if known, the address
+//   the chains should reach in that run
+// - chains are walked in (module, base, offsets) order on a worker pool, each
+//   worker reuses the pointers read for the previous chain's common prefix,
+//   so scan results sharing roots cost about one read per new step
+// ============================================================================
+
+struct ChainSnapshot
+{
+    std::wstring name;                          // File or process name, for output
+    const PointerMapFile *pointerMap = nullptr; // Saved run: pointer reads only
+    HANDLE process = nullptr;                   // Live run, used if pointerMap is null
+    std::vector<ModuleInfo> modules;            // Module bases of the run
+    uint64_t expectedAddress = 0;               // Address chains should reach, 0 = unknown
+};
+
+struct ChainScore
+{
+    uint16_t resolved = 0;     // Snapshots where every step could be read
+    uint16_t addressHits = 0;  // Snapshots where the chain reached expectedAddress
+    uint16_t valueSamples = 0; // Values read at the final address (live snapshots)
+    uint16_t valueAgree = 0;   // Samples equal to the most common value
+    float score = 0;           // 0..1, see ChainValidator::Score
+};
+
+struct ChainValidationStats
+{
+    size_t chainCount = 0;
+    size_t snapshotCount = 0;
+    uint64_t pointerReads = 0;  // Reads performed
+    uint64_t reusedReads = 0;   // Reads saved by prefix reuse
+    double sortMs = 0;
+    double validateMs = 0;
+};
+
+class ChainValidator
+{
+public:
+    static constexpr size_t MAX_SNAPSHOTS = 64;
+    static constexpr size_t BATCH_SIZE = 4096;
+
+    // Score every chain of table against every snapshot, threadCount 0 = one worker per hardware thread
+    std::vector<ChainScore> Validate(const PointerChainTable &table, const std::vector<ChainSnapshot> &snapshots,
+                                     unsigned threadCount = 0);
+
+    const ChainValidationStats &GetStats() const { return m_stats; }
+
+    // Fraction of address-checked snapshots hit (of all snapshots if no address is known),
+    // scaled by value agreement once two or more values were read
+    static float Score(const ChainScore &score, size_t snapshotCount, size_t addressSnapshots);
+
+    // Chains with score >= minScore
+    static size_t CountKept(const std::vector<ChainScore> &scores, float minScore);
+
+    // Score histogram in tenths
+    static void PrintSummary(const std::vector<ChainScore> &scores);
+
+private:
+    ChainValidationStats m_stats;
+};
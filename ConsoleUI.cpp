@@ -1,9 +1,13 @@
 #include "ConsoleUI.h"
 #include "DebugLog.h"
+#include "Benchmark.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <fstream>
+#include <chrono>
+#include <algorithm>
+#include <deque>
 
 // Helper to convert string to ValueType
 static ValueType StringToValueType(const std::string &str)
@@ -18,9 +22,11 @@ static ValueType StringToValueType(const std::string &str)
 }
 
 ConsoleUI::ConsoleUI(ProcessManager &pm, ModuleRegistry &mr, AddressResolver &ar, OffsetStorage &os,
-                     MemoryReader &mr2, PointerChainResolver &pcr, PointerChainStorage &pcs)
+                     MemoryReader &mr2, PointerChainResolver &pcr, PointerChainStorage &pcs,
+                     ProcessGroup &pg, HotReload &hr, ModuleHasher &mh)
     : m_processManager(pm), m_moduleRegistry(mr), m_addressResolver(ar), m_offsetStorage(os),
-      m_memoryReader(mr2), m_pointerChainResolver(pcr), m_pointerChainStorage(pcs)
+      m_memoryReader(mr2), m_pointerChainResolver(pcr), m_pointerChainStorage(pcs),
+      m_processGroup(pg), m_hotReload(hr), m_moduleHasher(mh), m_consistentReads(false)
 {
     // Set locale for proper character display
     setlocale(LC_ALL, "");
@@ -52,7 +58,7 @@ void ConsoleUI::ShowMainMenu()
         std::wcout << L"  2. Pointer Chain Manager (multi-level pointers)\n";
         std::wcout << L"  3. Module Dumper (Export module list to file)\n";
         std::wcout << L"  0. Exit\n";
-        std::wcout << L"\n  Commands: 'debug' - toggle debug | 'debugfile' - toggle file log\n\n";
+        std::wcout << L"\n  Commands: 'debug' - toggle debug | 'debugfile' - toggle file log | 'bench' - benchmarks\n\n";
 
         std::wstring input = GetInput(L"Select option");
 
@@ -94,6 +100,13 @@ void ConsoleUI::ShowMainMenu()
             continue;
         }
 
+        // Проверка на команду bench
+        if (input == L"bench" || input == L"BENCH")
+        {
+            ShowBenchmarkMenu();
+            continue;
+        }
+
         int choice = -1;
         try
         {
@@ -142,6 +155,9 @@ void ConsoleUI::ShowOffsetManagerMenu()
         std::wcout << L"              Offset Manager Mode                    \n";
         std::wcout << L"====================================================\n\n";
 
+        // Safe point between operations: merge edits of the watched file
+        m_hotReload.ApplyPending();
+
         // Show status
         if (m_processManager.IsAttached())
         {
@@ -163,10 +179,22 @@ void ConsoleUI::ShowOffsetManagerMenu()
         }
 
         std::wcout << L"[+] Offsets: " << m_offsetStorage.Count() << L" in storage";
+        if (!m_offsetStorage.GetActiveBuild().empty())
+        {
+            std::wcout << L" (build " << m_offsetStorage.GetActiveBuild() << L")";
+        }
+        if (m_offsetStorage.GetBuildCount() > 1)
+        {
+            std::wcout << L" (" << m_offsetStorage.GetBuildCount() << L" build sets)";
+        }
         if (m_offsetStorage.IsModified())
         {
             std::wcout << L" (modified)";
         }
+        if (m_hotReload.IsWatchingOffsets())
+        {
+            std::wcout << L" (watching file)";
+        }
         std::wcout << L"\n\n";
 
         std::wcout << L"Options:\n";
@@ -177,9 +205,14 @@ void ConsoleUI::ShowOffsetManagerMenu()
         std::wcout << L"  5. View offsets and resolved addresses\n";
         std::wcout << L"  6. Save offsets to file\n";
         std::wcout << L"  7. View module list\n";
+        std::wcout << L"  8. Convert offset file (.cfg <-> .ofdb)\n";
+        std::wcout << L"  9. Bind offsets to the attached build\n";
+        std::wcout << L" 10. Find offsets by signatures (AOB scan)\n";
+        std::wcout << L" 11. Generate signatures for stored offsets\n";
+        std::wcout << L" 12. Find code references to an offset (xrefs)\n";
         std::wcout << L"  0. Back to main menu\n\n";
 
-        int choice = GetChoice(L"Select option", 0, 7);
+        int choice = GetChoice(L"Select option", 0, 12);
 
         switch (choice)
         {
@@ -205,6 +238,21 @@ void ConsoleUI::ShowOffsetManagerMenu()
             m_moduleRegistry.PrintModules();
             Pause();
             break;
+        case 8:
+            ConvertOffsetFileFlow();
+            break;
+        case 9:
+            BindOffsetsToBuildFlow();
+            break;
+        case 10:
+            ScanSignaturesFlow();
+            break;
+        case 11:
+            GenerateSignaturesFlow();
+            break;
+        case 12:
+            FindXrefsFlow();
+            break;
         case 0:
             return;
         }
@@ -220,6 +268,9 @@ void ConsoleUI::ShowPointerChainManagerMenu()
         std::wcout << L"            Pointer Chain Manager Mode              \n";
         std::wcout << L"====================================================\n\n";
 
+        // Safe point between operations: merge edits of the watched file
+        m_hotReload.ApplyPending();
+
         // Show status
         if (m_processManager.IsAttached())
         {
@@ -231,6 +282,17 @@ void ConsoleUI::ShowPointerChainManagerMenu()
             std::wcout << L"[ ] Process: Not attached\n";
         }
 
+        if (m_snapshot.IsOpen())
+        {
+            std::wcout << L"[+] Snapshot: " << m_snapshot.GetFilename() << L" (offline, PID "
+                       << m_snapshot.GetProcessId() << L")\n";
+        }
+
+        if (m_consistentReads)
+        {
+            std::wcout << L"[+] Consistent reads: on (target paused while chains are read)\n";
+        }
+
         if (m_moduleRegistry.IsLoaded())
         {
             std::wcout << L"[+] Modules: " << m_moduleRegistry.GetModules().size() << L" loaded\n";
@@ -242,10 +304,22 @@ void ConsoleUI::ShowPointerChainManagerMenu()
 
         std::wcout << L"[+] Pointer Chains: " << m_pointerChainStorage.GetChainCount()
                    << L" stored";
+        if (!m_pointerChainStorage.GetActiveBuild().empty())
+        {
+            std::wcout << L" (build " << m_pointerChainStorage.GetActiveBuild() << L")";
+        }
+        if (m_pointerChainStorage.GetBuildCount() > 1)
+        {
+            std::wcout << L" (" << m_pointerChainStorage.GetBuildCount() << L" build sets)";
+        }
         if (m_pointerChainStorage.IsModified())
         {
             std::wcout << L" (modified)";
         }
+        if (m_hotReload.IsWatchingChains())
+        {
+            std::wcout << L" (watching file)";
+        }
         std::wcout << L"\n\n";
 
         std::wcout << L"Options:\n";
@@ -256,9 +330,17 @@ void ConsoleUI::ShowPointerChainManagerMenu()
         std::wcout << L"  5. View resolved chain values\n";
         std::wcout << L"  6. Save chains to file\n";
         std::wcout << L"  7. Print all chains\n";
+        std::wcout << L"  8. Resolve chains across all matching processes\n";
+        std::wcout << L"  9. Bind chains to the attached build\n";
+        std::wcout << L" 10. Pointer scan for an address\n";
+        std::wcout << L" 11. Validate chains against several runs (prune unstable)\n";
+        std::wcout << L" 12. Value scan (find an address by its value)\n";
+        std::wcout << L" 13. Load process snapshot (resolve offline)\n";
+        std::wcout << L" 14. Diff two process snapshots\n";
+        std::wcout << L" 15. Toggle consistent reads (pause target while resolving)\n";
         std::wcout << L"  0. Back to main menu\n\n";
 
-        int choice = GetChoice(L"Select option", 0, 7);
+        int choice = GetChoice(L"Select option", 0, 15);
 
         switch (choice)
         {
@@ -283,6 +365,30 @@ void ConsoleUI::ShowPointerChainManagerMenu()
         case 7:
             PrintChainList();
             break;
+        case 8:
+            ResolveChainsMultiProcessFlow();
+            break;
+        case 9:
+            BindChainsToBuildFlow();
+            break;
+        case 10:
+            PointerScanFlow();
+            break;
+        case 11:
+            ValidateChainsFlow();
+            break;
+        case 12:
+            ValueScanFlow();
+            break;
+        case 13:
+            LoadSnapshotFlow();
+            break;
+        case 14:
+            DiffSnapshotsFlow();
+            break;
+        case 15:
+            m_consistentReads = !m_consistentReads;
+            break;
         case 0:
             return;
         }
@@ -306,6 +412,8 @@ void ConsoleUI::ShowModuleDumperMenu()
 
     // Обновляем handle в MemoryReader
     m_memoryReader.SetProcessHandle(m_processManager.GetHandle());
+    m_memoryReader.SetSnapshot(nullptr);
+    m_snapshot.Close();
     DBG_INFO(L"Updated MemoryReader handle in Module Dumper");
     DebugLog::HandleInfo(m_processManager.GetHandle());
 
@@ -317,18 +425,190 @@ void ConsoleUI::ShowModuleDumperMenu()
 
     m_moduleRegistry.PrintModules();
 
-    std::wcout << L"\nSave to file? (y/n): ";
+    std::wcout << L"Hash module images? (y/n): ";
     std::wstring answer;
     std::getline(std::wcin, answer);
 
+    if (answer == L"y" || answer == L"Y")
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<ModuleHash> hashes = m_moduleHasher.HashModules(m_processManager.GetHandle(), m_moduleRegistry.GetModules());
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        ModuleHasher::PrintHashes(hashes);
+        std::wcout << L"[+] Hashed " << m_moduleHasher.GetLastBytesHashed() / (1024 * 1024) << L" MB in "
+                   << std::fixed << std::setprecision(3) << seconds << L" s";
+        if (seconds > 0.0 && m_moduleHasher.GetLastBytesHashed() != 0)
+            std::wcout << L" (" << std::setprecision(2) << m_moduleHasher.GetLastBytesHashed() / seconds / 1e9 << L" GB/s)";
+        std::wcout << std::defaultfloat << L"\n";
+    }
+
+    std::wcout << L"Show sections and exports of a module? (y/n): ";
+    std::getline(std::wcin, answer);
+
+    if (answer == L"y" || answer == L"Y")
+    {
+        std::wstring moduleName = GetInput(L"Module name (e.g., app.dll)");
+        const ModuleHeaders *headers = m_moduleRegistry.GetHeaders(moduleName, m_memoryReader, true);
+        if (headers == nullptr)
+        {
+            std::wcout << L"[-] No PE headers for module '" << moduleName << L"'.\n";
+        }
+        else
+        {
+            headers->PrintSections(moduleName);
+            headers->PrintSymbols(moduleName, GetInput(L"Export filter (substring, empty = all)"));
+        }
+    }
+
+    std::wcout << L"\nSave to file? (y/n): ";
+    std::getline(std::wcin, answer);
+
     if (answer == L"y" || answer == L"Y")
     {
         DumpModulesToFile();
     }
 
+    std::wcout << L"\nCapture process snapshot (all readable memory)? (y/n): ";
+    std::getline(std::wcin, answer);
+
+    if (answer == L"y" || answer == L"Y")
+    {
+        std::wstring filename = GetInput(L"Snapshot file (e.g., example.psnap)");
+        m_moduleRegistry.ReadFingerprints(m_memoryReader);
+
+        SnapshotCaptureStats stats;
+        if (ProcessSnapshot::Capture(m_processManager.GetHandle(), m_moduleRegistry.GetModules(), filename, 0, &stats))
+        {
+            std::wcout << L"[+] Captured " << (stats.capturedBytes >> 20) << L" MB in " << stats.regionCount
+                       << L" regions to " << filename << L" (" << (stats.storedBytes >> 20) << L" MB stored, "
+                       << std::fixed << std::setprecision(2) << stats.captureMs / 1000.0 << L" s)"
+                       << std::defaultfloat << L"\n";
+            if (stats.unreadablePages != 0)
+                std::wcout << L"[!] " << stats.unreadablePages << L" pages could not be read\n";
+        }
+    }
+
     Pause();
 }
 
+void ConsoleUI::ShowBenchmarkMenu()
+{
+    while (true)
+    {
+        ClearScreen();
+        std::wcout << L"====================================================\n";
+        std::wcout << L"                 Benchmarks                          \n";
+        std::wcout << L"====================================================\n\n";
+
+        std::wcout << L"Options:\n";
+        std::wcout << L"  1. Offset config parser (500k entries)\n";
+        std::wcout << L"  2. Binary offset database (500k entries)\n";
+        std::wcout << L"  3. AddressResolver::ResolveAll (500k entries)\n";
+        std::wcout << L"  4. Pointer chain table (100k chains)\n";
+        std::wcout << L"  5. Pointer chain file I/O (500k chains)\n";
+        std::wcout << L"  6. Edit journal saves (500k chains)\n";
+        std::wcout << L"  7. Module image hashing (512 MB)\n";
+        std::wcout << L"  8. Signature scan (100 MB module, 16 signatures)\n";
+        std::wcout << L"  9. Signature generation (64 MB module, 2k offsets)\n";
+        std::wcout << L" 10. Xref index build (64 MB of code)\n";
+        std::wcout << L" 11. Module headers and exports (16 modules)\n";
+        std::wcout << L" 12. Pointer scan (200k heap objects)\n";
+        std::wcout << L" 13. Chain validator (524k chains, 4 runs)\n";
+        std::wcout << L" 14. Value scan (256 MB of values)\n";
+        std::wcout << L" 15. Process snapshot (this process, 100k chains offline)\n";
+        std::wcout << L" 16. Snapshot diff (64 MB of values, 192 changes)\n";
+        std::wcout << L" 17. Consistent reads (4096 x/y/z triples, paused vs live)\n";
+        std::wcout << L" 18. Torn-read checks (4096 doubles, reread vs seqlock)\n";
+        std::wcout << L" 19. Field groups (4096 objects x 20 fields, one read per object)\n";
+        std::wcout << L"  0. Back to main menu\n\n";
+
+        int choice = GetChoice(L"Select option", 0, 19);
+
+        switch (choice)
+        {
+        case 1:
+            Benchmark::RunOffsetParser(500000);
+            Pause();
+            break;
+        case 2:
+            Benchmark::RunOffsetDatabase(500000);
+            Pause();
+            break;
+        case 3:
+            Benchmark::RunAddressResolver(500000);
+            Pause();
+            break;
+        case 4:
+            Benchmark::RunChainTable(100000);
+            Pause();
+            break;
+        case 5:
+            Benchmark::RunChainStorage(500000);
+            Pause();
+            break;
+        case 6:
+            Benchmark::RunEditJournal(500000);
+            Pause();
+            break;
+        case 7:
+            Benchmark::RunModuleHasher(512);
+            Pause();
+            break;
+        case 8:
+            Benchmark::RunSignatureScanner(100, 16);
+            Pause();
+            break;
+        case 9:
+            Benchmark::RunSignatureGenerator(64, 2000);
+            Pause();
+            break;
+        case 10:
+            Benchmark::RunXrefIndex(64);
+            Pause();
+            break;
+        case 11:
+            Benchmark::RunModuleHeaders(16, 5000);
+            Pause();
+            break;
+        case 12:
+            Benchmark::RunPointerScan(200000);
+            Pause();
+            break;
+        case 13:
+            Benchmark::RunChainValidator(4);
+            Pause();
+            break;
+        case 14:
+            Benchmark::RunValueScanner(256);
+            Pause();
+            break;
+        case 15:
+            Benchmark::RunProcessSnapshot(100000);
+            Pause();
+            break;
+        case 16:
+            Benchmark::RunSnapshotDiff(64);
+            Pause();
+            break;
+        case 17:
+            Benchmark::RunConsistentReads(4096);
+            Pause();
+            break;
+        case 18:
+            Benchmark::RunTornReads(4096);
+            Pause();
+            break;
+        case 19:
+            Benchmark::RunFieldGroups(4096);
+            Pause();
+            break;
+        case 0:
+            return;
+        }
+    }
+}
+
 // ============================================================================
 // Offset Manager Functions
 // ============================================================================
@@ -341,11 +621,19 @@ void ConsoleUI::AttachToProcessFlow()
     {
         // ВАЖНО: Обновляем handle в MemoryReader после подключения
         m_memoryReader.SetProcessHandle(m_processManager.GetHandle());
+        m_memoryReader.SetSnapshot(nullptr);
+        m_snapshot.Close();
+        m_pause.ClearHistogram();
         DBG_INFO(L"Updated MemoryReader handle");
         DebugLog::HandleInfo(m_processManager.GetHandle());
 
         m_moduleRegistry.LoadModules(m_processManager.GetPID());
+        m_moduleRegistry.ReadFingerprints(m_memoryReader);
         m_addressResolver.SetModuleRegistry(&m_moduleRegistry);
+        m_addressResolver.SetMemoryReader(&m_memoryReader);
+        m_pointerScanner.Clear();
+        m_valueScanner.Reset();
+        SelectBuilds();
     }
 
     Pause();
@@ -358,6 +646,8 @@ void ConsoleUI::LoadOffsetsFlow()
     if (m_offsetStorage.LoadFromFile(filename))
     {
         m_currentConfigFile = filename;
+        m_hotReload.WatchOffsets(filename);
+        SelectBuilds();
     }
 
     Pause();
@@ -396,7 +686,25 @@ void ConsoleUI::AddOffsetFlow()
                    << modInfo.baseAddress << std::dec << L"\n";
     }
 
-    entry.offset = GetHexInput(L"Offset (hex, e.g., 0xDEA964)");
+    entry.symbol = GetInput(L"Exported symbol (optional, offset is then relative to it)");
+    uintptr_t symbolRva = 0;
+    if (!entry.symbol.empty() &&
+        !m_moduleRegistry.FindSymbol(entry.moduleName, entry.symbol, m_memoryReader, symbolRva))
+    {
+        std::wcout << L"[!] Warning: '" << entry.symbol << L"' is not exported by " << entry.moduleName << L".\n";
+    }
+
+    entry.offset = GetHexInput(entry.symbol.empty() ? L"Offset (hex, e.g., 0xDEA964)" : L"Delta from symbol (hex, e.g., 0x20)");
+
+    // Suggest the symbol+delta form for plain module offsets
+    const ModuleHeaders *headers =
+        entry.symbol.empty() ? m_moduleRegistry.GetHeaders(entry.moduleName, m_memoryReader, true) : nullptr;
+    const ModuleSymbol *nearest = headers ? headers->FindNearestSymbol(entry.offset) : nullptr;
+    if (nearest != nullptr)
+    {
+        std::wcout << L"[*] Nearest export: " << entry.moduleName << L"!" << nearest->name << L"+0x" << std::hex
+                   << std::uppercase << entry.offset - nearest->rva << std::dec << L"\n";
+    }
     entry.description = GetInput(L"Description (optional, e.g., DataPointer)");
 
     m_offsetStorage.AddOffset(entry);
@@ -474,12 +782,46 @@ void ConsoleUI::SaveOffsetsFlow()
         filename = GetInput(L"Enter filename to save (e.g., offsets.cfg)");
     }
 
-    m_offsetStorage.SaveToFile(filename);
+    if (m_offsetStorage.SaveToFile(filename))
+    {
+        m_hotReload.WatchOffsets(filename);
+    }
     m_currentConfigFile = filename;
 
     Pause();
 }
 
+void ConsoleUI::ConvertOffsetFileFlow()
+{
+    std::wstring source = GetInput(L"Enter source file (.cfg or .ofdb)");
+
+    // Separate storage so the offsets currently being edited are left alone
+    OffsetStorage converter;
+    if (!converter.LoadFromFile(source))
+    {
+        Pause();
+        return;
+    }
+
+    // Default target: same name with the other format's extension
+    std::wstring target = source;
+    size_t dotPos = target.find_last_of(L'.');
+    if (dotPos != std::wstring::npos && target.find_first_of(L"\\/", dotPos) == std::wstring::npos)
+    {
+        target.erase(dotPos);
+    }
+    target += OffsetStorage::IsBinaryFilename(source) ? L".cfg" : L".ofdb";
+
+    std::wstring answer = GetInput(L"Target file [" + target + L"]");
+    if (!answer.empty())
+    {
+        target = answer;
+    }
+
+    converter.SaveToFile(target);
+    Pause();
+}
+
 // ============================================================================
 // Module Dumper Functions (from original base_address.cpp)
 // ============================================================================
@@ -610,7 +952,8 @@ void ConsoleUI::AddPointerChainFlow()
     std::wcout << L"  1. int (32-bit)\n";
     std::wcout << L"  2. float (32-bit)\n";
     std::wcout << L"  3. double (64-bit)\n";
-    int typeChoice = GetChoice(L"Select type", 1, 3);
+    std::wcout << L"  4. field group (several fields of one object, read at once)\n";
+    int typeChoice = GetChoice(L"Select type", 1, 4);
 
     std::string valueType;
     switch (typeChoice)
@@ -626,6 +969,83 @@ void ConsoleUI::AddPointerChainFlow()
         break;
     }
 
+    // Field group: fields are relative to the final address
+    std::vector<ChainField> fields;
+    if (typeChoice == 4)
+    {
+        std::wcout << L"\nEnter fields as '<offset> <type> <name>' (e.g., 0x10 float Speed).\n";
+        std::wcout << L"Offsets are hex, from the final address. Enter 'done' when finished.\n";
+        while (true)
+        {
+            std::wcout << L"Field [" << fields.size() + 1 << L"]: ";
+            std::wstring input;
+            std::getline(std::wcin, input);
+
+            if (input == L"done" || input == L"Done")
+            {
+                break;
+            }
+
+            std::wistringstream stream(input);
+            std::wstring offsetText;
+            std::wstring typeText;
+            ChainField field;
+            stream >> offsetText >> typeText;
+            std::getline(stream >> std::ws, field.name);
+
+            if (typeText != L"int" && typeText != L"float" && typeText != L"double")
+            {
+                std::wcout << L"[-] Type must be int, float or double. Try again.\n";
+                continue;
+            }
+            if (!PointerChainStorage::IsValidFieldName(field.name))
+            {
+                std::wcout << L"[-] Field names cannot contain , ) | or ;. Try again.\n";
+                continue;
+            }
+
+            try
+            {
+                field.offset = std::stoull(offsetText, nullptr, 16);
+            }
+            catch (...)
+            {
+                std::wcout << L"[-] Invalid hex value. Try again.\n";
+                continue;
+            }
+            field.type = StringToValueType(std::string(typeText.begin(), typeText.end()));
+            fields.push_back(field);
+        }
+
+        if (fields.empty())
+        {
+            std::wcout << L"[-] No fields provided.\n";
+            Pause();
+            return;
+        }
+
+        std::wstring error;
+        if (!PointerChainResolver::CheckFieldSpan(fields, error))
+        {
+            std::wcout << L"[-] " << error << L".\n";
+            Pause();
+            return;
+        }
+    }
+
+    // Opt-in torn-read check of the final value
+    std::wcout << L"\nTorn-read check (value may be caught mid-write):\n";
+    std::wcout << L"  1. none\n";
+    std::wcout << L"  2. reread until two reads agree\n";
+    std::wcout << L"  3. sequence counter (seqlock) in the same object\n";
+    int checkChoice = GetChoice(L"Select check", 1, 3);
+    uintptr_t sequenceOffset = 0;
+    if (checkChoice == 3)
+    {
+        std::wcout << L"\nEnter counter offset in the value's object (hex, same base as the last offset): ";
+        sequenceOffset = GetHexInput(L"Counter offset");
+    }
+
     // Get description
     std::wstring description = GetInput(L"\nEnter description (e.g., Health)");
 
@@ -634,8 +1054,11 @@ void ConsoleUI::AddPointerChainFlow()
     chain.moduleName = moduleName;
     chain.baseOffset = baseOffset;
     chain.offsets = offsets;
-    chain.valueType = StringToValueType(valueType);
+    chain.valueType = fields.empty() ? StringToValueType(valueType) : fields.front().type;
+    chain.fields = fields;
     chain.description = description;
+    chain.tornCheck = checkChoice == 2 ? TornCheck::Reread : checkChoice == 3 ? TornCheck::Sequence : TornCheck::None;
+    chain.sequenceOffset = sequenceOffset;
 
     m_pointerChainStorage.AddChain(chain);
 
@@ -650,9 +1073,9 @@ void ConsoleUI::ResolveAllChainsFlow()
     std::wcout << L"              Resolve All Chains                     \n";
     std::wcout << L"====================================================\n\n";
 
-    if (!m_processManager.IsAttached())
+    if (!m_processManager.IsAttached() && !m_snapshot.IsOpen())
     {
-        std::wcout << L"[-] No process attached.\n";
+        std::wcout << L"[-] No process attached and no snapshot loaded.\n";
         Pause();
         return;
     }
@@ -671,11 +1094,47 @@ void ConsoleUI::ResolveAllChainsFlow()
         return;
     }
 
-    auto &chains = m_pointerChainStorage.GetAllChainsMutable();
-    m_pointerChainResolver.ResolveAllChains(chains);
+    // Walk the compact table, then copy results back for display
+    auto &table = m_pointerChainStorage.GetTable();
+    if (!m_consistentReads || m_snapshot.IsOpen())
+    {
+        int resolved = m_pointerChainResolver.ResolveTable(table);
+        m_pointerChainStorage.ApplyTableResults();
+
+        std::wcout << L"[+] All chains resolved! (" << resolved << L"/" << table.Count() << L" succeeded)\n";
+        const TornReadStats &torn = m_pointerChainResolver.GetTornReadStats();
+        if (torn.checkedValues > 0)
+        {
+            std::wcout << L"[+] Torn-read checks: " << torn.checkedValues << L" values, " << torn.extraReads
+                       << L" extra reads, " << torn.retriedValues << L" retried, " << std::fixed << std::setprecision(1)
+                       << torn.checkUs << L" us" << std::defaultfloat << L"\n";
+            if (torn.suspectValues > 0)
+                std::wcout << L"[!] " << torn.suspectValues << L" value(s) flagged suspect (see View resolved chain values)\n";
+        }
+        Pause();
+        return;
+    }
+
+    ConsistentReadStats stats;
+    int resolved = m_pointerChainResolver.ResolveTableConsistent(table, m_pause, &stats);
+    m_pointerChainStorage.ApplyTableResults();
 
-    m_pointerChainStorage.MarkModified();
-    std::wcout << L"[+] All chains resolved!\n";
+    std::wcout << L"[+] All chains resolved! (" << resolved << L"/" << table.Count() << L" succeeded)\n";
+    if (stats.passes == 0)
+    {
+        std::wcout << L"[!] Target could not be paused, values were read live\n";
+    }
+    else
+    {
+        std::wcout << L"[+] " << stats.passes << L" paused pass(es), " << stats.spanCount << L" spans, "
+                   << stats.bytesRead << L" bytes, paused " << std::fixed << std::setprecision(1) << stats.pausedUs
+                   << L" us" << std::defaultfloat << L"\n";
+        if (stats.replanned > 0)
+            std::wcout << L"[*] " << stats.replanned << L" chain(s) moved while planning and were planned again\n";
+        if (stats.unpaused > 0)
+            std::wcout << L"[!] " << stats.unpaused << L" chain(s) kept moving and were read live\n";
+    }
+    m_pause.GetHistogram().Print();
     Pause();
 }
 
@@ -706,7 +1165,20 @@ void ConsoleUI::ViewChainValuesFlow()
             std::wcout << L"    Module: " << chain.moduleName.c_str()
                        << L"\n    Base + Offset: 0x" << std::hex << chain.baseOffset << std::dec << L"\n";
             std::wcout << L"    Resolved Address: 0x" << std::hex << chain.resolvedAddress << std::dec << L"\n";
-            std::wcout << L"    Value: " << chain.currentValue.ToString().c_str() << L"\n";
+            if (chain.fields.empty())
+                std::wcout << L"    Value: " << chain.currentValue.ToString().c_str();
+            else
+                std::wcout << L"    Fields: " << chain.fields.size() << L" (read in one span)";
+            if (chain.isSuspect)
+                std::wcout << L"  [!] suspect: still changing after " << PointerChainResolver::TORN_RETRY_BUDGET
+                           << L" torn-read checks";
+            std::wcout << L"\n";
+            for (const ChainField &field : chain.fields)
+            {
+                std::wcout << L"      +0x" << std::hex << std::setw(4) << std::setfill(L'0') << field.offset
+                           << std::setfill(L' ') << std::dec << L"  " << std::left << std::setw(20) << field.name
+                           << std::right << L" " << field.value.ToString() << L"\n";
+            }
         }
         else
         {
@@ -731,6 +1203,8 @@ void ConsoleUI::LoadChainsFromFileFlow()
     if (m_pointerChainStorage.LoadFromFile(filename))
     {
         m_pointerChainStorage.ClearModified();
+        m_hotReload.WatchChains(filename);
+        SelectBuilds();
         std::wcout << L"[+] Chains loaded successfully!\n";
         std::wcout << L"[+] Total chains: " << m_pointerChainStorage.GetChainCount() << L"\n";
     }
@@ -761,6 +1235,7 @@ void ConsoleUI::SaveChainsToFileFlow()
     if (m_pointerChainStorage.SaveToFile(filename))
     {
         m_pointerChainStorage.ClearModified();
+        m_hotReload.WatchChains(filename);
         std::wcout << L"[+] Chains saved successfully!\n";
     }
     else
@@ -783,31 +1258,701 @@ void ConsoleUI::PrintChainList()
     Pause();
 }
 
-// ============================================================================
-// Utility Functions
-// ============================================================================
-
-void ConsoleUI::ClearScreen()
+void ConsoleUI::ResolveChainsMultiProcessFlow()
 {
-    system("cls");
-}
+    ClearScreen();
+    std::wcout << L"====================================================\n";
+    std::wcout << L"        Resolve Chains (All Matching Processes)      \n";
+    std::wcout << L"====================================================\n\n";
 
-void ConsoleUI::Pause()
-{
-    std::wcout << L"\nPress Enter to continue...";
-    std::wcin.ignore((std::numeric_limits<std::streamsize>::max)(), L'\n');
-    std::wcin.get();
+    if (m_pointerChainStorage.GetChainCount() == 0)
+    {
+        std::wcout << L"[-] No chains stored.\n";
+        Pause();
+        return;
+    }
+
+    if (m_processGroup.IsAttached())
+    {
+        std::wcout << L"[+] Attached to " << m_processGroup.Count() << L" instances of '"
+                   << m_processGroup.GetProcessName() << L"'\n";
+        std::wcout << L"Re-scan for instances? (y/n): ";
+        std::wstring answer;
+        std::getline(std::wcin, answer);
+        if (answer == L"y" || answer == L"Y")
+        {
+            m_processGroup.AttachAll(m_processGroup.GetProcessName());
+        }
+    }
+    else
+    {
+        std::wstring processName = GetInput(L"Enter process name (e.g., example.exe)");
+        m_processGroup.AttachAll(processName);
+    }
+
+    if (!m_processGroup.IsAttached())
+    {
+        Pause();
+        return;
+    }
+
+    int resolved = m_processGroup.ResolveAllChains(m_pointerChainStorage.GetAllChains());
+    m_processGroup.PrintResults();
+
+    std::wcout << L"[+] Resolved " << resolved << L"/"
+               << m_pointerChainStorage.GetChainCount() * m_processGroup.Count()
+               << L" chains across " << m_processGroup.Count() << L" instances\n";
+    Pause();
 }
 
-std::wstring ConsoleUI::GetInput(const std::wstring &prompt)
+// ============================================================================
+// Build Set Functions
+// ============================================================================
+
+void ConsoleUI::SelectBuilds()
 {
-    std::wcout << prompt << L": ";
-    std::wstring input;
-    std::getline(std::wcin, input);
-    return input;
+    if (!m_moduleRegistry.IsLoaded())
+        return;
+
+    m_offsetStorage.SelectBuild(m_moduleRegistry);
+    m_pointerChainStorage.SelectBuild(m_moduleRegistry);
 }
 
-int ConsoleUI::GetChoice(const std::wstring &prompt, int min, int max)
+bool ConsoleUI::ChooseBuildKey(std::wstring &outKey)
+{
+    if (!m_moduleRegistry.IsLoaded())
+    {
+        std::wcout << L"\n[-] Please attach to process first!\n";
+        return false;
+    }
+
+    // The process image is the first module of the snapshot
+    const ModuleInfo &mainModule = m_moduleRegistry.GetModules().front();
+    std::wstring moduleName = GetInput(L"Module that identifies the build (Enter = " + mainModule.name + L")");
+
+    ModuleInfo info = mainModule;
+    if (!moduleName.empty() && !m_moduleRegistry.FindModule(moduleName, info))
+    {
+        std::wcout << L"[-] Module '" << moduleName << L"' not found in process.\n";
+        return false;
+    }
+    if (info.fingerprint == 0)
+    {
+        std::wcout << L"[-] No PE header fingerprint for " << info.name << L".\n";
+        return false;
+    }
+
+    outKey = ModuleRegistry::MakeBuildKey(info);
+    return true;
+}
+
+void ConsoleUI::BindOffsetsToBuildFlow()
+{
+    std::wstring key;
+    if (ChooseBuildKey(key) && m_offsetStorage.BindBuild(key))
+    {
+        std::wcout << L"[+] " << m_offsetStorage.Count() << L" offsets bound to " << key
+                   << L" (save to keep)\n";
+    }
+    Pause();
+}
+
+void ConsoleUI::ScanSignaturesFlow()
+{
+    if (!m_processManager.IsAttached() || !m_moduleRegistry.IsLoaded())
+    {
+        std::wcout << L"\n[-] Please attach to process first!\n";
+        Pause();
+        return;
+    }
+
+    std::wstring filename = GetInput(L"Enter signature filename (e.g., signatures.sig)");
+    std::vector<Signature> signatures;
+    if (!SignatureScanner::LoadFromFile(filename, signatures) || signatures.empty())
+    {
+        std::wcout << L"[-] No signatures loaded\n";
+        Pause();
+        return;
+    }
+
+    std::wstring section = GetInput(L"Limit to section (e.g., .text, empty = whole image)");
+
+    SignatureScanner scanner;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<SignatureResult> results =
+        scanner.Scan(m_processManager.GetHandle(), m_moduleRegistry, signatures, section);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    SignatureScanner::PrintResults(signatures, results);
+    size_t found = std::count_if(results.begin(), results.end(), [](const SignatureResult &result)
+                                 { return result.IsFound(); });
+    std::wcout << L"[+] " << found << L"/" << signatures.size() << L" signatures found, "
+               << scanner.GetLastBytesScanned() / (1024 * 1024) << L" MB scanned in " << std::fixed
+               << std::setprecision(3) << seconds << L" s" << std::defaultfloat << L"\n";
+
+    if (found != 0)
+    {
+        std::wcout << L"Add found offsets to storage? (y/n): ";
+        std::wstring answer;
+        std::getline(std::wcin, answer);
+        if (answer == L"y" || answer == L"Y")
+        {
+            for (size_t i = 0; i < signatures.size(); ++i)
+            {
+                OffsetEntry entry;
+                if (SignatureScanner::ToOffsetEntry(signatures[i], results[i], entry))
+                    m_offsetStorage.AddOffset(entry);
+            }
+            std::wcout << L"[+] " << found << L" offsets added (save to keep)\n";
+        }
+    }
+
+    Pause();
+}
+
+void ConsoleUI::GenerateSignaturesFlow()
+{
+    if (!m_processManager.IsAttached() || !m_moduleRegistry.IsLoaded())
+    {
+        std::wcout << L"\n[-] Please attach to process first!\n";
+        Pause();
+        return;
+    }
+
+    const std::vector<OffsetEntry> &entries = m_offsetStorage.GetOffsets();
+    if (entries.empty())
+    {
+        std::wcout << L"\n[-] No offsets in storage\n";
+        Pause();
+        return;
+    }
+
+    std::wcout << L"\n[*] Indexing module images and generating " << entries.size() << L" signatures...\n";
+    SignatureGenerator generator;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<GeneratedSignature> results = generator.Generate(m_processManager.GetHandle(), m_moduleRegistry, entries);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    SignatureGenerator::PrintResults(entries, results);
+
+    std::vector<Signature> signatures;
+    for (const GeneratedSignature &result : results)
+    {
+        if (result.found)
+            signatures.push_back(result.signature);
+    }
+    std::wcout << L"[+] " << signatures.size() << L"/" << entries.size() << L" signatures generated in "
+               << std::fixed << std::setprecision(2) << seconds << L" s" << std::defaultfloat << L"\n";
+
+    if (!signatures.empty())
+    {
+        std::wstring filename = GetInput(L"Save to signature file (empty = skip)");
+        if (!filename.empty())
+            SignatureScanner::SaveToFile(filename, signatures);
+    }
+
+    Pause();
+}
+
+void ConsoleUI::FindXrefsFlow()
+{
+    std::wcout << L"\n=== Code References ===\n\n";
+    std::wcout << L"  1. Module of the attached process\n";
+    std::wcout << L"  2. Module image file (captured image or ELF binary)\n\n";
+    int source = GetChoice(L"Select source", 1, 2);
+
+    ModuleImage image;
+    if (source == 1)
+    {
+        if (!m_processManager.IsAttached() || !m_moduleRegistry.IsLoaded())
+        {
+            std::wcout << L"[-] Please attach to process first!\n";
+            Pause();
+            return;
+        }
+
+        ModuleInfo info;
+        std::wstring moduleName = GetInput(L"Module name (e.g., app.dll)");
+        if (!m_moduleRegistry.FindModule(moduleName, info))
+        {
+            std::wcout << L"[-] Module '" << moduleName << L"' not found in process.\n";
+            Pause();
+            return;
+        }
+        if (!image.LoadFromProcess(m_memoryReader, info))
+        {
+            Pause();
+            return;
+        }
+    }
+    else if (!image.LoadFromFile(GetInput(L"Image filename")))
+    {
+        Pause();
+        return;
+    }
+
+    XrefIndex index;
+    auto start = std::chrono::steady_clock::now();
+    index.Build(image);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::wcout << L"[+] " << index.GetInstructionCount() << L" instructions decoded in " << index.GetCodeBytes() / 1024
+               << L" KB of code, " << index.GetXrefCount() << L" references (" << std::fixed << std::setprecision(3)
+               << seconds << L" s)" << std::defaultfloat << L"\n";
+
+    // Query loop, the index stays valid until the flow returns
+    while (true)
+    {
+        std::wstring input = GetInput(L"Offset to look up (hex, empty = done)");
+        if (input.empty())
+            break;
+
+        uintptr_t offset = static_cast<uintptr_t>(wcstoull(input.c_str(), nullptr, 16));
+        XrefIndex::PrintReferences(image, offset, index.FindReferences(offset));
+    }
+}
+
+void ConsoleUI::BindChainsToBuildFlow()
+{
+    std::wstring key;
+    if (ChooseBuildKey(key) && m_pointerChainStorage.BindBuild(key))
+    {
+        std::wcout << L"[+] " << m_pointerChainStorage.GetChainCount() << L" chains bound to " << key
+                   << L" (save to keep)\n";
+    }
+    Pause();
+}
+
+void ConsoleUI::PointerScanFlow()
+{
+    ClearScreen();
+    std::wcout << L"====================================================\n";
+    std::wcout << L"              Pointer Scan                           \n";
+    std::wcout << L"====================================================\n\n";
+
+    std::wcout << L"  1. Attached process\n";
+    std::wcout << L"  2. Saved pointer map file (offline)\n\n";
+    int source = GetChoice(L"Select source", 1, 2);
+
+    if (source == 1 && (!m_processManager.IsAttached() || !m_moduleRegistry.IsLoaded()))
+    {
+        std::wcout << L"[-] Please attach to process first!\n";
+        Pause();
+        return;
+    }
+
+    PointerScanOptions options;
+    options.target = GetHexInput(L"Target address");
+    options.maxDepth = static_cast<size_t>(GetChoice(L"Max depth (dereferences)", 1, 10));
+    options.maxOffset = GetHexInput(L"Max offset (e.g., 0x1000)");
+
+    if (source == 2)
+    {
+        std::wstring filename = GetInput(L"Pointer map file (e.g., run1.ptrmap)");
+        auto start = std::chrono::steady_clock::now();
+        if (!m_pointerScanner.LoadPointerMap(filename))
+        {
+            Pause();
+            return;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::wcout << L"[+] Mapped " << m_pointerScanner.GetPointerCount() << L" pointers, "
+                   << m_pointerScanner.GetMapFile().GetModules().size() << L" modules in " << std::fixed
+                   << std::setprecision(2) << ms << L" ms" << std::defaultfloat << L"\n";
+    }
+    else
+    {
+        bool rebuild = true;
+        if (m_pointerScanner.HasPointerMap() && !m_pointerScanner.IsOffline())
+        {
+            std::wcout << L"Reuse the pointer map of the last scan (" << m_pointerScanner.GetPointerCount()
+                       << L" pointers)? (y/n): ";
+            std::wstring answer;
+            std::getline(std::wcin, answer);
+            rebuild = !(answer == L"y" || answer == L"Y");
+        }
+
+        if (rebuild)
+        {
+            size_t budgetMB = static_cast<size_t>(GetChoice(L"Memory budget for the pointer map (MB)", 64, 65536));
+            std::wcout << L"\n[*] Building pointer map...\n";
+            if (!m_pointerScanner.BuildPointerMap(m_processManager.GetHandle(), budgetMB << 20))
+            {
+                Pause();
+                return;
+            }
+            const PointerScanStats &stats = m_pointerScanner.GetStats();
+            std::wcout << L"[+] " << m_pointerScanner.GetPointerCount() << L" pointers in " << stats.regionCount
+                       << L" regions (" << (stats.bytesScanned >> 20) << L" MB) in " << std::fixed
+                       << std::setprecision(2) << stats.mapMs / 1000.0 << L" s" << std::defaultfloat << L"\n";
+
+            std::wstring filename = GetInput(L"Save pointer map to file (empty = skip)");
+            if (!filename.empty() && m_pointerScanner.SavePointerMap(filename, m_moduleRegistry))
+                std::wcout << L"[+] Pointer map saved\n";
+        }
+    }
+
+    std::wcout << L"[*] Searching chains...\n";
+    std::vector<PointerChain> chains = source == 2 ? m_pointerScanner.FindChains(options)
+                                                   : m_pointerScanner.FindChains(m_moduleRegistry, options);
+    const PointerScanStats &stats = m_pointerScanner.GetStats();
+    std::wcout << L"[+] " << chains.size() << L" chains found in " << std::fixed << std::setprecision(2)
+               << stats.searchMs / 1000.0 << L" s" << std::defaultfloat;
+    if (stats.resultsCapped)
+    {
+        std::wcout << L" (stopped at " << options.maxResults << L")";
+    }
+    if (stats.budgetReached)
+    {
+        std::wcout << L"\n[!] Node budget of " << options.maxNodes
+                   << L" reached, longer chains may be missing (lower the depth or max offset)";
+    }
+    std::wcout << L"\n\n";
+
+    if (chains.empty())
+    {
+        Pause();
+        return;
+    }
+    PointerScanner::PrintChains(chains, 20);
+
+    std::wcout << L"\nAdd chains to storage? (y/n): ";
+    std::wstring answer;
+    std::getline(std::wcin, answer);
+    if (answer != L"y" && answer != L"Y")
+    {
+        Pause();
+        return;
+    }
+
+    std::wcout << L"\nValue type to read at final address:\n";
+    std::wcout << L"  1. int (32-bit)\n";
+    std::wcout << L"  2. float (32-bit)\n";
+    std::wcout << L"  3. double (64-bit)\n";
+    int typeChoice = GetChoice(L"Select type", 1, 3);
+    ValueType valueType = typeChoice == 1 ? ValueType::INT : typeChoice == 2 ? ValueType::FLOAT : ValueType::DOUBLE;
+
+    std::wstring description = GetInput(L"Enter description (e.g., Health)");
+    for (size_t i = 0; i < chains.size(); ++i)
+    {
+        chains[i].valueType = valueType;
+        chains[i].description = description + L" #" + std::to_wstring(i + 1);
+        m_pointerChainStorage.AddChain(chains[i]);
+    }
+    std::wcout << L"[+] " << chains.size() << L" chains added (save to keep)\n";
+
+    Pause();
+}
+
+void ConsoleUI::ValidateChainsFlow()
+{
+    ClearScreen();
+    std::wcout << L"====================================================\n";
+    std::wcout << L"              Validate Chains                        \n";
+    std::wcout << L"====================================================\n\n";
+
+    if (m_pointerChainStorage.GetChainCount() == 0)
+    {
+        std::wcout << L"[-] No chains to validate.\n";
+        Pause();
+        return;
+    }
+
+    // Saved maps stay mapped while the snapshots point at them
+    std::deque<PointerMapFile> maps;
+    std::vector<ChainSnapshot> snapshots;
+    while (true)
+    {
+        std::wcout << L"\nSnapshots: " << snapshots.size() << L"\n";
+        std::wcout << L"  1. Add saved pointer map (.ptrmap)\n";
+        std::wcout << L"  2. Add attached process (also compares values)\n";
+        std::wcout << L"  0. Done\n";
+        int choice = GetChoice(L"Select option", 0, 2);
+        if (choice == 0)
+            break;
+
+        ChainSnapshot snapshot;
+        if (choice == 1)
+        {
+            std::wstring filename = GetInput(L"Pointer map file");
+            maps.emplace_back();
+            if (!maps.back().Open(filename))
+            {
+                maps.pop_back();
+                continue;
+            }
+            snapshot.name = filename;
+            snapshot.pointerMap = &maps.back();
+            snapshot.modules = maps.back().GetModules();
+        }
+        else
+        {
+            if (!m_processManager.IsAttached() || !m_moduleRegistry.IsLoaded())
+            {
+                std::wcout << L"[-] Please attach to process first!\n";
+                continue;
+            }
+            snapshot.name = m_processManager.GetProcessName();
+            snapshot.process = m_processManager.GetHandle();
+            snapshot.modules = m_moduleRegistry.GetModules();
+        }
+        snapshot.expectedAddress = GetHexInput(L"Address the chains should reach in this run (0 = unknown)");
+        snapshots.push_back(snapshot);
+    }
+
+    if (snapshots.empty())
+    {
+        Pause();
+        return;
+    }
+
+    ChainValidator validator;
+    std::vector<ChainScore> scores = validator.Validate(m_pointerChainStorage.GetTable(), snapshots);
+    if (scores.empty())
+    {
+        Pause();
+        return;
+    }
+    const ChainValidationStats &stats = validator.GetStats();
+    ChainValidator::PrintSummary(scores);
+    std::wcout << L"[+] " << stats.chainCount << L" chains x " << stats.snapshotCount << L" snapshots in "
+               << std::fixed << std::setprecision(2) << (stats.sortMs + stats.validateMs) / 1000.0 << L" s ("
+               << stats.pointerReads << L" reads, " << stats.reusedReads << L" reused)" << std::defaultfloat << L"\n";
+
+    int minPercent = GetChoice(L"Keep chains with score at least (percent, 0 = keep all)", 0, 100);
+    float minScore = minPercent / 100.0f;
+    size_t kept = ChainValidator::CountKept(scores, minScore);
+    if (minPercent == 0 || kept == scores.size())
+    {
+        Pause();
+        return;
+    }
+
+    std::wcout << L"Remove " << (scores.size() - kept) << L" chains, keep " << kept << L"? (y/n): ";
+    std::wstring answer;
+    std::getline(std::wcin, answer);
+    if (answer == L"y" || answer == L"Y")
+    {
+        std::vector<PointerChain> &chains = m_pointerChainStorage.GetAllChainsMutable();
+        size_t out = 0;
+        for (size_t i = 0; i < chains.size(); ++i)
+        {
+            if (scores[i].score < minScore)
+                continue;
+            if (out != i)
+                chains[out] = std::move(chains[i]);
+            out++;
+        }
+        chains.resize(out);
+        m_pointerChainStorage.MarkModified();
+        std::wcout << L"[+] " << kept << L" chains kept (save to keep)\n";
+    }
+
+    Pause();
+}
+
+// ============================================================================
+// Utility Functions
+// ============================================================================
+
+void ConsoleUI::ValueScanFlow()
+{
+    ClearScreen();
+    std::wcout << L"====================================================\n";
+    std::wcout << L"              Value Scan                             \n";
+    std::wcout << L"====================================================\n\n";
+
+    if (!m_processManager.IsAttached())
+    {
+        std::wcout << L"[-] Please attach to process first!\n";
+        Pause();
+        return;
+    }
+
+    if (m_valueScanner.HasScan())
+    {
+        std::wcout << L"Continue the last scan (" << m_valueScanner.GetResultCount() << L" hits)? (y/n): ";
+        std::wstring answer;
+        std::getline(std::wcin, answer);
+        if (answer != L"y" && answer != L"Y")
+            m_valueScanner.Reset();
+    }
+
+    while (true)
+    {
+        if (!m_valueScanner.HasScan())
+        {
+            std::wcout << L"\nValue type:\n";
+            std::wcout << L"  1. int (32-bit)\n";
+            std::wcout << L"  2. float (32-bit)\n";
+            std::wcout << L"  3. double (64-bit)\n";
+            int typeChoice = GetChoice(L"Select type", 1, 3);
+            ValueType valueType = typeChoice == 1 ? ValueType::INT : typeChoice == 2 ? ValueType::FLOAT : ValueType::DOUBLE;
+
+            std::wcout << L"\nFirst scan:\n";
+            std::wcout << L"  1. Exact value\n";
+            std::wcout << L"  2. Value between\n";
+            std::wcout << L"  3. Unknown initial value\n";
+            int scanChoice = GetChoice(L"Select scan", 1, 3);
+
+            ScanCondition condition;
+            condition.compare = scanChoice == 1 ? ScanCompare::Exact : scanChoice == 2 ? ScanCompare::Range : ScanCompare::Unknown;
+            if (scanChoice == 1)
+                condition.value = GetNumberInput(L"Value");
+            if (scanChoice == 2)
+            {
+                condition.value = GetNumberInput(L"From");
+                condition.high = GetNumberInput(L"To");
+            }
+
+            std::wcout << L"\n[*] Scanning writable memory...\n";
+            if (!m_valueScanner.FirstScan(m_processManager.GetHandle(), valueType, condition))
+            {
+                Pause();
+                return;
+            }
+            m_valueScanner.PrintStats();
+        }
+
+        std::wcout << L"\nHits: " << m_valueScanner.GetResultCount() << L"\n";
+        std::wcout << L"  1. Next scan\n";
+        std::wcout << L"  2. Show hits\n";
+        std::wcout << L"  3. New scan\n";
+        std::wcout << L"  0. Back\n";
+        int choice = GetChoice(L"Select option", 0, 3);
+
+        if (choice == 0)
+            return;
+        if (choice == 2)
+        {
+            std::wcout << L"\n";
+            m_valueScanner.PrintResults(50);
+            continue;
+        }
+        if (choice == 3)
+        {
+            m_valueScanner.Reset();
+            continue;
+        }
+
+        std::wcout << L"\nNext scan, keep hits whose value is:\n";
+        std::wcout << L"  1. Exact value\n";
+        std::wcout << L"  2. Between\n";
+        std::wcout << L"  3. Changed\n";
+        std::wcout << L"  4. Unchanged\n";
+        std::wcout << L"  5. Increased\n";
+        std::wcout << L"  6. Decreased\n";
+        int scanChoice = GetChoice(L"Select scan", 1, 6);
+
+        const ScanCompare compares[] = {ScanCompare::Exact, ScanCompare::Range, ScanCompare::Changed,
+                                        ScanCompare::Unchanged, ScanCompare::Increased, ScanCompare::Decreased};
+        ScanCondition condition;
+        condition.compare = compares[scanChoice - 1];
+        if (scanChoice == 1)
+            condition.value = GetNumberInput(L"Value");
+        if (scanChoice == 2)
+        {
+            condition.value = GetNumberInput(L"From");
+            condition.high = GetNumberInput(L"To");
+        }
+
+        if (m_valueScanner.NextScan(condition))
+            m_valueScanner.PrintStats();
+    }
+}
+
+void ConsoleUI::LoadSnapshotFlow()
+{
+    ClearScreen();
+    std::wcout << L"====================================================\n";
+    std::wcout << L"              Load Process Snapshot                  \n";
+    std::wcout << L"====================================================\n\n";
+
+    std::wstring filename = GetInput(L"Snapshot file (e.g., example.psnap)");
+
+    // Open closes the current snapshot even when it fails
+    const bool hadSnapshot = m_snapshot.IsOpen();
+    m_memoryReader.SetSnapshot(nullptr);
+    if (!m_snapshot.Open(filename))
+    {
+        // The module bases of the closed snapshot must not outlive it: back to
+        // the attached process, or to no modules at all
+        if (hadSnapshot)
+        {
+            m_moduleRegistry.Clear();
+            if (m_processManager.IsAttached() && m_moduleRegistry.LoadModules(m_processManager.GetPID()))
+                m_moduleRegistry.ReadFingerprints(m_memoryReader);
+            std::wcout << L"[*] Previous snapshot closed, memory reads now come from "
+                       << (m_processManager.IsAttached() ? L"the attached process" : L"no source (attach or load)")
+                       << L"\n";
+        }
+        Pause();
+        return;
+    }
+
+    // Chains resolve against the module bases and memory of the captured run
+    m_memoryReader.SetSnapshot(&m_snapshot);
+    m_moduleRegistry.Clear();
+    for (const ModuleInfo &info : m_snapshot.GetModules())
+    {
+        m_moduleRegistry.AddModule(info);
+    }
+    m_addressResolver.SetModuleRegistry(&m_moduleRegistry);
+    m_addressResolver.SetMemoryReader(&m_memoryReader);
+
+    std::wcout << L"[+] Snapshot of PID " << m_snapshot.GetProcessId() << L": " << m_snapshot.RegionCount()
+               << L" regions, " << (m_snapshot.CapturedBytes() >> 20) << L" MB captured, "
+               << m_snapshot.GetModules().size() << L" modules\n";
+    std::wcout << L"[*] Memory reads now come from the snapshot until the next attach\n";
+    Pause();
+}
+
+void ConsoleUI::DiffSnapshotsFlow()
+{
+    ClearScreen();
+    std::wcout << L"====================================================\n";
+    std::wcout << L"              Diff Process Snapshots                 \n";
+    std::wcout << L"====================================================\n\n";
+
+    ProcessSnapshot before;
+    ProcessSnapshot after;
+    if (!before.Open(GetInput(L"First snapshot (before)")) || !after.Open(GetInput(L"Second snapshot (after)")))
+    {
+        Pause();
+        return;
+    }
+    if (before.GetProcessId() != after.GetProcessId())
+        std::wcout << L"[!] Snapshots are of different processes, addresses may not correspond\n";
+
+    SnapshotDiff diff;
+    if (diff.Compare(before, after))
+    {
+        diff.PrintStats();
+        diff.PrintRanges(50);
+    }
+    Pause();
+}
+
+void ConsoleUI::ClearScreen()
+{
+    system("cls");
+}
+
+void ConsoleUI::Pause()
+{
+    std::wcout << L"\nPress Enter to continue...";
+    std::wcin.ignore((std::numeric_limits<std::streamsize>::max)(), L'\n');
+    std::wcin.get();
+}
+
+std::wstring ConsoleUI::GetInput(const std::wstring &prompt)
+{
+    std::wcout << prompt << L": ";
+    std::wstring input;
+    std::getline(std::wcin, input);
+    return input;
+}
+
+int ConsoleUI::GetChoice(const std::wstring &prompt, int min, int max)
 {
     while (true)
     {
@@ -856,3 +2001,22 @@ uintptr_t ConsoleUI::GetHexInput(const std::wstring &prompt)
         }
     }
 }
+
+double ConsoleUI::GetNumberInput(const std::wstring &prompt)
+{
+    while (true)
+    {
+        std::wcout << prompt << L": ";
+        std::wstring input;
+        std::getline(std::wcin, input);
+
+        try
+        {
+            return std::stod(input);
+        }
+        catch (...)
+        {
+            std::wcout << L"Invalid number. Try again.\n";
+        }
+    }
+}
@@ -6,6 +6,18 @@
 #include "MemoryReader.h"
 #include "PointerChainResolver.h"
 #include "PointerChainStorage.h"
+#include "ProcessGroup.h"
+#include "HotReload.h"
+#include "ModuleHasher.h"
+#include "SignatureScanner.h"
+#include "SignatureGenerator.h"
+#include "XrefIndex.h"
+#include "PointerScanner.h"
+#include "ChainValidator.h"
+#include "ValueScanner.h"
+#include "ProcessSnapshot.h"
+#include "SnapshotDiff.h"
+#include "ProcessPause.h"
 #include <string>
 
 // ============================================================================
@@ -24,12 +36,21 @@ private:
     MemoryReader &m_memoryReader;
     PointerChainResolver &m_pointerChainResolver;
     PointerChainStorage &m_pointerChainStorage;
+    ProcessGroup &m_processGroup;
+    HotReload &m_hotReload;
+    ModuleHasher &m_moduleHasher;
+    PointerScanner m_pointerScanner; // Pointer map kept between scans of one process
+    ValueScanner m_valueScanner;     // Hits kept between next scans
+    ProcessSnapshot m_snapshot;      // Offline memory source while loaded
+    ProcessPause m_pause;            // Pause histogram kept across resolutions
+    bool m_consistentReads;          // Resolve chains while the target is paused
 
     std::wstring m_currentConfigFile;
 
 public:
     ConsoleUI(ProcessManager &pm, ModuleRegistry &mr, AddressResolver &ar, OffsetStorage &os,
-              MemoryReader &mr2, PointerChainResolver &pcr, PointerChainStorage &pcs);
+              MemoryReader &mr2, PointerChainResolver &pcr, PointerChainStorage &pcs,
+              ProcessGroup &pg, HotReload &hr, ModuleHasher &mh);
 
     // Main menu
     void ShowMainMenu();
@@ -38,6 +59,7 @@ public:
     void ShowOffsetManagerMenu();       // Offset management
     void ShowPointerChainManagerMenu(); // Pointer chain management
     void ShowModuleDumperMenu();        // Module dumper
+    void ShowBenchmarkMenu();           // Built-in benchmarks
 
 private:
     // === Offset Manager Functions ===
@@ -47,6 +69,11 @@ private:
     void ResolveOffsetsFlow();
     void ViewOffsetsFlow();
     void SaveOffsetsFlow();
+    void ConvertOffsetFileFlow();
+    void BindOffsetsToBuildFlow();
+    void ScanSignaturesFlow();
+    void GenerateSignaturesFlow();
+    void FindXrefsFlow();
 
     // === Pointer Chain Manager Functions ===
     void AddPointerChainFlow();
@@ -55,14 +82,26 @@ private:
     void LoadChainsFromFileFlow();
     void SaveChainsToFileFlow();
     void PrintChainList();
+    void ResolveChainsMultiProcessFlow();
+    void BindChainsToBuildFlow();
+    void PointerScanFlow();
+    void ValidateChainsFlow();
+    void ValueScanFlow();
+    void LoadSnapshotFlow();
+    void DiffSnapshotsFlow();
 
     // === Module Dumper Functions ===
     void DumpModulesToFile();
 
+    // === Build Sets ===
+    void SelectBuilds();                  // Activate the sets matching the loaded modules
+    bool ChooseBuildKey(std::wstring &outKey); // Ask for the module whose build keys a set
+
     // === Utilities ===
     void ClearScreen();
     void Pause();
     std::wstring GetInput(const std::wstring &prompt);
     int GetChoice(const std::wstring &prompt, int min, int max);
     uintptr_t GetHexInput(const std::wstring &prompt);
+    double GetNumberInput(const std::wstring &prompt);
 };
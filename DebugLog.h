@@ -1,9 +1,14 @@
 #pragma once
 #include <iostream>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <string>
-#include <Windows.h>
+#include "Platform.h"
+#ifndef _WIN32
+#include <ctime>
+#include <unistd.h>
+#endif
 
 // ============================================================================
 // DebugLog: Global debugging system
@@ -23,7 +28,7 @@ public:
     static void Enable()
     {
         s_enabled = true;
-        s_consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
+        s_consoleHandle = GetConsoleHandle();
     }
 
     static void Disable() { s_enabled = false; }
@@ -32,7 +37,7 @@ public:
     {
         s_enabled = !s_enabled;
         if (s_enabled)
-            s_consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
+            s_consoleHandle = GetConsoleHandle();
     }
 
     // File logging
@@ -43,17 +48,27 @@ public:
         if (s_logFile.is_open())
             s_logFile.close();
 
-        s_logFile.open(filename, std::ios::out | std::ios::app);
+        s_logFile.open(std::filesystem::path(filename), std::ios::out | std::ios::app);
         if (s_logFile.is_open())
         {
             s_fileLogging = true;
             // Write session header
+#ifdef _WIN32
             SYSTEMTIME st;
             GetLocalTime(&st);
             s_logFile << L"\n========== DEBUG SESSION START: "
                       << st.wYear << L"-" << st.wMonth << L"-" << st.wDay << L" "
                       << st.wHour << L":" << st.wMinute << L":" << st.wSecond
                       << L" ==========\n\n";
+#else
+            std::time_t now = std::time(nullptr);
+            std::tm st = {};
+            localtime_r(&now, &st);
+            s_logFile << L"\n========== DEBUG SESSION START: "
+                      << st.tm_year + 1900 << L"-" << st.tm_mon + 1 << L"-" << st.tm_mday << L" "
+                      << st.tm_hour << L":" << st.tm_min << L":" << st.tm_sec
+                      << L" ==========\n\n";
+#endif
             s_logFile.flush();
         }
     }
@@ -90,8 +105,17 @@ public:
 
     static void SetColor(Color color)
     {
+#ifdef _WIN32
         if (s_consoleHandle)
             SetConsoleTextAttribute(s_consoleHandle, static_cast<WORD>(color));
+#else
+        // Same colors as ANSI escapes (console attribute bits are B, G, R)
+        static const wchar_t *const codes[8] = {L"30", L"34", L"32", L"36", L"31", L"35", L"33", L"37"};
+        WORD attribute = static_cast<WORD>(color);
+        if (s_consoleHandle)
+            std::wcout << L"\x1b[" << (color == Color::Default ? L"0" : codes[attribute & 7])
+                       << (attribute & 8 ? L";1m" : L"m");
+#endif
     }
 
     static void ResetColor()
@@ -100,6 +124,16 @@ public:
     }
 
 private:
+    // Console to color, nullptr when output is not a console
+    static HANDLE GetConsoleHandle()
+    {
+#ifdef _WIN32
+        return GetStdHandle(STD_OUTPUT_HANDLE);
+#else
+        return isatty(STDOUT_FILENO) ? reinterpret_cast<HANDLE>(1) : nullptr;
+#endif
+    }
+
     // Internal method for writing to file
     static void WriteToFile(const std::wstring &msg)
     {
@@ -324,13 +358,15 @@ public:
 };
 
 // Макросы для удобства
-#define DBG_INFO(msg) DebugLog::Info(msg)
-#define DBG_OK(msg) DebugLog::Success(msg)
-#define DBG_WARN(msg) DebugLog::Warning(msg)
-#define DBG_ERR(msg) DebugLog::Error(msg)
-#define DBG_STEP(msg) DebugLog::Step(msg)
-#define DBG_ADDR(label, addr) DebugLog::Address(label, addr)
-#define DBG_PTR(from, val) DebugLog::PointerRead(from, val)
-#define DBG_CHAIN(step, total, addr, off, res) DebugLog::ChainStep(step, total, addr, off, res)
-#define DBG_MODULE(name, base, size) DebugLog::ModuleInfo(name, base, size)
-#define DBG_MEM(addr, size, ok) DebugLog::MemoryRead(addr, size, ok)
+// Arguments are only evaluated when debug mode is enabled, so message
+// concatenation costs nothing on hot paths with logging off
+#define DBG_INFO(msg) do { if (DebugLog::IsEnabled()) DebugLog::Info(msg); } while (0)
+#define DBG_OK(msg) do { if (DebugLog::IsEnabled()) DebugLog::Success(msg); } while (0)
+#define DBG_WARN(msg) do { if (DebugLog::IsEnabled()) DebugLog::Warning(msg); } while (0)
+#define DBG_ERR(msg) do { if (DebugLog::IsEnabled()) DebugLog::Error(msg); } while (0)
+#define DBG_STEP(msg) do { if (DebugLog::IsEnabled()) DebugLog::Step(msg); } while (0)
+#define DBG_ADDR(label, addr) do { if (DebugLog::IsEnabled()) DebugLog::Address(label, addr); } while (0)
+#define DBG_PTR(from, val) do { if (DebugLog::IsEnabled()) DebugLog::PointerRead(from, val); } while (0)
+#define DBG_CHAIN(step, total, addr, off, res) do { if (DebugLog::IsEnabled()) DebugLog::ChainStep(step, total, addr, off, res); } while (0)
+#define DBG_MODULE(name, base, size) do { if (DebugLog::IsEnabled()) DebugLog::ModuleInfo(name, base, size); } while (0)
+#define DBG_MEM(addr, size, ok) do { if (DebugLog::IsEnabled()) DebugLog::MemoryRead(addr, size, ok); } while (0)
@@ -0,0 +1,152 @@
+#include "DirtyPageTracker.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <string>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdlib>
+#endif
+
+#ifdef __linux__
+static constexpr uint64_t PAGEMAP_SOFT_DIRTY = uint64_t(1) << 55;
+static constexpr uint64_t PAGEMAP_SWAPPED = uint64_t(1) << 62;
+static constexpr uint64_t PAGEMAP_PRESENT = uint64_t(1) << 63;
+
+// "4" clears soft-dirty bits only, accessed bits and working set stay
+static bool ClearSoftDirty(int clearRefs)
+{
+    return pwrite(clearRefs, "4", 1, 0) == 1;
+}
+
+static bool ReadPagemap(int pagemap, uintptr_t address, size_t count, uint64_t *entries)
+{
+    const size_t bytes = count * sizeof(uint64_t);
+    const off_t offset = static_cast<off_t>(address / DirtyPageTracker::PAGE_BYTES * sizeof(uint64_t));
+    return pread(pagemap, entries, bytes, offset) == static_cast<ssize_t>(bytes);
+}
+#endif
+
+DirtyPageTracker::DirtyPageTracker()
+    : m_pagemap(-1), m_clearRefs(-1)
+{
+}
+
+DirtyPageTracker::~DirtyPageTracker()
+{
+    End();
+}
+
+bool DirtyPageTracker::IsSupported()
+{
+#ifdef __linux__
+    static const bool supported = []()
+    {
+        int clearRefs = open("/proc/self/clear_refs", O_WRONLY);
+        int pagemap = open("/proc/self/pagemap", O_RDONLY);
+        bool result = false;
+        void *page = aligned_alloc(PAGE_BYTES, PAGE_BYTES);
+        if (clearRefs >= 0 && pagemap >= 0 && page != nullptr)
+        {
+            // A page written after the reset must read back dirty
+            volatile uint8_t *bytes = static_cast<volatile uint8_t *>(page);
+            bytes[0] = 1;
+            uint64_t entry = 0;
+            if (ClearSoftDirty(clearRefs))
+            {
+                bytes[0] = 2;
+                result = ReadPagemap(pagemap, reinterpret_cast<uintptr_t>(page), 1, &entry) &&
+                         (entry & PAGEMAP_SOFT_DIRTY) != 0;
+            }
+        }
+        free(page);
+        if (clearRefs >= 0)
+            close(clearRefs);
+        if (pagemap >= 0)
+            close(pagemap);
+        return result;
+    }();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+bool DirtyPageTracker::Begin(DWORD processId)
+{
+    End();
+    if (!IsSupported())
+    {
+        DBG_INFO(L"Dirty page tracking not supported, full reads");
+        return false;
+    }
+
+#ifdef __linux__
+    const std::string proc = "/proc/" + std::to_string(processId);
+    m_clearRefs = open((proc + "/clear_refs").c_str(), O_WRONLY);
+    m_pagemap = open((proc + "/pagemap").c_str(), O_RDONLY);
+    if (m_clearRefs < 0 || m_pagemap < 0)
+    {
+        DBG_WARN(L"Cannot open pagemap/clear_refs of process " + std::to_wstring(processId) + L", full reads");
+        End();
+        return false;
+    }
+    DBG_OK(L"Tracking page writes of process " + std::to_wstring(processId));
+    return true;
+#else
+    return false;
+#endif
+}
+
+void DirtyPageTracker::End()
+{
+#ifdef __linux__
+    if (m_pagemap >= 0)
+        close(m_pagemap);
+    if (m_clearRefs >= 0)
+        close(m_clearRefs);
+#endif
+    m_pagemap = -1;
+    m_clearRefs = -1;
+}
+
+bool DirtyPageTracker::Reset()
+{
+#ifdef __linux__
+    return IsActive() && ClearSoftDirty(m_clearRefs);
+#else
+    return false;
+#endif
+}
+
+bool DirtyPageTracker::Query(uintptr_t address, size_t pageCount, std::vector<uint8_t> &outDirty) const
+{
+    outDirty.assign(pageCount, 1);
+    if (!IsActive())
+        return false;
+
+#ifdef __linux__
+    uint64_t entries[512];
+    for (size_t done = 0; done < pageCount;)
+    {
+        size_t count = (std::min)(pageCount - done, sizeof(entries) / sizeof(entries[0]));
+        if (!ReadPagemap(m_pagemap, address + done * PAGE_BYTES, count, entries))
+        {
+            outDirty.assign(pageCount, 1);
+            return false;
+        }
+        // Only a resident or swapped page keeps its bit, an empty entry can be
+        // a page dropped (MADV_DONTNEED) and refilled since the reset
+        for (size_t i = 0; i < count; ++i)
+        {
+            outDirty[done + i] = (entries[i] & (PAGEMAP_PRESENT | PAGEMAP_SWAPPED)) == 0 ||
+                                 (entries[i] & PAGEMAP_SOFT_DIRTY) != 0;
+        }
+        done += count;
+    }
+    return true;
+#else
+    (void)address;
+    return false;
+#endif
+}
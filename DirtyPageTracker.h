@@ -0,0 +1,49 @@
+#pragma once
+#include "Platform.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// DirtyPageTracker: Pages a process wrote since the last reset
+// Purpose: Let repeated scans reread only memory that can have changed
+// - Linux: kernel soft-dirty bits, reset through /proc/<pid>/clear_refs,
+//   read from /proc/<pid>/pagemap (bit 55); support is probed once on a page
+//   of this process, kernels without CONFIG_MEM_SOFT_DIRTY accept the reset
+//   but never set the bit
+// - Windows has no cross-process equivalent (GetWriteWatch only covers the
+//   caller's own allocations), Begin fails and callers read everything
+// - pages of regions mapped after the reset report dirty, so a false
+//   "clean" is never returned while the tracker is active
+// ============================================================================
+
+class DirtyPageTracker
+{
+public:
+    static constexpr size_t PAGE_BYTES = 0x1000;
+
+    DirtyPageTracker();
+    ~DirtyPageTracker();
+
+    DirtyPageTracker(const DirtyPageTracker &) = delete;
+    DirtyPageTracker &operator=(const DirtyPageTracker &) = delete;
+
+    // Start tracking a process, false if the system cannot track writes
+    bool Begin(DWORD processId);
+    void End();
+    bool IsActive() const { return m_pagemap >= 0; }
+
+    // Mark every page of the process clean
+    bool Reset();
+
+    // One flag per page of [address, address + pageCount pages), address page aligned
+    // false: state unknown, treat every page as dirty
+    bool Query(uintptr_t address, size_t pageCount, std::vector<uint8_t> &outDirty) const;
+
+    // True if the kernel sets soft-dirty bits (probed once)
+    static bool IsSupported();
+
+private:
+    int m_pagemap;    // pagemap file descriptor, -1 = inactive
+    int m_clearRefs;  // clear_refs file descriptor
+};
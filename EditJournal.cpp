@@ -0,0 +1,203 @@
+#include "EditJournal.h"
+#include "MappedFile.h"
+#include "DebugLog.h"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+
+EditJournal::EditJournal()
+    : m_journalOps(0), m_valid(false), m_appendEnabled(true)
+{
+}
+
+EditJournal::FileStamp EditJournal::ReadStamp(const std::wstring &filename)
+{
+    FileStamp stamp;
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExW(filename.c_str(), GetFileExInfoStandard, &attributes))
+        return stamp;
+
+    stamp.exists = true;
+    stamp.size = (static_cast<ULONGLONG>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+    stamp.writeTime = (static_cast<ULONGLONG>(attributes.ftLastWriteTime.dwHighDateTime) << 32) |
+                      attributes.ftLastWriteTime.dwLowDateTime;
+    return stamp;
+}
+
+std::string EditJournal::FormatHeader(const FileStamp &stamp)
+{
+    char header[80];
+    int length = snprintf(header, sizeof(header), "# journal %llu %llu\n",
+                          static_cast<unsigned long long>(stamp.size), static_cast<unsigned long long>(stamp.writeTime));
+    return std::string(header, length);
+}
+
+void EditJournal::Reset(const std::wstring &baseFile)
+{
+    m_baseFile = baseFile;
+    m_baseStamp = ReadStamp(baseFile);
+    m_pending.clear();
+    m_journalOps = 0;
+    m_valid = true;
+}
+
+void EditJournal::Record(JournalOp op, const std::string &payload)
+{
+    // An invalid journal is replaced by a full rewrite anyway
+    if (!m_valid)
+        return;
+
+    std::string line;
+    line.reserve(payload.size() + 1);
+    line += static_cast<char>(op);
+    line += payload;
+    m_pending.push_back(std::move(line));
+}
+
+size_t EditJournal::Replay(const std::wstring &baseFile, const ReplayCallback &apply)
+{
+    Reset(baseFile);
+
+    std::wstring journalFile = JournalPath(baseFile);
+    if (!ReadStamp(journalFile).exists)
+        return 0;
+
+    MappedFile file;
+    if (!file.Open(journalFile))
+    {
+        std::wcerr << L"[!] Failed to open journal: " << journalFile << std::endl;
+        m_valid = false;
+        return 0;
+    }
+
+    const char *cursor = reinterpret_cast<const char *>(file.Data());
+    const char *end = cursor + file.Size();
+
+    // Header must describe the current base file, otherwise the base was
+    // rewritten after the journal (crash during compaction, external edit)
+    std::string expected = FormatHeader(m_baseStamp);
+    if (file.Size() < expected.size() || memcmp(cursor, expected.data(), expected.size()) != 0)
+    {
+        std::wcerr << L"[!] Ignoring stale journal: " << journalFile << std::endl;
+        m_valid = false;
+        return 0;
+    }
+    cursor += expected.size();
+
+    size_t applied = 0;
+    size_t lineNumber = 1;
+    while (cursor < end)
+    {
+        const char *lineEnd = static_cast<const char *>(memchr(cursor, '\n', end - cursor));
+        if (lineEnd == nullptr)
+        {
+            // Torn append, the edit never completed; the next save rewrites
+            // the base instead of appending behind the fragment
+            DBG_WARN(L"Ignoring incomplete last journal line");
+            m_valid = false;
+            break;
+        }
+
+        const char *lineBegin = cursor;
+        cursor = lineEnd + 1;
+        lineNumber++;
+
+        if (lineEnd > lineBegin && lineEnd[-1] == '\r')
+            --lineEnd;
+        if (lineBegin == lineEnd)
+            continue;
+
+        char op = *lineBegin;
+        bool known = op == static_cast<char>(JournalOp::Add) || op == static_cast<char>(JournalOp::Remove) ||
+                     op == static_cast<char>(JournalOp::Clear) || op == static_cast<char>(JournalOp::Select);
+        if (!known || !apply(static_cast<JournalOp>(op), lineBegin + 1, lineEnd - lineBegin - 1))
+        {
+            std::wcerr << L"[!] Skipping invalid journal line " << lineNumber << std::endl;
+            continue;
+        }
+        applied++;
+    }
+
+    m_journalOps = applied;
+    return applied;
+}
+
+bool EditJournal::CanAppend(const std::wstring &filename, size_t entryCount) const
+{
+    if (!m_appendEnabled || !m_valid || m_baseFile.empty() || _wcsicmp(filename.c_str(), m_baseFile.c_str()) != 0)
+        return false;
+
+    // Base changed behind our back, appending would target the wrong base
+    FileStamp current = ReadStamp(m_baseFile);
+    if (!current.exists || current.size != m_baseStamp.size || current.writeTime != m_baseStamp.writeTime)
+        return false;
+
+    size_t ops = m_journalOps + m_pending.size();
+    return ops < COMPACT_MIN_OPS || ops <= entryCount / 4;
+}
+
+bool EditJournal::Append()
+{
+    if (m_pending.empty())
+        return true;
+
+    std::wstring journalFile = JournalPath(m_baseFile);
+    bool exists = ReadStamp(journalFile).exists;
+
+    std::string data;
+    if (!exists)
+        data = FormatHeader(m_baseStamp);
+    for (const auto &line : m_pending)
+    {
+        data += line;
+        data += '\n';
+    }
+
+    HANDLE hFile = CreateFileW(journalFile.c_str(), FILE_APPEND_DATA, FILE_SHARE_READ, NULL, OPEN_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        std::wcerr << L"[-] Failed to open journal: " << journalFile << std::endl;
+        return false;
+    }
+
+    DWORD written = 0;
+    BOOL ok = ::WriteFile(hFile, data.data(), static_cast<DWORD>(data.size()), &written, NULL) &&
+              written == data.size() && FlushFileBuffers(hFile);
+    CloseHandle(hFile);
+
+    if (!ok)
+    {
+        // A partial line is ignored on replay, later ops must not follow it
+        std::wcerr << L"[-] Failed to write journal: " << journalFile << std::endl;
+        m_valid = false;
+        return false;
+    }
+
+    m_journalOps += m_pending.size();
+    m_pending.clear();
+    return true;
+}
+
+bool EditJournal::CommitRewrite(const std::wstring &tempFile, const std::wstring &filename)
+{
+    // Data must be on disk before the rename makes it visible
+    HANDLE hFile = CreateFileW(tempFile.c_str(), GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hFile != INVALID_HANDLE_VALUE)
+    {
+        FlushFileBuffers(hFile);
+        CloseHandle(hFile);
+    }
+
+    if (!MoveFileExW(tempFile.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        std::wcerr << L"[-] Failed to replace " << filename << L" (error " << GetLastError() << L")" << std::endl;
+        DeleteFileW(tempFile.c_str());
+        return false;
+    }
+
+    // The old journal no longer matches the new base (stale by header too)
+    DeleteFileW(JournalPath(filename).c_str());
+    Reset(filename);
+    return true;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <windows.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// EditJournal: Append-only edit log next to a base file (<base>.journal)
+// Purpose: Small edits are saved by appending a few lines instead of
+// rewriting a large base file
+//
+// Journal layout (UTF-8 text):
+//   # journal <base size> <base write time>   - base file the ops apply to
+//   +<entry line>                             - add entry (storage's line format)
+//   -<index>                                  - remove entry at index
+//   !                                         - clear all entries
+//   @<build key>                              - switch to another build set
+//
+// - a journal whose header does not match the base file is stale and ignored
+// - a torn last line (crash during append) is ignored on replay
+// - compaction rewrites the base via temp file + MoveFileEx, then drops the journal
+// ============================================================================
+
+enum class JournalOp : char
+{
+    Add = '+',
+    Remove = '-',
+    Clear = '!',
+    Select = '@'
+};
+
+class EditJournal
+{
+public:
+    // Apply one replayed op, return false if the payload is invalid
+    using ReplayCallback = std::function<bool(JournalOp op, const char *payload, size_t length)>;
+
+    EditJournal();
+
+    // Base file now matches memory (after a full save)
+    void Reset(const std::wstring &baseFile);
+
+    // Memory changed in a way the journal cannot express, next save rewrites the base
+    void Invalidate() { m_valid = false; }
+
+    // Off while the base file is watched: a reload reads the base alone, so
+    // every save must rewrite it
+    void SetAppendEnabled(bool enabled) { m_appendEnabled = enabled; }
+
+    // Queue an edit for the next save
+    void Record(JournalOp op, const std::string &payload = std::string());
+
+    // Bind to a freshly loaded baseFile and replay its journal (if any)
+    // Returns number of applied ops
+    size_t Replay(const std::wstring &baseFile, const ReplayCallback &apply);
+
+    // True if a save to filename can append the queued edits
+    bool CanAppend(const std::wstring &filename, size_t entryCount) const;
+
+    // Append queued edits and flush them to disk
+    bool Append();
+
+    // Flush tempFile, atomically replace filename with it and drop the journal
+    bool CommitRewrite(const std::wstring &tempFile, const std::wstring &filename);
+
+    size_t GetPendingCount() const { return m_pending.size(); }
+    size_t GetJournalOpCount() const { return m_journalOps; }
+
+    static std::wstring JournalPath(const std::wstring &baseFile) { return baseFile + L".journal"; }
+    static std::wstring TempPath(const std::wstring &baseFile) { return baseFile + L".tmp"; }
+
+private:
+    struct FileStamp
+    {
+        ULONGLONG size = 0;
+        ULONGLONG writeTime = 0;
+        bool exists = false;
+    };
+
+    std::wstring m_baseFile;
+    FileStamp m_baseStamp;
+    std::vector<std::string> m_pending;
+    size_t m_journalOps;
+    bool m_valid;
+    bool m_appendEnabled;
+
+    // Compaction: rewrite the base once the journal has this many ops and
+    // more than a quarter of the entry count
+    static constexpr size_t COMPACT_MIN_OPS = 64;
+
+    static FileStamp ReadStamp(const std::wstring &filename);
+    static std::string FormatHeader(const FileStamp &stamp);
+};
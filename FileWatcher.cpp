@@ -0,0 +1,80 @@
+#include "FileWatcher.h"
+#include <chrono>
+
+FileWatcher::FileWatcher()
+    : m_intervalMs(250), m_stop(false)
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+    Stop();
+}
+
+bool FileWatcher::Start(const std::wstring &filename, ChangeCallback callback, DWORD intervalMs)
+{
+    Stop();
+
+    if (filename.empty() || !callback)
+        return false;
+
+    m_filename = filename;
+    m_callback = std::move(callback);
+    m_intervalMs = intervalMs;
+    m_stop = false;
+    m_thread = std::thread(&FileWatcher::Run, this);
+    return true;
+}
+
+void FileWatcher::Stop()
+{
+    if (!m_thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+FileWatcher::FileStamp FileWatcher::ReadStamp(const std::wstring &filename)
+{
+    FileStamp stamp;
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExW(filename.c_str(), GetFileExInfoStandard, &attributes))
+        return stamp;
+
+    stamp.exists = true;
+    stamp.writeTime = (static_cast<ULONGLONG>(attributes.ftLastWriteTime.dwHighDateTime) << 32) |
+                      attributes.ftLastWriteTime.dwLowDateTime;
+    stamp.size = (static_cast<ULONGLONG>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+    return stamp;
+}
+
+void FileWatcher::Run()
+{
+    FileStamp reported = ReadStamp(m_filename);
+    FileStamp last = reported;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_wake.wait_for(lock, std::chrono::milliseconds(m_intervalMs), [this]()
+                            { return m_stop; }))
+    {
+        lock.unlock();
+
+        FileStamp current = ReadStamp(m_filename);
+
+        // Report only after the stamp held still for one interval, a deleted
+        // file (mid-rename) is reported once it is back
+        if (current == last && current != reported && current.exists)
+        {
+            reported = current;
+            m_callback(m_filename);
+        }
+        last = current;
+
+        lock.lock();
+    }
+}
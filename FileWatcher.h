@@ -0,0 +1,64 @@
+#pragma once
+#include <windows.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// ============================================================================
+// FileWatcher: Background change detection for a single file
+// Purpose: Notice edits to loaded config files while the tool is running
+// - polls last write time + size on a worker thread (works for editors that
+//   save via temp file + rename, and on network shares)
+// - a change is reported once the file has been stable for one interval,
+//   so half-written files are not picked up
+// - the callback runs on the worker thread
+// ============================================================================
+
+class FileWatcher
+{
+public:
+    using ChangeCallback = std::function<void(const std::wstring &filename)>;
+
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher &) = delete;
+    FileWatcher &operator=(const FileWatcher &) = delete;
+
+    // Start watching (stops a previous watch first)
+    bool Start(const std::wstring &filename, ChangeCallback callback, DWORD intervalMs = 250);
+
+    // Stop the worker thread, waits for a running callback to finish
+    void Stop();
+
+    bool IsWatching() const { return m_thread.joinable(); }
+    const std::wstring &GetFilename() const { return m_filename; }
+
+private:
+    struct FileStamp
+    {
+        ULONGLONG writeTime = 0;
+        ULONGLONG size = 0;
+        bool exists = false;
+
+        bool operator==(const FileStamp &other) const
+        {
+            return writeTime == other.writeTime && size == other.size && exists == other.exists;
+        }
+        bool operator!=(const FileStamp &other) const { return !(*this == other); }
+    };
+
+    std::wstring m_filename;
+    ChangeCallback m_callback;
+    DWORD m_intervalMs;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    bool m_stop;
+
+    void Run();
+    static FileStamp ReadStamp(const std::wstring &filename);
+};
@@ -0,0 +1,133 @@
+#include "HotReload.h"
+#include <iostream>
+
+HotReload::HotReload(OffsetStorage &offsetStorage, PointerChainStorage &chainStorage)
+    : m_offsetStorage(offsetStorage), m_chainStorage(chainStorage)
+{
+}
+
+HotReload::~HotReload()
+{
+    StopAll();
+}
+
+void HotReload::WatchOffsets(const std::wstring &filename)
+{
+    // A reload reads the file alone, journaled edits have to be in it
+    if (!m_offsetStorage.CompactJournal())
+        std::wcout << L"[!] Journaled offset edits are not in " << filename << L" yet, reloads wait for the next save\n";
+    m_offsetStorage.SetJournalAppends(false);
+
+    m_offsetWatcher.Start(filename, [this](const std::wstring &changed)
+                          {
+        // Parse outside the lock, only the hand-over is synchronized
+        std::vector<OffsetEntry> entries;
+        std::vector<BuildSection> sections;
+        bool ok = OffsetStorage::ReadEntries(changed, entries, sections);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingOffsets.ready = true;
+        m_pendingOffsets.failed = !ok;
+        m_pendingOffsets.entries = std::move(entries);
+        m_pendingOffsets.sections = std::move(sections); });
+}
+
+void HotReload::WatchChains(const std::wstring &filename)
+{
+    if (!m_chainStorage.CompactJournal())
+        std::wcout << L"[!] Journaled chain edits are not in " << filename << L" yet, reloads wait for the next save\n";
+    m_chainStorage.SetJournalAppends(false);
+
+    m_chainWatcher.Start(filename, [this](const std::wstring &changed)
+                         {
+        std::vector<PointerChain> chains;
+        std::vector<BuildSection> sections;
+        bool ok = PointerChainStorage::ReadChains(changed, chains, sections);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pendingChains.ready = true;
+        m_pendingChains.failed = !ok;
+        m_pendingChains.entries = std::move(chains);
+        m_pendingChains.sections = std::move(sections); });
+}
+
+void HotReload::StopAll()
+{
+    m_offsetWatcher.Stop();
+    m_chainWatcher.Stop();
+    m_offsetStorage.SetJournalAppends(true);
+    m_chainStorage.SetJournalAppends(true);
+}
+
+bool HotReload::ApplyPending()
+{
+    Pending<OffsetEntry> offsets;
+    Pending<PointerChain> chains;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::swap(offsets, m_pendingOffsets);
+        std::swap(chains, m_pendingChains);
+    }
+
+    bool changed = false;
+
+    if (offsets.ready)
+    {
+        const std::wstring &filename = m_offsetWatcher.GetFilename();
+        if (offsets.failed)
+        {
+            std::wcout << L"[!] " << filename << L" changed but could not be read, keeping current offsets\n";
+        }
+        else if (m_offsetStorage.IsModified())
+        {
+            std::wcout << L"[!] " << filename << L" changed on disk, reload skipped (unsaved offset edits)\n";
+        }
+        else if (m_offsetStorage.GetJournaledEditCount() > 0)
+        {
+            std::wcout << L"[!] " << filename << L" changed on disk, reload skipped ("
+                       << m_offsetStorage.GetJournaledEditCount() << L" journaled edits not in the file)\n";
+        }
+        else
+        {
+            ReloadStats stats = m_offsetStorage.ApplyReload(std::move(offsets.entries), offsets.sections);
+            PrintStats(L"offsets", filename, stats);
+            changed |= stats.HasChanges();
+        }
+    }
+
+    if (chains.ready)
+    {
+        const std::wstring &filename = m_chainWatcher.GetFilename();
+        if (chains.failed)
+        {
+            std::wcout << L"[!] " << filename << L" changed but could not be read, keeping current chains\n";
+        }
+        else if (m_chainStorage.IsModified())
+        {
+            std::wcout << L"[!] " << filename << L" changed on disk, reload skipped (unsaved chain edits)\n";
+        }
+        else if (m_chainStorage.GetJournaledEditCount() > 0)
+        {
+            std::wcout << L"[!] " << filename << L" changed on disk, reload skipped ("
+                       << m_chainStorage.GetJournaledEditCount() << L" journaled edits not in the file)\n";
+        }
+        else
+        {
+            ReloadStats stats = m_chainStorage.ApplyReload(std::move(chains.entries), chains.sections);
+            PrintStats(L"chains", filename, stats);
+            changed |= stats.HasChanges();
+        }
+    }
+
+    return changed;
+}
+
+void HotReload::PrintStats(const wchar_t *what, const std::wstring &filename, const ReloadStats &stats)
+{
+    if (!stats.HasChanges())
+        return;
+
+    std::wcout << L"[+] Reloaded " << what << L" from " << filename << L": "
+               << stats.added << L" added, " << stats.removed << L" removed, "
+               << stats.updated << L" updated, " << stats.unchanged << L" unchanged\n";
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "FileWatcher.h"
+#include "OffsetStorage.h"
+#include "PointerChainStorage.h"
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// HotReload: Live reload of the loaded offset and chain files
+// Purpose: Pick up edits to config files without losing resolved state
+// - files are re-read and parsed on the watcher threads
+// - ApplyPending merges the parsed result into storage on the caller's
+//   thread, so it only runs between operations and never stalls a resolve
+// - storages with unsaved edits are left alone
+// - a watched file holds every edit: its journal is compacted into it when
+//   watching starts, and saves rewrite it instead of appending
+// ============================================================================
+
+class HotReload
+{
+public:
+    HotReload(OffsetStorage &offsetStorage, PointerChainStorage &chainStorage);
+    ~HotReload();
+
+    // Start watching the file currently loaded into the storage
+    void WatchOffsets(const std::wstring &filename);
+    void WatchChains(const std::wstring &filename);
+    void StopAll();
+
+    bool IsWatchingOffsets() const { return m_offsetWatcher.IsWatching(); }
+    bool IsWatchingChains() const { return m_chainWatcher.IsWatching(); }
+
+    // Merge parsed changes into storage and print a summary, call at safe points
+    // Returns true if any storage changed
+    bool ApplyPending();
+
+private:
+    // Parsed file contents waiting for ApplyPending
+    template <typename Entry>
+    struct Pending
+    {
+        bool ready = false;
+        bool failed = false;
+        std::vector<Entry> entries;
+        std::vector<BuildSection> sections;
+    };
+
+    OffsetStorage &m_offsetStorage;
+    PointerChainStorage &m_chainStorage;
+
+    std::mutex m_mutex;
+    Pending<OffsetEntry> m_pendingOffsets;
+    Pending<PointerChain> m_pendingChains;
+
+    // Declared last: stopped first on destruction, before pending state goes away
+    FileWatcher m_offsetWatcher;
+    FileWatcher m_chainWatcher;
+
+    static void PrintStats(const wchar_t *what, const std::wstring &filename, const ReloadStats &stats);
+};
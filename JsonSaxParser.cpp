@@ -0,0 +1,392 @@
+#include "JsonSaxParser.h"
+#include <algorithm>
+#include <cstring>
+
+// Parser position inside the current container
+enum class JsonState
+{
+    Value,      // Any value
+    ValueOrEnd, // Value or ']' right after '['
+    Key,        // Object key after ','
+    KeyOrEnd,   // Object key or '}' right after '{'
+    CommaOrEnd  // ',' or the closing bracket of the current container
+};
+
+static int HexDigit(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+// Read 4 hex digits of a \u escape
+static bool ReadHex4(const char *p, const char *end, unsigned &outValue)
+{
+    if (end - p < 4)
+        return false;
+
+    unsigned value = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        int digit = HexDigit(p[i]);
+        if (digit < 0)
+            return false;
+        value = (value << 4) | static_cast<unsigned>(digit);
+    }
+    outValue = value;
+    return true;
+}
+
+static void AppendCodepoint(unsigned cp, std::string &out)
+{
+    if (cp < 0x80)
+    {
+        out += static_cast<char>(cp);
+    }
+    else if (cp < 0x800)
+    {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else if (cp < 0x10000)
+    {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    else
+    {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+JsonSaxParser::JsonSaxParser()
+    : m_begin(nullptr), m_cursor(nullptr), m_end(nullptr), m_errorLine(0)
+{
+}
+
+bool JsonSaxParser::Parse(const char *data, size_t size, JsonSaxHandler &handler)
+{
+    m_begin = data;
+    m_cursor = data;
+    m_end = data + size;
+    m_stack.clear();
+    m_error.clear();
+    m_errorLine = 0;
+
+    // Skip UTF-8 BOM
+    if (size >= 3 && static_cast<unsigned char>(data[0]) == 0xEF &&
+        static_cast<unsigned char>(data[1]) == 0xBB && static_cast<unsigned char>(data[2]) == 0xBF)
+    {
+        m_cursor += 3;
+    }
+
+    JsonState state = JsonState::Value;
+
+    while (true)
+    {
+        SkipWhitespace();
+
+        if (state == JsonState::CommaOrEnd && m_stack.empty())
+        {
+            if (m_cursor != m_end)
+                return Fail(L"Unexpected data after document");
+            return true;
+        }
+
+        if (m_cursor == m_end)
+            return Fail(L"Unexpected end of input");
+
+        char c = *m_cursor;
+        bool handled = true;
+
+        if (state == JsonState::CommaOrEnd)
+        {
+            char container = m_stack.back();
+            if (c == ',')
+            {
+                ++m_cursor;
+                state = container == '{' ? JsonState::Key : JsonState::Value;
+            }
+            else if ((c == '}' && container == '{') || (c == ']' && container == '['))
+            {
+                ++m_cursor;
+                m_stack.pop_back();
+                handled = c == '}' ? handler.EndObject() : handler.EndArray();
+            }
+            else
+            {
+                return Fail(L"Expected ',' or closing bracket");
+            }
+        }
+        else if (state == JsonState::KeyOrEnd && c == '}')
+        {
+            ++m_cursor;
+            m_stack.pop_back();
+            handled = handler.EndObject();
+            state = JsonState::CommaOrEnd;
+        }
+        else if (state == JsonState::ValueOrEnd && c == ']')
+        {
+            ++m_cursor;
+            m_stack.pop_back();
+            handled = handler.EndArray();
+            state = JsonState::CommaOrEnd;
+        }
+        else if (state == JsonState::Key || state == JsonState::KeyOrEnd)
+        {
+            if (c != '"')
+                return Fail(L"Expected object key");
+
+            const char *key;
+            size_t keyLength;
+            if (!ParseString(key, keyLength))
+                return false;
+            handled = handler.Key(key, keyLength);
+
+            SkipWhitespace();
+            if (m_cursor == m_end || *m_cursor != ':')
+                return Fail(L"Expected ':' after object key");
+            ++m_cursor;
+            state = JsonState::Value;
+        }
+        else
+        {
+            // Value or ValueOrEnd
+            if (c == '{' || c == '[')
+            {
+                if (m_stack.size() >= MAX_DEPTH)
+                    return Fail(L"Nesting too deep");
+
+                ++m_cursor;
+                m_stack.push_back(c);
+                handled = c == '{' ? handler.StartObject() : handler.StartArray();
+                state = c == '{' ? JsonState::KeyOrEnd : JsonState::ValueOrEnd;
+            }
+            else
+            {
+                if (c == '"')
+                {
+                    const char *str;
+                    size_t strLength;
+                    if (!ParseString(str, strLength))
+                        return false;
+                    handled = handler.String(str, strLength);
+                }
+                else if (c == '-' || (c >= '0' && c <= '9'))
+                {
+                    if (!ParseNumber(handler))
+                        return false;
+                }
+                else if (c == 't' || c == 'f' || c == 'n')
+                {
+                    if (!ParseLiteral(handler))
+                        return false;
+                }
+                else
+                {
+                    return Fail(L"Unexpected character");
+                }
+                state = JsonState::CommaOrEnd;
+            }
+        }
+
+        if (!handled)
+            return Fail(L"Parsing stopped by handler");
+    }
+}
+
+void JsonSaxParser::SkipWhitespace()
+{
+    while (m_cursor < m_end && (*m_cursor == ' ' || *m_cursor == '\n' || *m_cursor == '\r' || *m_cursor == '\t'))
+        ++m_cursor;
+}
+
+bool JsonSaxParser::ParseString(const char *&outData, size_t &outLength)
+{
+    const char *start = ++m_cursor;
+
+    // Fast path: no escapes, the string is used in place
+    while (m_cursor < m_end)
+    {
+        unsigned char c = static_cast<unsigned char>(*m_cursor);
+        if (c == '"')
+        {
+            outData = start;
+            outLength = m_cursor - start;
+            ++m_cursor;
+            return true;
+        }
+        if (c == '\\')
+            break;
+        if (c < 0x20)
+            return Fail(L"Control character in string");
+        ++m_cursor;
+    }
+
+    if (m_cursor == m_end)
+        return Fail(L"Unterminated string");
+
+    // Escaped string: decode into the scratch buffer
+    m_scratch.assign(start, m_cursor);
+    while (m_cursor < m_end)
+    {
+        unsigned char c = static_cast<unsigned char>(*m_cursor);
+        if (c == '"')
+        {
+            ++m_cursor;
+            outData = m_scratch.data();
+            outLength = m_scratch.size();
+            return true;
+        }
+        if (c < 0x20)
+            return Fail(L"Control character in string");
+        if (c != '\\')
+        {
+            m_scratch += static_cast<char>(c);
+            ++m_cursor;
+            continue;
+        }
+
+        if (m_end - m_cursor < 2)
+            break;
+
+        char escape = m_cursor[1];
+        m_cursor += 2;
+        switch (escape)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            m_scratch += escape;
+            break;
+        case 'b':
+            m_scratch += '\b';
+            break;
+        case 'f':
+            m_scratch += '\f';
+            break;
+        case 'n':
+            m_scratch += '\n';
+            break;
+        case 'r':
+            m_scratch += '\r';
+            break;
+        case 't':
+            m_scratch += '\t';
+            break;
+        case 'u':
+        {
+            unsigned cp;
+            if (!ReadHex4(m_cursor, m_end, cp))
+                return Fail(L"Invalid \\u escape");
+            m_cursor += 4;
+
+            if (cp >= 0xD800 && cp <= 0xDBFF)
+            {
+                // High surrogate, combine with a following low surrogate
+                unsigned low;
+                if (m_end - m_cursor >= 6 && m_cursor[0] == '\\' && m_cursor[1] == 'u' &&
+                    ReadHex4(m_cursor + 2, m_end, low) && low >= 0xDC00 && low <= 0xDFFF)
+                {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    m_cursor += 6;
+                }
+                else
+                {
+                    cp = 0xFFFD;
+                }
+            }
+            else if (cp >= 0xDC00 && cp <= 0xDFFF)
+            {
+                cp = 0xFFFD;
+            }
+            AppendCodepoint(cp, m_scratch);
+            break;
+        }
+        default:
+            return Fail(L"Invalid escape sequence");
+        }
+    }
+
+    return Fail(L"Unterminated string");
+}
+
+bool JsonSaxParser::ParseNumber(JsonSaxHandler &handler)
+{
+    const char *start = m_cursor;
+    auto digits = [this]()
+    {
+        const char *first = m_cursor;
+        while (m_cursor < m_end && *m_cursor >= '0' && *m_cursor <= '9')
+            ++m_cursor;
+        return m_cursor > first;
+    };
+
+    if (*m_cursor == '-')
+        ++m_cursor;
+
+    if (m_cursor < m_end && *m_cursor == '0')
+        ++m_cursor;
+    else if (!digits())
+        return Fail(L"Invalid number");
+
+    if (m_cursor < m_end && *m_cursor == '.')
+    {
+        ++m_cursor;
+        if (!digits())
+            return Fail(L"Invalid number");
+    }
+
+    if (m_cursor < m_end && (*m_cursor == 'e' || *m_cursor == 'E'))
+    {
+        ++m_cursor;
+        if (m_cursor < m_end && (*m_cursor == '+' || *m_cursor == '-'))
+            ++m_cursor;
+        if (!digits())
+            return Fail(L"Invalid number");
+    }
+
+    if (!handler.Number(start, m_cursor - start))
+        return Fail(L"Parsing stopped by handler");
+    return true;
+}
+
+bool JsonSaxParser::ParseLiteral(JsonSaxHandler &handler)
+{
+    auto match = [this](const char *literal, size_t length)
+    {
+        if (static_cast<size_t>(m_end - m_cursor) < length || memcmp(m_cursor, literal, length) != 0)
+            return false;
+        m_cursor += length;
+        return true;
+    };
+
+    bool handled;
+    if (match("true", 4))
+        handled = handler.Bool(true);
+    else if (match("false", 5))
+        handled = handler.Bool(false);
+    else if (match("null", 4))
+        handled = handler.Null();
+    else
+        return Fail(L"Invalid literal");
+
+    if (!handled)
+        return Fail(L"Parsing stopped by handler");
+    return true;
+}
+
+bool JsonSaxParser::Fail(const std::wstring &message)
+{
+    m_error = message;
+    m_errorLine = 1 + std::count(m_begin, m_cursor, '\n');
+    return false;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// JsonSaxParser: Streaming (SAX-style) JSON reader without a DOM
+// Purpose: Parse large JSON files from a mapped buffer with flat memory use
+// - events are delivered to a JsonSaxHandler as they are read
+// - strings without escapes point straight into the input buffer
+// - strings with escapes are decoded into one reused scratch buffer
+// ============================================================================
+
+// Receives parse events, return false from any callback to abort parsing
+// Keys and strings are UTF-8 and only valid during the callback
+class JsonSaxHandler
+{
+public:
+    virtual ~JsonSaxHandler() = default;
+
+    virtual bool StartObject() { return true; }
+    virtual bool EndObject() { return true; }
+    virtual bool StartArray() { return true; }
+    virtual bool EndArray() { return true; }
+    virtual bool Key(const char * /*data*/, size_t /*length*/) { return true; }
+    virtual bool String(const char * /*data*/, size_t /*length*/) { return true; }
+    virtual bool Number(const char * /*data*/, size_t /*length*/) { return true; } // Raw number text
+    virtual bool Bool(bool /*value*/) { return true; }
+    virtual bool Null() { return true; }
+};
+
+class JsonSaxParser
+{
+public:
+    JsonSaxParser();
+
+    // Parse one JSON document, trailing whitespace is allowed
+    bool Parse(const char *data, size_t size, JsonSaxHandler &handler);
+
+    // Error details after Parse returned false
+    const std::wstring &GetError() const { return m_error; }
+    size_t GetErrorLine() const { return m_errorLine; }
+
+private:
+    const char *m_begin;
+    const char *m_cursor;
+    const char *m_end;
+    std::string m_scratch;
+    std::vector<char> m_stack; // '{' or '[' per open container
+    std::wstring m_error;
+    size_t m_errorLine;
+
+    // Nesting limit, protects against pathological input
+    static constexpr size_t MAX_DEPTH = 512;
+
+    void SkipWhitespace();
+    bool ParseString(const char *&outData, size_t &outLength);
+    bool ParseNumber(JsonSaxHandler &handler);
+    bool ParseLiteral(JsonSaxHandler &handler);
+    bool Fail(const std::wstring &message);
+};
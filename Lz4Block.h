@@ -0,0 +1,248 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// ============================================================================
+// Lz4Block: LZ4 block format compressor / bounds-checked decompressor
+// Purpose: Fast per-chunk compression of captured memory (ProcessSnapshot)
+// - greedy single-probe matcher with a 4096-entry hash table, skips ahead
+//   faster through incompressible data
+// - output decodes with the reference LZ4_decompress_safe, Decompress
+//   accepts any valid LZ4 block and never reads or writes out of bounds
+// ============================================================================
+
+namespace Lz4Block
+{
+    constexpr size_t MIN_MATCH = 4;
+    constexpr size_t LAST_LITERALS = 5; // Block ends with at least 5 literals
+    constexpr size_t MF_LIMIT = 12;     // No match starts in the last 12 bytes
+    constexpr size_t MAX_OFFSET = 65535;
+    constexpr unsigned HASH_BITS = 12;
+
+    // Worst case output size for size input bytes
+    constexpr size_t Bound(size_t size)
+    {
+        return size + size / 255 + 16;
+    }
+
+    inline uint32_t Read32(const uint8_t *p)
+    {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint64_t Read64(const uint8_t *p)
+    {
+        uint64_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint32_t Hash(uint32_t sequence)
+    {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    inline unsigned TrailingZeroBytes(uint64_t value)
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<unsigned>(index) / 8;
+#else
+        return static_cast<unsigned>(__builtin_ctzll(value)) / 8;
+#endif
+    }
+
+    // Bytes equal at a and b, up to limit (a < limit)
+    inline size_t MatchLength(const uint8_t *a, const uint8_t *b, const uint8_t *limit)
+    {
+        const uint8_t *start = a;
+        while (a + 8 <= limit)
+        {
+            uint64_t diff = Read64(a) ^ Read64(b);
+            if (diff != 0)
+                return static_cast<size_t>(a - start) + TrailingZeroBytes(diff);
+            a += 8;
+            b += 8;
+        }
+        while (a < limit && *a == *b)
+        {
+            ++a;
+            ++b;
+        }
+        return static_cast<size_t>(a - start);
+    }
+
+    // Length continuation bytes after a saturated (15) token nibble
+    inline uint8_t *WriteLength(uint8_t *out, size_t length)
+    {
+        for (; length >= 255; length -= 255)
+        {
+            *out++ = 255;
+        }
+        *out++ = static_cast<uint8_t>(length);
+        return out;
+    }
+
+    // Compress size bytes, returns the block size or 0 if it would exceed capacity
+    inline size_t Compress(const uint8_t *src, size_t size, uint8_t *dst, size_t capacity)
+    {
+        uint8_t *out = dst;
+        uint8_t *const outEnd = dst + capacity;
+        const uint8_t *anchor = src;
+        const uint8_t *const end = src + size;
+
+        // Literals anchor..literalEnd followed by a match (matchLength 0 = last literals)
+        auto emit = [&](const uint8_t *literalEnd, size_t offset, size_t matchLength) -> bool
+        {
+            const size_t literals = static_cast<size_t>(literalEnd - anchor);
+            const size_t worst = 1 + literals / 255 + 1 + literals + 2 + matchLength / 255 + 1;
+            if (worst > static_cast<size_t>(outEnd - out))
+                return false;
+
+            uint8_t *token = out++;
+            *token = static_cast<uint8_t>((literals >= 15 ? 15 : literals) << 4);
+            if (literals >= 15)
+                out = WriteLength(out, literals - 15);
+            if (literals <= 16 && end - anchor >= 16 && outEnd - out >= 16)
+                memcpy(out, anchor, 16);
+            else
+                memcpy(out, anchor, literals);
+            out += literals;
+            if (matchLength == 0)
+                return true;
+
+            *out++ = static_cast<uint8_t>(offset);
+            *out++ = static_cast<uint8_t>(offset >> 8);
+            const size_t code = matchLength - MIN_MATCH;
+            *token |= static_cast<uint8_t>(code >= 15 ? 15 : code);
+            if (code >= 15)
+                out = WriteLength(out, code - 15);
+            return true;
+        };
+
+        if (size > MF_LIMIT)
+        {
+            uint32_t table[1u << HASH_BITS] = {};
+            const uint8_t *const matchLimit = end - LAST_LITERALS;
+            const uint8_t *const inputLimit = end - MF_LIMIT;
+            const uint8_t *ip = src;
+            while (ip < inputLimit)
+            {
+                const uint32_t sequence = Read32(ip);
+                const uint32_t hash = Hash(sequence);
+                const uint8_t *candidate = src + table[hash];
+                table[hash] = static_cast<uint32_t>(ip - src);
+
+                if (candidate >= ip || static_cast<size_t>(ip - candidate) > MAX_OFFSET || Read32(candidate) != sequence)
+                {
+                    // Step grows with the distance to the last match
+                    ip += 1 + (static_cast<size_t>(ip - anchor) >> 6);
+                    continue;
+                }
+
+                size_t length = MIN_MATCH + MatchLength(ip + MIN_MATCH, candidate + MIN_MATCH, matchLimit);
+                if (!emit(ip, static_cast<size_t>(ip - candidate), length))
+                    return 0;
+                ip += length;
+                anchor = ip;
+                if (ip - 2 >= src && ip < inputLimit)
+                    table[Hash(Read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - src);
+            }
+        }
+
+        if (!emit(end, 0, 0))
+            return 0;
+        return static_cast<size_t>(out - dst);
+    }
+
+    // Decompress a block into exactly outSize bytes, false if the block is malformed
+    inline bool Decompress(const uint8_t *src, size_t size, uint8_t *dst, size_t outSize)
+    {
+        const uint8_t *ip = src;
+        const uint8_t *const ipEnd = src + size;
+        uint8_t *op = dst;
+        uint8_t *const opEnd = dst + outSize;
+
+        auto readLength = [&](size_t &length) -> bool
+        {
+            uint8_t byte;
+            do
+            {
+                if (ip >= ipEnd)
+                    return false;
+                byte = *ip++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        };
+
+        while (ip < ipEnd)
+        {
+            const uint8_t token = *ip++;
+            size_t literals = token >> 4;
+            if (literals == 15 && !readLength(literals))
+                return false;
+            if (literals <= 16 && ipEnd - ip >= 16 && opEnd - op >= 16)
+            {
+                // Short run away from both ends: fixed-size copy, the extra bytes are overwritten later
+                memcpy(op, ip, 16);
+            }
+            else
+            {
+                if (literals > static_cast<size_t>(ipEnd - ip) || literals > static_cast<size_t>(opEnd - op))
+                    return false;
+                memcpy(op, ip, literals);
+            }
+            ip += literals;
+            op += literals;
+            if (ip == ipEnd)
+                break;
+
+            if (ipEnd - ip < 2)
+                return false;
+            const size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast<size_t>(op - dst))
+                return false;
+
+            size_t length = token & 15;
+            if (length == 15 && !readLength(length))
+                return false;
+            length += MIN_MATCH;
+            if (length > static_cast<size_t>(opEnd - op))
+                return false;
+
+            // Overlapping copies repeat the last offset bytes
+            const uint8_t *match = op - offset;
+            if (offset >= 8 && length + 8 <= static_cast<size_t>(opEnd - op))
+            {
+                // 8-byte steps only read bytes already written, may write up to 7 past the match
+                for (size_t i = 0; i < length; i += 8)
+                {
+                    memcpy(op + i, match + i, 8);
+                }
+                op += length;
+            }
+            else if (offset >= length)
+            {
+                memcpy(op, match, length);
+                op += length;
+            }
+            else
+            {
+                for (size_t i = 0; i < length; ++i)
+                {
+                    *op++ = *match++;
+                }
+            }
+        }
+        return op == opEnd;
+    }
+}
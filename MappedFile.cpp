@@ -0,0 +1,155 @@
+#include "MappedFile.h"
+#include "DebugLog.h"
+#include "StringUtils.h"
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile()
+    : m_hFile(INVALID_HANDLE_VALUE), m_hMapping(NULL), m_data(nullptr), m_size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::wstring &filename)
+{
+    Close();
+
+    m_hFile = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                          NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (m_hFile == INVALID_HANDLE_VALUE)
+    {
+        DBG_ERR(L"CreateFileW failed for " + filename + L", error: " + std::to_wstring(GetLastError()));
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(m_hFile, &fileSize))
+    {
+        DBG_ERR(L"GetFileSizeEx failed for " + filename);
+        Close();
+        return false;
+    }
+
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+
+    // CreateFileMapping rejects zero-length files, an empty view is enough
+    if (m_size == 0)
+    {
+        return true;
+    }
+
+    m_hMapping = CreateFileMappingW(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m_hMapping == NULL)
+    {
+        DBG_ERR(L"CreateFileMappingW failed, error: " + std::to_wstring(GetLastError()));
+        Close();
+        return false;
+    }
+
+    m_data = static_cast<const uint8_t *>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr)
+    {
+        DBG_ERR(L"MapViewOfFile failed, error: " + std::to_wstring(GetLastError()));
+        Close();
+        return false;
+    }
+
+    DBG_INFO(L"Mapped " + filename + L" (" + std::to_wstring(m_size) + L" bytes)");
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data != nullptr)
+    {
+        UnmapViewOfFile(m_data);
+        m_data = nullptr;
+    }
+    if (m_hMapping != NULL)
+    {
+        CloseHandle(m_hMapping);
+        m_hMapping = NULL;
+    }
+    if (m_hFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(m_hFile);
+        m_hFile = INVALID_HANDLE_VALUE;
+    }
+    m_size = 0;
+}
+#else
+MappedFile::MappedFile()
+    : m_fd(-1), m_data(nullptr), m_size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::wstring &filename)
+{
+    Close();
+
+    m_fd = open(StringUtils::WideToUtf8(filename).c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd == -1)
+    {
+        DBG_ERR(L"open failed for " + filename + L", errno: " + std::to_wstring(errno));
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(m_fd, &status) != 0 || !S_ISREG(status.st_mode))
+    {
+        DBG_ERR(L"fstat failed or not a regular file: " + filename);
+        Close();
+        return false;
+    }
+
+    m_size = static_cast<size_t>(status.st_size);
+
+    // mmap rejects zero-length mappings, an empty view is enough
+    if (m_size == 0)
+    {
+        return true;
+    }
+
+    void *view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (view == MAP_FAILED)
+    {
+        DBG_ERR(L"mmap failed, errno: " + std::to_wstring(errno));
+        Close();
+        return false;
+    }
+    m_data = static_cast<const uint8_t *>(view);
+
+    DBG_INFO(L"Mapped " + filename + L" (" + std::to_wstring(m_size) + L" bytes)");
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<uint8_t *>(m_data), m_size);
+        m_data = nullptr;
+    }
+    if (m_fd != -1)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+    m_size = 0;
+}
+#endif
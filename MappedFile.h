@@ -0,0 +1,46 @@
+#pragma once
+#include "Platform.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ============================================================================
+// MappedFile: Read-only memory-mapped file
+// Purpose: Zero-copy access to large config/database files
+// The view stays valid until Close() or destruction
+// Windows: file mapping object, elsewhere: mmap of the file descriptor
+// ============================================================================
+
+class MappedFile
+{
+private:
+#ifdef _WIN32
+    HANDLE m_hFile;
+    HANDLE m_hMapping;
+#else
+    int m_fd;
+#endif
+    const uint8_t *m_data;
+    size_t m_size;
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Map whole file read-only (empty files map to an empty view)
+    bool Open(const std::wstring &filename);
+
+    // Unmap and close handles
+    void Close();
+
+#ifdef _WIN32
+    bool IsOpen() const { return m_hFile != INVALID_HANDLE_VALUE; }
+#else
+    bool IsOpen() const { return m_fd != -1; }
+#endif
+    const uint8_t *Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+};
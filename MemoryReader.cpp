@@ -1,10 +1,47 @@
 #include "MemoryReader.h"
 #include "DebugLog.h"
+#include "ProcessSnapshot.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <cwchar>
+#ifndef _WIN32
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <sys/uio.h>
+#endif
+
+// One read from the target, bytesRead is how much arrived before the first
+// unreadable byte
+static bool ReadProcessBytes(HANDLE processHandle, uintptr_t address, void *buffer, size_t size, size_t &bytesRead)
+{
+#ifdef _WIN32
+    SIZE_T transferred = 0;
+    BOOL result = ReadProcessMemory(processHandle, reinterpret_cast<LPCVOID>(address), buffer, size, &transferred);
+    bytesRead = transferred;
+    return result && transferred == size;
+#else
+    iovec local = {buffer, size};
+    iovec remote = {reinterpret_cast<void *>(address), size};
+    ssize_t transferred = process_vm_readv(static_cast<pid_t>(GetProcessId(processHandle)), &local, 1, &remote, 1, 0);
+    bytesRead = transferred > 0 ? static_cast<size_t>(transferred) : 0;
+    return transferred == static_cast<ssize_t>(size);
+#endif
+}
+
+static DWORD LastReadError()
+{
+#ifdef _WIN32
+    return GetLastError();
+#else
+    return static_cast<DWORD>(errno);
+#endif
+}
 
 MemoryReader::MemoryReader(HANDLE processHandle)
-    : m_processHandle(processHandle), m_logErrors(true)
+    : m_processHandle(processHandle), m_snapshot(nullptr), m_logErrors(true)
 {
     DBG_INFO(L"MemoryReader initialized with process handle");
 }
@@ -52,7 +89,7 @@ uintptr_t MemoryReader::ReadPointer(uintptr_t address, bool &success)
 bool MemoryReader::ReadMemory(uintptr_t address, void *buffer, size_t size)
 {
     // Проверяем handle перед чтением
-    if (m_processHandle == NULL || m_processHandle == INVALID_HANDLE_VALUE)
+    if (m_snapshot == nullptr && (m_processHandle == NULL || m_processHandle == INVALID_HANDLE_VALUE))
     {
         DBG_ERR(L"Process handle is invalid!");
         DebugLog::HandleInfo(m_processHandle);
@@ -75,18 +112,26 @@ bool MemoryReader::ReadMemory(uintptr_t address, void *buffer, size_t size)
         return false;
     }
 
-    SIZE_T bytesRead = 0;
-    BOOL result = ReadProcessMemory(
-        m_processHandle,
-        (LPCVOID)address,
-        buffer,
-        size,
-        &bytesRead);
+    if (m_snapshot != nullptr)
+    {
+        if (!m_snapshot->Read(address, buffer, size))
+        {
+            DBG_ERR(L"Address not captured in snapshot");
+            if (m_logErrors)
+            {
+                std::wcerr << L"[MemoryReader] Not in snapshot: 0x"
+                           << std::hex << address << std::dec << L" (bytes: " << size << L")" << std::endl;
+            }
+            return false;
+        }
+        return true;
+    }
 
-    if (!result || bytesRead != size)
+    size_t bytesRead = 0;
+    if (!ReadProcessBytes(m_processHandle, address, buffer, size, bytesRead))
     {
-        DWORD lastError = GetLastError();
-        DBG_ERR(L"ReadProcessMemory failed, error code: " + std::to_wstring(lastError));
+        DWORD lastError = LastReadError();
+        DBG_ERR(L"Process memory read failed, error code: " + std::to_wstring(lastError));
         if (m_logErrors)
         {
             std::wcerr << L"[MemoryReader] Failed to read from 0x"
@@ -99,6 +144,99 @@ bool MemoryReader::ReadMemory(uintptr_t address, void *buffer, size_t size)
     return true;
 }
 
+size_t MemoryReader::ReadRangePadded(HANDLE processHandle, uintptr_t address, void *buffer, size_t size,
+                                     std::vector<uint32_t> *badPages)
+{
+    size_t bytesRead = 0;
+    if (ReadProcessBytes(processHandle, address, buffer, size, bytesRead))
+        return 0;
+
+    // Slow path: the range crosses a guard/no-access page, read page by page
+    const size_t pageSize = 0x1000;
+    uint8_t *bytes = static_cast<uint8_t *>(buffer);
+    size_t unreadablePages = 0;
+    for (size_t offset = 0; offset < size; offset += pageSize)
+    {
+        size_t length = (std::min)(pageSize, size - offset);
+        if (!ReadProcessBytes(processHandle, address + offset, bytes + offset, length, bytesRead))
+        {
+            memset(bytes + offset, 0, length);
+            unreadablePages++;
+            if (badPages != nullptr)
+                badPages->push_back(static_cast<uint32_t>(offset / pageSize));
+        }
+    }
+    return unreadablePages;
+}
+
+void MemoryReader::EnumerateRegions(HANDLE processHandle, std::vector<MemoryRegion> &outRegions, bool writableOnly)
+{
+    outRegions.clear();
+
+#ifdef _WIN32
+    const DWORD writable = PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+    const DWORD readable = writableOnly ? writable : writable | PAGE_READONLY | PAGE_EXECUTE_READ;
+
+    uintptr_t address = MIN_VALID_ADDRESS;
+    MEMORY_BASIC_INFORMATION info;
+    while (address < MAX_VALID_ADDRESS &&
+           VirtualQueryEx(processHandle, reinterpret_cast<LPCVOID>(address), &info, sizeof(info)) == sizeof(info))
+    {
+        uintptr_t base = reinterpret_cast<uintptr_t>(info.BaseAddress);
+        uintptr_t end = base + info.RegionSize;
+        if (end <= address)
+            break;
+
+        // Mapped files (shared sections, file views) rarely hold program state and can be huge
+        if (info.State == MEM_COMMIT && info.Type != MEM_MAPPED && (info.Protect & readable) != 0 &&
+            (info.Protect & PAGE_GUARD) == 0)
+        {
+            base = (std::max)(base, static_cast<uintptr_t>(MIN_VALID_ADDRESS));
+            end = (std::min)(end, static_cast<uintptr_t>(MAX_VALID_ADDRESS));
+            if (!outRegions.empty() && outRegions.back().base + outRegions.back().size == base)
+            {
+                outRegions.back().size += end - base;
+            }
+            else if (end > base)
+            {
+                outRegions.push_back({base, end - base});
+            }
+        }
+        address = end;
+    }
+#else
+    // /proc/<pid>/maps: "start-end perms offset dev inode path", sorted by address
+    std::ifstream maps("/proc/" + std::to_string(GetProcessId(processHandle)) + "/maps");
+    std::string line;
+    while (std::getline(maps, line))
+    {
+        unsigned long long start = 0;
+        unsigned long long stop = 0;
+        char perms[5] = {};
+        int pathAt = 0;
+        if (sscanf(line.c_str(), "%llx-%llx %4s %*s %*s %*s %n", &start, &stop, perms, &pathAt) < 3)
+            continue;
+
+        // Shared mappings are the mapped files of Windows, [vvar] cannot be read
+        const char *path = pathAt > 0 ? line.c_str() + pathAt : "";
+        if (perms[0] != 'r' || (writableOnly && perms[1] != 'w') || perms[3] == 's' ||
+            strcmp(path, "[vvar]") == 0 || strcmp(path, "[vvar_vclock]") == 0)
+            continue;
+
+        uintptr_t base = (std::max)(static_cast<uintptr_t>(start), static_cast<uintptr_t>(MIN_VALID_ADDRESS));
+        uintptr_t end = (std::min)(static_cast<uintptr_t>(stop), static_cast<uintptr_t>(MAX_VALID_ADDRESS));
+        if (!outRegions.empty() && outRegions.back().base + outRegions.back().size == base)
+        {
+            outRegions.back().size += end - base;
+        }
+        else if (end > base)
+        {
+            outRegions.push_back({base, end - base});
+        }
+    }
+#endif
+}
+
 bool MemoryReader::IsValidAddress(uintptr_t address) const
 {
     return address >= MIN_VALID_ADDRESS && address <= MAX_VALID_ADDRESS;
@@ -113,16 +251,16 @@ std::wstring MemoryValue::ToString() const
     switch (type)
     {
     case ValueType::INT:
-        swprintf_s(buffer, L"%d", data.intValue);
+        swprintf(buffer, 256, L"%d", data.intValue);
         break;
     case ValueType::FLOAT:
-        swprintf_s(buffer, L"%.6f", data.floatValue);
+        swprintf(buffer, 256, L"%.6f", data.floatValue);
         break;
     case ValueType::DOUBLE:
-        swprintf_s(buffer, L"%.15f", data.doubleValue);
+        swprintf(buffer, 256, L"%.15f", data.doubleValue);
         break;
     default:
-        swprintf_s(buffer, L"<unknown type>");
+        swprintf(buffer, 256, L"<unknown type>");
         break;
     }
     return buffer;
@@ -1,8 +1,9 @@
 #pragma once
 
-#include <Windows.h>
+#include "Platform.h"
 #include <cstdint>
 #include <string>
+#include <vector>
 
 // Value types for pointer chain reads
 enum class ValueType
@@ -12,6 +13,14 @@ enum class ValueType
     DOUBLE
 };
 
+// Torn-read validation of a chain's final value, opted into per chain
+enum class TornCheck : uint8_t
+{
+    None,    // Single read
+    Reread,  // Read again until two consecutive reads agree
+    Sequence // Seqlock counter in the value's object: even and unchanged around the read
+};
+
 // Represents a typed value read from memory
 struct MemoryValue
 {
@@ -27,6 +36,15 @@ struct MemoryValue
     std::wstring ToString() const;
 };
 
+// Committed readable address range of a process
+struct MemoryRegion
+{
+    uintptr_t base;
+    uintptr_t size;
+};
+
+class ProcessSnapshot;
+
 // Safe memory reader with validation and error handling
 class MemoryReader
 {
@@ -37,6 +55,10 @@ public:
     void SetProcessHandle(HANDLE processHandle) { m_processHandle = processHandle; }
     HANDLE GetProcessHandle() const { return m_processHandle; }
 
+    // Read from a captured snapshot instead of the process (nullptr = live reads)
+    void SetSnapshot(const ProcessSnapshot *snapshot) { m_snapshot = snapshot; }
+    const ProcessSnapshot *GetSnapshot() const { return m_snapshot; }
+
     // Type-safe read operations with validation
     int32_t ReadInt(uintptr_t address, bool &success);
     float ReadFloat(uintptr_t address, bool &success);
@@ -46,15 +68,26 @@ public:
     // Generic memory read
     bool ReadMemory(uintptr_t address, void *buffer, size_t size);
 
+    // Bulk read of a large range (module images), no validation or logging
+    // Unreadable pages are zero-filled, returns their count and, if given,
+    // appends their indices (from address, in pages) to badPages
+    static size_t ReadRangePadded(HANDLE processHandle, uintptr_t address, void *buffer, size_t size,
+                                  std::vector<uint32_t> *badPages = nullptr);
+
+    // Committed, readable, non-guard regions inside the user-space limits,
+    // sorted, adjacent regions merged; file mappings are skipped
+    static void EnumerateRegions(HANDLE processHandle, std::vector<MemoryRegion> &outRegions, bool writableOnly = false);
+
+    // x64 user-space memory limits
+    static constexpr uintptr_t MIN_VALID_ADDRESS = 0x10000;
+    static constexpr uintptr_t MAX_VALID_ADDRESS = 0x7FFFFFFF0000;
+
     // Address validation
     bool IsValidAddress(uintptr_t address) const;
     void SetLogErrors(bool enabled) { m_logErrors = enabled; }
 
 private:
     HANDLE m_processHandle;
+    const ProcessSnapshot *m_snapshot;
     bool m_logErrors;
-
-    // x64 user-space memory limits
-    static constexpr uintptr_t MIN_VALID_ADDRESS = 0x10000;
-    static constexpr uintptr_t MAX_VALID_ADDRESS = 0x7FFFFFFF0000;
 };
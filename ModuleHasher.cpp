@@ -0,0 +1,132 @@
+#include "ModuleHasher.h"
+#include "XXHash64.h"
+#include "MemoryReader.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+std::vector<ModuleHash> ModuleHasher::HashModules(HANDLE hProcess, const std::vector<ModuleInfo> &modules,
+                                                  unsigned threadCount)
+{
+    std::vector<ModuleHash> results(modules.size());
+    m_lastBytesHashed = 0;
+
+    // One chunk task per MB of every module that is not cached
+    struct ChunkTask
+    {
+        size_t module;
+        size_t chunk;
+    };
+    std::vector<ChunkTask> tasks;
+    std::vector<std::vector<uint64_t>> chunkHashes(modules.size());
+    std::vector<std::atomic<size_t>> unreadable(modules.size());
+
+    std::vector<uint8_t> header(PAGE_SIZE);
+    for (size_t i = 0; i < modules.size(); ++i)
+    {
+        const ModuleInfo &module = modules[i];
+        ModuleHash &result = results[i];
+        result.name = module.name;
+        result.baseAddress = module.baseAddress;
+        result.size = module.size;
+
+        size_t headerSize = (std::min)(PAGE_SIZE, static_cast<size_t>(module.size));
+        MemoryReader::ReadRangePadded(hProcess, module.baseAddress, header.data(), headerSize);
+        result.headerHash = XXHash64::Hash(header.data(), headerSize);
+
+        auto cached = m_cache.find(CacheKey(module.baseAddress, module.size, result.headerHash));
+        if (cached != m_cache.end())
+        {
+            result.contentHash = cached->second.contentHash;
+            result.unreadablePages = cached->second.unreadablePages;
+            result.cached = true;
+            continue;
+        }
+
+        size_t chunkCount = (static_cast<size_t>(module.size) + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        chunkHashes[i].resize(chunkCount);
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            tasks.push_back({i, chunk});
+        }
+        m_lastBytesHashed += module.size;
+    }
+
+    if (!tasks.empty())
+    {
+        if (threadCount == 0)
+            threadCount = (std::max)(1u, std::thread::hardware_concurrency());
+        threadCount = static_cast<unsigned>((std::min)(static_cast<size_t>(threadCount), tasks.size()));
+
+        // Workers pull chunks from a shared counter, big modules spread over all threads
+        std::atomic<size_t> nextTask(0);
+        auto worker = [&]()
+        {
+            std::vector<uint8_t> buffer(CHUNK_SIZE);
+            for (size_t t = nextTask++; t < tasks.size(); t = nextTask++)
+            {
+                const ChunkTask &task = tasks[t];
+                const ModuleInfo &module = modules[task.module];
+                size_t offset = task.chunk * CHUNK_SIZE;
+                size_t length = (std::min)(CHUNK_SIZE, static_cast<size_t>(module.size) - offset);
+
+                size_t unreadablePages = MemoryReader::ReadRangePadded(hProcess, module.baseAddress + offset, buffer.data(), length);
+                chunkHashes[task.module][task.chunk] = XXHash64::Hash(buffer.data(), length, task.chunk);
+                if (unreadablePages != 0)
+                    unreadable[task.module] += unreadablePages;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < threadCount; ++t)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    for (size_t i = 0; i < modules.size(); ++i)
+    {
+        ModuleHash &result = results[i];
+        if (result.cached)
+            continue;
+
+        const std::vector<uint64_t> &hashes = chunkHashes[i];
+        result.contentHash = XXHash64::Hash(hashes.data(), hashes.size() * sizeof(uint64_t), result.size);
+        result.unreadablePages = unreadable[i];
+        m_cache[CacheKey(result.baseAddress, result.size, result.headerHash)] = {result.contentHash, result.unreadablePages};
+    }
+
+    DBG_OK(L"Hashed " + std::to_wstring(modules.size()) + L" modules (" + std::to_wstring(tasks.size()) +
+           L" chunks, " + std::to_wstring(m_lastBytesHashed) + L" bytes read)");
+    return results;
+}
+
+void ModuleHasher::PrintHashes(const std::vector<ModuleHash> &hashes)
+{
+    std::wcout << L"\n=== Module Content Hashes ===\n";
+    std::wcout << std::left << std::setw(35) << L"Module Name"
+               << L" | " << std::setw(16) << L"Content Hash"
+               << L" | " << L"Notes" << std::endl;
+    std::wcout << std::wstring(75, L'-') << std::endl;
+
+    for (const auto &hash : hashes)
+    {
+        std::wcout << std::left << std::setw(35) << hash.name << L" | " << std::right << std::hex << std::uppercase
+                   << std::setfill(L'0') << std::setw(16) << hash.contentHash << std::setfill(L' ') << std::dec
+                   << std::left << L" | ";
+        if (hash.cached)
+            std::wcout << L"cached ";
+        if (hash.unreadablePages != 0)
+            std::wcout << hash.unreadablePages << L" unreadable pages";
+        std::wcout << std::endl;
+    }
+    std::wcout << std::endl;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "ModuleRegistry.h"
+
+// ============================================================================
+// ModuleHasher: Full-content hashes of module images in a target process
+// Purpose: Detect target updates and verify snapshots beyond the PE header
+// - images are read in 1 MB chunks, chunks of all modules are hashed on a
+//   worker pool (XXH64), the module hash is XXH64 over its chunk hashes
+// - pages that cannot be read hash as zeros and are counted
+// - results are cached per (base, size, header page hash), so hashing the
+//   same modules again costs one page read per module
+// ============================================================================
+
+struct ModuleHash
+{
+    std::wstring name;
+    uintptr_t baseAddress = 0;
+    uintptr_t size = 0;
+    uint64_t headerHash = 0;     // XXH64 of the first page (PE headers)
+    uint64_t contentHash = 0;    // XXH64 over the per-chunk hashes
+    size_t unreadablePages = 0;  // Pages hashed as zeros
+    bool cached = false;         // Taken from the cache, image not re-read
+};
+
+class ModuleHasher
+{
+public:
+    static constexpr size_t CHUNK_SIZE = 1 << 20;
+    static constexpr size_t PAGE_SIZE = 0x1000;
+
+    // Hash every module, threadCount 0 = one worker per hardware thread
+    std::vector<ModuleHash> HashModules(HANDLE hProcess, const std::vector<ModuleInfo> &modules,
+                                        unsigned threadCount = 0);
+
+    void ClearCache() { m_cache.clear(); }
+    size_t GetCacheSize() const { return m_cache.size(); }
+
+    // Image bytes read by the last HashModules call (cache misses only)
+    uint64_t GetLastBytesHashed() const { return m_lastBytesHashed; }
+
+    // Print a hash table to console
+    static void PrintHashes(const std::vector<ModuleHash> &hashes);
+
+private:
+    struct CacheEntry
+    {
+        uint64_t contentHash;
+        size_t unreadablePages;
+    };
+
+    // (base, size, header hash)
+    using CacheKey = std::tuple<uintptr_t, uintptr_t, uint64_t>;
+
+    std::map<CacheKey, CacheEntry> m_cache;
+    uint64_t m_lastBytesHashed = 0;
+};
@@ -0,0 +1,461 @@
+#include "ModuleHeaders.h"
+#include "StringUtils.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+// Largest image we lay out in memory (position lists of the xref index are 32-bit)
+static const uint64_t MAX_IMAGE_SIZE = 0xFFFFFFFFull;
+
+// Bounds-checked little-endian field read from a header buffer
+template <typename T>
+static bool ReadField(const uint8_t *data, size_t size, uint64_t offset, T &out)
+{
+    if (offset > size || size - offset < sizeof(T))
+        return false;
+    memcpy(&out, data + offset, sizeof(T));
+    return true;
+}
+
+// Section and symbol names are ASCII in practice, bytes are widened as is
+static std::wstring WidenName(const char *name, size_t maxLength)
+{
+    size_t length = strnlen(name, maxLength);
+    return StringUtils::Utf8ToWide(name, length);
+}
+
+bool ModuleHeaders::ParsePe(const uint8_t *data, size_t size)
+{
+    Clear();
+
+    uint16_t magic;
+    int32_t peOffset;
+    uint32_t signature;
+    if (!ReadField(data, size, 0, magic) || magic != 0x5A4D || !ReadField(data, size, 0x3C, peOffset) ||
+        peOffset <= 0 || !ReadField(data, size, peOffset, signature) || signature != 0x00004550)
+        return false;
+
+    // IMAGE_FILE_HEADER follows the signature, the optional header follows that
+    uint64_t fileHeader = static_cast<uint64_t>(peOffset) + 4;
+    uint16_t sectionCount;
+    uint32_t timeDateStamp;
+    uint16_t optionalHeaderSize;
+    uint16_t optionalMagic;
+    uint32_t sizeOfImage;
+    if (!ReadField(data, size, fileHeader + 2, sectionCount) || !ReadField(data, size, fileHeader + 4, timeDateStamp) ||
+        !ReadField(data, size, fileHeader + 16, optionalHeaderSize) ||
+        !ReadField(data, size, fileHeader + 20, optionalMagic))
+        return false;
+
+    uint64_t optionalHeader = fileHeader + 20;
+    if (!ReadField(data, size, optionalHeader + 56, sizeOfImage))
+        return false;
+
+    // PE32+ and PE32 differ in ImageBase width, which shifts the data directories
+    uint64_t dataDirectoryCount;
+    uint64_t dataDirectories;
+    if (optionalMagic == 0x20B)
+    {
+        ReadField(data, size, optionalHeader + 24, m_preferredBase);
+        dataDirectoryCount = optionalHeader + 108;
+        dataDirectories = optionalHeader + 112;
+    }
+    else
+    {
+        uint32_t imageBase32 = 0;
+        ReadField(data, size, optionalHeader + 28, imageBase32);
+        m_preferredBase = imageBase32;
+        dataDirectoryCount = optionalHeader + 92;
+        dataDirectories = optionalHeader + 96;
+    }
+
+    uint32_t directoryCount = 0;
+    if (ReadField(data, size, dataDirectoryCount, directoryCount) && directoryCount > 0)
+    {
+        ReadField(data, size, dataDirectories, m_exportRva);
+        ReadField(data, size, dataDirectories + 4, m_exportSize);
+    }
+
+    // The export size sizes one bulk read of the target, keep it inside the image
+    if (m_exportRva >= sizeOfImage)
+    {
+        if (m_exportRva != 0 || m_exportSize != 0)
+            DBG_WARN(L"PE export directory outside the image, ignored");
+        m_exportRva = 0;
+        m_exportSize = 0;
+    }
+    else
+    {
+        m_exportSize = (std::min)(m_exportSize, sizeOfImage - m_exportRva);
+    }
+
+    // IMAGE_SECTION_HEADER: Name[8], VirtualSize, VirtualAddress, SizeOfRawData, ..., Characteristics at 36
+    uint64_t sectionTable = optionalHeader + optionalHeaderSize;
+    for (uint16_t i = 0; i < sectionCount; ++i)
+    {
+        uint64_t header = sectionTable + i * 40ull;
+        char name[8];
+        uint32_t virtualSize, virtualAddress, rawSize, characteristics;
+        if (!ReadField(data, size, header, name) || !ReadField(data, size, header + 8, virtualSize) ||
+            !ReadField(data, size, header + 12, virtualAddress) || !ReadField(data, size, header + 16, rawSize) ||
+            !ReadField(data, size, header + 36, characteristics))
+        {
+            DBG_WARN(L"PE section table truncated after " + std::to_wstring(i) + L" of " +
+                     std::to_wstring(sectionCount) + L" sections");
+            break;
+        }
+
+        ImageSection section;
+        section.name = WidenName(name, sizeof(name));
+        section.rva = virtualAddress;
+        section.size = virtualSize != 0 ? virtualSize : rawSize;
+        section.readable = (characteristics & 0x40000000) != 0;                  // MEM_READ
+        section.writable = (characteristics & 0x80000000) != 0;                  // MEM_WRITE
+        section.executable = (characteristics & (0x20000000 | 0x00000020)) != 0; // MEM_EXECUTE | CNT_CODE
+        if (section.rva >= sizeOfImage)
+            continue;
+        section.size = (std::min)(section.size, static_cast<uintptr_t>(sizeOfImage - section.rva));
+        m_sections.push_back(section);
+    }
+
+    m_fingerprint = (static_cast<uint64_t>(timeDateStamp) << 32) | sizeOfImage;
+    m_imageSize = sizeOfImage;
+    m_format = ImageFormat::PE;
+    m_symbolsLoaded = m_exportRva == 0 || m_exportSize == 0;
+    return true;
+}
+
+bool ModuleHeaders::ParseElf(const uint8_t *file, size_t size)
+{
+    Clear();
+
+    // ELF64 little-endian only
+    if (size < 64 || memcmp(file, "\x7F" "ELF", 4) != 0 || file[4] != 2 || file[5] != 1)
+        return false;
+
+    uint64_t programHeaders, sectionHeaders;
+    uint16_t programEntrySize, programCount, sectionEntrySize, sectionCount, nameSection;
+    if (!ReadField(file, size, 32, programHeaders) || !ReadField(file, size, 40, sectionHeaders) ||
+        !ReadField(file, size, 54, programEntrySize) || !ReadField(file, size, 56, programCount) ||
+        !ReadField(file, size, 58, sectionEntrySize) || !ReadField(file, size, 60, sectionCount) ||
+        !ReadField(file, size, 62, nameSection))
+        return false;
+
+    // Elf64_Phdr: p_type, p_flags, p_offset, p_vaddr, p_paddr, p_filesz, p_memsz
+    std::vector<uint64_t> vaddrs;
+    uint64_t low = UINT64_MAX;
+    uint64_t high = 0;
+    for (uint16_t i = 0; i < programCount; ++i)
+    {
+        uint64_t header = programHeaders + static_cast<uint64_t>(i) * programEntrySize;
+        uint32_t type, flags;
+        uint64_t vaddr;
+        ImageSegment segment;
+        if (!ReadField(file, size, header, type) || !ReadField(file, size, header + 4, flags) ||
+            !ReadField(file, size, header + 8, segment.fileOffset) || !ReadField(file, size, header + 16, vaddr) ||
+            !ReadField(file, size, header + 32, segment.fileSize) || !ReadField(file, size, header + 40, segment.memorySize))
+            return false;
+        if (type != 1) // PT_LOAD
+            continue;
+
+        segment.executable = (flags & 0x1) != 0; // PF_X
+        m_segments.push_back(segment);
+        vaddrs.push_back(vaddr);
+        low = (std::min)(low, vaddr & ~static_cast<uint64_t>(0xFFF));
+        high = (std::max)(high, vaddr + segment.memorySize);
+    }
+    if (m_segments.empty() || high <= low || high - low > MAX_IMAGE_SIZE)
+    {
+        m_segments.clear();
+        return false;
+    }
+
+    for (size_t i = 0; i < m_segments.size(); ++i)
+    {
+        m_segments[i].rva = static_cast<uintptr_t>(vaddrs[i] - low);
+    }
+    m_preferredBase = low;
+    m_imageSize = high - low;
+
+    // Elf64_Shdr: sh_name, sh_type, sh_flags, sh_addr, sh_offset, sh_size, sh_link
+    uint64_t namesOffset = 0;
+    uint64_t namesSize = 0;
+    if (nameSection < sectionCount)
+    {
+        uint64_t header = sectionHeaders + static_cast<uint64_t>(nameSection) * sectionEntrySize;
+        ReadField(file, size, header + 24, namesOffset);
+        ReadField(file, size, header + 32, namesSize);
+        if (namesOffset > size || size - namesOffset < namesSize)
+            namesSize = 0;
+    }
+
+    for (uint16_t i = 0; i < sectionCount; ++i)
+    {
+        uint64_t header = sectionHeaders + static_cast<uint64_t>(i) * sectionEntrySize;
+        uint32_t nameIndex, type, link;
+        uint64_t flags, address, sectionSize;
+        if (!ReadField(file, size, header, nameIndex) || !ReadField(file, size, header + 4, type) ||
+            !ReadField(file, size, header + 8, flags) || !ReadField(file, size, header + 16, address) ||
+            !ReadField(file, size, header + 32, sectionSize) || !ReadField(file, size, header + 40, link))
+            break;
+
+        if ((type == 2 || type == 11) && link < sectionCount) // SHT_SYMTAB, SHT_DYNSYM
+        {
+            uint64_t linkHeader = sectionHeaders + static_cast<uint64_t>(link) * sectionEntrySize;
+            ParseElfSymbols(file, size, header, linkHeader);
+        }
+
+        if (!(flags & 0x2) || address < low || address >= high) // SHF_ALLOC, inside the image
+            continue;
+
+        ImageSection section;
+        if (nameIndex < namesSize)
+            section.name = WidenName(reinterpret_cast<const char *>(file + namesOffset + nameIndex),
+                                     static_cast<size_t>(namesSize - nameIndex));
+        section.rva = static_cast<uintptr_t>(address - low);
+        section.size = static_cast<uintptr_t>((std::min)(sectionSize, high - address));
+        section.readable = true;
+        section.writable = (flags & 0x1) != 0;   // SHF_WRITE
+        section.executable = (flags & 0x4) != 0; // SHF_EXECINSTR
+        m_sections.push_back(section);
+    }
+
+    // Stripped section headers: the segments are the sections
+    if (m_sections.empty())
+    {
+        for (size_t i = 0; i < m_segments.size(); ++i)
+        {
+            ImageSection section;
+            section.name = L"LOAD" + std::to_wstring(i);
+            section.rva = m_segments[i].rva;
+            section.size = static_cast<uintptr_t>(m_segments[i].memorySize);
+            section.readable = true;
+            section.executable = m_segments[i].executable;
+            m_sections.push_back(section);
+        }
+    }
+
+    IndexSymbols();
+    m_symbolsLoaded = true;
+    m_format = ImageFormat::ELF;
+    return true;
+}
+
+void ModuleHeaders::ParseElfSymbols(const uint8_t *file, size_t size, uint64_t sectionHeader, uint64_t linkHeader)
+{
+    uint64_t tableOffset, tableSize, stringsOffset, stringsSize;
+    if (!ReadField(file, size, sectionHeader + 24, tableOffset) || !ReadField(file, size, sectionHeader + 32, tableSize) ||
+        !ReadField(file, size, linkHeader + 24, stringsOffset) || !ReadField(file, size, linkHeader + 32, stringsSize) ||
+        tableOffset > size || size - tableOffset < tableSize || stringsOffset > size || size - stringsOffset < stringsSize)
+        return;
+
+    // Elf64_Sym: st_name, st_info, st_other, st_shndx, st_value, st_size (24 bytes)
+    const uint8_t *table = file + tableOffset;
+    const char *strings = reinterpret_cast<const char *>(file + stringsOffset);
+    for (uint64_t offset = 0; offset + 24 <= tableSize; offset += 24)
+    {
+        uint32_t nameIndex;
+        uint16_t sectionIndex;
+        uint64_t value;
+        memcpy(&nameIndex, table + offset, sizeof(nameIndex));
+        memcpy(&sectionIndex, table + offset + 6, sizeof(sectionIndex));
+        memcpy(&value, table + offset + 8, sizeof(value));
+        uint8_t type = table[offset + 4] & 0xF;
+
+        // Defined objects, functions and IFUNC resolvers inside the image
+        if ((type != 1 && type != 2 && type != 10) || sectionIndex == 0 || nameIndex == 0 || nameIndex >= stringsSize ||
+            value < m_preferredBase || value - m_preferredBase >= m_imageSize)
+            continue;
+
+        ModuleSymbol symbol;
+        symbol.name = WidenName(strings + nameIndex, static_cast<size_t>(stringsSize - nameIndex));
+        symbol.rva = static_cast<uintptr_t>(value - m_preferredBase);
+        m_symbols.push_back(std::move(symbol));
+    }
+}
+
+bool ModuleHeaders::LoadExports(const uint8_t *image, size_t size)
+{
+    if (m_symbolsLoaded)
+        return true;
+    if (m_format != ImageFormat::PE)
+        return false;
+
+    ParseExportDirectory(image, size, 0);
+    m_symbolsLoaded = true;
+    return true;
+}
+
+void ModuleHeaders::ParseExportDirectory(const uint8_t *data, size_t size, uint32_t dataRva)
+{
+    // An RVA inside data, as an offset into data
+    auto local = [dataRva, size](uint32_t rva, uint64_t length, uint64_t &outOffset)
+    {
+        if (rva < dataRva || rva - dataRva > size || size - (rva - dataRva) < length)
+            return false;
+        outOffset = rva - dataRva;
+        return true;
+    };
+
+    // IMAGE_EXPORT_DIRECTORY: NumberOfFunctions at 20, NumberOfNames at 24, then the three array RVAs
+    uint64_t directory;
+    uint32_t functionCount, nameCount, functionsRva, namesRva, ordinalsRva;
+    if (!local(m_exportRva, 40, directory) || !ReadField(data, size, directory + 20, functionCount) ||
+        !ReadField(data, size, directory + 24, nameCount) || !ReadField(data, size, directory + 28, functionsRva) ||
+        !ReadField(data, size, directory + 32, namesRva) || !ReadField(data, size, directory + 36, ordinalsRva))
+    {
+        DBG_WARN(L"Export directory is out of range");
+        return;
+    }
+
+    uint64_t functions, names, ordinals;
+    if (!local(functionsRva, functionCount * 4ull, functions) || !local(namesRva, nameCount * 4ull, names) ||
+        !local(ordinalsRva, nameCount * 2ull, ordinals))
+    {
+        DBG_WARN(L"Export arrays lie outside the export directory");
+        return;
+    }
+
+    size_t skipped = 0;
+    m_symbols.reserve(nameCount);
+    for (uint32_t i = 0; i < nameCount; ++i)
+    {
+        uint32_t nameRva, functionRva;
+        uint16_t ordinal;
+        uint64_t nameOffset;
+        memcpy(&nameRva, data + names + i * 4ull, sizeof(nameRva));
+        memcpy(&ordinal, data + ordinals + i * 2ull, sizeof(ordinal));
+        if (ordinal >= functionCount || !local(nameRva, 1, nameOffset))
+        {
+            skipped++;
+            continue;
+        }
+        memcpy(&functionRva, data + functions + ordinal * 4ull, sizeof(functionRva));
+
+        // Forwarders point back into the export directory ("OTHER.Function")
+        if (functionRva == 0 || (functionRva >= m_exportRva && functionRva - m_exportRva < m_exportSize))
+            continue;
+
+        ModuleSymbol symbol;
+        symbol.name = WidenName(reinterpret_cast<const char *>(data + nameOffset), static_cast<size_t>(size - nameOffset));
+        symbol.rva = functionRva;
+        m_symbols.push_back(std::move(symbol));
+    }
+
+    if (skipped != 0)
+    {
+        DBG_WARN(std::to_wstring(skipped) + L" exports with names outside the export directory skipped");
+    }
+    IndexSymbols();
+}
+
+void ModuleHeaders::IndexSymbols()
+{
+    std::stable_sort(m_symbols.begin(), m_symbols.end(), [](const ModuleSymbol &a, const ModuleSymbol &b)
+                     { return a.name < b.name; });
+    m_symbols.erase(std::unique(m_symbols.begin(), m_symbols.end(), [](const ModuleSymbol &a, const ModuleSymbol &b)
+                                { return a.name == b.name; }),
+                    m_symbols.end());
+
+    m_symbolsByRva.resize(m_symbols.size());
+    for (uint32_t i = 0; i < m_symbolsByRva.size(); ++i)
+    {
+        m_symbolsByRva[i] = i;
+    }
+    std::sort(m_symbolsByRva.begin(), m_symbolsByRva.end(), [this](uint32_t a, uint32_t b)
+              { return m_symbols[a].rva < m_symbols[b].rva; });
+}
+
+void ModuleHeaders::Clear()
+{
+    m_format = ImageFormat::Unknown;
+    m_fingerprint = 0;
+    m_preferredBase = 0;
+    m_imageSize = 0;
+    m_sections.clear();
+    m_segments.clear();
+    m_exportRva = 0;
+    m_exportSize = 0;
+    m_symbolsLoaded = false;
+    m_symbols.clear();
+    m_symbolsByRva.clear();
+}
+
+const ImageSection *ModuleHeaders::FindSection(const std::wstring &name) const
+{
+    for (const ImageSection &section : m_sections)
+    {
+        if (section.name == name)
+            return &section;
+    }
+    return nullptr;
+}
+
+const ImageSection *ModuleHeaders::FindSectionByRva(uintptr_t rva) const
+{
+    for (const ImageSection &section : m_sections)
+    {
+        if (rva >= section.rva && rva - section.rva < section.size)
+            return &section;
+    }
+    return nullptr;
+}
+
+bool ModuleHeaders::FindSymbol(const std::wstring &name, uintptr_t &outRva) const
+{
+    auto it = std::lower_bound(m_symbols.begin(), m_symbols.end(), name, [](const ModuleSymbol &symbol, const std::wstring &value)
+                               { return symbol.name < value; });
+    if (it == m_symbols.end() || it->name != name)
+        return false;
+
+    outRva = it->rva;
+    return true;
+}
+
+const ModuleSymbol *ModuleHeaders::FindNearestSymbol(uintptr_t rva) const
+{
+    auto it = std::upper_bound(m_symbolsByRva.begin(), m_symbolsByRva.end(), rva, [this](uintptr_t value, uint32_t index)
+                               { return value < m_symbols[index].rva; });
+    if (it == m_symbolsByRva.begin())
+        return nullptr;
+    return &m_symbols[*(it - 1)];
+}
+
+void ModuleHeaders::PrintSections(const std::wstring &moduleName) const
+{
+    std::wcout << L"\n=== Sections of " << moduleName << L" ===\n";
+    std::wcout << std::left << std::setw(20) << L"Name"
+               << L" | " << std::setw(12) << L"RVA"
+               << L" | " << std::setw(12) << L"Size"
+               << L" | " << L"Access" << std::endl;
+    std::wcout << std::wstring(60, L'-') << std::endl;
+
+    for (const auto &section : m_sections)
+    {
+        std::wcout << std::left << std::setw(20) << section.name << L" | 0x" << std::hex << std::uppercase
+                   << std::setw(10) << section.rva << L" | 0x" << std::setw(10) << section.size << std::dec
+                   << L" | " << (section.readable ? L'r' : L'-') << (section.writable ? L'w' : L'-')
+                   << (section.executable ? L'x' : L'-') << std::endl;
+    }
+    std::wcout << std::endl;
+}
+
+void ModuleHeaders::PrintSymbols(const std::wstring &moduleName, const std::wstring &filter) const
+{
+    std::wcout << L"\n=== Symbols of " << moduleName << L" ===\n";
+
+    size_t shown = 0;
+    for (uint32_t index : m_symbolsByRva)
+    {
+        const ModuleSymbol &symbol = m_symbols[index];
+        if (!filter.empty() && symbol.name.find(filter) == std::wstring::npos)
+            continue;
+
+        std::wcout << L"  0x" << std::hex << std::uppercase << std::setw(10) << std::left << symbol.rva << std::dec
+                   << L" " << symbol.name << std::endl;
+        shown++;
+    }
+    std::wcout << L"[+] " << shown << L" of " << m_symbols.size() << L" symbols shown.\n" << std::endl;
+}
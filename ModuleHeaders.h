@@ -0,0 +1,136 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class MemoryReader;
+
+// ============================================================================
+// ModuleHeaders: Parsed PE/ELF headers of one module
+// Purpose: Sections with permissions and exported symbols, parsed once and
+// cached per module (ModuleRegistry::GetHeaders), so scans can be limited to
+// a section and offsets can be stored as symbol+delta
+// - PE, loaded module: one bulk read of the header page, the export table is
+//   read in one more piece on the first symbol lookup (ModuleImageProcess.cpp)
+// - PE, image in memory: headers and exports parsed in place
+// - ELF64 file: PT_LOAD segments, section headers, .dynsym and .symtab
+// All addresses are RVAs (ELF: relative to the lowest PT_LOAD vaddr)
+// ============================================================================
+
+struct ImageSection
+{
+    std::wstring name;      // ".text", ".rdata", ... (segment index if unnamed)
+    uintptr_t rva = 0;      // Start, relative to the image base
+    uintptr_t size = 0;     // Size in memory
+    bool readable = false;
+    bool writable = false;
+    bool executable = false;
+};
+
+// ELF PT_LOAD segment: file range placed at rva
+struct ImageSegment
+{
+    uint64_t fileOffset = 0;
+    uint64_t fileSize = 0;
+    uintptr_t rva = 0;
+    uint64_t memorySize = 0;
+    bool executable = false;
+};
+
+struct ModuleSymbol
+{
+    std::wstring name;
+    uintptr_t rva = 0;
+};
+
+enum class ImageFormat
+{
+    Unknown,
+    PE,
+    ELF
+};
+
+class ModuleHeaders
+{
+public:
+    // Bytes read from a module base by ReadFromProcess (DOS, NT and section headers)
+    static constexpr size_t HEADER_READ_SIZE = 0x1000;
+
+    // Read the header page of a loaded PE module and parse it
+    bool ReadFromProcess(MemoryReader &reader, uintptr_t baseAddress, uintptr_t moduleSize);
+
+    // Parse PE headers at the start of data (a header page or a whole image)
+    bool ParsePe(const uint8_t *data, size_t size);
+
+    // Parse an ELF64 little-endian file, symbols are loaded with it
+    bool ParseElf(const uint8_t *file, size_t size);
+
+    // Export table of a loaded PE module, read in one piece (no-op once loaded)
+    bool LoadExports(MemoryReader &reader, uintptr_t baseAddress);
+
+    // Export table of a PE image laid out in memory (data covers the image)
+    bool LoadExports(const uint8_t *image, size_t size);
+
+    void Clear();
+
+    bool IsValid() const { return m_format != ImageFormat::Unknown; }
+    ImageFormat GetFormat() const { return m_format; }
+
+    // PE: (TimeDateStamp << 32) | SizeOfImage, ELF: 0
+    uint64_t GetFingerprint() const { return m_fingerprint; }
+
+    // Link-time base: ImageBase of a PE, lowest PT_LOAD vaddr of an ELF
+    uint64_t GetPreferredBase() const { return m_preferredBase; }
+
+    // SizeOfImage of a PE, extent of the PT_LOAD segments of an ELF
+    uint64_t GetImageSize() const { return m_imageSize; }
+
+    const std::vector<ImageSection> &GetSections() const { return m_sections; }
+    const std::vector<ImageSegment> &GetSegments() const { return m_segments; }
+
+    // First section with this name (case-sensitive, ".text"), nullptr if none
+    const ImageSection *FindSection(const std::wstring &name) const;
+
+    // Section containing rva, nullptr if none
+    const ImageSection *FindSectionByRva(uintptr_t rva) const;
+
+    // True once the symbols were loaded (an image without exports has none)
+    bool HasSymbols() const { return m_symbolsLoaded; }
+
+    // Symbols sorted by name
+    const std::vector<ModuleSymbol> &GetSymbols() const { return m_symbols; }
+
+    // RVA of a symbol by exact name
+    bool FindSymbol(const std::wstring &name, uintptr_t &outRva) const;
+
+    // Closest symbol at or below rva, nullptr if none
+    const ModuleSymbol *FindNearestSymbol(uintptr_t rva) const;
+
+    // Print the section table / symbols containing filter (empty = all) to console
+    void PrintSections(const std::wstring &moduleName) const;
+    void PrintSymbols(const std::wstring &moduleName, const std::wstring &filter) const;
+
+private:
+    ImageFormat m_format = ImageFormat::Unknown;
+    uint64_t m_fingerprint = 0;
+    uint64_t m_preferredBase = 0;
+    uint64_t m_imageSize = 0;
+    std::vector<ImageSection> m_sections;
+    std::vector<ImageSegment> m_segments;
+
+    uint32_t m_exportRva = 0;  // PE export data directory
+    uint32_t m_exportSize = 0;
+    bool m_symbolsLoaded = false;
+    std::vector<ModuleSymbol> m_symbols;   // Sorted by name
+    std::vector<uint32_t> m_symbolsByRva;  // Indices into m_symbols, sorted by rva
+
+    // Parse the export directory, data holds the image bytes [dataRva, dataRva + size)
+    void ParseExportDirectory(const uint8_t *data, size_t size, uint32_t dataRva);
+
+    // Append the defined function/object symbols of an ELF symbol table section
+    void ParseElfSymbols(const uint8_t *file, size_t size, uint64_t sectionHeader, uint64_t linkHeader);
+
+    // Sort by name, drop duplicate names, build the rva order
+    void IndexSymbols();
+};
@@ -0,0 +1,106 @@
+#include "ModuleImage.h"
+#include "MappedFile.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+bool ModuleImage::LoadFromFile(const std::wstring &filename)
+{
+    Clear();
+
+    MappedFile file;
+    if (!file.Open(filename))
+    {
+        std::wcerr << L"[-] Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    size_t slash = filename.find_last_of(L"\\/");
+    std::wstring name = slash == std::wstring::npos ? filename : filename.substr(slash + 1);
+
+    const uint8_t *data = file.Data();
+    size_t size = file.Size();
+    if (size >= 4 && memcmp(data, "\x7F" "ELF", 4) == 0)
+    {
+        m_name = name;
+        if (!LoadElf(data, size))
+        {
+            std::wcerr << L"[-] Unsupported or malformed ELF file: " << filename << std::endl;
+            Clear();
+            return false;
+        }
+        return true;
+    }
+
+    if (!LoadFromMemory(name, data, size))
+    {
+        std::wcerr << L"[-] Not a captured module image or ELF64 file: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool ModuleImage::LoadFromMemory(const std::wstring &name, const uint8_t *data, size_t size)
+{
+    Clear();
+    m_name = name;
+    m_image.assign(data, data + size);
+    if (!ParsePeHeaders())
+    {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+void ModuleImage::Clear()
+{
+    m_name.clear();
+    m_headers.Clear();
+    m_image.clear();
+    m_image.shrink_to_fit();
+    m_sections.clear();
+}
+
+bool ModuleImage::ParsePeHeaders()
+{
+    if (!m_headers.ParsePe(m_image.data(), m_image.size()))
+        return false;
+
+    // A captured image may be shorter than SizeOfImage
+    for (const ImageSection &section : m_headers.GetSections())
+    {
+        if (section.rva >= m_image.size())
+            continue;
+        m_sections.push_back(section);
+        m_sections.back().size = (std::min)(section.size, static_cast<uintptr_t>(m_image.size() - section.rva));
+    }
+    m_headers.LoadExports(m_image.data(), m_image.size());
+
+    DBG_OK(m_name + L": PE image, " + std::to_wstring(m_sections.size()) + L" sections, " +
+           std::to_wstring(m_headers.GetSymbols().size()) + L" exports");
+    return true;
+}
+
+bool ModuleImage::LoadElf(const uint8_t *file, size_t size)
+{
+    if (!m_headers.ParseElf(file, size))
+        return false;
+
+    m_image.assign(static_cast<size_t>(m_headers.GetImageSize()), 0);
+    for (const ImageSegment &segment : m_headers.GetSegments())
+    {
+        if (segment.fileOffset > size)
+            continue;
+        uint64_t length = (std::min)(segment.fileSize, static_cast<uint64_t>(size - segment.fileOffset));
+        length = (std::min)(length, segment.memorySize);
+        memcpy(&m_image[segment.rva], file + segment.fileOffset, static_cast<size_t>(length));
+    }
+    m_sections = m_headers.GetSections();
+
+    DBG_OK(m_name + L": ELF image, " + std::to_wstring(m_image.size()) + L" bytes, " +
+           std::to_wstring(m_sections.size()) + L" sections, " + std::to_wstring(m_headers.GetSymbols().size()) +
+           L" symbols");
+    return true;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ModuleHeaders.h"
+
+class MemoryReader;
+struct ModuleInfo;
+
+// ============================================================================
+// ModuleImage: In-memory copy of a module laid out by RVA, with its sections
+// Purpose: Offline code analysis (xrefs) on live modules, captured images and
+// ELF binaries alike
+// - live module: one bulk ReadProcessMemory of SizeOfImage
+//   (ModuleImageProcess.cpp, the only part that needs a process)
+// - captured image file ("MZ"): a module image dumped from memory, used as is
+// - ELF64 file: PT_LOAD segments placed at (vaddr - lowest vaddr)
+// Sections and symbols come from ModuleHeaders
+// Offsets in this image are module-relative, the same as OffsetEntry offsets
+// ============================================================================
+
+class ModuleImage
+{
+public:
+    // Read a module of the target process (unreadable pages become zeros)
+    bool LoadFromProcess(MemoryReader &reader, const ModuleInfo &module);
+
+    // Load a captured PE image or an ELF64 binary, detected by content
+    bool LoadFromFile(const std::wstring &filename);
+
+    // Use a PE image already in memory (copied)
+    bool LoadFromMemory(const std::wstring &name, const uint8_t *data, size_t size);
+
+    void Clear();
+
+    const std::wstring &GetName() const { return m_name; }
+    ImageFormat GetFormat() const { return m_headers.GetFormat(); }
+    const uint8_t *Data() const { return m_image.data(); }
+    size_t Size() const { return m_image.size(); }
+    const std::vector<ImageSection> &GetSections() const { return m_sections; }
+
+    // Parsed headers, exports/symbols included
+    const ModuleHeaders &GetHeaders() const { return m_headers; }
+
+    // Link-time base: ImageBase of a PE, lowest PT_LOAD vaddr of an ELF
+    uint64_t GetPreferredBase() const { return m_headers.GetPreferredBase(); }
+
+    // Print the section table to console
+    void PrintSections() const { m_headers.PrintSections(m_name); }
+
+private:
+    std::wstring m_name;
+    ModuleHeaders m_headers;
+    std::vector<uint8_t> m_image;
+    std::vector<ImageSection> m_sections; // Clipped to m_image
+
+    // Headers, sections and exports from the PE image in m_image
+    bool ParsePeHeaders();
+
+    // Build m_image from the PT_LOAD segments of an ELF64 file
+    bool LoadElf(const uint8_t *file, size_t size);
+};
@@ -0,0 +1,66 @@
+#include "ModuleImage.h"
+#include "MemoryReader.h"
+#include "ModuleRegistry.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <iostream>
+
+// Loaders that read a live module; the file/image parsers in ModuleImage.cpp
+// and ModuleHeaders.cpp do not depend on a process and build everywhere
+
+bool ModuleHeaders::ReadFromProcess(MemoryReader &reader, uintptr_t baseAddress, uintptr_t moduleSize)
+{
+    Clear();
+
+    std::vector<uint8_t> page((std::min)(HEADER_READ_SIZE, static_cast<size_t>(moduleSize)));
+    if (page.empty() || !reader.ReadMemory(baseAddress, page.data(), page.size()))
+        return false;
+    return ParsePe(page.data(), page.size());
+}
+
+bool ModuleHeaders::LoadExports(MemoryReader &reader, uintptr_t baseAddress)
+{
+    if (m_symbolsLoaded)
+        return true;
+    if (m_format != ImageFormat::PE)
+        return false;
+
+    // The directory, its three arrays and the names normally lie inside the export directory range
+    std::vector<uint8_t> exportData(m_exportSize);
+    size_t unreadablePages = MemoryReader::ReadRangePadded(reader.GetProcessHandle(), baseAddress + m_exportRva,
+                                                           exportData.data(), exportData.size());
+    if (unreadablePages != 0)
+    {
+        DBG_WARN(L"Export table: " + std::to_wstring(unreadablePages) + L" unreadable pages read as zeros");
+    }
+
+    ParseExportDirectory(exportData.data(), exportData.size(), m_exportRva);
+    m_symbolsLoaded = true;
+    return true;
+}
+
+bool ModuleImage::LoadFromProcess(MemoryReader &reader, const ModuleInfo &module)
+{
+    Clear();
+
+    // Positions in the xref index are 32-bit
+    if (module.size == 0 || module.size > 0xFFFFFFFFu)
+        return false;
+
+    m_name = module.name;
+    m_image.resize(static_cast<size_t>(module.size));
+    size_t unreadablePages = MemoryReader::ReadRangePadded(reader.GetProcessHandle(), module.baseAddress,
+                                                           m_image.data(), m_image.size());
+    if (unreadablePages != 0)
+    {
+        DBG_WARN(module.name + L": " + std::to_wstring(unreadablePages) + L" unreadable pages read as zeros");
+    }
+
+    if (!ParsePeHeaders())
+    {
+        std::wcerr << L"[-] No valid PE headers in module: " << module.name << std::endl;
+        Clear();
+        return false;
+    }
+    return true;
+}
@@ -1,8 +1,19 @@
 #include "ModuleRegistry.h"
+#include "MemoryReader.h"
 #include "DebugLog.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cwctype>
+#ifdef _WIN32
+#include <tlhelp32.h>
+#else
+#include <fstream>
+#include "StringUtils.h"
+#endif
 
 ModuleRegistry::ModuleRegistry()
     : m_pid(0), m_isLoaded(false)
@@ -15,6 +26,7 @@ bool ModuleRegistry::LoadModules(DWORD pid)
     Clear();
     m_pid = pid;
 
+#ifdef _WIN32
     HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32, pid);
 
     if (hSnapshot == INVALID_HANDLE_VALUE)
@@ -50,6 +62,55 @@ bool ModuleRegistry::LoadModules(DWORD pid)
     }
 
     CloseHandle(hSnapshot);
+#else
+    // /proc/<pid>/maps lists every mapping of a file separately: the module
+    // spans from its first mapping to the end of its last one
+    std::ifstream maps("/proc/" + std::to_string(pid) + "/maps");
+    if (!maps.is_open())
+    {
+        DBG_ERR(L"Cannot open /proc/" + std::to_wstring(pid) + L"/maps");
+        std::wcerr << L"[-] Failed to read the module list of process " << pid << std::endl;
+        return false;
+    }
+
+    std::map<std::string, size_t> byPath;
+    std::string line;
+    while (std::getline(maps, line))
+    {
+        unsigned long long start = 0;
+        unsigned long long stop = 0;
+        int pathAt = 0;
+        if (sscanf(line.c_str(), "%llx-%llx %*s %*s %*s %*s %n", &start, &stop, &pathAt) < 2 || pathAt <= 0 ||
+            line[pathAt] != '/')
+            continue;
+
+        const std::string path = line.substr(pathAt);
+        auto it = byPath.find(path);
+        if (it != byPath.end())
+        {
+            ModuleInfo &info = m_modules[it->second];
+            info.size = (std::max)(info.size, static_cast<uintptr_t>(stop) - info.baseAddress);
+            continue;
+        }
+
+        const std::string name = path.substr(path.rfind('/') + 1);
+        ModuleInfo info;
+        info.name = StringUtils::Utf8ToWide(name.data(), name.size());
+        info.baseAddress = static_cast<uintptr_t>(start);
+        info.size = static_cast<uintptr_t>(stop - start);
+        byPath[path] = m_modules.size();
+        m_modules.push_back(info);
+    }
+
+    for (const ModuleInfo &info : m_modules)
+    {
+        DBG_MODULE(info.name, info.baseAddress, info.size);
+        std::wstring lowerName = info.name;
+        std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::towlower);
+        m_moduleMap[lowerName] = info;
+    }
+#endif
+
     m_isLoaded = !m_modules.empty();
 
     if (m_isLoaded)
@@ -101,10 +162,115 @@ uintptr_t ModuleRegistry::GetModuleBase(const std::wstring &moduleName) const
     return 0;
 }
 
+const ModuleHeaders *ModuleRegistry::GetHeaders(const std::wstring &moduleName, MemoryReader &reader, bool withSymbols) const
+{
+    std::wstring lowerName = moduleName;
+    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::towlower);
+
+    auto module = m_moduleMap.find(lowerName);
+    if (module == m_moduleMap.end())
+        return nullptr;
+
+    // Failed parses are cached too, a module without headers is not re-read
+    auto it = m_headers.find(lowerName);
+    if (it == m_headers.end())
+    {
+        it = m_headers.emplace(lowerName, ModuleHeaders()).first;
+        if (!it->second.ReadFromProcess(reader, module->second.baseAddress, module->second.size))
+        {
+            DBG_WARN(L"No PE headers in module: " + module->second.name);
+        }
+    }
+
+    ModuleHeaders &headers = it->second;
+    if (!headers.IsValid())
+        return nullptr;
+    if (withSymbols && !headers.HasSymbols())
+    {
+        headers.LoadExports(reader, module->second.baseAddress);
+        DBG_OK(module->second.name + L": " + std::to_wstring(headers.GetSymbols().size()) + L" exports loaded");
+    }
+    return &headers;
+}
+
+bool ModuleRegistry::FindSymbol(const std::wstring &moduleName, const std::wstring &symbol, MemoryReader &reader,
+                                uintptr_t &outRva) const
+{
+    const ModuleHeaders *headers = GetHeaders(moduleName, reader, true);
+    return headers != nullptr && headers->FindSymbol(symbol, outRva);
+}
+
+size_t ModuleRegistry::ReadFingerprints(MemoryReader &reader)
+{
+    auto start = std::chrono::steady_clock::now();
+    size_t count = 0;
+
+    for (auto &module : m_modules)
+    {
+        const ModuleHeaders *headers = GetHeaders(module.name, reader);
+        module.fingerprint = headers ? headers->GetFingerprint() : 0;
+        if (!headers)
+            continue;
+        count++;
+
+        std::wstring lowerName = module.name;
+        std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::towlower);
+        m_moduleMap[lowerName].fingerprint = module.fingerprint;
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    DBG_OK(L"Fingerprinted " + std::to_wstring(count) + L" of " + std::to_wstring(m_modules.size()) +
+           L" modules in " + std::to_wstring(ms) + L" ms");
+    return count;
+}
+
+std::wstring ModuleRegistry::MakeBuildKey(const ModuleInfo &info)
+{
+    wchar_t fingerprint[32];
+    swprintf(fingerprint, 32, L"@%08X-%08X", static_cast<unsigned>(info.fingerprint >> 32),
+             static_cast<unsigned>(info.fingerprint & 0xFFFFFFFF));
+    return info.name + fingerprint;
+}
+
+bool ModuleRegistry::MatchesBuildKey(const std::wstring &key) const
+{
+    size_t at = key.rfind(L'@');
+    if (at == std::wstring::npos)
+        return false;
+
+    std::wstring lowerName = key.substr(0, at);
+    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::towlower);
+
+    auto it = m_moduleMap.find(lowerName);
+    if (it == m_moduleMap.end() || it->second.fingerprint == 0)
+        return false;
+
+    // Fingerprint digits compare case-insensitively
+    std::wstring expected = MakeBuildKey(it->second).substr(it->second.name.size());
+    std::wstring given = key.substr(at);
+    std::transform(expected.begin(), expected.end(), expected.begin(), ::towlower);
+    std::transform(given.begin(), given.end(), given.begin(), ::towlower);
+    return expected == given;
+}
+
+void ModuleRegistry::AddModule(const ModuleInfo &info)
+{
+    m_modules.push_back(info);
+
+    std::wstring lowerName = info.name;
+    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::towlower);
+    m_moduleMap[lowerName] = info;
+    m_headers.erase(lowerName);
+
+    m_isLoaded = true;
+    DBG_MODULE(info.name, info.baseAddress, info.size);
+}
+
 void ModuleRegistry::Clear()
 {
     m_modules.clear();
     m_moduleMap.clear();
+    m_headers.clear();
     m_isLoaded = false;
 }
 
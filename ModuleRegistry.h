@@ -1,14 +1,19 @@
 #pragma once
-#include <windows.h>
-#include <tlhelp32.h>
+#include "Platform.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
+#include "ModuleHeaders.h"
+
+class MemoryReader;
 
 // ============================================================================
 // ModuleRegistry: Process module registry
 // Purpose: Retrieve and store loaded module information
 // ImageBase, SizeOfImage for each module
+// Build fingerprint: PE TimeDateStamp + SizeOfImage, read from the image headers
+// Headers (sections, exports) are parsed on first use and cached per module
 // ============================================================================
 
 struct ModuleInfo
@@ -16,6 +21,7 @@ struct ModuleInfo
     std::wstring name;     // Module name (e.g., "app.dll")
     uintptr_t baseAddress; // ImageBase (base address)
     uintptr_t size;        // SizeOfImage (module size)
+    uint64_t fingerprint = 0; // (TimeDateStamp << 32) | SizeOfImage, 0 = not read
 };
 
 class ModuleRegistry
@@ -23,6 +29,7 @@ class ModuleRegistry
 private:
     std::vector<ModuleInfo> m_modules;
     std::map<std::wstring, ModuleInfo> m_moduleMap; // Fast lookup by name
+    mutable std::map<std::wstring, ModuleHeaders> m_headers; // Lazily parsed, by lowercase name
     DWORD m_pid;
     bool m_isLoaded;
 
@@ -44,6 +51,28 @@ public:
     // Check if modules are loaded
     bool IsLoaded() const { return m_isLoaded; }
 
+    // Headers of a loaded module: one header page read and parsed on first use
+    // withSymbols also reads the export table (once) if it was not read yet
+    // nullptr if the module is not loaded or has no valid PE headers
+    const ModuleHeaders *GetHeaders(const std::wstring &moduleName, MemoryReader &reader, bool withSymbols = false) const;
+
+    // RVA of an exported symbol, the export table is read on the module's first lookup
+    bool FindSymbol(const std::wstring &moduleName, const std::wstring &symbol, MemoryReader &reader,
+                    uintptr_t &outRva) const;
+
+    // Read the build fingerprint of every module (from the cached headers)
+    // Returns number of modules fingerprinted
+    size_t ReadFingerprints(MemoryReader &reader);
+
+    // Build key of a module: "name@TTTTTTTT-SSSSSSSS" (timestamp, image size)
+    static std::wstring MakeBuildKey(const ModuleInfo &info);
+
+    // True if the module named in key is loaded with the same fingerprint
+    bool MatchesBuildKey(const std::wstring &key) const;
+
+    // Register a module manually (offline sources, benchmarks)
+    void AddModule(const ModuleInfo &info);
+
     // Clear registry
     void Clear();
 
@@ -0,0 +1,312 @@
+#include "OffsetDatabase.h"
+#include "DebugLog.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+static const char OFFSET_DB_MAGIC[4] = {'O', 'F', 'D', 'B'};
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Append [uint32 length][UTF-16 chars] padded to 4 bytes, returns its offset
+static uint32_t AppendString(std::vector<uint8_t> &table, const std::wstring &str)
+{
+    uint32_t ref = static_cast<uint32_t>(table.size());
+    uint32_t length = static_cast<uint32_t>(str.size());
+
+    size_t pos = table.size();
+    table.resize(AlignUp(pos + sizeof(uint32_t) + length * sizeof(char16_t), 4));
+    memcpy(&table[pos], &length, sizeof(length));
+
+    char16_t *chars = reinterpret_cast<char16_t *>(&table[pos + sizeof(uint32_t)]);
+    for (uint32_t i = 0; i < length; ++i)
+    {
+        chars[i] = static_cast<char16_t>(str[i]);
+    }
+    return ref;
+}
+
+OffsetDatabase::OffsetDatabase()
+    : m_header(nullptr), m_modules(nullptr), m_symbolRefs(nullptr), m_entries(nullptr), m_strings(nullptr)
+{
+}
+
+bool OffsetDatabase::IsDatabase(const uint8_t *data, size_t size)
+{
+    return size >= sizeof(OffsetDbHeader) && memcmp(data, OFFSET_DB_MAGIC, sizeof(OFFSET_DB_MAGIC)) == 0;
+}
+
+bool OffsetDatabase::Open(const std::wstring &filename)
+{
+    Close();
+
+    if (!m_file.Open(filename))
+    {
+        std::wcerr << L"[-] Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    const uint8_t *data = m_file.Data();
+    uint64_t size = m_file.Size();
+
+    if (!IsDatabase(data, static_cast<size_t>(size)))
+    {
+        std::wcerr << L"[-] Not an offset database: " << filename << std::endl;
+        m_file.Close();
+        return false;
+    }
+
+    const OffsetDbHeader *header = reinterpret_cast<const OffsetDbHeader *>(data);
+    if (header->version == 0 || header->version > OFFSET_DB_VERSION)
+    {
+        std::wcerr << L"[-] Unsupported offset database version: " << header->version << std::endl;
+        m_file.Close();
+        return false;
+    }
+
+    // Every table must lie inside the file (checked without overflow)
+    auto tableFits = [size](uint64_t offset, uint64_t count, uint64_t elementSize)
+    {
+        return offset <= size && offset % 8 == 0 && count <= (size - offset) / elementSize;
+    };
+
+    uint64_t symbolTableOffset = AlignUp(header->moduleTableOffset + header->moduleCount * sizeof(OffsetDbModule), 8);
+    if (!tableFits(header->moduleTableOffset, header->moduleCount, sizeof(OffsetDbModule)) ||
+        (header->version >= 3 && !tableFits(symbolTableOffset, header->moduleCount, sizeof(uint32_t))) ||
+        !tableFits(header->entryTableOffset, header->entryCount, sizeof(OffsetDbEntry)) ||
+        !tableFits(header->stringTableOffset, header->stringTableSize, 1))
+    {
+        std::wcerr << L"[-] Corrupted offset database (table out of bounds): " << filename << std::endl;
+        m_file.Close();
+        return false;
+    }
+
+    m_header = header;
+    m_modules = reinterpret_cast<const OffsetDbModule *>(data + header->moduleTableOffset);
+    m_symbolRefs = header->version >= 3 ? reinterpret_cast<const uint32_t *>(data + symbolTableOffset) : nullptr;
+    m_entries = reinterpret_cast<const OffsetDbEntry *>(data + header->entryTableOffset);
+    m_strings = data + header->stringTableOffset;
+
+    DBG_OK(L"Mapped offset database: " + std::to_wstring(header->entryCount) + L" entries, " +
+           std::to_wstring(header->moduleCount) + L" modules");
+    return true;
+}
+
+void OffsetDatabase::Close()
+{
+    m_file.Close();
+    m_header = nullptr;
+    m_modules = nullptr;
+    m_symbolRefs = nullptr;
+    m_entries = nullptr;
+    m_strings = nullptr;
+}
+
+bool OffsetDatabase::ReadString(uint32_t ref, std::wstring &out) const
+{
+    out.clear();
+    if (ref == OFFSET_DB_NO_STRING)
+        return true;
+
+    uint64_t tableSize = m_header->stringTableSize;
+    uint32_t length = 0;
+    if (ref > tableSize || tableSize - ref < sizeof(uint32_t))
+        return false;
+    memcpy(&length, m_strings + ref, sizeof(length));
+
+    uint64_t charsOffset = static_cast<uint64_t>(ref) + sizeof(uint32_t);
+    if (length > (tableSize - charsOffset) / sizeof(char16_t))
+        return false;
+
+    const uint8_t *chars = m_strings + charsOffset;
+    out.resize(length);
+    for (uint32_t i = 0; i < length; ++i)
+    {
+        char16_t c;
+        memcpy(&c, chars + i * sizeof(char16_t), sizeof(c));
+        out[i] = static_cast<wchar_t>(c);
+    }
+    return true;
+}
+
+std::wstring OffsetDatabase::GetModuleName(uint32_t moduleId) const
+{
+    std::wstring name;
+    if (!IsOpen() || moduleId >= m_header->moduleCount || !ReadString(m_modules[moduleId].nameRef, name))
+    {
+        DBG_WARN(L"Invalid module id in offset database: " + std::to_wstring(moduleId));
+        return L"";
+    }
+    return name;
+}
+
+std::wstring OffsetDatabase::GetModuleBuild(uint32_t moduleId) const
+{
+    std::wstring build;
+    if (!IsOpen() || moduleId >= m_header->moduleCount || m_header->version < 2)
+        return build;
+
+    if (!ReadString(m_modules[moduleId].buildRef, build))
+        DBG_WARN(L"Invalid build reference in offset database: " + std::to_wstring(moduleId));
+    return build;
+}
+
+std::wstring OffsetDatabase::GetModuleSymbol(uint32_t moduleId) const
+{
+    std::wstring symbol;
+    if (!IsOpen() || moduleId >= m_header->moduleCount || m_symbolRefs == nullptr)
+        return symbol;
+
+    if (!ReadString(m_symbolRefs[moduleId], symbol))
+        DBG_WARN(L"Invalid symbol reference in offset database: " + std::to_wstring(moduleId));
+    return symbol;
+}
+
+std::wstring OffsetDatabase::GetDescription(const OffsetDbEntry &entry) const
+{
+    std::wstring description;
+    if (!IsOpen() || !ReadString(entry.descriptionRef, description))
+    {
+        DBG_WARN(L"Invalid description reference in offset database");
+        return L"";
+    }
+    return description;
+}
+
+void OffsetDatabase::ToEntries(std::vector<OffsetEntry> &outEntries, std::vector<BuildSection> *outSections) const
+{
+    if (!IsOpen())
+        return;
+
+    std::vector<std::wstring> moduleNames(m_header->moduleCount);
+    std::vector<std::wstring> moduleBuilds(m_header->moduleCount);
+    std::vector<std::wstring> moduleSymbols(m_header->moduleCount);
+    for (uint32_t i = 0; i < m_header->moduleCount; ++i)
+    {
+        moduleNames[i] = GetModuleName(i);
+        moduleBuilds[i] = GetModuleBuild(i);
+        moduleSymbols[i] = GetModuleSymbol(i);
+    }
+
+    size_t count = EntryCount();
+    outEntries.reserve(outEntries.size() + count);
+    std::wstring currentBuild;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const OffsetDbEntry &dbEntry = m_entries[i];
+        if (dbEntry.moduleId < moduleBuilds.size() && moduleBuilds[dbEntry.moduleId] != currentBuild)
+        {
+            currentBuild = moduleBuilds[dbEntry.moduleId];
+            if (outSections != nullptr)
+                outSections->push_back({outEntries.size(), currentBuild});
+        }
+
+        OffsetEntry &entry = outEntries.emplace_back();
+        if (dbEntry.moduleId < moduleNames.size())
+        {
+            entry.moduleName = moduleNames[dbEntry.moduleId];
+            entry.symbol = moduleSymbols[dbEntry.moduleId];
+        }
+        entry.offset = static_cast<uintptr_t>(dbEntry.offset);
+        entry.description = GetDescription(dbEntry);
+    }
+}
+
+bool OffsetDatabase::Write(const std::wstring &filename, const std::vector<OffsetEntry> &entries,
+                           const std::vector<BuildSection> *sections)
+{
+    std::vector<uint8_t> strings;
+    std::vector<OffsetDbModule> modules;
+    std::vector<uint32_t> symbolRefs;
+    std::vector<OffsetDbEntry> dbEntries(entries.size());
+
+    // Module ids are assigned case-insensitively, like ModuleRegistry lookups,
+    // separately for every build set and symbol
+    std::unordered_map<std::wstring, uint32_t> moduleIds;
+
+    std::wstring build;
+    uint32_t buildRef = OFFSET_DB_NO_STRING;
+    size_t nextSection = 0;
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        const OffsetEntry &entry = entries[i];
+
+        while (sections != nullptr && nextSection < sections->size() && (*sections)[nextSection].first <= i)
+        {
+            build = (*sections)[nextSection++].key;
+            buildRef = build.empty() ? OFFSET_DB_NO_STRING : AppendString(strings, build);
+        }
+
+        std::wstring lowerName = entry.moduleName;
+        std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::towlower);
+        lowerName += L'|' + build + L'!' + entry.symbol;
+
+        auto it = moduleIds.find(lowerName);
+        if (it == moduleIds.end())
+        {
+            OffsetDbModule module = {};
+            module.nameRef = AppendString(strings, entry.moduleName);
+            module.buildRef = buildRef;
+            it = moduleIds.emplace(lowerName, static_cast<uint32_t>(modules.size())).first;
+            modules.push_back(module);
+            symbolRefs.push_back(entry.symbol.empty() ? OFFSET_DB_NO_STRING : AppendString(strings, entry.symbol));
+        }
+
+        dbEntries[i].offset = entry.offset;
+        dbEntries[i].moduleId = it->second;
+        dbEntries[i].descriptionRef = entry.description.empty() ? OFFSET_DB_NO_STRING : AppendString(strings, entry.description);
+    }
+
+    if (strings.size() >= OFFSET_DB_NO_STRING)
+    {
+        std::wcerr << L"[-] String table too large for offset database format" << std::endl;
+        return false;
+    }
+
+    OffsetDbHeader header = {};
+    memcpy(header.magic, OFFSET_DB_MAGIC, sizeof(header.magic));
+    header.version = OFFSET_DB_VERSION;
+    header.moduleCount = static_cast<uint32_t>(modules.size());
+    header.entryCount = dbEntries.size();
+    header.moduleTableOffset = AlignUp(sizeof(OffsetDbHeader), 8);
+    uint64_t symbolTableOffset = AlignUp(header.moduleTableOffset + modules.size() * sizeof(OffsetDbModule), 8);
+    header.entryTableOffset = AlignUp(symbolTableOffset + symbolRefs.size() * sizeof(uint32_t), 8);
+    header.stringTableOffset = AlignUp(header.entryTableOffset + dbEntries.size() * sizeof(OffsetDbEntry), 8);
+    header.stringTableSize = strings.size();
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::wcerr << L"[-] Failed to create file: " << filename << std::endl;
+        return false;
+    }
+
+    // All table offsets are already aligned, only padding after the header/tables is needed
+    auto writePadded = [&file](const void *data, size_t bytes, uint64_t nextOffset, uint64_t currentOffset)
+    {
+        file.write(static_cast<const char *>(data), bytes);
+        static const char zeros[8] = {};
+        file.write(zeros, static_cast<std::streamsize>(nextOffset - (currentOffset + bytes)));
+    };
+
+    writePadded(&header, sizeof(header), header.moduleTableOffset, 0);
+    writePadded(modules.data(), modules.size() * sizeof(OffsetDbModule), symbolTableOffset, header.moduleTableOffset);
+    writePadded(symbolRefs.data(), symbolRefs.size() * sizeof(uint32_t), header.entryTableOffset, symbolTableOffset);
+    writePadded(dbEntries.data(), dbEntries.size() * sizeof(OffsetDbEntry), header.stringTableOffset, header.entryTableOffset);
+    file.write(reinterpret_cast<const char *>(strings.data()), strings.size());
+
+    if (!file.good())
+    {
+        std::wcerr << L"[-] Failed to write offset database: " << filename << std::endl;
+        return false;
+    }
+
+    DBG_OK(L"Wrote offset database with " + std::to_wstring(dbEntries.size()) + L" entries");
+    return true;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "MappedFile.h"
+#include "OffsetStorage.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// OffsetDatabase: Compiled binary offset database (.ofdb)
+// Purpose: Load large offset sets by mmap with zero parsing
+//
+// File layout (little-endian, all tables 8-byte aligned):
+//   OffsetDbHeader
+//   OffsetDbModule[moduleCount]   - module id -> name (+ build key) in string table
+//   uint32_t[moduleCount]         - module id -> symbol in string table (version 3)
+//   OffsetDbEntry[entryCount]     - packed (offset, moduleId, descriptionRef)
+//   String table                  - [uint32 length][UTF-16 chars], 4-aligned
+//
+// Version 2: a module id is a (name, build set) pair, entries of one build
+// set are stored contiguously (see BuildSets)
+// Version 3: a module id is a (name, build set, symbol) triple, the symbol
+// table directly follows the module table (8-aligned)
+// ============================================================================
+
+constexpr uint32_t OFFSET_DB_VERSION = 3;
+constexpr uint32_t OFFSET_DB_NO_STRING = 0xFFFFFFFF;
+
+struct OffsetDbHeader
+{
+    char magic[4];              // "OFDB"
+    uint32_t version;           // OFFSET_DB_VERSION
+    uint32_t moduleCount;       // Entries in module table
+    uint32_t reserved;          // Always 0
+    uint64_t entryCount;        // Entries in entry table
+    uint64_t moduleTableOffset; // File offset of module table
+    uint64_t entryTableOffset;  // File offset of entry table
+    uint64_t stringTableOffset; // File offset of string table
+    uint64_t stringTableSize;   // String table size in bytes
+};
+
+struct OffsetDbModule
+{
+    uint32_t nameRef;  // String table offset of module name
+    uint32_t buildRef; // Build set key or OFFSET_DB_NO_STRING (version 1: reserved)
+};
+
+struct OffsetDbEntry
+{
+    uint64_t offset;         // Offset relative to module base
+    uint32_t moduleId;       // Index into module table
+    uint32_t descriptionRef; // String table offset or OFFSET_DB_NO_STRING
+};
+
+static_assert(sizeof(OffsetDbHeader) == 56, "OffsetDbHeader layout changed");
+static_assert(sizeof(OffsetDbModule) == 8, "OffsetDbModule layout changed");
+static_assert(sizeof(OffsetDbEntry) == 16, "OffsetDbEntry layout changed");
+
+class OffsetDatabase
+{
+private:
+    MappedFile m_file;
+    const OffsetDbHeader *m_header;
+    const OffsetDbModule *m_modules;
+    const uint32_t *m_symbolRefs; // Version 3, nullptr before
+    const OffsetDbEntry *m_entries;
+    const uint8_t *m_strings;
+
+public:
+    OffsetDatabase();
+
+    // Map database file and validate its tables
+    bool Open(const std::wstring &filename);
+    void Close();
+    bool IsOpen() const { return m_header != nullptr; }
+
+    size_t ModuleCount() const { return m_header ? m_header->moduleCount : 0; }
+    size_t EntryCount() const { return m_header ? static_cast<size_t>(m_header->entryCount) : 0; }
+
+    // Direct access to the mapped entry array
+    const OffsetDbEntry *Entries() const { return m_entries; }
+
+    // String accessors (copy out of the mapping)
+    std::wstring GetModuleName(uint32_t moduleId) const;
+    std::wstring GetModuleBuild(uint32_t moduleId) const;
+    std::wstring GetModuleSymbol(uint32_t moduleId) const; // Empty = offsets are module-relative
+    std::wstring GetDescription(const OffsetDbEntry &entry) const;
+
+    // Convert mapped entries into OffsetEntry form, build set boundaries go to outSections
+    void ToEntries(std::vector<OffsetEntry> &outEntries, std::vector<BuildSection> *outSections = nullptr) const;
+
+    // Check for database magic at the start of a buffer
+    static bool IsDatabase(const uint8_t *data, size_t size);
+
+    // Compile entries into a database file (sections as produced by ToEntries)
+    static bool Write(const std::wstring &filename, const std::vector<OffsetEntry> &entries,
+                      const std::vector<BuildSection> *sections = nullptr);
+
+private:
+    bool ReadString(uint32_t ref, std::wstring &out) const;
+};
@@ -1,9 +1,12 @@
 #include "OffsetStorage.h"
+#include "MappedFile.h"
+#include "OffsetDatabase.h"
+#include "StringUtils.h"
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <cstring>
 
 OffsetStorage::OffsetStorage()
     : m_isModified(false)
@@ -14,73 +17,328 @@ bool OffsetStorage::LoadFromFile(const std::wstring &filename)
 {
     m_filename = filename;
     Clear();
+    m_builds.Clear();
 
-    std::wifstream file(filename);
-    if (!file.is_open())
+    std::vector<BuildSection> sections;
+    if (!ReadEntries(filename, m_offsets, sections))
+        return false;
+    m_builds.Load(m_offsets, sections);
+
+    size_t replayed = m_journal.Replay(filename, [this](JournalOp op, const char *payload, size_t length)
+                                       {
+        if (op == JournalOp::Clear)
+        {
+            m_offsets.clear();
+            return true;
+        }
+        if (op == JournalOp::Select)
+        {
+            m_builds.Switch(m_offsets, StringUtils::Utf8ToWide(payload, length));
+            return true;
+        }
+
+        OffsetEntry entry;
+        std::wstring detail;
+        if (op != JournalOp::Add || ParseLine(payload, payload + length, entry, detail) != OffsetLineError::None)
+            return false;
+        m_offsets.push_back(std::move(entry));
+        return true; });
+    m_isModified = false;
+
+    std::wcout << L"[+] Loaded " << m_offsets.size() << L" offsets from " << filename;
+    if (m_builds.GetSetCount() > 1)
+        std::wcout << L" (" << m_builds.GetSetCount() << L" build sets)";
+    if (replayed > 0)
+        std::wcout << L" (" << replayed << L" journaled edits)";
+    std::wcout << std::endl;
+    return true;
+}
+
+bool OffsetStorage::ReadEntries(const std::wstring &filename, std::vector<OffsetEntry> &outEntries,
+                                std::vector<BuildSection> &outSections)
+{
+    MappedFile file;
+    if (!file.Open(filename))
     {
         std::wcerr << L"[-] Failed to open file: " << filename << std::endl;
         return false;
     }
 
-    std::wstring line;
+    if (OffsetDatabase::IsDatabase(file.Data(), file.Size()))
+    {
+        // Compiled binary database, no text parsing needed
+        file.Close();
+        OffsetDatabase database;
+        if (!database.Open(filename))
+            return false;
+        database.ToEntries(outEntries, &outSections);
+    }
+    else
+    {
+        ParseBuffer(reinterpret_cast<const char *>(file.Data()), file.Size(), outEntries, &outSections);
+    }
+    return true;
+}
+
+ReloadStats OffsetStorage::ApplyReload(std::vector<OffsetEntry> &&entries, const std::vector<BuildSection> &sections)
+{
+    auto keyOf = [](const OffsetEntry &entry)
+    {
+        std::wstring key = entry.moduleName;
+        std::transform(key.begin(), key.end(), key.begin(), ::towlower);
+        key += L'!' + entry.symbol + L'|' + std::to_wstring(entry.offset) + L'|' + entry.description;
+        return key;
+    };
+    auto identityOf = [](const OffsetEntry &entry) -> const std::wstring &
+    {
+        return entry.description;
+    };
+
+    // Merged result no longer follows the journal, next save rewrites the file
+    m_journal.Invalidate();
+    return MergeReload(m_offsets, m_builds.TakeReload(std::move(entries), sections), keyOf, identityOf);
+}
+
+bool OffsetStorage::SelectBuild(const ModuleRegistry &registry)
+{
+    std::wstring key;
+    if (!m_builds.FindMatch(registry, key))
+        return false;
+
+    m_builds.Switch(m_offsets, key);
+    m_journal.Record(JournalOp::Select, StringUtils::WideToUtf8(key));
+
+    std::wcout << L"[+] Selected offsets for " << (key.empty() ? L"unknown build (default set)" : key)
+               << L": " << m_offsets.size() << L" entries" << std::endl;
+    return true;
+}
+
+bool OffsetStorage::BindBuild(const std::wstring &key)
+{
+    if (!m_builds.Bind(key))
+    {
+        std::wcerr << L"[-] Build " << key << L" already has an offset set" << std::endl;
+        return false;
+    }
+
+    // Renaming a set is not a journal op
+    m_journal.Invalidate();
+    m_isModified = true;
+    return true;
+}
+
+// Output buffer is flushed to the file when it grows past this size
+static const size_t SAVE_BUFFER_SIZE = 1 << 20;
+
+static inline bool IsTrimChar(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static inline void TrimRange(const char *&begin, const char *&end)
+{
+    while (begin < end && IsTrimChar(*begin))
+        ++begin;
+    while (end > begin && IsTrimChar(end[-1]))
+        --end;
+}
+
+void OffsetStorage::ParseBuffer(const char *data, size_t size, std::vector<OffsetEntry> &outEntries,
+                                std::vector<BuildSection> *outSections)
+{
+    const char *cursor = data;
+    const char *bufferEnd = data + size;
+
+    // Skip UTF-8 BOM
+    if (size >= 3 && static_cast<unsigned char>(data[0]) == 0xEF &&
+        static_cast<unsigned char>(data[1]) == 0xBB && static_cast<unsigned char>(data[2]) == 0xBF)
+    {
+        cursor += 3;
+    }
+
+    // One entry per line at most
+    outEntries.reserve(outEntries.size() + std::count(cursor, bufferEnd, '\n') + 1);
+
     int lineNumber = 0;
 
-    while (std::getline(file, line))
+    while (cursor < bufferEnd)
     {
+        const char *lineEnd = static_cast<const char *>(memchr(cursor, '\n', bufferEnd - cursor));
+        if (lineEnd == nullptr)
+            lineEnd = bufferEnd;
+
+        const char *lineBegin = cursor;
+        cursor = lineEnd < bufferEnd ? lineEnd + 1 : bufferEnd;
         lineNumber++;
-        line = Trim(line);
+
+        TrimRange(lineBegin, lineEnd);
 
         // Skip empty lines and comments
-        if (line.empty() || line[0] == L'#' || line[0] == L';')
+        if (lineBegin == lineEnd || *lineBegin == '#' || *lineBegin == ';')
             continue;
 
-        // Format: ModuleName+0xOffset=Description
-        // Example: app.dll+0xDEA964=DataPointer
-
-        size_t plusPos = line.find(L'+');
-        size_t equalPos = line.find(L'=');
-
-        if (plusPos == std::wstring::npos)
+        std::wstring build;
+        if (ParseBuildSection(lineBegin, lineEnd, build))
         {
-            std::wcerr << L"[!] Invalid format at line " << lineNumber << L": " << line << std::endl;
+            if (outSections != nullptr)
+                outSections->push_back({outEntries.size(), std::move(build)});
             continue;
         }
 
-        OffsetEntry entry;
-        entry.moduleName = Trim(line.substr(0, plusPos));
-
-        std::wstring offsetStr;
-        if (equalPos != std::wstring::npos)
+        // Build the entry in place, dropped again if the line is malformed
+        OffsetEntry &entry = outEntries.emplace_back();
+        std::wstring detail;
+        OffsetLineError error = ParseLine(lineBegin, lineEnd, entry, detail);
+        if (error != OffsetLineError::None)
         {
-            offsetStr = Trim(line.substr(plusPos + 1, equalPos - plusPos - 1));
-            entry.description = Trim(line.substr(equalPos + 1));
-        }
-        else
-        {
-            offsetStr = Trim(line.substr(plusPos + 1));
+            if (error == OffsetLineError::BadOffset)
+                std::wcerr << L"[!] Failed to parse offset at line ";
+            else if (error == OffsetLineError::EmptySymbol)
+                std::wcerr << L"[!] Empty symbol name at line ";
+            else
+                std::wcerr << L"[!] Invalid format at line ";
+            std::wcerr << lineNumber << L": " << detail << std::endl;
+            outEntries.pop_back();
         }
+    }
+}
+
+OffsetLineError OffsetStorage::ParseLine(const char *begin, const char *end, OffsetEntry &entry, std::wstring &detail)
+{
+    // Format: ModuleName+0xOffset=Description or ModuleName!Symbol+0xDelta=Description
+    // Example: app.dll+0xDEA964=DataPointer
+
+    const char *plusPos = static_cast<const char *>(memchr(begin, '+', end - begin));
+    const char *equalPos = static_cast<const char *>(memchr(begin, '=', end - begin));
+
+    if (plusPos == nullptr)
+    {
+        detail = StringUtils::Utf8ToWide(begin, end - begin);
+        return OffsetLineError::InvalidFormat;
+    }
 
-        if (!ParseHexValue(offsetStr, entry.offset))
+    const char *nameBegin = begin;
+    const char *nameEnd = plusPos;
+    const char *bangPos = static_cast<const char *>(memchr(begin, '!', plusPos - begin));
+    if (bangPos != nullptr)
+    {
+        const char *symbolBegin = bangPos + 1;
+        const char *symbolEnd = plusPos;
+        TrimRange(symbolBegin, symbolEnd);
+        if (symbolBegin == symbolEnd)
         {
-            std::wcerr << L"[!] Failed to parse offset at line " << lineNumber << L": " << offsetStr << std::endl;
-            continue;
+            detail = StringUtils::Utf8ToWide(begin, end - begin);
+            return OffsetLineError::EmptySymbol;
         }
+        StringUtils::Utf8ToWide(symbolBegin, symbolEnd - symbolBegin, entry.symbol);
+        nameEnd = bangPos;
+    }
+    else
+    {
+        entry.symbol.clear();
+    }
+    TrimRange(nameBegin, nameEnd);
+    StringUtils::Utf8ToWide(nameBegin, nameEnd - nameBegin, entry.moduleName);
 
-        m_offsets.push_back(entry);
+    const char *offsetBegin = plusPos + 1;
+    const char *offsetEnd = end;
+    if (equalPos != nullptr)
+    {
+        if (equalPos > plusPos)
+            offsetEnd = equalPos;
+
+        const char *descBegin = equalPos + 1;
+        const char *descEnd = end;
+        TrimRange(descBegin, descEnd);
+        StringUtils::Utf8ToWide(descBegin, descEnd - descBegin, entry.description);
     }
+    TrimRange(offsetBegin, offsetEnd);
 
-    file.close();
-    m_isModified = false;
+    if (!StringUtils::ParseHex(offsetBegin, offsetEnd, entry.offset))
+    {
+        detail = StringUtils::Utf8ToWide(offsetBegin, offsetEnd - offsetBegin);
+        return OffsetLineError::BadOffset;
+    }
+    return OffsetLineError::None;
+}
+
+void OffsetStorage::FormatEntry(const OffsetEntry &entry, std::string &out)
+{
+    StringUtils::AppendUtf8(entry.moduleName, out);
+    if (!entry.symbol.empty())
+    {
+        out += '!';
+        StringUtils::AppendUtf8(entry.symbol, out);
+    }
+    out += '+';
+    StringUtils::AppendHex(entry.offset, out);
+
+    if (!entry.description.empty())
+    {
+        out += '=';
+        StringUtils::AppendUtf8(entry.description, out);
+    }
+}
+
+bool OffsetStorage::CompactJournal()
+{
+    if (m_journal.GetJournalOpCount() == 0 || m_filename.empty())
+        return true;
+    if (m_isModified)
+        return false;
+
+    size_t ops = m_journal.GetJournalOpCount();
+    std::wstring tempFile = EditJournal::TempPath(m_filename);
+    if (!WriteAll(tempFile) || !m_journal.CommitRewrite(tempFile, m_filename))
+        return false;
 
-    std::wcout << L"[+] Loaded " << m_offsets.size() << L" offsets from " << filename << std::endl;
+    std::wcout << L"[+] Compacted " << ops << L" journaled edits into " << m_filename << std::endl;
     return true;
 }
 
 bool OffsetStorage::SaveToFile(const std::wstring &filename)
 {
+    // Only the edits since the last load/save go to disk
+    size_t edits = m_journal.GetPendingCount();
+    if (m_journal.CanAppend(filename, m_offsets.size()) && m_journal.Append())
+    {
+        m_filename = filename;
+        m_isModified = false;
+        std::wcout << L"[+] Saved " << m_offsets.size() << L" offsets to " << filename
+                   << L" (" << edits << L" edits appended to journal)" << std::endl;
+        return true;
+    }
+
+    // Full rewrite into a temp file, swapped in atomically
+    std::wstring tempFile = EditJournal::TempPath(filename);
+    if (!WriteAll(tempFile) || !m_journal.CommitRewrite(tempFile, filename))
+        return false;
+
     m_filename = filename;
+    m_isModified = false;
+    std::wcout << L"[+] Saved " << m_offsets.size() << L" offsets to " << filename
+               << (IsBinaryFilename(filename) ? L" (binary)" : L"") << std::endl;
+    return true;
+}
 
-    std::wofstream file(filename);
+bool OffsetStorage::WriteAll(const std::wstring &filename) const
+{
+    if (IsBinaryFilename(filename))
+    {
+        if (m_builds.GetSetCount() == 1 && GetActiveBuild().empty())
+            return OffsetDatabase::Write(filename, m_offsets);
+
+        // Flatten the sets, the database keeps them apart by module id
+        std::vector<OffsetEntry> entries;
+        std::vector<BuildSection> sections;
+        m_builds.ForEachSet(m_offsets, [&](const std::wstring &key, const std::vector<OffsetEntry> &set)
+                            {
+            sections.push_back({entries.size(), key});
+            entries.insert(entries.end(), set.begin(), set.end()); });
+        return OffsetDatabase::Write(filename, entries, &sections);
+    }
+
+    std::ofstream file(filename);
     if (!file.is_open())
     {
         std::wcerr << L"[-] Failed to create file: " << filename << std::endl;
@@ -88,29 +346,49 @@ bool OffsetStorage::SaveToFile(const std::wstring &filename)
     }
 
     // File header
-    file << L"# Offset Configuration File\n";
-    file << L"# Format: ModuleName+0xOffset=Description\n";
-    file << L"# Example: app.dll+0xDEA964=DataPointer\n";
-    file << L"#\n";
-    file << L"# Note: Absolute addresses are NOT saved, only module+offset pairs\n\n";
-
-    for (const auto &entry : m_offsets)
-    {
-        file << entry.moduleName << L"+0x" << std::hex << std::uppercase << entry.offset;
-
-        if (!entry.description.empty())
+    std::string buffer;
+    buffer += "# Offset Configuration File\n";
+    buffer += "# Format: ModuleName+0xOffset=Description\n";
+    buffer += "# Example: app.dll+0xDEA964=DataPointer\n";
+    buffer += "# Relative to an export: app.dll!CreateInterface+0x20=Interface\n";
+    buffer += "#\n";
+    buffer += "# Note: Absolute addresses are NOT saved, only module+offset pairs\n\n";
+
+    m_builds.ForEachSet(m_offsets, [&](const std::wstring &key, const std::vector<OffsetEntry> &set)
+                        {
+        if (!key.empty())
+            AppendBuildSection(key, buffer);
+
+        for (const auto &entry : set)
         {
-            file << L"=" << entry.description;
-        }
+            FormatEntry(entry, buffer);
+            buffer += '\n';
+
+            // Flush in large blocks, the buffer stays bounded for huge configs
+            if (buffer.size() >= SAVE_BUFFER_SIZE)
+            {
+                file.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        } });
+    file.write(buffer.data(), buffer.size());
+    file.close();
 
-        file << L"\n";
+    if (!file.good())
+    {
+        std::wcerr << L"[-] Failed to write file: " << filename << std::endl;
+        return false;
     }
+    return true;
+}
 
-    file.close();
-    m_isModified = false;
+bool OffsetStorage::IsBinaryFilename(const std::wstring &filename)
+{
+    const std::wstring extension = L".ofdb";
+    if (filename.size() < extension.size())
+        return false;
 
-    std::wcout << L"[+] Saved " << m_offsets.size() << L" offsets to " << filename << std::endl;
-    return true;
+    return _wcsicmp(filename.c_str() + filename.size() - extension.size(), extension.c_str()) == 0;
 }
 
 bool OffsetStorage::Save()
@@ -127,11 +405,16 @@ void OffsetStorage::AddOffset(const OffsetEntry &entry)
 {
     m_offsets.push_back(entry);
     m_isModified = true;
+
+    std::string line;
+    FormatEntry(entry, line);
+    m_journal.Record(JournalOp::Add, line);
 }
 
 void OffsetStorage::Clear()
 {
     m_offsets.clear();
+    m_journal.Record(JournalOp::Clear);
     m_isModified = false;
 }
 
@@ -152,7 +435,7 @@ void OffsetStorage::PrintOffsets() const
 
     for (const auto &entry : m_offsets)
     {
-        std::wcout << std::left << std::setw(20) << entry.moduleName
+        std::wcout << std::left << std::setw(20) << (entry.symbol.empty() ? entry.moduleName : entry.moduleName + L'!' + entry.symbol)
                    << L" | 0x" << std::hex << std::uppercase << std::setw(10) << entry.offset;
 
         if (entry.isResolved)
@@ -168,42 +451,3 @@ void OffsetStorage::PrintOffsets() const
     }
     std::wcout << std::endl;
 }
-
-bool OffsetStorage::ParseHexValue(const std::wstring &str, uintptr_t &outValue)
-{
-    std::wstring cleanStr = str;
-
-    // Удаляем префикс 0x или 0X если есть
-    if (cleanStr.length() >= 2)
-    {
-        if (cleanStr.substr(0, 2) == L"0x" || cleanStr.substr(0, 2) == L"0X")
-        {
-            cleanStr = cleanStr.substr(2);
-        }
-    }
-
-    // Проверяем, что строка содержит только hex символы
-    for (wchar_t c : cleanStr)
-    {
-        if (!iswxdigit(c))
-        {
-            return false;
-        }
-    }
-
-    std::wstringstream ss;
-    ss << std::hex << cleanStr;
-    ss >> outValue;
-
-    return !ss.fail();
-}
-
-std::wstring OffsetStorage::Trim(const std::wstring &str)
-{
-    size_t first = str.find_first_not_of(L" \t\r\n");
-    if (first == std::wstring::npos)
-        return L"";
-
-    size_t last = str.find_last_not_of(L" \t\r\n");
-    return str.substr(first, last - first + 1);
-}
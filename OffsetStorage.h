@@ -2,18 +2,26 @@
 #include <string>
 #include <vector>
 #include <map>
+#include "ReloadDiff.h"
+#include "EditJournal.h"
+#include "BuildSets.h"
 
 // ============================================================================
 // OffsetStorage: Offset storage system
 // Purpose: Load and save offsets in "module + offset" format
 // File format: Simple text-based (INI-like)
+// An offset can be relative to an exported symbol: module!Symbol+0xDelta
 // Absolute addresses are NOT saved, only module + offset
+// Edits are saved to <file>.journal until the next compaction (see EditJournal)
+// One file can hold a set per target build, [module@fingerprint] sections
+// (see BuildSets); the set matching the loaded modules is the active one
 // ============================================================================
 
 struct OffsetEntry
 {
     std::wstring moduleName;  // Module name (e.g., "app.dll")
-    uintptr_t offset;         // Offset relative to module base
+    std::wstring symbol;      // Exported symbol the offset is relative to (empty = module base)
+    uintptr_t offset;         // Offset relative to module base (or symbol)
     std::wstring description; // Description (e.g., "Pointer1")
 
     // Runtime data (not saved to file)
@@ -26,33 +34,80 @@ struct OffsetEntry
     }
 };
 
+// Why a config line was rejected, the detail text is the offending part
+enum class OffsetLineError : uint8_t
+{
+    None,
+    InvalidFormat, // No '+', detail is the line
+    EmptySymbol,   // Nothing after '!', detail is the line
+    BadOffset      // Not a hex number, detail is the offset text
+};
+
 class OffsetStorage
 {
 private:
     std::vector<OffsetEntry> m_offsets;
     std::wstring m_filename;
     bool m_isModified;
+    EditJournal m_journal;
+    BuildSets<OffsetEntry> m_builds;
+
+    // Write all entries to filename (no journal involved)
+    bool WriteAll(const std::wstring &filename) const;
 
 public:
     OffsetStorage();
 
-    // Load offsets from file
+    // Load offsets from file (text config or binary .ofdb, detected by content)
+    // and replay its edit journal
     bool LoadFromFile(const std::wstring &filename);
 
-    // Save offsets to file
+    // Save offsets to file (binary database if filename ends with .ofdb)
+    // Edits since the last load/save are appended to the journal when possible
     bool SaveToFile(const std::wstring &filename);
 
     // Save using current filename
     bool Save();
 
+    // Fold the replayed journal into the loaded file, false if unsaved edits
+    // are in the way (the next save rewrites the file then)
+    bool CompactJournal();
+
+    // Journal ops of the loaded file that are not in the file itself
+    size_t GetJournaledEditCount() const { return m_journal.GetJournalOpCount(); }
+
+    // Off while the file is hot reloaded: saves rewrite it instead of appending
+    void SetJournalAppends(bool enabled) { m_journal.SetAppendEnabled(enabled); }
+
+    // File of the last load/save (empty if none)
+    const std::wstring &GetFilename() const { return m_filename; }
+
+    // Read a config file without touching storage (text or .ofdb, detected by content)
+    static bool ReadEntries(const std::wstring &filename, std::vector<OffsetEntry> &outEntries,
+                            std::vector<BuildSection> &outSections);
+
+    // Replace entries with re-read file contents, unchanged entries keep their resolution
+    ReloadStats ApplyReload(std::vector<OffsetEntry> &&entries, const std::vector<BuildSection> &sections);
+
+    // Activate the offset set for the loaded module builds (default set if none fits)
+    // Returns true if the active set changed
+    bool SelectBuild(const ModuleRegistry &registry);
+
+    // Attach the active offsets to a build key, fails if that build already has a set
+    bool BindBuild(const std::wstring &key);
+
+    // Build key of the active set (empty = default set) and number of sets
+    const std::wstring &GetActiveBuild() const { return m_builds.GetActiveKey(); }
+    size_t GetBuildCount() const { return m_builds.GetSetCount(); }
+
     // Add new offset
     void AddOffset(const OffsetEntry &entry);
 
-    // Get offset list
+    // Get offset list (active build set)
     const std::vector<OffsetEntry> &GetOffsets() const { return m_offsets; }
     std::vector<OffsetEntry> &GetOffsets() { return m_offsets; }
 
-    // Clear offset list
+    // Clear offset list (active build set)
     void Clear();
 
     // Check if modified
@@ -64,10 +119,19 @@ public:
     // Print all offsets to console
     void PrintOffsets() const;
 
-private:
-    // Parse hex value string
-    bool ParseHexValue(const std::wstring &str, uintptr_t &outValue);
+    // Parse UTF-8 config text in place and append entries to outEntries
+    // [build] section lines go to outSections (ignored if null)
+    // Malformed lines are reported to wcerr and skipped
+    static void ParseBuffer(const char *data, size_t size, std::vector<OffsetEntry> &outEntries,
+                            std::vector<BuildSection> *outSections = nullptr);
+
+    // Parse one config line (trimmed, not a comment) into entry
+    // Returns the error kind with its detail text if the line is malformed
+    static OffsetLineError ParseLine(const char *begin, const char *end, OffsetEntry &entry, std::wstring &detail);
+
+    // Append one entry as a config line (UTF-8, no newline)
+    static void FormatEntry(const OffsetEntry &entry, std::string &out);
 
-    // Trim whitespace
-    std::wstring Trim(const std::wstring &str);
+    // Check for the binary database extension (.ofdb)
+    static bool IsBinaryFilename(const std::wstring &filename);
 };
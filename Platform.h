@@ -0,0 +1,34 @@
+#pragma once
+
+// ============================================================================
+// Platform: Win32 types shared by the portable units
+// Purpose: The decoder, image loaders and file formats also build on Linux
+// analysis hosts, where windows.h does not exist
+// - Windows: windows.h as is
+// - elsewhere: the handful of Win32 typedefs those units use; a process
+//   HANDLE is the target's pid, there is nothing to open or close
+// ============================================================================
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cstdint>
+
+typedef uint8_t BYTE;
+typedef uint16_t WORD;
+typedef uint32_t DWORD;
+typedef void *HANDLE;
+
+#define INVALID_HANDLE_VALUE (reinterpret_cast<HANDLE>(static_cast<intptr_t>(-1)))
+
+// Process "handle" of a pid, for MemoryReader and the scanners
+inline HANDLE ProcessHandleFromId(DWORD processId)
+{
+    return reinterpret_cast<HANDLE>(static_cast<uintptr_t>(processId));
+}
+
+inline DWORD GetProcessId(HANDLE process)
+{
+    return static_cast<DWORD>(reinterpret_cast<uintptr_t>(process));
+}
+#endif
@@ -1,8 +1,14 @@
 #include "PointerChainResolver.h"
 #include "DebugLog.h"
+#include "ProcessPause.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cwchar>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 PointerChainResolver::PointerChainResolver(
     const ModuleRegistry *moduleRegistry,
@@ -103,17 +109,37 @@ bool PointerChainResolver::ResolveChain(PointerChain &chain)
         }
     }
 
-    // Step 5: Read final value from resolved address
+    // Step 5: Read final value (or the whole field group) from resolved address
     chain.resolvedAddress = currentPtr;
+    chain.isSuspect = false;
     DBG_ADDR(L"Final resolved address", currentPtr);
 
-    if (!ReadFinalValue(currentPtr, chain))
+    if (!chain.fields.empty())
+    {
+        if (!ReadFieldGroup(currentPtr, chain))
+        {
+            chain.lastError = L"Failed to read value at final address";
+            chain.isResolved = false;
+            DBG_ERR(L"Failed to read field group");
+            return false;
+        }
+    }
+    else if (!ReadFinalValue(currentPtr, chain))
     {
         chain.lastError = L"Failed to read value at final address";
         chain.isResolved = false;
         DBG_ERR(L"Failed to read final value");
         return false;
     }
+    else if (chain.tornCheck != TornCheck::None && m_memoryReader->GetSnapshot() == nullptr)
+    {
+        // Step 6: Opt-in torn-read check, snapshot reads cannot tear
+        uintptr_t objectBase = chain.offsets.empty() ? currentPtr : currentPtr - chain.offsets.back();
+        chain.isSuspect = !CheckTornValue(currentPtr, &chain.currentValue.data, ValueSize(chain.valueType),
+                                          chain.tornCheck, objectBase, chain.sequenceOffset);
+    }
+    if (chain.isSuspect)
+        DBG_WARN(L"Value still changing after " + std::to_wstring(TORN_RETRY_BUDGET) + L" attempts, flagged suspect");
 
     chain.isResolved = true;
     chain.lastError = L"";
@@ -121,6 +147,66 @@ bool PointerChainResolver::ResolveChain(PointerChain &chain)
     return true;
 }
 
+bool PointerChainResolver::CheckTornValue(uintptr_t address, void *value, size_t size, TornCheck check,
+                                          uintptr_t objectBase, uintptr_t sequenceOffset)
+{
+    auto start = std::chrono::steady_clock::now();
+    bool consistent = false;
+    unsigned attempt = 0;
+
+    if (check == TornCheck::Reread)
+    {
+        // A value caught mid-write differs from the next read of it
+        uint64_t small = 0;
+        std::vector<uint8_t> large(size > sizeof(small) ? size : 0);
+        void *again = large.empty() ? static_cast<void *>(&small) : large.data();
+        for (; attempt < TORN_RETRY_BUDGET; ++attempt)
+        {
+            m_tornStats.extraReads++;
+            if (!m_memoryReader->ReadMemory(address, again, size))
+                break;
+            if (memcmp(again, value, size) == 0)
+            {
+                consistent = true;
+                break;
+            }
+            memcpy(value, again, size);
+        }
+    }
+    else
+    {
+        // Seqlock reader: the writer keeps the counter odd while it writes
+        const uintptr_t sequenceAddress = objectBase + sequenceOffset;
+        for (; attempt < TORN_RETRY_BUDGET; ++attempt)
+        {
+            uint32_t before = 0;
+            uint32_t after = 0;
+            m_tornStats.extraReads += 3;
+            if (!m_memoryReader->ReadMemory(sequenceAddress, &before, sizeof(before)) ||
+                !m_memoryReader->ReadMemory(address, value, size) ||
+                !m_memoryReader->ReadMemory(sequenceAddress, &after, sizeof(after)))
+                break;
+            if ((before & 1) == 0 && before == after)
+            {
+                consistent = true;
+                break;
+            }
+
+            // Writer inside its update, give it a chance to finish before the next attempt
+            if ((after & 1) != 0)
+                std::this_thread::yield();
+        }
+    }
+
+    m_tornStats.checkedValues++;
+    if (attempt > 0)
+        m_tornStats.retriedValues++;
+    if (!consistent)
+        m_tornStats.suspectValues++;
+    m_tornStats.checkUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return consistent;
+}
+
 bool PointerChainResolver::ResolveStep(uintptr_t &currentPtr, uintptr_t offset)
 {
     // Add offset to current pointer
@@ -200,8 +286,75 @@ bool PointerChainResolver::ReadFinalValue(uintptr_t address, PointerChain &chain
     return success;
 }
 
+// Typed value from the raw bytes of a read
+static MemoryValue DecodeValue(const uint8_t *bytes, ValueType type)
+{
+    MemoryValue value;
+    value.type = type;
+    value.isValid = true;
+    value.data.doubleValue = 0.0;
+    memcpy(&value.data, bytes, PointerChainResolver::ValueSize(type));
+    return value;
+}
+
+void PointerChainResolver::FieldGroupSpan(const std::vector<ChainField> &fields, uintptr_t &begin, size_t &size)
+{
+    begin = fields.front().offset;
+    uintptr_t end = 0;
+    for (const ChainField &field : fields)
+    {
+        begin = (std::min)(begin, field.offset);
+        end = (std::max)(end, field.offset + PointerChainResolver::ValueSize(field.type));
+    }
+    size = end - begin;
+}
+
+bool PointerChainResolver::CheckFieldSpan(const std::vector<ChainField> &fields, std::wstring &error)
+{
+    if (fields.empty())
+        return true;
+
+    uintptr_t begin = 0;
+    size_t size = 0;
+    FieldGroupSpan(fields, begin, size);
+    if (size <= MAX_FIELD_SPAN)
+        return true;
+
+    error = L"Field group spans " + FormatHex(size) + L" bytes, more than the " + FormatHex(MAX_FIELD_SPAN) +
+            L" read at once";
+    return false;
+}
+
+bool PointerChainResolver::ReadFieldGroup(uintptr_t address, PointerChain &chain)
+{
+    uintptr_t spanBegin = 0;
+    size_t spanSize = 0;
+    FieldGroupSpan(chain.fields, spanBegin, spanSize);
+    if (spanSize > MAX_FIELD_SPAN)
+        return false;
+
+    std::vector<uint8_t> bytes(spanSize);
+    if (!m_memoryReader->ReadMemory(address + spanBegin, bytes.data(), spanSize))
+        return false;
+
+    if (chain.tornCheck != TornCheck::None && m_memoryReader->GetSnapshot() == nullptr)
+    {
+        uintptr_t objectBase = chain.offsets.empty() ? address : address - chain.offsets.back();
+        chain.isSuspect = !CheckTornValue(address + spanBegin, bytes.data(), spanSize, chain.tornCheck, objectBase,
+                                          chain.sequenceOffset);
+    }
+
+    for (ChainField &field : chain.fields)
+    {
+        field.value = DecodeValue(bytes.data() + (field.offset - spanBegin), field.type);
+    }
+    chain.currentValue = chain.fields.front().value;
+    return true;
+}
+
 int PointerChainResolver::ResolveAllChains(std::vector<PointerChain> &chains)
 {
+    m_tornStats = TornReadStats();
     int successCount = 0;
     for (auto &chain : chains)
     {
@@ -213,6 +366,399 @@ int PointerChainResolver::ResolveAllChains(std::vector<PointerChain> &chains)
     return successCount;
 }
 
+// Bytes read at a table chain's final address: its value, or the span of its field group
+struct TableValueRead
+{
+    uintptr_t offset = 0; // From the final address
+    size_t size = 0;
+    std::vector<uint8_t> bytes;
+};
+
+// Walk of one table chain, shared by the live and the consistent resolution
+// read(address, buffer, size) fetches target bytes; dereferences all but the last offset
+template <typename ReadFn>
+static ChainError WalkTableChain(const MemoryReader &reader, const PointerChainTable &table, size_t index,
+                                 uintptr_t baseAddress, ReadFn &&read, uintptr_t &address, TableValueRead &value,
+                                 uint16_t &errorStep)
+{
+    errorStep = 0;
+    value.offset = 0;
+    value.size = PointerChainResolver::ValueSize(table.GetValueType(index));
+    const uint32_t fieldCount = table.GetFieldCount(index);
+    if (fieldCount > 0)
+    {
+        uintptr_t end = 0;
+        value.offset = table.GetFieldOffset(index, 0);
+        for (uint32_t f = 0; f < fieldCount; ++f)
+        {
+            uintptr_t fieldOffset = table.GetFieldOffset(index, f);
+            value.offset = (std::min)(value.offset, fieldOffset);
+            end = (std::max)(end, fieldOffset + PointerChainResolver::ValueSize(table.GetFieldType(index, f)));
+        }
+        value.size = end - value.offset;
+        if (value.size > PointerChainResolver::MAX_FIELD_SPAN)
+            return ChainError::ValueReadFailed;
+    }
+    if (value.bytes.size() < value.size)
+        value.bytes.resize(value.size);
+
+    if (!reader.IsValidAddress(baseAddress))
+        return ChainError::InvalidBaseAddress;
+
+    uintptr_t currentPtr = 0;
+    if (!read(baseAddress, &currentPtr, sizeof(currentPtr)))
+        return ChainError::BaseReadFailed;
+
+    const uintptr_t *offsets = table.GetOffsets(index);
+    const uint32_t offsetCount = table.GetOffsetCount(index);
+
+    for (uint32_t i = 0; i < offsetCount; ++i)
+    {
+        uintptr_t nextAddress = currentPtr + offsets[i];
+        DBG_CHAIN(i + 1, offsetCount, currentPtr, offsets[i], nextAddress);
+
+        if (!reader.IsValidAddress(nextAddress))
+        {
+            errorStep = static_cast<uint16_t>(i + 1);
+            return ChainError::InvalidStepAddress;
+        }
+
+        if (i == offsetCount - 1)
+        {
+            currentPtr = nextAddress;
+            break;
+        }
+
+        if (!read(nextAddress, &currentPtr, sizeof(currentPtr)))
+        {
+            errorStep = static_cast<uint16_t>(i + 1);
+            return ChainError::StepReadFailed;
+        }
+
+        if (!reader.IsValidAddress(currentPtr))
+        {
+            errorStep = static_cast<uint16_t>(i + 1);
+            return ChainError::InvalidStepPointer;
+        }
+    }
+
+    // Value bits (or the field group span) in one read, decoded by StoreTableValue
+    address = currentPtr;
+    if (!read(currentPtr + value.offset, value.bytes.data(), value.size))
+        return ChainError::ValueReadFailed;
+    return ChainError::None;
+}
+
+// Raw bits of the value and of every field into the table's runtime columns
+static void StoreTableValue(PointerChainTable &table, size_t index, uintptr_t address, const TableValueRead &value,
+                            bool suspect)
+{
+    const uint32_t fieldCount = table.GetFieldCount(index);
+    for (uint32_t f = 0; f < fieldCount; ++f)
+    {
+        uint64_t raw = 0;
+        memcpy(&raw, value.bytes.data() + (table.GetFieldOffset(index, f) - value.offset),
+               PointerChainResolver::ValueSize(table.GetFieldType(index, f)));
+        table.SetFieldRaw(index, f, raw);
+    }
+
+    // A field group's own value is its first field
+    const uintptr_t valueOffset = fieldCount > 0 ? table.GetFieldOffset(index, 0) - value.offset : 0;
+    uint64_t rawValue = 0;
+    memcpy(&rawValue, value.bytes.data() + valueOffset, PointerChainResolver::ValueSize(table.GetValueType(index)));
+    table.SetResolved(index, address, rawValue, suspect);
+}
+
+std::vector<uintptr_t> PointerChainResolver::LookUpModuleBases(const PointerChainTable &table) const
+{
+    // Module bases per pooled string id, looked up once per module
+    const size_t count = table.Count();
+    std::vector<uintptr_t> moduleBases(table.GetStringCount(), 0);
+    std::vector<uint8_t> moduleLookedUp(table.GetStringCount(), 0);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        uint32_t moduleId = table.GetModuleId(index);
+        if (moduleLookedUp[moduleId])
+            continue;
+
+        ModuleInfo moduleInfo;
+        if (m_moduleRegistry->FindModule(table.GetString(moduleId), moduleInfo))
+        {
+            moduleBases[moduleId] = moduleInfo.baseAddress;
+        }
+        moduleLookedUp[moduleId] = 1;
+    }
+    return moduleBases;
+}
+
+int PointerChainResolver::ResolveTable(PointerChainTable &table)
+{
+    const size_t count = table.Count();
+    const std::vector<uintptr_t> moduleBases = LookUpModuleBases(table);
+    auto liveRead = [this](uintptr_t address, void *buffer, size_t size)
+    {
+        return m_memoryReader->ReadMemory(address, buffer, size);
+    };
+    const bool checkTorn = m_memoryReader->GetSnapshot() == nullptr;
+    m_tornStats = TornReadStats();
+    TableValueRead value;
+
+    int successCount = 0;
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        uintptr_t moduleBase = moduleBases[table.GetModuleId(index)];
+        if (moduleBase == 0)
+        {
+            table.SetError(index, ChainError::ModuleNotFound);
+            continue;
+        }
+
+        uintptr_t address = 0;
+        uint16_t errorStep = 0;
+        ChainError error = WalkTableChain(*m_memoryReader, table, index, moduleBase + table.GetBaseOffset(index),
+                                          liveRead, address, value, errorStep);
+        if (error != ChainError::None)
+        {
+            table.SetError(index, error, errorStep, address);
+            continue;
+        }
+
+        // Opt-in torn-read check, snapshot reads cannot tear
+        const TornCheck check = table.GetTornCheck(index);
+        bool suspect = false;
+        if (check != TornCheck::None && checkTorn)
+        {
+            const uint32_t offsetCount = table.GetOffsetCount(index);
+            uintptr_t objectBase = offsetCount == 0 ? address : address - table.GetOffsets(index)[offsetCount - 1];
+            suspect = !CheckTornValue(address + value.offset, value.bytes.data(), value.size, check, objectBase,
+                                      table.GetSequenceOffset(index));
+        }
+
+        StoreTableValue(table, index, address, value, suspect);
+        successCount++;
+    }
+
+    DBG_OK(L"Resolved " + std::to_wstring(successCount) + L"/" + std::to_wstring(count) + L" chains from table");
+    if (m_tornStats.suspectValues > 0)
+        DBG_WARN(std::to_wstring(m_tornStats.suspectValues) + L" value(s) flagged as possibly torn");
+    return successCount;
+}
+
+int PointerChainResolver::ResolveTableConsistent(PointerChainTable &table, ProcessPause &pause,
+                                                 ConsistentReadStats *stats)
+{
+    ConsistentReadStats localStats;
+    ConsistentReadStats &out = stats != nullptr ? *stats : localStats;
+    out = ConsistentReadStats();
+    m_tornStats = TornReadStats();
+
+    // Snapshot reads already come from one moment
+    if (m_memoryReader->GetSnapshot() != nullptr)
+        return ResolveTable(table);
+
+    HANDLE processHandle = m_memoryReader->GetProcessHandle();
+    if (!pause.Prepare(::GetProcessId(processHandle)))
+    {
+        DBG_WARN(L"Target cannot be paused, resolving chains without a pause");
+        out.unpaused = table.Count();
+        return ResolveTable(table);
+    }
+
+    const size_t count = table.Count();
+    const std::vector<uintptr_t> moduleBases = LookUpModuleBases(table);
+
+    std::vector<size_t> pending;
+    pending.reserve(count);
+    int successCount = 0;
+    for (size_t index = 0; index < count; ++index)
+    {
+        if (moduleBases[table.GetModuleId(index)] == 0)
+        {
+            table.SetError(index, ChainError::ModuleNotFound);
+            continue;
+        }
+        pending.push_back(index);
+    }
+
+    struct PlannedRead
+    {
+        uintptr_t address;
+        size_t size;
+    };
+    struct ReadSpan
+    {
+        uintptr_t address;
+        size_t size;
+        size_t bufferOffset;
+    };
+    std::vector<PlannedRead> planned;
+    std::vector<ReadSpan> spans;
+    std::vector<uint8_t> buffer;
+    std::vector<uintptr_t> badPages; // Sorted page addresses that failed during the pause
+    std::vector<uint32_t> spanBadPages;
+    std::vector<size_t> replan;
+    TableValueRead value;
+
+    auto planRead = [&](uintptr_t address, void *data, size_t size)
+    {
+        planned.push_back({address, size});
+        return m_memoryReader->ReadMemory(address, data, size);
+    };
+
+    // Served from the paused copy; misses mean the chain moved since it was planned
+    bool missed = false;
+    auto pausedRead = [&](uintptr_t address, void *data, size_t size)
+    {
+        auto it = std::upper_bound(spans.begin(), spans.end(), address,
+                                   [](uintptr_t value, const ReadSpan &span) { return value < span.address; });
+        if (it == spans.begin() || address + size > (it - 1)->address + (it - 1)->size)
+        {
+            missed = true;
+            return false;
+        }
+        const ReadSpan &span = *(it - 1);
+        const uintptr_t firstPage = address & ~static_cast<uintptr_t>(0xFFF);
+        auto bad = std::lower_bound(badPages.begin(), badPages.end(), firstPage);
+        if (bad != badPages.end() && *bad < address + size)
+            return false;
+        memcpy(data, buffer.data() + span.bufferOffset + (address - span.address), size);
+        return true;
+    };
+
+    for (unsigned pass = 0; pass < MAX_CONSISTENT_PASSES && !pending.empty(); ++pass)
+    {
+        // Plan: walk the chains live, recording every address they touch
+        planned.clear();
+        for (size_t index : pending)
+        {
+            uintptr_t address = 0;
+            uint16_t errorStep = 0;
+            WalkTableChain(*m_memoryReader, table, index, moduleBases[table.GetModuleId(index)] + table.GetBaseOffset(index),
+                           planRead, address, value, errorStep);
+        }
+
+        std::sort(planned.begin(), planned.end(),
+                  [](const PlannedRead &a, const PlannedRead &b) { return a.address < b.address; });
+        spans.clear();
+        size_t bufferSize = 0;
+        for (const PlannedRead &read : planned)
+        {
+            if (!spans.empty() && read.address <= spans.back().address + spans.back().size + SPAN_MERGE_GAP)
+            {
+                ReadSpan &last = spans.back();
+                size_t end = (std::max)(last.address + last.size, read.address + read.size) - last.address;
+                bufferSize += end - last.size;
+                last.size = end;
+                continue;
+            }
+            spans.push_back({read.address, read.size, bufferSize});
+            bufferSize += read.size;
+        }
+        buffer.resize(bufferSize);
+
+        // Execute: the whole batch while the target is stopped
+        if (!pause.Suspend())
+        {
+            DBG_WARN(L"Target did not pause, resolving remaining chains without a pause");
+            break;
+        }
+        badPages.clear();
+        for (const ReadSpan &span : spans)
+        {
+            spanBadPages.clear();
+            MemoryReader::ReadRangePadded(processHandle, span.address, buffer.data() + span.bufferOffset, span.size,
+                                          &spanBadPages);
+            for (uint32_t page : spanBadPages)
+            {
+                // Page indices count from the span start, not from a page boundary
+                uintptr_t pageStart = span.address + static_cast<uintptr_t>(page) * 0x1000;
+                uintptr_t pageEnd = (std::min)(pageStart + 0x1000, span.address + span.size);
+                for (uintptr_t p = pageStart & ~static_cast<uintptr_t>(0xFFF); p < pageEnd; p += 0x1000)
+                {
+                    badPages.push_back(p);
+                }
+            }
+        }
+        pause.Resume();
+        std::sort(badPages.begin(), badPages.end());
+        badPages.erase(std::unique(badPages.begin(), badPages.end()), badPages.end());
+
+        out.passes++;
+        out.spanCount += spans.size();
+        out.bytesRead += bufferSize;
+        out.pausedUs += pause.GetLastPauseUs();
+
+        // Replay: walk again on the paused copy
+        replan.clear();
+        for (size_t index : pending)
+        {
+            uintptr_t address = 0;
+            uint16_t errorStep = 0;
+            missed = false;
+            ChainError error = WalkTableChain(*m_memoryReader, table, index,
+                                              moduleBases[table.GetModuleId(index)] + table.GetBaseOffset(index),
+                                              pausedRead, address, value, errorStep);
+            if (missed)
+            {
+                replan.push_back(index);
+                continue;
+            }
+            if (error != ChainError::None)
+            {
+                table.SetError(index, error, errorStep, address);
+                continue;
+            }
+            StoreTableValue(table, index, address, value, false);
+            successCount++;
+        }
+        out.replanned += replan.size();
+        pending.swap(replan);
+    }
+
+    // Chains that kept moving between plan and pause
+    auto liveRead = [this](uintptr_t address, void *data, size_t size)
+    {
+        return m_memoryReader->ReadMemory(address, data, size);
+    };
+    for (size_t index : pending)
+    {
+        uintptr_t address = 0;
+        uint16_t errorStep = 0;
+        ChainError error = WalkTableChain(*m_memoryReader, table, index,
+                                          moduleBases[table.GetModuleId(index)] + table.GetBaseOffset(index), liveRead,
+                                          address, value, errorStep);
+        if (error != ChainError::None)
+        {
+            table.SetError(index, error, errorStep, address);
+            continue;
+        }
+        StoreTableValue(table, index, address, value, false);
+        successCount++;
+    }
+    out.unpaused = pending.size();
+
+    pause.Release();
+    DBG_OK(L"Resolved " + std::to_wstring(successCount) + L"/" + std::to_wstring(count) + L" chains from table in " +
+           std::to_wstring(out.passes) + L" paused pass(es)");
+    return successCount;
+}
+
+size_t PointerChainResolver::ValueSize(ValueType type)
+{
+    switch (type)
+    {
+    case ValueType::INT:
+        return sizeof(int32_t);
+    case ValueType::FLOAT:
+        return sizeof(float);
+    case ValueType::DOUBLE:
+        return sizeof(double);
+    }
+    return sizeof(int32_t);
+}
+
 std::wstring PointerChainResolver::GetResolutionInfo(const PointerChain &chain) const
 {
     std::wstringstream ss;
@@ -240,6 +786,6 @@ std::wstring PointerChainResolver::GetResolutionInfo(const PointerChain &chain)
 std::wstring PointerChainResolver::FormatHex(uintptr_t value)
 {
     wchar_t buffer[32];
-    swprintf_s(buffer, L"0x%llX", value);
+    swprintf(buffer, 32, L"0x%llX", static_cast<unsigned long long>(value));
     return buffer;
 }
@@ -1,11 +1,25 @@
 #pragma once
 
-#include <Windows.h>
+#include "Platform.h"
 #include <cstdint>
 #include <vector>
 #include <string>
 #include "ModuleRegistry.h"
 #include "MemoryReader.h"
+#include "PointerChainTable.h"
+
+// One field of a chain's field group, all fields are read in one span
+struct ChainField
+{
+    uintptr_t offset;  // From the chain's final address
+    ValueType type;
+    std::wstring name; // "MaxHealth"
+    MemoryValue value; // Runtime, last read value
+
+    ChainField() : offset(0), type(ValueType::INT), value()
+    {
+    }
+};
 
 // Single pointer chain configuration
 struct PointerChain
@@ -15,24 +29,56 @@ struct PointerChain
     std::vector<uintptr_t> offsets; // [0x18, 0x70, 0x370, 0x2D0]
     ValueType valueType;            // INT / FLOAT / DOUBLE
     std::wstring description;       // "Player HP"
+    TornCheck tornCheck;            // Opt-in validation of the final read
+    uintptr_t sequenceOffset;       // TornCheck::Sequence: counter offset in the value's object
+    std::vector<ChainField> fields; // Field group read instead of one value (valueType = first field's)
 
     // Runtime (not saved to file)
     uintptr_t resolvedAddress; // Final calculated address
     MemoryValue currentValue;  // Last read value
     bool isResolved;           // Successfully resolved
+    bool isSuspect;            // Torn-read check still failing after the retry budget
     std::wstring lastError;    // Error message if resolution failed
 
     PointerChain()
-        : baseOffset(0), valueType(ValueType::INT),
-          resolvedAddress(0), isResolved(false)
+        : baseOffset(0), valueType(ValueType::INT), tornCheck(TornCheck::None), sequenceOffset(0),
+          resolvedAddress(0), isResolved(false), isSuspect(false)
     {
     }
 };
 
+class ProcessPause;
+
+// Outcome of one ResolveTableConsistent call
+struct ConsistentReadStats
+{
+    unsigned passes = 0;   // Plan / pause / replay rounds
+    size_t spanCount = 0;  // Coalesced reads issued while paused
+    size_t bytesRead = 0;
+    size_t replanned = 0;  // Chains whose path moved between plan and pause
+    size_t unpaused = 0;   // Chains finally read without a pause
+    double pausedUs = 0;   // Target stopped for this long in total
+};
+
+// Torn-read checks of the last ResolveAllChains / ResolveTable call
+struct TornReadStats
+{
+    size_t checkedValues = 0; // Values of chains that opted in
+    size_t extraReads = 0;    // Reads beyond the single value read
+    size_t retriedValues = 0; // Values that changed at least once while checked
+    size_t suspectValues = 0; // Still inconsistent when the retry budget ran out
+    double checkUs = 0;       // Time spent checking
+};
+
 // Resolves pointer chains step-by-step with validation
 class PointerChainResolver
 {
 public:
+    static constexpr unsigned MAX_CONSISTENT_PASSES = 3;
+    static constexpr size_t SPAN_MERGE_GAP = 256; // Planned reads closer than this are read as one span
+    static constexpr unsigned TORN_RETRY_BUDGET = 8; // Attempts per checked value before it is flagged suspect
+    static constexpr size_t MAX_FIELD_SPAN = 0x10000;  // Largest field group span read in one call
+
     PointerChainResolver(
         const ModuleRegistry *moduleRegistry,
         MemoryReader *memoryReader);
@@ -43,12 +89,36 @@ public:
     // Resolve all chains in collection
     int ResolveAllChains(std::vector<PointerChain> &chains);
 
+    // Resolve all chains of a compact table, results go to its runtime columns
+    int ResolveTable(PointerChainTable &table);
+
+    // Same results from a single moment of the target: walks the chains live
+    // to plan their reads, merges them into spans, reads the spans while the
+    // target is paused and replays the walks on that copy. Chains whose path
+    // moved in between are planned again, up to MAX_CONSISTENT_PASSES times
+    int ResolveTableConsistent(PointerChainTable &table, ProcessPause &pause, ConsistentReadStats *stats = nullptr);
+
+    const TornReadStats &GetTornReadStats() const { return m_tornStats; }
+
     // Get detailed resolution info for display
     std::wstring GetResolutionInfo(const PointerChain &chain) const;
 
+    // Size in bytes of a value type in target memory
+    static size_t ValueSize(ValueType type);
+
+    // Bytes a field group read covers: lowest field offset to the end of the highest field
+    static void FieldGroupSpan(const std::vector<ChainField> &fields, uintptr_t &begin, size_t &size);
+
+    // False, with the reason in error, if a field group spans more than MAX_FIELD_SPAN
+    static bool CheckFieldSpan(const std::vector<ChainField> &fields, std::wstring &error);
+
 private:
     const ModuleRegistry *m_moduleRegistry;
     MemoryReader *m_memoryReader;
+    TornReadStats m_tornStats;
+
+    // Base address per pooled module name id of the table, 0 if not loaded
+    std::vector<uintptr_t> LookUpModuleBases(const PointerChainTable &table) const;
 
     // Step-by-step pointer following with validation
     bool ResolveStep(uintptr_t &currentPtr, uintptr_t offset);
@@ -56,6 +126,15 @@ private:
     // Read final value based on type
     bool ReadFinalValue(uintptr_t address, PointerChain &chain);
 
+    // Read the span of the chain's field group in one call and decode each field
+    bool ReadFieldGroup(uintptr_t address, PointerChain &chain);
+
+    // Re-validate a live read of size bytes at address (value holds the first
+    // read, gets the accepted one); objectBase is the address the last offset
+    // was added to. False if the bytes still looked torn when the retry budget ran out
+    bool CheckTornValue(uintptr_t address, void *value, size_t size, TornCheck check, uintptr_t objectBase,
+                        uintptr_t sequenceOffset);
+
     // Format hex address with leading zeros
     static std::wstring FormatHex(uintptr_t value);
 };
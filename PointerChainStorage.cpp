@@ -1,11 +1,18 @@
 #include "PointerChainStorage.h"
+#include "MappedFile.h"
+#include "JsonSaxParser.h"
+#include "StringUtils.h"
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <thread>
 
-// Simple JSON builder for pointer chains without external dependencies
+// Value type names used in the chain file format
 class SimpleJSON
 {
 public:
@@ -23,173 +30,1180 @@ public:
             return "int";
         }
     }
+};
+
+static void FormatChain(const PointerChain &chain, std::string &out);
+
+void PointerChainStorage::AddChain(const PointerChain &chain)
+{
+    m_chains.push_back(chain);
+    m_modified = true;
+    m_tableDirty = true;
+
+    std::string line;
+    FormatChain(chain, line);
+    m_journal.Record(JournalOp::Add, line);
+}
+
+void PointerChainStorage::RemoveChain(size_t index)
+{
+    if (index < m_chains.size())
+    {
+        m_chains.erase(m_chains.begin() + index);
+        m_modified = true;
+        m_tableDirty = true;
+        m_journal.Record(JournalOp::Remove, std::to_string(index));
+    }
+}
+
+// Files below this size are parsed on the calling thread
+static const size_t PARALLEL_PARSE_THRESHOLD = 1 << 20;
+static const size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+// Output buffer is flushed to the file when it grows past this size
+static const size_t SAVE_BUFFER_SIZE = 1 << 20;
+
+// One slice of the file, parsed independently; line numbers are chunk-relative
+struct ChainParseChunk
+{
+    const char *begin;
+    const char *end;
+    std::vector<PointerChain> chains;
+    std::vector<BuildSection> sections; // first is chunk-relative
+    std::vector<std::pair<int, std::wstring>> warnings;
+    int lineCount;
+};
+
+static inline void TrimSpaces(const char *&begin, const char *&end)
+{
+    while (begin < end && (*begin == ' ' || *begin == '\t'))
+        ++begin;
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t'))
+        --end;
+}
+
+static ValueType ParseValueType(const char *begin, const char *end)
+{
+    size_t length = end - begin;
+    if (length == 5 && memcmp(begin, "float", 5) == 0)
+        return ValueType::FLOAT;
+    if (length == 6 && memcmp(begin, "double", 6) == 0)
+        return ValueType::DOUBLE;
+    return ValueType::INT;
+}
+
+// Strict form for fields: unknown names are rejected instead of read as int
+static bool ParseFieldType(const char *begin, const char *end, ValueType &type)
+{
+    size_t length = end - begin;
+    if (length == 3 && memcmp(begin, "int", 3) == 0)
+        type = ValueType::INT;
+    else if (length == 5 && memcmp(begin, "float", 5) == 0)
+        type = ValueType::FLOAT;
+    else if (length == 6 && memcmp(begin, "double", 6) == 0)
+        type = ValueType::DOUBLE;
+    else
+        return false;
+    return true;
+}
+
+// One field group item: "<hex offset> <type> <name>", the name may contain spaces
+static bool ParseField(const char *begin, const char *end, ChainField &field, std::wstring &warning)
+{
+    TrimSpaces(begin, end);
+    const char *offsetEnd = begin;
+    while (offsetEnd < end && *offsetEnd != ' ' && *offsetEnd != '\t')
+        ++offsetEnd;
+    const char *typeBegin = offsetEnd;
+    const char *nameEnd = end;
+    TrimSpaces(typeBegin, nameEnd);
+    const char *typeEnd = typeBegin;
+    while (typeEnd < nameEnd && *typeEnd != ' ' && *typeEnd != '\t')
+        ++typeEnd;
+    const char *nameBegin = typeEnd;
+    TrimSpaces(nameBegin, nameEnd);
+
+    if (!StringUtils::ParseHex(begin, offsetEnd, field.offset) || !ParseFieldType(typeBegin, typeEnd, field.type))
+    {
+        warning = L"Failed to parse field: " + StringUtils::Utf8ToWide(begin, end - begin);
+        return false;
+    }
+    StringUtils::Utf8ToWide(nameBegin, nameEnd - nameBegin, field.name);
+    if (!PointerChainStorage::IsValidFieldName(field.name))
+    {
+        warning = L"Field name contains , ) | ; or a line break: " + field.name;
+        return false;
+    }
+    return true;
+}
+
+// Field group in place of the value type: "fields(0x0 int Health, 0x4 int MaxHealth, 0x10 float Speed)"
+static bool ParseFieldGroup(const char *begin, const char *end, PointerChain &chain, std::wstring &warning)
+{
+    chain.fields.clear();
+    const char *cursor = begin;
+    while (cursor < end)
+    {
+        const char *itemEnd = static_cast<const char *>(memchr(cursor, ',', end - cursor));
+        if (itemEnd == nullptr)
+            itemEnd = end;
+
+        ChainField &field = chain.fields.emplace_back();
+        if (!ParseField(cursor, itemEnd, field, warning))
+            return false;
+        cursor = itemEnd + 1;
+    }
+
+    if (chain.fields.empty())
+    {
+        warning = L"Empty field group";
+        return false;
+    }
+    if (!PointerChainResolver::CheckFieldSpan(chain.fields, warning))
+        return false;
+    chain.valueType = chain.fields.front().type;
+    return true;
+}
 
-    static ValueType StringToValueType(const std::string &str)
+static void AppendFieldGroup(const PointerChain &chain, std::string &out)
+{
+    out += "fields(";
+    for (size_t i = 0; i < chain.fields.size(); ++i)
     {
-        if (str == "int")
-            return ValueType::INT;
-        if (str == "float")
-            return ValueType::FLOAT;
-        if (str == "double")
-            return ValueType::DOUBLE;
-        return ValueType::INT;
+        const ChainField &field = chain.fields[i];
+        if (i > 0)
+            out += ", ";
+        StringUtils::AppendHex(field.offset, out);
+        out += ' ';
+        out += SimpleJSON::ValueTypeToString(field.type);
+        out += ' ';
+        StringUtils::AppendUtf8(field.name, out);
+    }
+    out += ')';
+}
+
+// Torn-read option: "reread" or "seq=<hex offset of the counter in the value's object>"
+static bool ParseTornCheck(const char *begin, const char *end, PointerChain &chain)
+{
+    size_t length = end - begin;
+    if (length == 6 && memcmp(begin, "reread", 6) == 0)
+    {
+        chain.tornCheck = TornCheck::Reread;
+        return true;
+    }
+    if (length > 4 && memcmp(begin, "seq=", 4) == 0 && StringUtils::ParseHex(begin + 4, end, chain.sequenceOffset))
+    {
+        chain.tornCheck = TornCheck::Sequence;
+        return true;
     }
+    return false;
+}
 
-    static std::string UintPtrToHexString(uintptr_t value)
+static void AppendTornCheck(const PointerChain &chain, std::string &out)
+{
+    if (chain.tornCheck == TornCheck::Reread)
+    {
+        out += "reread";
+    }
+    else if (chain.tornCheck == TornCheck::Sequence)
     {
-        std::ostringstream oss;
-        oss << "0x" << std::hex << std::uppercase << value;
-        return oss.str();
+        out += "seq=";
+        StringUtils::AppendHex(chain.sequenceOffset, out);
     }
+}
+
+static void ParseChunk(ChainParseChunk &chunk)
+{
+    const char *cursor = chunk.begin;
+    chunk.lineCount = 0;
+    chunk.chains.reserve(std::count(chunk.begin, chunk.end, '\n') + 1);
 
-    static uintptr_t HexStringToUintPtr(const std::string &str)
+    while (cursor < chunk.end)
     {
-        try
+        const char *lineEnd = static_cast<const char *>(memchr(cursor, '\n', chunk.end - cursor));
+        if (lineEnd == nullptr)
+            lineEnd = chunk.end;
+
+        const char *lineBegin = cursor;
+        cursor = lineEnd < chunk.end ? lineEnd + 1 : chunk.end;
+        chunk.lineCount++;
+
+        if (lineEnd > lineBegin && lineEnd[-1] == '\r')
+            --lineEnd;
+
+        // Skip empty lines and comments
+        if (lineBegin == lineEnd || *lineBegin == '#')
+            continue;
+
+        std::wstring build;
+        if (ParseBuildSection(lineBegin, lineEnd, build))
         {
-            return std::stoull(str, nullptr, 16);
+            chunk.sections.push_back({chunk.chains.size(), std::move(build)});
+            continue;
         }
-        catch (...)
+
+        PointerChain &chain = chunk.chains.emplace_back();
+        std::wstring warning;
+        if (!PointerChainStorage::ParseLine(lineBegin, lineEnd, chain, warning))
         {
-            return 0;
+            if (!warning.empty())
+                chunk.warnings.emplace_back(chunk.lineCount, std::move(warning));
+            chunk.chains.pop_back();
         }
     }
-};
-
-void PointerChainStorage::AddChain(const PointerChain &chain)
-{
-    m_chains.push_back(chain);
-    m_modified = true;
 }
 
-void PointerChainStorage::RemoveChain(size_t index)
+bool PointerChainStorage::ParseLine(const char *begin, const char *end, PointerChain &chain, std::wstring &warning)
 {
-    if (index < m_chains.size())
+    // Parse line: moduleName|baseOffset|offsets|valueType[;tornCheck]|description
+    // valueType is either a type name or a field group, fields(...)
+    const char *fields[4];
+    const char *fieldCursor = begin;
+    for (int found = 0; found < 4; ++found)
     {
-        m_chains.erase(m_chains.begin() + index);
-        m_modified = true;
+        fields[found] = static_cast<const char *>(memchr(fieldCursor, '|', end - fieldCursor));
+        if (fields[found] == nullptr)
+            return false;
+        fieldCursor = fields[found] + 1;
+    }
+
+    const char *baseBegin = fields[0] + 1;
+    const char *baseEnd = fields[1];
+    TrimSpaces(baseBegin, baseEnd);
+    if (!StringUtils::ParseHex(baseBegin, baseEnd, chain.baseOffset))
+    {
+        warning = L"Failed to parse base offset: " + StringUtils::Utf8ToWide(baseBegin, baseEnd - baseBegin);
+        return false;
+    }
+
+    // Comma separated offsets, empty items are ignored
+    const char *offsetCursor = fields[1] + 1;
+    const char *offsetsEnd = fields[2];
+    while (offsetCursor < offsetsEnd)
+    {
+        const char *itemEnd = static_cast<const char *>(memchr(offsetCursor, ',', offsetsEnd - offsetCursor));
+        if (itemEnd == nullptr)
+            itemEnd = offsetsEnd;
+
+        const char *itemBegin = offsetCursor;
+        offsetCursor = itemEnd + 1;
+        TrimSpaces(itemBegin, itemEnd);
+        if (itemBegin == itemEnd)
+            continue;
+
+        uintptr_t offset = 0;
+        if (!StringUtils::ParseHex(itemBegin, itemEnd, offset))
+        {
+            warning = L"Failed to parse offset: " + StringUtils::Utf8ToWide(itemBegin, itemEnd - itemBegin);
+            return false;
+        }
+        chain.offsets.push_back(offset);
+    }
+
+    const char *typeBegin = fields[2] + 1;
+    const char *typeEnd = fields[3];
+    TrimSpaces(typeBegin, typeEnd);
+    const bool isGroup = typeEnd - typeBegin > 7 && memcmp(typeBegin, "fields(", 7) == 0;
+    const char *groupEnd = isGroup ? static_cast<const char *>(memchr(typeBegin, ')', typeEnd - typeBegin)) : typeBegin;
+    if (groupEnd == nullptr)
+    {
+        warning = L"Unterminated field group: " + StringUtils::Utf8ToWide(typeBegin, typeEnd - typeBegin);
+        return false;
     }
+    const char *option = static_cast<const char *>(memchr(groupEnd, ';', typeEnd - groupEnd));
+    if (option != nullptr)
+    {
+        const char *optionBegin = option + 1;
+        const char *optionEnd = typeEnd;
+        TrimSpaces(optionBegin, optionEnd);
+        if (!ParseTornCheck(optionBegin, optionEnd, chain))
+        {
+            warning = L"Unknown torn-read check: " + StringUtils::Utf8ToWide(optionBegin, optionEnd - optionBegin);
+            return false;
+        }
+        typeEnd = option;
+    }
+    if (isGroup)
+    {
+        if (!ParseFieldGroup(typeBegin + 7, groupEnd, chain, warning))
+            return false;
+    }
+    else
+    {
+        TrimSpaces(typeBegin, typeEnd);
+        chain.valueType = ParseValueType(typeBegin, typeEnd);
+    }
+
+    StringUtils::Utf8ToWide(begin, fields[0] - begin, chain.moduleName);
+    StringUtils::Utf8ToWide(fields[3] + 1, end - (fields[3] + 1), chain.description);
+    return true;
 }
 
-bool PointerChainStorage::LoadFromFile(const std::wstring &filename)
+// Builds chains from JSON events:
+// { "pointer_chains": [ { "module", "baseOffset", "offsets", "valueType", "tornCheck", "description",
+//                          "fields": [ { "offset", "type", "name" } ] } ] }
+// Unknown keys are skipped together with their values
+class ChainJsonHandler : public JsonSaxHandler
 {
-    try
+public:
+    ChainJsonHandler(std::vector<PointerChain> &chains, std::vector<BuildSection> *sections)
+        : m_chains(chains), m_sections(sections), m_level(Level::Root), m_field(Field::Other), m_skipDepth(0),
+          m_chainIndex(0), m_chainValid(true)
+    {
+    }
+
+    bool StartObject() override
+    {
+        if (m_skipDepth > 0)
+        {
+            ++m_skipDepth;
+        }
+        else if (m_level == Level::Root)
+        {
+            m_level = Level::Top;
+        }
+        else if (m_level == Level::Chains)
+        {
+            m_chains.emplace_back();
+            m_chainValid = true;
+            m_chainBuild.clear();
+            m_level = Level::Chain;
+        }
+        else if (m_level == Level::Fields)
+        {
+            m_chains.back().fields.emplace_back();
+            m_level = Level::FieldItem;
+        }
+        else
+        {
+            ++m_skipDepth;
+        }
+        m_field = Field::Other;
+        return true;
+    }
+
+    bool EndObject() override
+    {
+        if (m_skipDepth > 0)
+        {
+            --m_skipDepth;
+            return true;
+        }
+        if (m_level == Level::FieldItem)
+        {
+            m_level = Level::Fields;
+        }
+        else if (m_level == Level::Chain)
+        {
+            // A field group's value type is its first field's
+            if (!m_chains.back().fields.empty())
+                m_chains.back().valueType = m_chains.back().fields.front().type;
+
+            // Same span limit as text lines
+            std::wstring error;
+            if (m_chainValid && !PointerChainResolver::CheckFieldSpan(m_chains.back().fields, error))
+            {
+                std::wcerr << L"[!] " << error << L" in chain " << m_chainIndex + 1 << std::endl;
+                m_chainValid = false;
+            }
+
+            if (!m_chainValid)
+            {
+                m_chains.pop_back();
+            }
+            else if (m_chainBuild != m_currentBuild)
+            {
+                m_currentBuild = m_chainBuild;
+                if (m_sections != nullptr)
+                    m_sections->push_back({m_chains.size() - 1, m_currentBuild});
+            }
+            m_chainIndex++;
+            m_level = Level::Chains;
+        }
+        else if (m_level == Level::Top)
+        {
+            m_level = Level::Done;
+        }
+        return true;
+    }
+
+    bool StartArray() override
     {
-        std::wifstream file(filename);
-        if (!file.is_open())
+        if (m_skipDepth > 0)
+        {
+            ++m_skipDepth;
+        }
+        else if (m_level == Level::Root)
         {
-            std::wcerr << L"[-] Failed to open file: " << filename << std::endl;
+            m_error = L"Top-level value must be an object";
             return false;
         }
+        else if (m_level == Level::Top && m_field == Field::PointerChains)
+        {
+            m_level = Level::Chains;
+        }
+        else if (m_level == Level::Chain && m_field == Field::Offsets)
+        {
+            m_level = Level::Offsets;
+        }
+        else if (m_level == Level::Chain && m_field == Field::Fields)
+        {
+            m_level = Level::Fields;
+        }
+        else
+        {
+            ++m_skipDepth;
+        }
+        m_field = Field::Other;
+        return true;
+    }
 
-        m_chains.clear();
-        std::wstring line;
+    bool EndArray() override
+    {
+        if (m_skipDepth > 0)
+        {
+            --m_skipDepth;
+            return true;
+        }
+        m_level = m_level == Level::Offsets || m_level == Level::Fields ? Level::Chain : Level::Top;
+        return true;
+    }
 
-        while (std::getline(file, line))
+    bool Key(const char *data, size_t length) override
+    {
+        if (m_skipDepth > 0)
+            return true;
+
+        m_field = Field::Other;
+        if (m_level == Level::Top)
+        {
+            if (Equals(data, length, "pointer_chains"))
+                m_field = Field::PointerChains;
+        }
+        else if (m_level == Level::Chain)
         {
-            // Skip empty lines and comments
-            if (line.empty() || line[0] == L'#')
-                continue;
+            if (Equals(data, length, "module"))
+                m_field = Field::Module;
+            else if (Equals(data, length, "baseOffset"))
+                m_field = Field::BaseOffset;
+            else if (Equals(data, length, "offsets"))
+                m_field = Field::Offsets;
+            else if (Equals(data, length, "valueType"))
+                m_field = Field::ValueType;
+            else if (Equals(data, length, "tornCheck"))
+                m_field = Field::TornCheck;
+            else if (Equals(data, length, "description"))
+                m_field = Field::Description;
+            else if (Equals(data, length, "build"))
+                m_field = Field::Build;
+            else if (Equals(data, length, "fields"))
+                m_field = Field::Fields;
+        }
+        else if (m_level == Level::FieldItem)
+        {
+            if (Equals(data, length, "offset"))
+                m_field = Field::FieldOffset;
+            else if (Equals(data, length, "type"))
+                m_field = Field::FieldType;
+            else if (Equals(data, length, "name"))
+                m_field = Field::FieldName;
+        }
+        return true;
+    }
 
-            // Parse line: moduleName|baseOffset|offsets|valueType|description
-            size_t pos1 = line.find(L'|');
-            if (pos1 == std::wstring::npos)
-                continue;
+    bool String(const char *data, size_t length) override
+    {
+        if (m_skipDepth > 0)
+            return true;
 
-            size_t pos2 = line.find(L'|', pos1 + 1);
-            if (pos2 == std::wstring::npos)
-                continue;
+        if (m_level == Level::Offsets)
+        {
+            AddOffset(data, length, false);
+            return true;
+        }
+        if (m_level == Level::FieldItem)
+        {
+            SetFieldValue(data, length, false);
+            return true;
+        }
+        if (m_level != Level::Chain)
+            return true;
 
-            size_t pos3 = line.find(L'|', pos2 + 1);
-            if (pos3 == std::wstring::npos)
-                continue;
+        PointerChain &chain = m_chains.back();
+        switch (m_field)
+        {
+        case Field::Module:
+            StringUtils::Utf8ToWide(data, length, chain.moduleName);
+            break;
+        case Field::Description:
+            StringUtils::Utf8ToWide(data, length, chain.description);
+            break;
+        case Field::Build:
+            StringUtils::Utf8ToWide(data, length, m_chainBuild);
+            break;
+        case Field::ValueType:
+            chain.valueType = ParseValueType(data, data + length);
+            break;
+        case Field::TornCheck:
+            if (!ParseTornCheck(data, data + length, chain) && m_chainValid)
+            {
+                std::wcerr << L"[!] Unknown torn-read check in chain " << m_chainIndex + 1 << L": "
+                           << StringUtils::Utf8ToWide(data, length) << std::endl;
+                m_chainValid = false;
+            }
+            break;
+        case Field::BaseOffset:
+            ParseOffsetValue(data, length, false, chain.baseOffset, L"base offset");
+            break;
+        default:
+            break;
+        }
+        m_field = Field::Other;
+        return true;
+    }
 
-            size_t pos4 = line.find(L'|', pos3 + 1);
-            if (pos4 == std::wstring::npos)
-                continue;
+    bool Number(const char *data, size_t length) override
+    {
+        if (m_skipDepth > 0)
+            return true;
 
-            PointerChain chain;
+        if (m_level == Level::Offsets)
+        {
+            AddOffset(data, length, true);
+        }
+        else if (m_level == Level::Chain && m_field == Field::BaseOffset)
+        {
+            ParseOffsetValue(data, length, true, m_chains.back().baseOffset, L"base offset");
+        }
+        else if (m_level == Level::FieldItem)
+        {
+            SetFieldValue(data, length, true);
+        }
+        m_field = Field::Other;
+        return true;
+    }
 
-            // Extract fields
-            chain.moduleName = line.substr(0, pos1);
+    bool Bool(bool) override
+    {
+        m_field = Field::Other;
+        return true;
+    }
 
-            std::string baseOffsetStr(line.substr(pos1 + 1, pos2 - pos1 - 1).begin(),
-                                      line.substr(pos1 + 1, pos2 - pos1 - 1).end());
-            chain.baseOffset = SimpleJSON::HexStringToUintPtr(baseOffsetStr);
+    bool Null() override
+    {
+        m_field = Field::Other;
+        return true;
+    }
 
-            std::wstring offsetsStr = line.substr(pos2 + 1, pos3 - pos2 - 1);
-            std::wistringstream offsetStream(offsetsStr);
-            std::wstring offsetHex;
-            while (std::getline(offsetStream, offsetHex, L','))
+    // Reason when a callback stopped the parser
+    const std::wstring &GetError() const { return m_error; }
+
+private:
+    enum class Level
+    {
+        Root,      // Before the top-level object
+        Top,       // Inside the top-level object
+        Chains,    // Inside "pointer_chains"
+        Chain,     // Inside one chain object
+        Offsets,   // Inside a chain's "offsets"
+        Fields,    // Inside a chain's "fields"
+        FieldItem, // Inside one field object
+        Done
+    };
+
+    enum class Field
+    {
+        Other,
+        PointerChains,
+        Module,
+        BaseOffset,
+        Offsets,
+        ValueType,
+        TornCheck,
+        Description,
+        Build,
+        Fields,
+        FieldOffset,
+        FieldType,
+        FieldName
+    };
+
+    std::vector<PointerChain> &m_chains;
+    std::vector<BuildSection> *m_sections;
+    Level m_level;
+    Field m_field;
+    int m_skipDepth;
+    size_t m_chainIndex;
+    bool m_chainValid;
+    std::wstring m_chainBuild;   // "build" of the chain being parsed
+    std::wstring m_currentBuild; // Build of the last emitted section
+    std::wstring m_error;
+
+    static bool Equals(const char *data, size_t length, const char *literal)
+    {
+        return strlen(literal) == length && memcmp(data, literal, length) == 0;
+    }
+
+    void ParseOffsetValue(const char *data, size_t length, bool decimal, uintptr_t &outValue, const wchar_t *what)
+    {
+        bool parsed;
+        if (decimal)
+        {
+            auto result = std::from_chars(data, data + length, outValue);
+            parsed = result.ec == std::errc() && result.ptr == data + length;
+        }
+        else
+        {
+            parsed = StringUtils::ParseHex(data, data + length, outValue);
+        }
+
+        if (!parsed && m_chainValid)
+        {
+            std::wcerr << L"[!] Failed to parse " << what << L" in chain " << m_chainIndex + 1 << L": "
+                       << StringUtils::Utf8ToWide(data, length) << std::endl;
+            m_chainValid = false;
+        }
+    }
+
+    void AddOffset(const char *data, size_t length, bool decimal)
+    {
+        uintptr_t offset = 0;
+        ParseOffsetValue(data, length, decimal, offset, L"offset");
+        m_chains.back().offsets.push_back(offset);
+    }
+
+    void SetFieldValue(const char *data, size_t length, bool number)
+    {
+        ChainField &field = m_chains.back().fields.back();
+        if (m_field == Field::FieldOffset)
+        {
+            ParseOffsetValue(data, length, number, field.offset, L"field offset");
+        }
+        else if (m_field == Field::FieldType && !number)
+        {
+            if (!ParseFieldType(data, data + length, field.type) && m_chainValid)
             {
-                std::string offsetStr(offsetHex.begin(), offsetHex.end());
-                chain.offsets.push_back(SimpleJSON::HexStringToUintPtr(offsetStr));
+                std::wcerr << L"[!] Unknown field type in chain " << m_chainIndex + 1 << L": "
+                           << StringUtils::Utf8ToWide(data, length) << std::endl;
+                m_chainValid = false;
             }
+        }
+        else if (m_field == Field::FieldName && !number)
+        {
+            StringUtils::Utf8ToWide(data, length, field.name);
+            if (!PointerChainStorage::IsValidFieldName(field.name) && m_chainValid)
+            {
+                std::wcerr << L"[!] Field name contains , ) | ; or a line break in chain " << m_chainIndex + 1 << L": "
+                           << field.name << std::endl;
+                m_chainValid = false;
+            }
+        }
+        m_field = Field::Other;
+    }
+};
+
+void PointerChainStorage::ParseBuffer(const char *data, size_t size, std::vector<PointerChain> &outChains,
+                                      std::vector<BuildSection> *outSections)
+{
+    const char *bufferEnd = data + size;
+
+    // Skip UTF-8 BOM
+    if (size >= 3 && static_cast<unsigned char>(data[0]) == 0xEF &&
+        static_cast<unsigned char>(data[1]) == 0xBB && static_cast<unsigned char>(data[2]) == 0xBF)
+    {
+        data += 3;
+    }
+
+    // Split at line boundaries into one chunk per worker
+    size_t workerCount = 1;
+    if (static_cast<size_t>(bufferEnd - data) >= PARALLEL_PARSE_THRESHOLD)
+    {
+        workerCount = (std::max)(1u, std::thread::hardware_concurrency());
+        workerCount = (std::min)(workerCount, static_cast<size_t>(bufferEnd - data) / MIN_CHUNK_SIZE);
+    }
 
-            std::string valueTypeStr(line.substr(pos3 + 1, pos4 - pos3 - 1).begin(),
-                                     line.substr(pos3 + 1, pos4 - pos3 - 1).end());
-            chain.valueType = SimpleJSON::StringToValueType(valueTypeStr);
+    std::vector<ChainParseChunk> chunks(workerCount);
+    const char *chunkBegin = data;
+    for (size_t i = 0; i < workerCount; ++i)
+    {
+        const char *chunkEnd = bufferEnd;
+        if (i + 1 < workerCount)
+        {
+            chunkEnd = chunkBegin + (bufferEnd - chunkBegin) / (workerCount - i);
+            const char *newline = static_cast<const char *>(memchr(chunkEnd, '\n', bufferEnd - chunkEnd));
+            chunkEnd = newline ? newline + 1 : bufferEnd;
+        }
+        chunks[i].begin = chunkBegin;
+        chunks[i].end = chunkEnd;
+        chunkBegin = chunkEnd;
+    }
 
-            chain.description = line.substr(pos4 + 1);
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < chunks.size(); ++i)
+    {
+        threads.emplace_back(ParseChunk, std::ref(chunks[i]));
+    }
+    ParseChunk(chunks[0]);
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    // Merge in file order, warnings get absolute line numbers
+    size_t total = outChains.size();
+    for (const auto &chunk : chunks)
+    {
+        total += chunk.chains.size();
+    }
+    outChains.reserve(total);
 
-            m_chains.push_back(chain);
+    int firstLine = 0;
+    for (auto &chunk : chunks)
+    {
+        for (const auto &warning : chunk.warnings)
+        {
+            std::wcerr << L"[!] " << warning.second << L" at line " << firstLine + warning.first << std::endl;
         }
+        if (outSections != nullptr)
+        {
+            for (auto &section : chunk.sections)
+            {
+                outSections->push_back({outChains.size() + section.first, std::move(section.key)});
+            }
+        }
+        std::move(chunk.chains.begin(), chunk.chains.end(), std::back_inserter(outChains));
+        firstLine += chunk.lineCount;
+    }
+}
+
+bool PointerChainStorage::ParseJsonBuffer(const char *data, size_t size, std::vector<PointerChain> &outChains,
+                                          std::vector<BuildSection> *outSections)
+{
+    ChainJsonHandler handler(outChains, outSections);
+    JsonSaxParser parser;
+    if (!parser.Parse(data, size, handler))
+    {
+        const std::wstring &reason = handler.GetError().empty() ? parser.GetError() : handler.GetError();
+        std::wcerr << L"[-] JSON error at line " << parser.GetErrorLine() << L": " << reason << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool PointerChainStorage::IsJsonBuffer(const char *data, size_t size)
+{
+    const char *end = data + size;
+    if (size >= 3 && static_cast<unsigned char>(data[0]) == 0xEF &&
+        static_cast<unsigned char>(data[1]) == 0xBB && static_cast<unsigned char>(data[2]) == 0xBF)
+    {
+        data += 3;
+    }
+
+    while (data < end && (*data == ' ' || *data == '\t' || *data == '\r' || *data == '\n'))
+        ++data;
+
+    // Pipe format lines start with a module name or '#'
+    return data < end && *data == '{';
+}
+
+bool PointerChainStorage::IsJsonFilename(const std::wstring &filename)
+{
+    const std::wstring extension = L".json";
+    if (filename.size() < extension.size())
+        return false;
+
+    return _wcsicmp(filename.c_str() + filename.size() - extension.size(), extension.c_str()) == 0;
+}
 
-        file.close();
-        std::wcout << L"[+] Loaded " << m_chains.size() << L" pointer chains from file" << std::endl;
+bool PointerChainStorage::LoadFromFile(const std::wstring &filename)
+{
+    m_chains.clear();
+    m_builds.Clear();
+    m_tableDirty = true;
+
+    std::vector<BuildSection> sections;
+    if (!ReadChains(filename, m_chains, sections))
+    {
+        m_chains.clear();
+        return false;
+    }
+    m_builds.Load(m_chains, sections);
+    m_filename = filename;
+
+    size_t replayed = m_journal.Replay(filename, [this](JournalOp op, const char *payload, size_t length)
+                                       { return ReplayOp(op, payload, length); });
+
+    std::wcout << L"[+] Loaded " << m_chains.size() << L" pointer chains from file";
+    if (m_builds.GetSetCount() > 1)
+        std::wcout << L" (" << m_builds.GetSetCount() << L" build sets)";
+    if (replayed > 0)
+        std::wcout << L" (" << replayed << L" journaled edits)";
+    std::wcout << std::endl;
+    return true;
+}
+
+bool PointerChainStorage::ReplayOp(JournalOp op, const char *payload, size_t length)
+{
+    switch (op)
+    {
+    case JournalOp::Add:
+    {
+        PointerChain chain;
+        std::wstring warning;
+        if (!ParseLine(payload, payload + length, chain, warning))
+            return false;
+        m_chains.push_back(std::move(chain));
         return true;
     }
-    catch (const std::exception &e)
+    case JournalOp::Remove:
     {
-        std::cerr << "[-] Error loading chains: " << e.what() << std::endl;
+        size_t index = 0;
+        auto result = std::from_chars(payload, payload + length, index);
+        if (result.ec != std::errc() || result.ptr != payload + length || index >= m_chains.size())
+            return false;
+        m_chains.erase(m_chains.begin() + index);
+        return true;
+    }
+    case JournalOp::Clear:
+        m_chains.clear();
+        return true;
+    case JournalOp::Select:
+        m_builds.Switch(m_chains, StringUtils::Utf8ToWide(payload, length));
+        return true;
+    }
+    return false;
+}
+
+bool PointerChainStorage::ReadChains(const std::wstring &filename, std::vector<PointerChain> &outChains,
+                                     std::vector<BuildSection> &outSections)
+{
+    MappedFile file;
+    if (!file.Open(filename))
+    {
+        std::wcerr << L"[-] Failed to open file: " << filename << std::endl;
         return false;
     }
+
+    // Format is detected from the contents, not the extension
+    const char *data = reinterpret_cast<const char *>(file.Data());
+    if (IsJsonBuffer(data, file.Size()))
+        return ParseJsonBuffer(data, file.Size(), outChains, &outSections);
+
+    ParseBuffer(data, file.Size(), outChains, &outSections);
+    return true;
 }
 
-bool PointerChainStorage::SaveToFile(const std::wstring &filename) const
+ReloadStats PointerChainStorage::ApplyReload(std::vector<PointerChain> &&chains, const std::vector<BuildSection> &sections)
 {
-    try
+    auto keyOf = [](const PointerChain &chain)
     {
-        std::wofstream file(filename);
-        if (!file.is_open())
+        std::wstring key = chain.moduleName;
+        std::transform(key.begin(), key.end(), key.begin(), ::towlower);
+        key += L'|' + std::to_wstring(chain.baseOffset);
+        for (uintptr_t offset : chain.offsets)
         {
-            std::wcerr << L"[-] Failed to open file for writing: " << filename << std::endl;
-            return false;
+            key += L',' + std::to_wstring(offset);
         }
+        key += L'|' + std::to_wstring(static_cast<int>(chain.valueType)) + L';' +
+               std::to_wstring(static_cast<int>(chain.tornCheck)) + L',' + std::to_wstring(chain.sequenceOffset);
+        for (const ChainField &field : chain.fields)
+        {
+            key += L';' + std::to_wstring(field.offset) + L' ' + std::to_wstring(static_cast<int>(field.type)) + L' ' +
+                   field.name;
+        }
+        key += L'|' + chain.description;
+        return key;
+    };
+    auto identityOf = [](const PointerChain &chain) -> const std::wstring &
+    {
+        return chain.description;
+    };
 
-        file << L"# Pointer Chains Configuration\n";
-        file << L"# Format: moduleName|baseOffset|offsets|valueType|description\n\n";
+    m_tableDirty = true;
+    m_journal.Invalidate();
+    return MergeReload(m_chains, m_builds.TakeReload(std::move(chains), sections), keyOf, identityOf);
+}
 
-        for (const auto &chain : m_chains)
-        {
-            file << chain.moduleName << L"|";
-            file << std::wstring(SimpleJSON::UintPtrToHexString(chain.baseOffset).begin(),
-                                 SimpleJSON::UintPtrToHexString(chain.baseOffset).end())
-                 << L"|";
+bool PointerChainStorage::SelectBuild(const ModuleRegistry &registry)
+{
+    std::wstring key;
+    if (!m_builds.FindMatch(registry, key))
+        return false;
+
+    m_builds.Switch(m_chains, key);
+    m_tableDirty = true;
+    m_journal.Record(JournalOp::Select, StringUtils::WideToUtf8(key));
+
+    std::wcout << L"[+] Selected pointer chains for " << (key.empty() ? L"unknown build (default set)" : key)
+               << L": " << m_chains.size() << L" chains" << std::endl;
+    return true;
+}
+
+bool PointerChainStorage::BindBuild(const std::wstring &key)
+{
+    if (!m_builds.Bind(key))
+    {
+        std::wcerr << L"[-] Build " << key << L" already has a chain set" << std::endl;
+        return false;
+    }
+
+    // Renaming a set is not a journal op
+    m_journal.Invalidate();
+    m_modified = true;
+    return true;
+}
+
+// Append one chain as a config line (UTF-8, no newline)
+static void FormatChain(const PointerChain &chain, std::string &out)
+{
+    StringUtils::AppendUtf8(chain.moduleName, out);
+    out += '|';
+    StringUtils::AppendHex(chain.baseOffset, out);
+    out += '|';
+
+    for (size_t i = 0; i < chain.offsets.size(); ++i)
+    {
+        if (i > 0)
+            out += ',';
+        StringUtils::AppendHex(chain.offsets[i], out);
+    }
+
+    out += '|';
+    if (chain.fields.empty())
+        out += SimpleJSON::ValueTypeToString(chain.valueType);
+    else
+        AppendFieldGroup(chain, out);
+    if (chain.tornCheck != TornCheck::None)
+    {
+        out += ';';
+        AppendTornCheck(chain, out);
+    }
+    out += '|';
+    StringUtils::AppendUtf8(chain.description, out);
+}
+
+// Append a quoted JSON string (UTF-8, escaped only where needed)
+static void AppendJsonString(const std::wstring &str, std::string &out)
+{
+    out += '"';
+    size_t start = out.size();
+    StringUtils::AppendUtf8(str, out);
 
-            for (size_t i = 0; i < chain.offsets.size(); ++i)
+    for (size_t i = start; i < out.size(); ++i)
+    {
+        unsigned char c = static_cast<unsigned char>(out[i]);
+        if (c != '"' && c != '\\' && c >= 0x20)
+            continue;
+
+        // Slow path: rebuild the tail with escapes
+        std::string tail = out.substr(i);
+        out.resize(i);
+        for (char ch : tail)
+        {
+            switch (ch)
             {
-                if (i > 0)
-                    file << L",";
-                file << std::wstring(SimpleJSON::UintPtrToHexString(chain.offsets[i]).begin(),
-                                     SimpleJSON::UintPtrToHexString(chain.offsets[i]).end());
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20)
+                {
+                    char escape[8];
+                    snprintf(escape, sizeof(escape), "\\u%04X", static_cast<unsigned>(ch));
+                    out += escape;
+                }
+                else
+                {
+                    out += ch;
+                }
             }
+        }
+        break;
+    }
+    out += '"';
+}
 
-            file << L"|";
-            file << std::wstring(SimpleJSON::ValueTypeToString(chain.valueType).begin(),
-                                 SimpleJSON::ValueTypeToString(chain.valueType).end())
-                 << L"|";
-            file << chain.description << L"\n";
+// Append one chain as an element of the "pointer_chains" array
+static void FormatChainJson(const PointerChain &chain, const std::wstring &build, bool first, std::string &out)
+{
+    out += first ? "    {\n" : ",\n    {\n";
+    if (!build.empty())
+    {
+        out += "      \"build\": ";
+        AppendJsonString(build, out);
+        out += ",\n";
+    }
+    out += "      \"module\": ";
+    AppendJsonString(chain.moduleName, out);
+    out += ",\n      \"baseOffset\": \"";
+    StringUtils::AppendHex(chain.baseOffset, out);
+    out += "\",\n      \"offsets\": [";
+
+    for (size_t i = 0; i < chain.offsets.size(); ++i)
+    {
+        out += i > 0 ? ", \"" : "\"";
+        StringUtils::AppendHex(chain.offsets[i], out);
+        out += '"';
+    }
+
+    out += "],\n      \"valueType\": \"";
+    out += SimpleJSON::ValueTypeToString(chain.valueType);
+    if (chain.tornCheck != TornCheck::None)
+    {
+        out += "\",\n      \"tornCheck\": \"";
+        AppendTornCheck(chain, out);
+    }
+    out += "\",\n      \"description\": ";
+    AppendJsonString(chain.description, out);
+    if (!chain.fields.empty())
+    {
+        out += ",\n      \"fields\": [";
+        for (size_t i = 0; i < chain.fields.size(); ++i)
+        {
+            const ChainField &field = chain.fields[i];
+            out += i > 0 ? ",\n        { \"offset\": \"" : "\n        { \"offset\": \"";
+            StringUtils::AppendHex(field.offset, out);
+            out += "\", \"type\": \"";
+            out += SimpleJSON::ValueTypeToString(field.type);
+            out += "\", \"name\": ";
+            AppendJsonString(field.name, out);
+            out += " }";
         }
+        out += "\n      ]";
+    }
+    out += "\n    }";
+}
 
-        file.close();
-        std::wcout << L"[+] Saved " << m_chains.size() << L" pointer chains to file" << std::endl;
+bool PointerChainStorage::CompactJournal()
+{
+    if (m_journal.GetJournalOpCount() == 0 || m_filename.empty())
+        return true;
+    if (m_modified)
+        return false;
+
+    size_t ops = m_journal.GetJournalOpCount();
+    std::wstring tempFile = EditJournal::TempPath(m_filename);
+    if (!WriteAll(tempFile, IsJsonFilename(m_filename)) || !m_journal.CommitRewrite(tempFile, m_filename))
+        return false;
+
+    std::wcout << L"[+] Compacted " << ops << L" journaled edits into " << m_filename << std::endl;
+    return true;
+}
+
+bool PointerChainStorage::SaveToFile(const std::wstring &filename)
+{
+    // Only the edits since the last load/save go to disk
+    size_t edits = m_journal.GetPendingCount();
+    if (m_journal.CanAppend(filename, m_chains.size()) && m_journal.Append())
+    {
+        m_filename = filename;
+        std::wcout << L"[+] Saved " << m_chains.size() << L" pointer chains to file ("
+                   << edits << L" edits appended to journal)" << std::endl;
         return true;
     }
-    catch (const std::exception &e)
+
+    // Full rewrite into a temp file, swapped in atomically
+    std::wstring tempFile = EditJournal::TempPath(filename);
+    if (!WriteAll(tempFile, IsJsonFilename(filename)) || !m_journal.CommitRewrite(tempFile, filename))
+        return false;
+
+    m_filename = filename;
+    std::wcout << L"[+] Saved " << m_chains.size() << L" pointer chains to file" << std::endl;
+    return true;
+}
+
+bool PointerChainStorage::WriteAll(const std::wstring &filename, bool json) const
+{
+    // Text mode keeps the platform line endings the wofstream writer produced
+    std::ofstream file(filename);
+    if (!file.is_open())
     {
-        std::cerr << "[-] Error saving chains: " << e.what() << std::endl;
+        std::wcerr << L"[-] Failed to open file for writing: " << filename << std::endl;
         return false;
     }
+
+    std::string buffer;
+    buffer.reserve(SAVE_BUFFER_SIZE + 1024);
+    if (json)
+    {
+        buffer += "{\n  \"pointer_chains\": [\n";
+    }
+    else
+    {
+        buffer += "# Pointer Chains Configuration\n";
+        buffer += "# Format: moduleName|baseOffset|offsets|valueType[;tornCheck]|description\n";
+        buffer += "# valueType may be a field group: fields(0x0 int Health, 0x4 float Speed)\n\n";
+    }
+
+    bool first = true;
+    m_builds.ForEachSet(m_chains, [&](const std::wstring &key, const std::vector<PointerChain> &set)
+                        {
+        if (!json && !key.empty())
+            AppendBuildSection(key, buffer);
+
+        for (const auto &chain : set)
+        {
+            if (json)
+            {
+                FormatChainJson(chain, key, first, buffer);
+                first = false;
+            }
+            else
+            {
+                FormatChain(chain, buffer);
+                buffer += '\n';
+            }
+
+            // Flush in large blocks, the buffer stays bounded for huge chain sets
+            if (buffer.size() >= SAVE_BUFFER_SIZE)
+            {
+                file.write(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        } });
+    if (json)
+    {
+        buffer += first ? "  ]\n}\n" : "\n  ]\n}\n";
+    }
+    file.write(buffer.data(), buffer.size());
+    file.close();
+
+    if (!file.good())
+    {
+        std::wcerr << L"[-] Failed to write file: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+PointerChainTable &PointerChainStorage::GetTable()
+{
+    if (m_tableDirty)
+    {
+        m_table.Build(m_chains);
+        m_tableDirty = false;
+    }
+    return m_table;
+}
+
+void PointerChainStorage::ApplyTableResults()
+{
+    if (m_tableDirty)
+        return;
+
+    m_table.ExportResults(m_chains);
 }
 
 void PointerChainStorage::PrintAllChains() const
@@ -209,6 +1223,19 @@ void PointerChainStorage::PrintAllChains() const
         std::wcout << L"    Module: " << chain.moduleName << L"\n";
         std::wcout << L"    Base Offset: 0x" << std::hex << chain.baseOffset << std::dec << L"\n";
         std::wcout << L"    Chain Steps: " << chain.offsets.size() << L"\n";
-        std::wcout << L"    Value Type: " << std::wstring(SimpleJSON::ValueTypeToString(chain.valueType).begin(), SimpleJSON::ValueTypeToString(chain.valueType).end()) << L"\n\n";
+        std::wcout << L"    Value Type: " << std::wstring(SimpleJSON::ValueTypeToString(chain.valueType).begin(), SimpleJSON::ValueTypeToString(chain.valueType).end()) << L"\n";
+        if (chain.tornCheck != TornCheck::None)
+        {
+            std::string check;
+            AppendTornCheck(chain, check);
+            std::wcout << L"    Torn-read Check: " << StringUtils::Utf8ToWide(check.data(), check.size()) << L"\n";
+        }
+        if (!chain.fields.empty())
+        {
+            std::string group;
+            AppendFieldGroup(chain, group);
+            std::wcout << L"    Field Group: " << StringUtils::Utf8ToWide(group.data(), group.size()) << L"\n";
+        }
+        std::wcout << L"\n";
     }
 }
@@ -3,27 +3,116 @@
 #include <vector>
 #include <string>
 #include "PointerChainResolver.h"
+#include "ReloadDiff.h"
+#include "EditJournal.h"
+#include "BuildSets.h"
 
 // Storage and persistence for pointer chains
+// Edits are saved to <file>.journal until the next compaction (see EditJournal)
+// Chains of several target builds share one file, the chain list holds the
+// set selected for the loaded modules (see BuildSets)
 class PointerChainStorage
 {
 public:
     PointerChainStorage() = default;
 
-    // Chain management
+    // Characters a field name cannot hold: they delimit field groups in chain files
+    static constexpr const wchar_t *FIELD_NAME_RESERVED = L",)|;\r\n";
+    static bool IsValidFieldName(const std::wstring &name)
+    {
+        return name.find_first_of(FIELD_NAME_RESERVED) == std::wstring::npos;
+    }
+
     void AddChain(const PointerChain &chain);
     void RemoveChain(size_t index);
-    void ClearAllChains() { m_chains.clear(); }
+    // Chain management works on the active build set
+    void ClearAllChains()
+    {
+        m_chains.clear();
+        m_tableDirty = true;
+        m_journal.Record(JournalOp::Clear);
+    }
 
     size_t GetChainCount() const { return m_chains.size(); }
     const PointerChain &GetChain(size_t index) const { return m_chains[index]; }
-    PointerChain &GetChainMutable(size_t index) { return m_chains[index]; }
+    PointerChain &GetChainMutable(size_t index)
+    {
+        m_tableDirty = true;
+        m_journal.Invalidate();
+        return m_chains[index];
+    }
     const std::vector<PointerChain> &GetAllChains() const { return m_chains; }
-    std::vector<PointerChain> &GetAllChainsMutable() { return m_chains; }
+    std::vector<PointerChain> &GetAllChainsMutable()
+    {
+        m_tableDirty = true;
+        m_journal.Invalidate();
+        return m_chains;
+    }
+
+    // Compact struct-of-arrays view of the chains, rebuilt after edits
+    PointerChainTable &GetTable();
+
+    // Copy table resolution results back into the chain objects
+    void ApplyTableResults();
 
-    // File I/O (uses JSON format)
+    // File I/O (UTF-8): pipe-separated text, or JSON for *.json on save
+    // Load detects the format from the file contents and replays the edit journal
+    // Save appends edits since the last load/save to the journal when possible
     bool LoadFromFile(const std::wstring &filename);
-    bool SaveToFile(const std::wstring &filename) const;
+    bool SaveToFile(const std::wstring &filename);
+
+    // File of the last load/save (empty if none)
+    const std::wstring &GetFilename() const { return m_filename; }
+
+    // Fold the replayed journal into the loaded file, false if unsaved edits
+    // are in the way (the next save rewrites the file then)
+    bool CompactJournal();
+
+    // Journal ops of the loaded file that are not in the file itself
+    size_t GetJournaledEditCount() const { return m_journal.GetJournalOpCount(); }
+
+    // Off while the file is hot reloaded: saves rewrite it instead of appending
+    void SetJournalAppends(bool enabled) { m_journal.SetAppendEnabled(enabled); }
+
+    // Read a chain file without touching storage (format detected by content)
+    static bool ReadChains(const std::wstring &filename, std::vector<PointerChain> &outChains,
+                           std::vector<BuildSection> &outSections);
+
+    // Replace chains with re-read file contents, unchanged chains keep their resolution
+    ReloadStats ApplyReload(std::vector<PointerChain> &&chains, const std::vector<BuildSection> &sections);
+
+    // Activate the chain set for the loaded module builds (default set if none fits)
+    // Returns true if the active set changed
+    bool SelectBuild(const ModuleRegistry &registry);
+
+    // Attach the active chains to a build key, fails if that build already has a set
+    bool BindBuild(const std::wstring &key);
+
+    // Build key of the active set (empty = default set) and number of sets
+    const std::wstring &GetActiveBuild() const { return m_builds.GetActiveKey(); }
+    size_t GetBuildCount() const { return m_builds.GetSetCount(); }
+
+    // Parse chain file text and append to outChains, [build] sections go to outSections
+    // Large buffers are split at line boundaries and parsed on several threads
+    // Malformed lines are reported to wcerr and skipped
+    static void ParseBuffer(const char *data, size_t size, std::vector<PointerChain> &outChains,
+                            std::vector<BuildSection> *outSections = nullptr);
+
+    // Parse one pipe format line (no newline, not a comment) into chain
+    // Returns false if the line is malformed, with a reason in warning if it has one
+    static bool ParseLine(const char *begin, const char *end, PointerChain &chain, std::wstring &warning);
+
+    // Stream JSON chain text through the SAX parser and append to outChains
+    // Chains with a "build" field go to that build's section
+    // Returns false on a syntax error (reported to wcerr)
+    static bool ParseJsonBuffer(const char *data, size_t size, std::vector<PointerChain> &outChains,
+                                std::vector<BuildSection> *outSections = nullptr);
+
+    // First non-space character is '{'
+    static bool IsJsonBuffer(const char *data, size_t size);
+
+    // Check for the JSON extension (.json)
+    static bool IsJsonFilename(const std::wstring &filename);
 
     // Display all chains
     void PrintAllChains() const;
@@ -35,5 +124,17 @@ public:
 
 private:
     std::vector<PointerChain> m_chains;
+    std::wstring m_filename;
     bool m_modified = false;
+    EditJournal m_journal;
+    BuildSets<PointerChain> m_builds;
+
+    PointerChainTable m_table;
+    bool m_tableDirty = true;
+
+    // Write all chains to filename (no journal involved)
+    bool WriteAll(const std::wstring &filename, bool json) const;
+
+    // Apply one replayed journal op to m_chains
+    bool ReplayOp(JournalOp op, const char *payload, size_t length);
 };
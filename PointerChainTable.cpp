@@ -0,0 +1,282 @@
+#include "PointerChainTable.h"
+#include "PointerChainResolver.h"
+#include <algorithm>
+#include <cstring>
+
+std::wstring_view StringPool::View(uint32_t id) const
+{
+    const ChainSpan &span = m_spans[id];
+    return std::wstring_view(m_chars.data() + span.start, span.length);
+}
+
+uint32_t StringPool::Intern(const std::wstring &str)
+{
+    size_t hash = std::hash<std::wstring_view>()(str);
+    auto range = m_index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (View(it->second) == str)
+            return it->second;
+    }
+
+    ChainSpan span;
+    span.start = static_cast<uint32_t>(m_chars.size());
+    span.length = static_cast<uint32_t>(str.size());
+    m_chars.insert(m_chars.end(), str.begin(), str.end());
+
+    uint32_t id = static_cast<uint32_t>(m_spans.size());
+    m_spans.push_back(span);
+    m_index.emplace(hash, id);
+    return id;
+}
+
+std::wstring StringPool::Get(uint32_t id) const
+{
+    if (id >= m_spans.size())
+        return L"";
+
+    return std::wstring(View(id));
+}
+
+void StringPool::Clear()
+{
+    m_chars.clear();
+    m_spans.clear();
+    m_index.clear();
+}
+
+size_t StringPool::MemoryUsage() const
+{
+    // Node estimate: key + id + next pointer + cached hash
+    size_t indexBytes = m_index.size() * (sizeof(size_t) + sizeof(uint32_t) + 2 * sizeof(void *)) +
+                        m_index.bucket_count() * sizeof(void *);
+    return m_chars.capacity() * sizeof(wchar_t) + m_spans.capacity() * sizeof(ChainSpan) + indexBytes;
+}
+
+void PointerChainTable::Build(const std::vector<PointerChain> &chains)
+{
+    Clear();
+
+    size_t totalOffsets = 0;
+    size_t totalFields = 0;
+    for (const auto &chain : chains)
+    {
+        totalOffsets += chain.offsets.size() + (chain.tornCheck == TornCheck::Sequence ? 1 : 0);
+        totalFields += chain.fields.size();
+    }
+
+    m_moduleIds.reserve(chains.size());
+    m_descriptionIds.reserve(chains.size());
+    m_baseOffsets.reserve(chains.size());
+    m_offsetSpans.reserve(chains.size());
+    m_valueTypes.reserve(chains.size());
+    m_tornChecks.reserve(chains.size());
+    m_offsetArena.reserve(totalOffsets);
+    m_fieldSpans.reserve(chains.size());
+    m_fieldOffsets.reserve(totalFields);
+    m_fieldTypes.reserve(totalFields);
+    m_fieldNameIds.reserve(totalFields);
+    m_fieldRawValues.reserve(totalFields);
+
+    for (const auto &chain : chains)
+    {
+        AddChain(chain);
+    }
+}
+
+void PointerChainTable::AddChain(const PointerChain &chain)
+{
+    m_moduleIds.push_back(m_strings.Intern(chain.moduleName));
+    m_descriptionIds.push_back(m_strings.Intern(chain.description));
+    m_baseOffsets.push_back(chain.baseOffset);
+    m_valueTypes.push_back(static_cast<uint8_t>(chain.fields.empty() ? chain.valueType : chain.fields.front().type));
+    m_tornChecks.push_back(static_cast<uint8_t>(chain.tornCheck));
+
+    ChainSpan span;
+    span.start = static_cast<uint32_t>(m_offsetArena.size());
+    span.length = static_cast<uint32_t>(chain.offsets.size());
+    m_offsetArena.insert(m_offsetArena.end(), chain.offsets.begin(), chain.offsets.end());
+    if (chain.tornCheck == TornCheck::Sequence)
+        m_offsetArena.push_back(chain.sequenceOffset);
+    m_offsetSpans.push_back(span);
+
+    ChainSpan fieldSpan;
+    fieldSpan.start = static_cast<uint32_t>(m_fieldOffsets.size());
+    fieldSpan.length = static_cast<uint32_t>(chain.fields.size());
+    for (const ChainField &field : chain.fields)
+    {
+        m_fieldOffsets.push_back(field.offset);
+        m_fieldTypes.push_back(static_cast<uint8_t>(field.type));
+        m_fieldNameIds.push_back(m_strings.Intern(field.name));
+        m_fieldRawValues.push_back(0);
+    }
+    m_fieldSpans.push_back(fieldSpan);
+
+    m_resolvedAddresses.push_back(0);
+    m_rawValues.push_back(0);
+    m_resolved.push_back(0);
+    m_suspect.push_back(0);
+    m_errors.push_back(ChainError::NotResolved);
+    m_errorSteps.push_back(0);
+}
+
+void PointerChainTable::Clear()
+{
+    m_moduleIds.clear();
+    m_descriptionIds.clear();
+    m_baseOffsets.clear();
+    m_offsetSpans.clear();
+    m_valueTypes.clear();
+    m_tornChecks.clear();
+    m_offsetArena.clear();
+    m_fieldSpans.clear();
+    m_fieldOffsets.clear();
+    m_fieldTypes.clear();
+    m_fieldNameIds.clear();
+    m_fieldRawValues.clear();
+    m_strings.Clear();
+
+    m_resolvedAddresses.clear();
+    m_rawValues.clear();
+    m_resolved.clear();
+    m_suspect.clear();
+    m_errors.clear();
+    m_errorSteps.clear();
+}
+
+uintptr_t PointerChainTable::GetSequenceOffset(size_t index) const
+{
+    if (GetTornCheck(index) != TornCheck::Sequence)
+        return 0;
+    const ChainSpan &span = m_offsetSpans[index];
+    return m_offsetArena[span.start + span.length];
+}
+
+void PointerChainTable::SetResolved(size_t index, uintptr_t address, uint64_t rawValue, bool suspect)
+{
+    m_resolvedAddresses[index] = address;
+    m_rawValues[index] = rawValue;
+    m_resolved[index] = 1;
+    m_suspect[index] = suspect ? 1 : 0;
+    m_errors[index] = ChainError::None;
+    m_errorSteps[index] = 0;
+}
+
+void PointerChainTable::SetError(size_t index, ChainError error, uint16_t step, uintptr_t address)
+{
+    m_resolvedAddresses[index] = address;
+    m_resolved[index] = 0;
+    m_suspect[index] = 0;
+    m_errors[index] = error;
+    m_errorSteps[index] = step;
+}
+
+// Typed value from raw bits
+static MemoryValue DecodeRaw(ValueType type, uint64_t raw, bool valid)
+{
+    MemoryValue value;
+    value.type = type;
+    value.isValid = valid;
+    value.data.doubleValue = 0.0;
+
+    switch (value.type)
+    {
+    case ValueType::INT:
+        memcpy(&value.data.intValue, &raw, sizeof(int32_t));
+        break;
+    case ValueType::FLOAT:
+        memcpy(&value.data.floatValue, &raw, sizeof(float));
+        break;
+    case ValueType::DOUBLE:
+        memcpy(&value.data.doubleValue, &raw, sizeof(double));
+        break;
+    }
+    return value;
+}
+
+MemoryValue PointerChainTable::GetValue(size_t index) const
+{
+    return DecodeRaw(GetValueType(index), m_rawValues[index], m_resolved[index] != 0);
+}
+
+MemoryValue PointerChainTable::GetFieldValue(size_t index, uint32_t field) const
+{
+    return DecodeRaw(GetFieldType(index, field), m_fieldRawValues[m_fieldSpans[index].start + field],
+                     m_resolved[index] != 0);
+}
+
+std::wstring PointerChainTable::GetErrorText(size_t index) const
+{
+    std::wstring step = std::to_wstring(m_errorSteps[index]) + L"/" + std::to_wstring(m_offsetSpans[index].length);
+
+    switch (m_errors[index])
+    {
+    case ChainError::None:
+        return L"";
+    case ChainError::NotResolved:
+        return L"Not resolved yet";
+    case ChainError::ModuleNotFound:
+        return L"Module not found: " + GetModuleName(index);
+    case ChainError::InvalidBaseAddress:
+        return L"Invalid base address after module offset";
+    case ChainError::BaseReadFailed:
+        return L"Failed to read pointer at base address";
+    case ChainError::InvalidStepAddress:
+        return L"Invalid address at chain step " + step;
+    case ChainError::StepReadFailed:
+        return L"Failed to read pointer at chain step " + step;
+    case ChainError::InvalidStepPointer:
+        return L"Invalid pointer value at chain step " + step;
+    case ChainError::ValueReadFailed:
+        return L"Failed to read value at final address";
+    }
+    return L"";
+}
+
+void PointerChainTable::ExportResults(std::vector<PointerChain> &chains) const
+{
+    size_t count = (std::min)(chains.size(), Count());
+    for (size_t i = 0; i < count; ++i)
+    {
+        PointerChain &chain = chains[i];
+        chain.isResolved = IsResolved(i);
+        chain.isSuspect = IsSuspect(i);
+        chain.resolvedAddress = m_resolvedAddresses[i];
+        if (chain.isResolved)
+        {
+            chain.currentValue = GetValue(i);
+            chain.lastError.clear();
+        }
+        else
+        {
+            chain.lastError = GetErrorText(i);
+        }
+        for (uint32_t f = 0; f < GetFieldCount(i) && f < chain.fields.size(); ++f)
+        {
+            chain.fields[f].value = GetFieldValue(i, f);
+        }
+    }
+}
+
+size_t PointerChainTable::MemoryUsage() const
+{
+    return m_moduleIds.capacity() * sizeof(uint32_t) +
+           m_descriptionIds.capacity() * sizeof(uint32_t) +
+           m_baseOffsets.capacity() * sizeof(uintptr_t) +
+           m_offsetSpans.capacity() * sizeof(ChainSpan) +
+           m_valueTypes.capacity() * sizeof(uint8_t) +
+           m_tornChecks.capacity() * sizeof(uint8_t) +
+           m_offsetArena.capacity() * sizeof(uintptr_t) +
+           m_fieldSpans.capacity() * sizeof(ChainSpan) +
+           m_fieldOffsets.capacity() * sizeof(uintptr_t) +
+           m_fieldTypes.capacity() * sizeof(uint8_t) +
+           m_fieldNameIds.capacity() * sizeof(uint32_t) +
+           m_fieldRawValues.capacity() * sizeof(uint64_t) +
+           m_resolvedAddresses.capacity() * sizeof(uintptr_t) +
+           m_rawValues.capacity() * sizeof(uint64_t) +
+           m_resolved.capacity() * sizeof(uint8_t) +
+           m_suspect.capacity() * sizeof(uint8_t) +
+           m_errors.capacity() * sizeof(ChainError) +
+           m_errorSteps.capacity() * sizeof(uint16_t) +
+           m_strings.MemoryUsage();
+}
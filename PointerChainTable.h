@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "MemoryReader.h"
+
+struct PointerChain;
+
+// ============================================================================
+// PointerChainTable: Compact struct-of-arrays chain storage
+// Purpose: Cache-friendly iteration over large chain sets
+// - offsets of all chains live in one arena, chains hold (start, length) spans;
+//   a sequence counter offset (TornCheck::Sequence) follows the chain's span
+// - field groups live in a second set of arenas, chains hold field spans
+// - module names / descriptions are interned in a string pool
+// - runtime state is kept in parallel arrays, errors as codes (no strings)
+// ============================================================================
+
+struct ChainSpan
+{
+    uint32_t start;
+    uint32_t length;
+};
+
+// Resolution failure reasons, text is produced on demand
+enum class ChainError : uint8_t
+{
+    None,
+    NotResolved,
+    ModuleNotFound,
+    InvalidBaseAddress,
+    BaseReadFailed,
+    InvalidStepAddress,
+    StepReadFailed,
+    InvalidStepPointer,
+    ValueReadFailed
+};
+
+// Interned wide strings stored back to back in one buffer
+class StringPool
+{
+private:
+    std::vector<wchar_t> m_chars;
+    std::vector<ChainSpan> m_spans;
+    std::unordered_multimap<size_t, uint32_t> m_index; // hash -> id, text lives only in m_chars
+
+    std::wstring_view View(uint32_t id) const;
+
+public:
+    // Returns id of existing equal string or adds a new one
+    uint32_t Intern(const std::wstring &str);
+
+    std::wstring Get(uint32_t id) const;
+    size_t Count() const { return m_spans.size(); }
+    void Clear();
+
+    // Approximate heap usage in bytes
+    size_t MemoryUsage() const;
+};
+
+class PointerChainTable
+{
+private:
+    // Definition columns
+    std::vector<uint32_t> m_moduleIds;
+    std::vector<uint32_t> m_descriptionIds;
+    std::vector<uintptr_t> m_baseOffsets;
+    std::vector<ChainSpan> m_offsetSpans;
+    std::vector<uint8_t> m_valueTypes; // ValueType
+    std::vector<uint8_t> m_tornChecks; // TornCheck
+    std::vector<uintptr_t> m_offsetArena;
+    std::vector<ChainSpan> m_fieldSpans; // Empty span: single value
+    std::vector<uintptr_t> m_fieldOffsets;
+    std::vector<uint8_t> m_fieldTypes; // ValueType
+    std::vector<uint32_t> m_fieldNameIds;
+    StringPool m_strings;
+
+    // Runtime columns
+    std::vector<uintptr_t> m_resolvedAddresses;
+    std::vector<uint64_t> m_rawValues; // Value bits, interpreted by value type
+    std::vector<uint8_t> m_resolved;
+    std::vector<uint8_t> m_suspect; // Torn-read check failed
+    std::vector<ChainError> m_errors;
+    std::vector<uint16_t> m_errorSteps; // 1-based chain step for step errors
+    std::vector<uint64_t> m_fieldRawValues;
+
+public:
+    PointerChainTable() = default;
+
+    // Rebuild from chain definitions (runtime state is reset)
+    void Build(const std::vector<PointerChain> &chains);
+    void AddChain(const PointerChain &chain);
+    void Clear();
+
+    size_t Count() const { return m_baseOffsets.size(); }
+
+    // Definition accessors
+    uint32_t GetModuleId(size_t index) const { return m_moduleIds[index]; }
+    uintptr_t GetBaseOffset(size_t index) const { return m_baseOffsets[index]; }
+    ValueType GetValueType(size_t index) const { return static_cast<ValueType>(m_valueTypes[index]); }
+    const uintptr_t *GetOffsets(size_t index) const { return m_offsetArena.data() + m_offsetSpans[index].start; }
+    uint32_t GetOffsetCount(size_t index) const { return m_offsetSpans[index].length; }
+    TornCheck GetTornCheck(size_t index) const { return static_cast<TornCheck>(m_tornChecks[index]); }
+    uintptr_t GetSequenceOffset(size_t index) const;
+
+    // Field group of a chain, fields in definition order
+    uint32_t GetFieldCount(size_t index) const { return m_fieldSpans[index].length; }
+    uintptr_t GetFieldOffset(size_t index, uint32_t field) const
+    {
+        return m_fieldOffsets[m_fieldSpans[index].start + field];
+    }
+    ValueType GetFieldType(size_t index, uint32_t field) const
+    {
+        return static_cast<ValueType>(m_fieldTypes[m_fieldSpans[index].start + field]);
+    }
+    std::wstring GetFieldName(size_t index, uint32_t field) const
+    {
+        return m_strings.Get(m_fieldNameIds[m_fieldSpans[index].start + field]);
+    }
+    std::wstring GetString(uint32_t id) const { return m_strings.Get(id); }
+    std::wstring GetModuleName(size_t index) const { return m_strings.Get(m_moduleIds[index]); }
+    std::wstring GetDescription(size_t index) const { return m_strings.Get(m_descriptionIds[index]); }
+    size_t GetStringCount() const { return m_strings.Count(); }
+
+    // Runtime state
+    void SetResolved(size_t index, uintptr_t address, uint64_t rawValue, bool suspect = false);
+    // address: final address when only the value read failed, 0 if the walk stopped before it
+    void SetError(size_t index, ChainError error, uint16_t step = 0, uintptr_t address = 0);
+    bool IsResolved(size_t index) const { return m_resolved[index] != 0; }
+    bool IsSuspect(size_t index) const { return m_suspect[index] != 0; }
+    void SetFieldRaw(size_t index, uint32_t field, uint64_t rawValue)
+    {
+        m_fieldRawValues[m_fieldSpans[index].start + field] = rawValue;
+    }
+    MemoryValue GetFieldValue(size_t index, uint32_t field) const;
+    uintptr_t GetResolvedAddress(size_t index) const { return m_resolvedAddresses[index]; }
+    ChainError GetError(size_t index) const { return m_errors[index]; }
+    MemoryValue GetValue(size_t index) const;
+
+    // Same wording as PointerChain::lastError from PointerChainResolver::ResolveChain
+    std::wstring GetErrorText(size_t index) const;
+
+    // Copy runtime state back into AoS chains (same order as Build)
+    void ExportResults(std::vector<PointerChain> &chains) const;
+
+    // Approximate heap usage in bytes
+    size_t MemoryUsage() const;
+};
@@ -0,0 +1,338 @@
+#include "PointerMapFile.h"
+#include "DebugLog.h"
+#include <ctime>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static const char POINTER_MAP_MAGIC[4] = {'P', 'M', 'A', 'P'};
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Append [uint32 length][UTF-16 chars] padded to 4 bytes, returns its offset
+static uint32_t AppendString(std::vector<uint8_t> &table, const std::wstring &str)
+{
+    uint32_t ref = static_cast<uint32_t>(table.size());
+    uint32_t length = static_cast<uint32_t>(str.size());
+
+    size_t pos = table.size();
+    table.resize(AlignUp(pos + sizeof(uint32_t) + length * sizeof(char16_t), 4));
+    memcpy(&table[pos], &length, sizeof(length));
+
+    char16_t *chars = reinterpret_cast<char16_t *>(&table[pos + sizeof(uint32_t)]);
+    for (uint32_t i = 0; i < length; ++i)
+    {
+        chars[i] = static_cast<char16_t>(str[i]);
+    }
+    return ref;
+}
+
+static void AppendVarint(std::vector<uint8_t> &out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+static bool ReadVarint(const uint8_t *&data, const uint8_t *end, uint64_t &value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && data < end; shift += 7)
+    {
+        uint8_t byte = *data++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+// Signed delta of the non-sorted field, small magnitudes give short varints
+static uint64_t ZigZag(uint64_t delta)
+{
+    return (delta << 1) ^ (0 - (delta >> 63));
+}
+
+static uint64_t UnZigZag(uint64_t value)
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+// Block index and data of one sort order, keys are ascending
+static void EncodeBlocks(const std::vector<PointerMapEntry> &entries, bool locationOrder,
+                         std::vector<PointerMapBlock> &index, std::vector<uint8_t> &data)
+{
+    for (size_t first = 0; first < entries.size(); first += PointerMapFile::BLOCK_ENTRIES)
+    {
+        size_t last = (std::min)(first + PointerMapFile::BLOCK_ENTRIES, entries.size());
+        uint64_t key = locationOrder ? entries[first].location : entries[first].value;
+        uint64_t other = locationOrder ? entries[first].value : entries[first].location;
+        index.push_back({key, other, data.size()});
+
+        for (size_t i = first + 1; i < last; ++i)
+        {
+            uint64_t nextKey = locationOrder ? entries[i].location : entries[i].value;
+            uint64_t nextOther = locationOrder ? entries[i].value : entries[i].location;
+            AppendVarint(data, nextKey - key);
+            AppendVarint(data, ZigZag(nextOther - other));
+            key = nextKey;
+            other = nextOther;
+        }
+    }
+}
+
+PointerMapFile::PointerMapFile()
+    : m_header(nullptr), m_valueIndex(nullptr), m_locationIndex(nullptr), m_blockData(nullptr), m_blockCount(0)
+{
+}
+
+bool PointerMapFile::IsPointerMap(const uint8_t *data, size_t size)
+{
+    return size >= sizeof(PointerMapHeader) && memcmp(data, POINTER_MAP_MAGIC, sizeof(POINTER_MAP_MAGIC)) == 0;
+}
+
+bool PointerMapFile::Open(const std::wstring &filename)
+{
+    Close();
+
+    if (!m_file.Open(filename))
+    {
+        std::wcerr << L"[-] Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    const uint8_t *data = m_file.Data();
+    uint64_t size = m_file.Size();
+
+    if (!IsPointerMap(data, static_cast<size_t>(size)))
+    {
+        std::wcerr << L"[-] Not a pointer map: " << filename << std::endl;
+        m_file.Close();
+        return false;
+    }
+
+    const PointerMapHeader *header = reinterpret_cast<const PointerMapHeader *>(data);
+    if (header->version == 0 || header->version > POINTER_MAP_VERSION || header->blockEntries != BLOCK_ENTRIES)
+    {
+        std::wcerr << L"[-] Unsupported pointer map version: " << header->version << std::endl;
+        m_file.Close();
+        return false;
+    }
+
+    // Every table must lie inside the file (checked without overflow)
+    auto tableFits = [size](uint64_t offset, uint64_t count, uint64_t elementSize)
+    {
+        return offset <= size && offset % 8 == 0 && count <= (size - offset) / elementSize;
+    };
+
+    uint64_t blockCount = (header->entryCount + BLOCK_ENTRIES - 1) / BLOCK_ENTRIES;
+    if (!tableFits(header->moduleTableOffset, header->moduleCount, sizeof(PointerMapModule)) ||
+        !tableFits(header->valueIndexOffset, blockCount, sizeof(PointerMapBlock)) ||
+        !tableFits(header->locationIndexOffset, blockCount, sizeof(PointerMapBlock)) ||
+        !tableFits(header->blockDataOffset, header->blockDataSize, 1) ||
+        !tableFits(header->stringTableOffset, header->stringTableSize, 1))
+    {
+        std::wcerr << L"[-] Corrupted pointer map (table out of bounds): " << filename << std::endl;
+        m_file.Close();
+        return false;
+    }
+
+    // Module names are copied out once, the pointer tables stay in the mapping
+    const PointerMapModule *modules = reinterpret_cast<const PointerMapModule *>(data + header->moduleTableOffset);
+    const uint8_t *strings = data + header->stringTableOffset;
+    for (uint32_t i = 0; i < header->moduleCount; ++i)
+    {
+        ModuleInfo info;
+        info.baseAddress = static_cast<uintptr_t>(modules[i].baseAddress);
+        info.size = static_cast<uintptr_t>(modules[i].size);
+
+        uint64_t ref = modules[i].nameRef;
+        uint32_t length = 0;
+        if (ref > header->stringTableSize || header->stringTableSize - ref < sizeof(uint32_t))
+        {
+            std::wcerr << L"[-] Corrupted pointer map (module name): " << filename << std::endl;
+            Close();
+            return false;
+        }
+        memcpy(&length, strings + ref, sizeof(length));
+        uint64_t charsOffset = ref + sizeof(uint32_t);
+        if (length > (header->stringTableSize - charsOffset) / sizeof(char16_t))
+        {
+            std::wcerr << L"[-] Corrupted pointer map (module name): " << filename << std::endl;
+            Close();
+            return false;
+        }
+        info.name.resize(length);
+        for (uint32_t c = 0; c < length; ++c)
+        {
+            char16_t ch;
+            memcpy(&ch, strings + charsOffset + c * sizeof(char16_t), sizeof(ch));
+            info.name[c] = static_cast<wchar_t>(ch);
+        }
+        m_modules.push_back(info);
+    }
+
+    m_header = header;
+    m_valueIndex = reinterpret_cast<const PointerMapBlock *>(data + header->valueIndexOffset);
+    m_locationIndex = reinterpret_cast<const PointerMapBlock *>(data + header->locationIndexOffset);
+    m_blockData = data + header->blockDataOffset;
+    m_blockCount = static_cast<size_t>(blockCount);
+
+    DBG_OK(L"Mapped pointer map: " + std::to_wstring(header->entryCount) + L" pointers, " +
+           std::to_wstring(header->moduleCount) + L" modules");
+    return true;
+}
+
+void PointerMapFile::Close()
+{
+    m_file.Close();
+    m_header = nullptr;
+    m_valueIndex = nullptr;
+    m_locationIndex = nullptr;
+    m_blockData = nullptr;
+    m_blockCount = 0;
+    m_modules.clear();
+}
+
+size_t PointerMapFile::DecodeBlock(const PointerMapBlock *index, size_t block, PointerMapEntry *out,
+                                   bool locationOrder) const
+{
+    uint64_t first = static_cast<uint64_t>(block) * BLOCK_ENTRIES;
+    size_t count = static_cast<size_t>((std::min)(static_cast<uint64_t>(BLOCK_ENTRIES), m_header->entryCount - first));
+
+    uint64_t key = index[block].firstKey;
+    uint64_t other = index[block].firstOther;
+    uint64_t dataOffset = index[block].dataOffset;
+    if (dataOffset > m_header->blockDataSize)
+        return 0;
+
+    const uint8_t *data = m_blockData + dataOffset;
+    const uint8_t *end = m_blockData + m_header->blockDataSize;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i != 0)
+        {
+            uint64_t keyDelta, otherDelta;
+            if (!ReadVarint(data, end, keyDelta) || !ReadVarint(data, end, otherDelta))
+            {
+                DBG_WARN(L"Corrupted pointer map block " + std::to_wstring(block));
+                return 0;
+            }
+            key += keyDelta;
+            other += UnZigZag(otherDelta);
+        }
+        out[i].value = locationOrder ? other : key;
+        out[i].location = locationOrder ? key : other;
+    }
+    return count;
+}
+
+bool PointerMapFile::ReadPointer(uint64_t location, uint64_t &value) const
+{
+    if (!IsOpen() || m_blockCount == 0)
+        return false;
+
+    // Locations are unique, the entry is in the last block starting at or below it
+    size_t block = static_cast<size_t>(
+        std::upper_bound(m_locationIndex, m_locationIndex + m_blockCount, location,
+                         [](uint64_t address, const PointerMapBlock &index)
+                         { return address < index.firstKey; }) - m_locationIndex);
+    if (block == 0)
+        return false;
+    block--;
+
+    PointerMapEntry entries[BLOCK_ENTRIES];
+    size_t count = DecodeBlock(m_locationIndex, block, entries, true);
+    for (size_t i = 0; i < count && entries[i].location <= location; ++i)
+    {
+        if (entries[i].location == location)
+        {
+            value = entries[i].value;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PointerMapFile::Write(const std::wstring &filename, const std::vector<PointerMapEntry> &entries,
+                           const std::vector<ModuleInfo> &modules, bool truncated)
+{
+    std::vector<uint8_t> strings;
+    std::vector<PointerMapModule> mapModules;
+    for (const ModuleInfo &info : modules)
+    {
+        PointerMapModule module = {};
+        module.baseAddress = info.baseAddress;
+        module.size = info.size;
+        module.nameRef = AppendString(strings, info.name);
+        mapModules.push_back(module);
+    }
+
+    std::vector<PointerMapBlock> valueIndex;
+    std::vector<PointerMapBlock> locationIndex;
+    std::vector<uint8_t> blockData;
+    EncodeBlocks(entries, false, valueIndex, blockData);
+    {
+        std::vector<PointerMapEntry> byLocation(entries);
+        std::sort(byLocation.begin(), byLocation.end(), [](const PointerMapEntry &a, const PointerMapEntry &b)
+                  { return a.location < b.location; });
+        EncodeBlocks(byLocation, true, locationIndex, blockData);
+    }
+
+    PointerMapHeader header = {};
+    memcpy(header.magic, POINTER_MAP_MAGIC, sizeof(header.magic));
+    header.version = POINTER_MAP_VERSION;
+    header.moduleCount = static_cast<uint32_t>(mapModules.size());
+    header.flags = truncated ? POINTER_MAP_TRUNCATED : 0;
+    header.blockEntries = BLOCK_ENTRIES;
+    header.entryCount = entries.size();
+    header.timestamp = static_cast<uint64_t>(time(nullptr));
+    header.moduleTableOffset = AlignUp(sizeof(PointerMapHeader), 8);
+    header.valueIndexOffset = AlignUp(header.moduleTableOffset + mapModules.size() * sizeof(PointerMapModule), 8);
+    header.locationIndexOffset = AlignUp(header.valueIndexOffset + valueIndex.size() * sizeof(PointerMapBlock), 8);
+    header.blockDataOffset = AlignUp(header.locationIndexOffset + locationIndex.size() * sizeof(PointerMapBlock), 8);
+    header.blockDataSize = blockData.size();
+    header.stringTableOffset = AlignUp(header.blockDataOffset + blockData.size(), 8);
+    header.stringTableSize = strings.size();
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::wcerr << L"[-] Failed to create file: " << filename << std::endl;
+        return false;
+    }
+
+    // All table offsets are already aligned, only padding after the header/tables is needed
+    auto writePadded = [&file](const void *data, size_t bytes, uint64_t nextOffset, uint64_t currentOffset)
+    {
+        file.write(static_cast<const char *>(data), bytes);
+        static const char zeros[8] = {};
+        file.write(zeros, static_cast<std::streamsize>(nextOffset - (currentOffset + bytes)));
+    };
+
+    writePadded(&header, sizeof(header), header.moduleTableOffset, 0);
+    writePadded(mapModules.data(), mapModules.size() * sizeof(PointerMapModule), header.valueIndexOffset,
+                header.moduleTableOffset);
+    writePadded(valueIndex.data(), valueIndex.size() * sizeof(PointerMapBlock), header.locationIndexOffset,
+                header.valueIndexOffset);
+    writePadded(locationIndex.data(), locationIndex.size() * sizeof(PointerMapBlock), header.blockDataOffset,
+                header.locationIndexOffset);
+    writePadded(blockData.data(), blockData.size(), header.stringTableOffset, header.blockDataOffset);
+    file.write(reinterpret_cast<const char *>(strings.data()), strings.size());
+
+    if (!file.good())
+    {
+        std::wcerr << L"[-] Failed to write pointer map: " << filename << std::endl;
+        return false;
+    }
+
+    DBG_OK(L"Wrote pointer map with " + std::to_wstring(entries.size()) + L" pointers, " +
+           std::to_wstring(blockData.size() / (std::max)(entries.size(), size_t(1))) + L" data bytes per pointer");
+    return true;
+}
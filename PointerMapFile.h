@@ -0,0 +1,145 @@
+#pragma once
+#include "MappedFile.h"
+#include "ModuleRegistry.h"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// PointerMapFile: Saved pointer map of one target run (.ptrmap)
+// Purpose: Re-scan and cross-check chains offline, after the target restarted
+// Opening maps the file and decodes only the module table, the pointer
+// tables are decoded block by block as queries touch them
+//
+// File layout (little-endian, all tables 8-byte aligned):
+//   PointerMapHeader
+//   PointerMapModule[moduleCount]  - module base, size and name at capture time
+//   PointerMapBlock[blockCount]    - value order index (reverse map queries)
+//   PointerMapBlock[blockCount]    - location order index (pointer reads)
+//   Block data                     - per block, entries after the first as
+//                                    varint key delta + zigzag varint delta
+//                                    of the other field
+//   String table                   - [uint32 length][UTF-16 chars], 4-aligned
+// ============================================================================
+
+struct PointerMapEntry
+{
+    uint64_t value;    // Pointer stored at location
+    uint64_t location; // Address holding the pointer
+};
+
+constexpr uint32_t POINTER_MAP_VERSION = 1;
+constexpr uint32_t POINTER_MAP_TRUNCATED = 1; // Header flag: memory budget was reached
+
+struct PointerMapHeader
+{
+    char magic[4];                // "PMAP"
+    uint32_t version;             // POINTER_MAP_VERSION
+    uint32_t moduleCount;         // Entries in module table
+    uint32_t flags;               // POINTER_MAP_TRUNCATED
+    uint32_t blockEntries;        // Entries per block (last block may be short)
+    uint32_t reserved;            // Always 0
+    uint64_t entryCount;          // Pointers in the map
+    uint64_t timestamp;           // Capture time, seconds since 1970
+    uint64_t moduleTableOffset;   // File offset of module table
+    uint64_t valueIndexOffset;    // File offset of value order index
+    uint64_t locationIndexOffset; // File offset of location order index
+    uint64_t blockDataOffset;     // File offset of block data
+    uint64_t blockDataSize;       // Block data size in bytes
+    uint64_t stringTableOffset;   // File offset of string table
+    uint64_t stringTableSize;     // String table size in bytes
+};
+
+struct PointerMapModule
+{
+    uint64_t baseAddress;
+    uint64_t size;
+    uint32_t nameRef;  // String table offset of module name
+    uint32_t reserved; // Always 0
+};
+
+struct PointerMapBlock
+{
+    uint64_t firstKey;   // Value (value order) or location (location order) of the first entry
+    uint64_t firstOther; // The other field of the first entry
+    uint64_t dataOffset; // Offset of the remaining entries in block data
+};
+
+static_assert(sizeof(PointerMapHeader) == 96, "PointerMapHeader layout changed");
+static_assert(sizeof(PointerMapModule) == 24, "PointerMapModule layout changed");
+static_assert(sizeof(PointerMapBlock) == 24, "PointerMapBlock layout changed");
+
+class PointerMapFile
+{
+public:
+    static constexpr uint32_t BLOCK_ENTRIES = 64;
+
+    PointerMapFile();
+
+    // Map a pointer map file and validate its tables
+    bool Open(const std::wstring &filename);
+    void Close();
+    bool IsOpen() const { return m_header != nullptr; }
+
+    uint64_t EntryCount() const { return m_header ? m_header->entryCount : 0; }
+    uint64_t GetTimestamp() const { return m_header ? m_header->timestamp : 0; }
+    bool IsTruncated() const { return m_header && (m_header->flags & POINTER_MAP_TRUNCATED) != 0; }
+    uint64_t FileSize() const { return m_file.Size(); }
+
+    // Modules at capture time (fingerprints are not stored)
+    const std::vector<ModuleInfo> &GetModules() const { return m_modules; }
+
+    // Call f(entry) for pointers with value in [begin, end], ordered by value,
+    // until f returns false
+    template <typename F>
+    void ForEachReferrer(uint64_t begin, uint64_t end, F &&f) const
+    {
+        if (!IsOpen() || m_blockCount == 0)
+            return;
+
+        // Last block starting at or below begin, equal values may spill into it from the left
+        size_t block = static_cast<size_t>(
+            std::lower_bound(m_valueIndex, m_valueIndex + m_blockCount, begin,
+                             [](const PointerMapBlock &index, uint64_t value)
+                             { return index.firstKey < value; }) - m_valueIndex);
+        if (block != 0)
+            block--;
+
+        PointerMapEntry entries[BLOCK_ENTRIES];
+        for (; block < m_blockCount && m_valueIndex[block].firstKey <= end; ++block)
+        {
+            size_t count = DecodeBlock(m_valueIndex, block, entries, false);
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (entries[i].value > end)
+                    return;
+                if (entries[i].value >= begin && !f(entries[i]))
+                    return;
+            }
+        }
+    }
+
+    // Pointer stored at location, false if the map holds none there
+    bool ReadPointer(uint64_t location, uint64_t &value) const;
+
+    // Check for pointer map magic at the start of a buffer
+    static bool IsPointerMap(const uint8_t *data, size_t size);
+
+    // Write entries (sorted by value, then location) with the module table
+    static bool Write(const std::wstring &filename, const std::vector<PointerMapEntry> &entries,
+                      const std::vector<ModuleInfo> &modules, bool truncated);
+
+private:
+    MappedFile m_file;
+    const PointerMapHeader *m_header;
+    const PointerMapBlock *m_valueIndex;
+    const PointerMapBlock *m_locationIndex;
+    const uint8_t *m_blockData;
+    size_t m_blockCount;
+    std::vector<ModuleInfo> m_modules;
+
+    // Decode one block into out (value/location filled for both orders),
+    // returns the entry count, 0 for a corrupted block
+    size_t DecodeBlock(const PointerMapBlock *index, size_t block, PointerMapEntry *out, bool locationOrder) const;
+};
@@ -0,0 +1,458 @@
+#include "PointerScanner.h"
+#include "MemoryReader.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+static bool ValueLess(const PointerMapEntry &a, const PointerMapEntry &b)
+{
+    return a.value < b.value || (a.value == b.value && a.location < b.location);
+}
+
+// Sort runs of the map on the worker pool, then merge neighbouring runs pairwise
+static void ParallelSort(std::vector<PointerMapEntry> &entries, unsigned threadCount)
+{
+    size_t runCount = (std::min)(static_cast<size_t>(threadCount), (std::max)(entries.size() / 65536, size_t(1)));
+    std::vector<size_t> bounds;
+    for (size_t r = 0; r <= runCount; ++r)
+    {
+        bounds.push_back(entries.size() * r / runCount);
+    }
+
+    auto runParallel = [](size_t taskCount, const std::function<void(size_t)> &task)
+    {
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < taskCount; ++t)
+        {
+            threads.emplace_back(task, t);
+        }
+        task(0);
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+    };
+
+    runParallel(runCount, [&](size_t r)
+                { std::sort(entries.begin() + bounds[r], entries.begin() + bounds[r + 1], ValueLess); });
+
+    for (size_t width = 1; width < runCount; width *= 2)
+    {
+        std::vector<size_t> merges;
+        for (size_t r = 0; r + width < runCount; r += 2 * width)
+        {
+            merges.push_back(r);
+        }
+        runParallel(merges.size(), [&](size_t m)
+                    {
+                        size_t r = merges[m];
+                        auto first = entries.begin() + bounds[r];
+                        auto middle = entries.begin() + bounds[r + width];
+                        auto last = entries.begin() + bounds[(std::min)(r + 2 * width, runCount)];
+                        std::inplace_merge(first, middle, last, ValueLess);
+                    });
+    }
+}
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool PointerScanner::IsMapped(uint64_t address) const
+{
+    auto it = std::upper_bound(m_regions.begin(), m_regions.end(), address, [](uint64_t value, const MemoryRegion &region)
+                               { return value < region.base; });
+    if (it == m_regions.begin())
+        return false;
+    --it;
+    return address - it->base < it->size;
+}
+
+bool PointerScanner::BuildPointerMap(HANDLE hProcess, size_t memoryBudget, unsigned threadCount)
+{
+    Clear();
+    auto start = std::chrono::steady_clock::now();
+
+    MemoryReader::EnumerateRegions(hProcess, m_regions);
+    if (m_regions.empty())
+    {
+        std::wcerr << L"[-] No readable memory regions in target process" << std::endl;
+        return false;
+    }
+
+    struct Slice
+    {
+        uintptr_t address;
+        size_t size;
+    };
+    std::vector<Slice> slices;
+    for (const MemoryRegion &region : m_regions)
+    {
+        for (uintptr_t offset = 0; offset < region.size; offset += SLICE_SIZE)
+        {
+            slices.push_back({region.base + offset, static_cast<size_t>((std::min)(static_cast<uintptr_t>(SLICE_SIZE), region.size - offset))});
+        }
+        m_stats.bytesScanned += region.size;
+    }
+    m_stats.regionCount = m_regions.size();
+
+    if (threadCount == 0)
+        threadCount = (std::max)(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<unsigned>((std::min)(static_cast<size_t>(threadCount), slices.size()));
+
+    const size_t maxEntries = memoryBudget / sizeof(PointerMapEntry);
+    const uint64_t lowest = m_regions.front().base;
+    const uint64_t highest = m_regions.back().base + m_regions.back().size;
+
+    std::vector<std::vector<PointerMapEntry>> found(slices.size());
+    std::atomic<size_t> nextSlice(0);
+    std::atomic<size_t> reserved(0);
+    std::atomic<size_t> unreadablePages(0);
+    std::atomic<bool> truncated(false);
+
+    auto worker = [&]()
+    {
+        std::vector<uint8_t> buffer(SLICE_SIZE);
+        for (size_t s = nextSlice++; s < slices.size(); s = nextSlice++)
+        {
+            if (truncated)
+                break;
+
+            const Slice &slice = slices[s];
+            unreadablePages += MemoryReader::ReadRangePadded(hProcess, slice.address, buffer.data(), slice.size);
+
+            // Region bases are page aligned, so slice offsets of 8 are aligned locations
+            std::vector<PointerMapEntry> &out = found[s];
+            for (size_t offset = 0; offset + sizeof(uint64_t) <= slice.size; offset += sizeof(uint64_t))
+            {
+                uint64_t value;
+                memcpy(&value, buffer.data() + offset, sizeof(value));
+                if (value < lowest || value >= highest || !IsMapped(value))
+                    continue;
+                out.push_back({value, slice.address + offset});
+            }
+
+            size_t before = reserved.fetch_add(out.size());
+            if (before + out.size() > maxEntries)
+            {
+                out.resize(before < maxEntries ? maxEntries - before : 0);
+                truncated = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    // Slice lists are released as they are appended
+    size_t total = 0;
+    for (const auto &list : found)
+    {
+        total += list.size();
+    }
+    m_entries.reserve(total);
+    for (auto &list : found)
+    {
+        m_entries.insert(m_entries.end(), list.begin(), list.end());
+        std::vector<PointerMapEntry>().swap(list);
+    }
+    ParallelSort(m_entries, threadCount);
+
+    m_stats.unreadablePages = unreadablePages;
+    m_stats.truncated = truncated;
+    m_stats.mapMs = ElapsedMs(start);
+
+    if (m_stats.truncated)
+    {
+        std::wcerr << L"[!] Pointer map truncated at " << (memoryBudget >> 20)
+                   << L" MB, raise the memory budget to find all chains" << std::endl;
+    }
+    DBG_OK(L"Pointer map: " + std::to_wstring(m_entries.size()) + L" pointers in " +
+           std::to_wstring(m_stats.regionCount) + L" regions, " + std::to_wstring(m_stats.bytesScanned >> 20) + L" MB");
+    return true;
+}
+
+void PointerScanner::Clear()
+{
+    m_regions.clear();
+    m_entries.clear();
+    m_entries.shrink_to_fit();
+    m_file.Close();
+    m_stats = PointerScanStats();
+}
+
+size_t PointerScanner::GetPointerCount() const
+{
+    return m_file.IsOpen() ? static_cast<size_t>(m_file.EntryCount()) : m_entries.size();
+}
+
+bool PointerScanner::SavePointerMap(const std::wstring &filename, const ModuleRegistry &registry) const
+{
+    if (m_entries.empty())
+    {
+        std::wcerr << L"[-] No pointer map built in this session" << std::endl;
+        return false;
+    }
+    return PointerMapFile::Write(filename, m_entries, registry.GetModules(), m_stats.truncated);
+}
+
+bool PointerScanner::LoadPointerMap(const std::wstring &filename)
+{
+    Clear();
+    if (!m_file.Open(filename))
+        return false;
+
+    m_stats.truncated = m_file.IsTruncated();
+    if (m_stats.truncated)
+    {
+        std::wcerr << L"[!] Pointer map was truncated at capture, chains may be missing" << std::endl;
+    }
+    return true;
+}
+
+template <typename F>
+void PointerScanner::ForEachReferrer(uint64_t begin, uint64_t end, F &&f) const
+{
+    if (m_file.IsOpen())
+    {
+        m_file.ForEachReferrer(begin, end, f);
+        return;
+    }
+
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), begin, [](const PointerMapEntry &entry, uint64_t value)
+                               { return entry.value < value; });
+    for (; it != m_entries.end() && it->value <= end; ++it)
+    {
+        if (!f(*it))
+            return;
+    }
+}
+
+const PointerScanner::RootModule *PointerScanner::FindModule(const std::vector<RootModule> &modules, uint64_t address)
+{
+    auto it = std::upper_bound(modules.begin(), modules.end(), address, [](uint64_t value, const RootModule &module)
+                               { return value < module.base; });
+    if (it == modules.begin())
+        return nullptr;
+    --it;
+    return address < it->end ? &*it : nullptr;
+}
+
+bool PointerScanner::IsOnPath(const SearchContext &context, size_t depth, size_t index, uint64_t location)
+{
+    for (size_t d = depth; d > 0; --d)
+    {
+        const SearchNode &node = (*context.levels)[d][index];
+        if (node.location == location)
+            return true;
+        index = node.parent;
+    }
+    return false;
+}
+
+void PointerScanner::EmitChain(const SearchContext &context, size_t depth, size_t index, uintptr_t offset,
+                               const RootModule &module, uint64_t location, std::vector<PointerChain> &chains)
+{
+    PointerChain chain;
+    chain.moduleName = *module.name;
+    chain.baseOffset = static_cast<uintptr_t>(location - module.base);
+    chain.offsets.push_back(offset);
+    for (size_t d = depth; d > 0; --d)
+    {
+        const SearchNode &node = (*context.levels)[d][index];
+        chain.offsets.push_back(node.offset);
+        index = node.parent;
+    }
+    chains.push_back(std::move(chain));
+    (*context.resultCount)++;
+}
+
+void PointerScanner::Expand(const SearchContext &context, size_t depth, size_t index, std::vector<PointerChain> &chains,
+                            std::vector<SearchNode> &children) const
+{
+    const PointerScanOptions &options = *context.options;
+    const uint64_t address = (*context.levels)[depth][index].location;
+    const bool expandChildren = depth + 1 < options.maxDepth;
+
+    uint64_t low = address > options.maxOffset ? address - options.maxOffset : 0;
+    ForEachReferrer(low, address, [&](const PointerMapEntry &entry)
+                    {
+                        // One chain past maxResults is enough to know the result set is capped
+                        if (*context.resultCount > options.maxResults)
+                            return false;
+
+                        uintptr_t offset = static_cast<uintptr_t>(address - entry.value);
+                        if (const RootModule *module = FindModule(*context.modules, entry.location))
+                        {
+                            EmitChain(context, depth, index, offset, *module, entry.location, chains);
+                        }
+                        else if (expandChildren && !IsOnPath(context, depth, index, entry.location))
+                        {
+                            if (context.queuedNodes->fetch_add(1) < context.nodeBudget)
+                                children.push_back({entry.location, offset, index});
+                            else
+                                *context.budgetReached = true;
+                        }
+                        return true;
+                    });
+}
+
+std::vector<PointerChain> PointerScanner::FindChains(const ModuleRegistry &registry, const PointerScanOptions &options)
+{
+    return FindChains(registry.GetModules(), options);
+}
+
+std::vector<PointerChain> PointerScanner::FindChains(const PointerScanOptions &options)
+{
+    return FindChains(m_file.GetModules(), options);
+}
+
+std::vector<PointerChain> PointerScanner::FindChains(const std::vector<ModuleInfo> &roots, const PointerScanOptions &options)
+{
+    auto start = std::chrono::steady_clock::now();
+    m_stats.nodesVisited = 0;
+    m_stats.resultsCapped = false;
+    m_stats.budgetReached = false;
+    m_stats.searchMs = 0;
+
+    std::vector<RootModule> modules;
+    for (const ModuleInfo &info : roots)
+    {
+        modules.push_back({info.baseAddress, info.baseAddress + info.size, &info.name});
+    }
+    std::sort(modules.begin(), modules.end(), [](const RootModule &a, const RootModule &b)
+              { return a.base < b.base; });
+
+    if (options.maxDepth == 0 || !HasPointerMap())
+        return {};
+
+    unsigned threadCount = options.threadCount;
+    if (threadCount == 0)
+        threadCount = (std::max)(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::vector<SearchNode>> levels(1);
+    levels[0].push_back({options.target, 0, 0});
+    std::atomic<size_t> resultCount(0);
+    std::atomic<uint64_t> queuedNodes(1);
+    std::atomic<uint64_t> nodes(0);
+    std::atomic<bool> budgetReached(false);
+
+    SearchContext context;
+    context.options = &options;
+    context.modules = &modules;
+    context.levels = &levels;
+    context.nodeBudget = options.maxNodes != 0 ? options.maxNodes : UINT64_MAX;
+    context.resultCount = &resultCount;
+    context.queuedNodes = &queuedNodes;
+    context.budgetReached = &budgetReached;
+
+    // Level by level: every chain of n dereferences is found before any chain of n + 1
+    std::vector<PointerChain> chains;
+    for (size_t depth = 0; depth < options.maxDepth && !levels[depth].empty(); ++depth)
+    {
+        const size_t levelSize = levels[depth].size();
+        const size_t batchCount = (levelSize + SEARCH_BATCH - 1) / SEARCH_BATCH;
+        std::vector<std::vector<PointerChain>> found(batchCount);
+        std::vector<std::vector<SearchNode>> children(batchCount);
+        std::atomic<size_t> nextBatch(0);
+
+        auto worker = [&]()
+        {
+            uint64_t expanded = 0;
+            for (size_t b = nextBatch++; b < batchCount && resultCount <= options.maxResults; b = nextBatch++)
+            {
+                size_t end = (std::min)((b + 1) * SEARCH_BATCH, levelSize);
+                for (size_t n = b * SEARCH_BATCH; n < end && resultCount <= options.maxResults; ++n)
+                {
+                    Expand(context, depth, n, found[b], children[b]);
+                    expanded++;
+                }
+            }
+            nodes += expanded;
+        };
+
+        unsigned levelThreads = static_cast<unsigned>((std::min)(static_cast<size_t>(threadCount), batchCount));
+        std::vector<std::thread> threads;
+        for (unsigned t = 1; t < levelThreads; ++t)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        // Batches in order keep the next level independent of thread timing (short of a limit)
+        std::vector<SearchNode> next;
+        for (size_t b = 0; b < batchCount; ++b)
+        {
+            for (PointerChain &chain : found[b])
+            {
+                chains.push_back(std::move(chain));
+            }
+            next.insert(next.end(), children[b].begin(), children[b].end());
+        }
+        if (resultCount > options.maxResults)
+            break;
+        levels.push_back(std::move(next));
+    }
+
+    // Shortest chains are the most stable, ties by module and offsets for a repeatable order
+    std::sort(chains.begin(), chains.end(), [](const PointerChain &a, const PointerChain &b)
+              {
+                  if (a.offsets.size() != b.offsets.size())
+                      return a.offsets.size() < b.offsets.size();
+                  if (a.moduleName != b.moduleName)
+                      return a.moduleName < b.moduleName;
+                  if (a.baseOffset != b.baseOffset)
+                      return a.baseOffset < b.baseOffset;
+                  return a.offsets < b.offsets;
+              });
+    if (chains.size() > options.maxResults)
+    {
+        chains.resize(options.maxResults);
+        m_stats.resultsCapped = true;
+    }
+
+    m_stats.nodesVisited = nodes;
+    m_stats.budgetReached = budgetReached;
+    m_stats.searchMs = ElapsedMs(start);
+    DBG_OK(L"Pointer scan: " + std::to_wstring(chains.size()) + L" chains, " + std::to_wstring(m_stats.nodesVisited) +
+           L" nodes expanded");
+    return chains;
+}
+
+void PointerScanner::PrintChains(const std::vector<PointerChain> &chains, size_t maxLines)
+{
+    size_t shown = (std::min)(chains.size(), maxLines);
+    for (size_t i = 0; i < shown; ++i)
+    {
+        const PointerChain &chain = chains[i];
+        std::wcout << L"  " << std::setw(4) << (i + 1) << L". " << chain.moduleName << L"+0x" << std::hex
+                   << std::uppercase << chain.baseOffset;
+        for (uintptr_t offset : chain.offsets)
+        {
+            std::wcout << L" -> 0x" << offset;
+        }
+        std::wcout << std::dec << std::endl;
+    }
+    if (chains.size() > shown)
+    {
+        std::wcout << L"  ... " << (chains.size() - shown) << L" more" << std::endl;
+    }
+}
@@ -0,0 +1,142 @@
+#pragma once
+#include <windows.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ModuleRegistry.h"
+#include "PointerChainResolver.h"
+#include "PointerMapFile.h"
+
+// ============================================================================
+// PointerScanner: Finds pointer chains from module statics to a target address
+// Purpose: Discover "app.dll"+0x649910 -> 0x18 -> 0x70 -> 0x2D0 style chains
+// without a debugger, results go straight into PointerChainStorage
+// - pointer map: committed readable regions (file mappings excluded) are
+//   read in 1 MB slices on a worker pool, every 8-byte aligned value that
+//   points into a scanned region is kept as (value, location), then sorted
+//   by value (reverse map)
+// - the map is capped by a memory budget, a truncated map is reported and
+//   can miss chains
+// - search: breadth-first from the target backwards, locations holding a
+//   value within [address - maxOffset, address] are the next level; a
+//   location inside a module of the registry ends the chain. Each level is
+//   split over the worker pool and finished before the next one starts, so
+//   shorter chains fill maxResults first; maxNodes bounds the expansions
+// - a map can be saved (PointerMapFile) and searched again offline, against
+//   the module bases of the run it was captured in
+// ============================================================================
+
+struct PointerScanOptions
+{
+    uintptr_t target = 0;
+    size_t maxDepth = 5;          // Maximum number of dereferences
+    uintptr_t maxOffset = 0x1000; // Maximum offset added to a pointer
+    size_t maxResults = 10000;    // Search stops once this many chains are found
+    uint64_t maxNodes = 10000000; // Addresses the search may expand, 24 bytes each (0 = no limit)
+    unsigned threadCount = 0;     // 0 = one worker per hardware thread
+};
+
+struct PointerScanStats
+{
+    size_t regionCount = 0;
+    uint64_t bytesScanned = 0;
+    size_t unreadablePages = 0;
+    bool truncated = false;      // Memory budget reached, map is incomplete
+    double mapMs = 0;
+    uint64_t nodesVisited = 0;   // Addresses expanded by the last search
+    bool resultsCapped = false;  // Last search found more than maxResults chains, the rest were dropped
+    bool budgetReached = false;  // Last search stopped expanding at maxNodes
+    double searchMs = 0;
+};
+
+class PointerScanner
+{
+public:
+    static constexpr size_t SLICE_SIZE = 1 << 20;
+    static constexpr size_t SEARCH_BATCH = 256; // Nodes of a level per worker task
+
+    // Build the reverse pointer map of all readable memory of a process
+    // memoryBudget: bytes the map may use (16 bytes per pointer), merging the
+    // per-slice lists briefly needs up to twice that
+    bool BuildPointerMap(HANDLE hProcess, size_t memoryBudget, unsigned threadCount = 0);
+
+    // Save the built map with the module bases of registry
+    bool SavePointerMap(const std::wstring &filename, const ModuleRegistry &registry) const;
+
+    // Map a saved pointer map, replaces the current map
+    bool LoadPointerMap(const std::wstring &filename);
+
+    // Chains from module statics to options.target, shortest first
+    // Offsets are in PointerChain order (root first), description/valueType left empty
+    std::vector<PointerChain> FindChains(const ModuleRegistry &registry, const PointerScanOptions &options);
+
+    // Same, rooted at the modules stored with a loaded map file
+    std::vector<PointerChain> FindChains(const PointerScanOptions &options);
+
+    void Clear();
+
+    bool HasPointerMap() const { return !m_entries.empty() || m_file.IsOpen(); }
+    bool IsOffline() const { return m_file.IsOpen(); }
+    size_t GetPointerCount() const;
+    const PointerScanStats &GetStats() const { return m_stats; }
+    const PointerMapFile &GetMapFile() const { return m_file; }
+
+    // Print chains as module+0xBASE -> off -> off
+    static void PrintChains(const std::vector<PointerChain> &chains, size_t maxLines);
+
+private:
+    struct RootModule
+    {
+        uintptr_t base;
+        uintptr_t end;
+        const std::wstring *name;
+    };
+
+    // Location on a chain, parent is its index in the previous level
+    struct SearchNode
+    {
+        uint64_t location;
+        uintptr_t offset; // Added to the value at location
+        size_t parent;
+    };
+
+    struct SearchContext
+    {
+        const PointerScanOptions *options;
+        const std::vector<RootModule> *modules;
+        const std::vector<std::vector<SearchNode>> *levels; // levels[0] holds the target
+        uint64_t nodeBudget;
+        std::atomic<size_t> *resultCount;
+        std::atomic<uint64_t> *queuedNodes;
+        std::atomic<bool> *budgetReached;
+    };
+
+    std::vector<MemoryRegion> m_regions;    // Readable, sorted, adjacent regions merged
+    std::vector<PointerMapEntry> m_entries; // Sorted by value
+    PointerMapFile m_file;                  // Loaded map, used instead of m_entries
+    PointerScanStats m_stats;
+
+    // True if address lies in a scanned region
+    bool IsMapped(uint64_t address) const;
+
+    // Call f(entry) for pointers with value in [begin, end] until f returns false
+    template <typename F>
+    void ForEachReferrer(uint64_t begin, uint64_t end, F &&f) const;
+
+    std::vector<PointerChain> FindChains(const std::vector<ModuleInfo> &roots, const PointerScanOptions &options);
+
+    // Expand levels[depth][index]: chains ending in a module go to chains,
+    // other referrers to children (the next level) while the node budget lasts
+    void Expand(const SearchContext &context, size_t depth, size_t index, std::vector<PointerChain> &chains,
+                std::vector<SearchNode> &children) const;
+
+    // True if location is levels[depth][index] or one of its parents
+    static bool IsOnPath(const SearchContext &context, size_t depth, size_t index, uint64_t location);
+
+    // Emit the chain module location -> offset -> levels[depth][index] -> ... -> target
+    static void EmitChain(const SearchContext &context, size_t depth, size_t index, uintptr_t offset,
+                          const RootModule &module, uint64_t location, std::vector<PointerChain> &chains);
+
+    static const RootModule *FindModule(const std::vector<RootModule> &modules, uint64_t address);
+};
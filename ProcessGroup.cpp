@@ -0,0 +1,138 @@
+#include "ProcessGroup.h"
+#include "DebugLog.h"
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+int ProcessGroup::AttachAll(const std::wstring &processName)
+{
+    DBG_STEP(L"Attaching to all instances of: " + processName);
+    DetachAll();
+    m_processName = processName;
+
+    std::vector<DWORD> pids = ProcessManager::FindAllProcessIDs(processName);
+    if (pids.empty())
+    {
+        std::wcerr << L"[-] Process '" << processName << L"' not found." << std::endl;
+        return 0;
+    }
+
+    for (DWORD pid : pids)
+    {
+        auto instance = std::make_unique<ProcessInstance>();
+
+        if (!instance->process.AttachToPID(pid, processName))
+            continue;
+
+        instance->reader.SetProcessHandle(instance->process.GetHandle());
+        // Per-read error spam from dozens of instances is useless, failures
+        // are reported through PointerChain::lastError instead
+        instance->reader.SetLogErrors(false);
+
+        if (!instance->modules.LoadModules(pid))
+            continue;
+
+        m_instances.push_back(std::move(instance));
+    }
+
+    std::wcout << L"[+] Attached to " << m_instances.size() << L"/" << pids.size()
+               << L" instances of '" << processName << L"'" << std::endl;
+    return static_cast<int>(m_instances.size());
+}
+
+void ProcessGroup::DetachAll()
+{
+    if (!m_instances.empty())
+    {
+        DBG_INFO(L"Detaching from " + std::to_wstring(m_instances.size()) + L" instances");
+    }
+    m_instances.clear();
+}
+
+int ProcessGroup::ResolveAllChains(const std::vector<PointerChain> &chains)
+{
+    if (m_instances.empty())
+        return 0;
+
+    // Build the compact table once, every instance resolves its own copy
+    PointerChainTable table;
+    table.Build(chains);
+
+    for (auto &instance : m_instances)
+    {
+        instance->chains = chains;
+        instance->table = table;
+        instance->resolvedCount = 0;
+    }
+
+    // DebugLog writes to a shared file stream, keep it single-threaded
+    size_t workerCount = DebugLog::IsEnabled() ? 1 : (std::max)(1u, std::thread::hardware_concurrency());
+    workerCount = (std::min)(workerCount, m_instances.size());
+
+    std::atomic<size_t> nextInstance(0);
+    auto worker = [this, &nextInstance]()
+    {
+        size_t index;
+        while ((index = nextInstance.fetch_add(1)) < m_instances.size())
+        {
+            ProcessInstance &instance = *m_instances[index];
+            instance.resolvedCount = instance.resolver.ResolveTable(instance.table);
+            instance.table.ExportResults(instance.chains);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < workerCount; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    int total = 0;
+    for (const auto &instance : m_instances)
+    {
+        total += instance->resolvedCount;
+    }
+
+    DBG_OK(L"Resolved " + std::to_wstring(total) + L" chains across " + std::to_wstring(m_instances.size()) + L" instances");
+    return total;
+}
+
+void ProcessGroup::PrintResults() const
+{
+    if (m_instances.empty())
+    {
+        std::wcout << L"[-] No instances attached." << std::endl;
+        return;
+    }
+
+    for (const auto &instance : m_instances)
+    {
+        std::wcout << L"\n=== PID " << instance->process.GetPID() << L" ("
+                   << instance->resolvedCount << L"/" << instance->chains.size()
+                   << L" resolved) ===\n";
+
+        for (size_t i = 0; i < instance->chains.size(); ++i)
+        {
+            const auto &chain = instance->chains[i];
+            std::wcout << L"  [" << i + 1 << L"] " << chain.description << L": ";
+
+            if (chain.isResolved)
+            {
+                std::wcout << chain.currentValue.ToString()
+                           << L" @ 0x" << std::hex << std::uppercase << chain.resolvedAddress << std::dec;
+            }
+            else
+            {
+                std::wcout << L"[-] " << chain.lastError;
+            }
+            std::wcout << L"\n";
+        }
+    }
+    std::wcout << std::endl;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "ProcessManager.h"
+#include "ModuleRegistry.h"
+#include "MemoryReader.h"
+#include "PointerChainResolver.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// ProcessGroup: Multi-process attachment
+// Purpose: Attach to every process with a given name at once
+// Each instance owns its own ModuleRegistry / MemoryReader (ASLR differs
+// per process) and resolves the same chain set in parallel
+// ============================================================================
+
+struct ProcessInstance
+{
+    ProcessManager process;
+    ModuleRegistry modules;
+    MemoryReader reader;
+    PointerChainResolver resolver;
+
+    // Per-instance copy of the chain set with runtime results
+    std::vector<PointerChain> chains;
+    PointerChainTable table;
+    int resolvedCount;
+
+    ProcessInstance()
+        : reader(NULL), resolver(&modules, &reader), resolvedCount(0)
+    {
+    }
+
+    ProcessInstance(const ProcessInstance &) = delete;
+    ProcessInstance &operator=(const ProcessInstance &) = delete;
+};
+
+class ProcessGroup
+{
+private:
+    std::vector<std::unique_ptr<ProcessInstance>> m_instances;
+    std::wstring m_processName;
+
+public:
+    ProcessGroup() = default;
+
+    // Attach to all processes named processName, returns attached count
+    int AttachAll(const std::wstring &processName);
+
+    // Detach from all instances
+    void DetachAll();
+
+    bool IsAttached() const { return !m_instances.empty(); }
+    size_t Count() const { return m_instances.size(); }
+    const std::wstring &GetProcessName() const { return m_processName; }
+    const ProcessInstance &GetInstance(size_t index) const { return *m_instances[index]; }
+
+    // Resolve the chain set against every instance in parallel
+    // Returns total number of resolved chains across all instances
+    int ResolveAllChains(const std::vector<PointerChain> &chains);
+
+    // Print per-instance results to console
+    void PrintResults() const;
+};
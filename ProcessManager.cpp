@@ -23,17 +23,29 @@ bool ProcessManager::AttachToProcess(const std::wstring &processName)
         Detach();
     }
 
-    m_processName = processName;
-    m_pid = FindProcessID(processName);
+    DWORD pid = FindProcessID(processName);
 
-    if (m_pid == 0)
+    if (pid == 0)
     {
         DBG_ERR(L"Process not found: " + processName);
         std::wcerr << L"[-] Process '" << processName << L"' not found." << std::endl;
         return false;
     }
 
-    DBG_INFO(L"Found process PID: " + std::to_wstring(m_pid));
+    DBG_INFO(L"Found process PID: " + std::to_wstring(pid));
+    return AttachToPID(pid, processName);
+}
+
+bool ProcessManager::AttachToPID(DWORD pid, const std::wstring &processName)
+{
+    if (m_isAttached)
+    {
+        DBG_INFO(L"Already attached, detaching first...");
+        Detach();
+    }
+
+    m_processName = processName;
+    m_pid = pid;
 
     // Open process handle with read permissions
     m_hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, m_pid);
@@ -102,3 +114,36 @@ DWORD ProcessManager::FindProcessID(const std::wstring &processName)
     CloseHandle(hSnapshot);
     return pid;
 }
+
+std::vector<DWORD> ProcessManager::FindAllProcessIDs(const std::wstring &processName)
+{
+    DBG_STEP(L"Searching for all processes named: " + processName);
+    std::vector<DWORD> pids;
+    HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+
+    if (hSnapshot == INVALID_HANDLE_VALUE)
+    {
+        DBG_ERR(L"CreateToolhelp32Snapshot failed");
+        std::wcerr << L"[-] Failed to create process snapshot." << std::endl;
+        return pids;
+    }
+
+    PROCESSENTRY32W pe32;
+    pe32.dwSize = sizeof(PROCESSENTRY32W);
+
+    if (Process32FirstW(hSnapshot, &pe32))
+    {
+        do
+        {
+            if (_wcsicmp(processName.c_str(), pe32.szExeFile) == 0)
+            {
+                pids.push_back(pe32.th32ProcessID);
+                DBG_OK(L"Found matching process: " + std::wstring(pe32.szExeFile) + L" (PID: " + std::to_wstring(pe32.th32ProcessID) + L")");
+            }
+        } while (Process32NextW(hSnapshot, &pe32));
+    }
+
+    DBG_INFO(L"Found " + std::to_wstring(pids.size()) + L" matching processes");
+    CloseHandle(hSnapshot);
+    return pids;
+}
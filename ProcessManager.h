@@ -2,6 +2,7 @@
 #include <windows.h>
 #include <tlhelp32.h>
 #include <string>
+#include <vector>
 
 // ============================================================================
 // ProcessManager: Process management
@@ -23,6 +24,9 @@ public:
     // Find process by name
     bool AttachToProcess(const std::wstring &processName);
 
+    // Attach to a specific PID (used when several processes share a name)
+    bool AttachToPID(DWORD pid, const std::wstring &processName);
+
     // Detach from process
     void Detach();
 
@@ -38,6 +42,9 @@ public:
     // Get process name
     std::wstring GetProcessName() const { return m_processName; }
 
+    // Find PIDs of all processes with the given name
+    static std::vector<DWORD> FindAllProcessIDs(const std::wstring &processName);
+
 private:
     // Find PID by process name
     DWORD FindProcessID(const std::wstring &processName);
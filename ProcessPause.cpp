@@ -0,0 +1,256 @@
+#include "ProcessPause.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#ifdef __linux__
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#else
+#include <tlhelp32.h>
+#endif
+
+#ifdef __linux__
+// Scheduler state letter of a /proc stat file, 0 if unreadable
+static char ReadState(const std::string &statPath)
+{
+    int fd = open(statPath.c_str(), O_RDONLY);
+    if (fd < 0)
+        return 0;
+    char buffer[512];
+    ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (length <= 0)
+        return 0;
+    buffer[length] = 0;
+
+    // "tid (comm) S ...", comm may itself contain ')'
+    const char *paren = strrchr(buffer, ')');
+    return paren != nullptr && paren[1] == ' ' ? paren[2] : 0;
+}
+
+// True once every thread of the process is in a stopped state
+static bool AllThreadsStopped(DWORD processId)
+{
+    const std::string taskDir = "/proc/" + std::to_string(processId) + "/task";
+    DIR *dir = opendir(taskDir.c_str());
+    if (dir == nullptr)
+        return false;
+
+    bool stopped = true;
+    while (dirent *entry = readdir(dir))
+    {
+        if (entry->d_name[0] == '.')
+            continue;
+        char state = ReadState(taskDir + "/" + entry->d_name + "/stat");
+        if (state != 'T' && state != 't' && state != 0)
+        {
+            stopped = false;
+            break;
+        }
+    }
+    closedir(dir);
+    return stopped;
+}
+#endif
+
+void PauseHistogram::Add(double microseconds)
+{
+    size_t bucket = 0;
+    if (microseconds >= 1.0)
+        bucket = (std::min)(BUCKETS - 1, static_cast<size_t>(std::log2(microseconds)) + 1);
+    counts[bucket]++;
+
+    minUs = count == 0 ? microseconds : (std::min)(minUs, microseconds);
+    maxUs = count == 0 ? microseconds : (std::max)(maxUs, microseconds);
+    totalUs += microseconds;
+    count++;
+}
+
+void PauseHistogram::Clear()
+{
+    *this = PauseHistogram();
+}
+
+void PauseHistogram::Print() const
+{
+    if (count == 0)
+    {
+        std::wcout << L"[*] No target pauses recorded" << std::endl;
+        return;
+    }
+
+    std::wcout << L"[+] Target pauses: " << count << L", min " << std::fixed << std::setprecision(1) << minUs
+               << L" us, mean " << totalUs / count << L" us, max " << maxUs << L" us" << std::defaultfloat
+               << std::endl;
+
+    size_t first = 0;
+    size_t last = BUCKETS - 1;
+    while (counts[first] == 0)
+    {
+        first++;
+    }
+    while (counts[last] == 0)
+    {
+        last--;
+    }
+    const uint64_t peak = *std::max_element(counts + first, counts + last + 1);
+    for (size_t b = first; b <= last; ++b)
+    {
+        std::wcout << L"  ";
+        if (b == 0)
+            std::wcout << L"          < 1";
+        else if (b == BUCKETS - 1)
+            std::wcout << L"   >= " << std::setw(7) << (uint64_t(1) << (b - 1));
+        else
+            std::wcout << std::setw(6) << (uint64_t(1) << (b - 1)) << L"-" << std::setw(6) << (uint64_t(1) << b);
+        std::wcout << L" us |" << std::wstring(static_cast<size_t>(40 * counts[b] / peak), L'#')
+                   << L" " << counts[b] << std::endl;
+    }
+}
+
+ProcessPause::ProcessPause()
+    : m_processId(0), m_paused(false), m_lastPauseUs(0)
+#ifdef __linux__
+      ,
+      m_wasStopped(false)
+#endif
+{
+}
+
+ProcessPause::~ProcessPause()
+{
+    Release();
+}
+
+bool ProcessPause::Prepare(DWORD processId)
+{
+    Release();
+
+#ifdef __linux__
+    if (processId == static_cast<DWORD>(getpid()))
+    {
+        DBG_WARN(L"Cannot stop this process with SIGSTOP");
+        return false;
+    }
+    if (kill(static_cast<pid_t>(processId), 0) != 0)
+    {
+        DBG_WARN(L"No permission to signal process " + std::to_wstring(processId));
+        return false;
+    }
+    char state = ReadState("/proc/" + std::to_string(processId) + "/stat");
+    m_wasStopped = state == 'T' || state == 't';
+#else
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshot == INVALID_HANDLE_VALUE)
+        return false;
+
+    const DWORD self = GetCurrentThreadId();
+    THREADENTRY32 entry;
+    entry.dwSize = sizeof(entry);
+    for (BOOL more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry))
+    {
+        if (entry.th32OwnerProcessID != processId || entry.th32ThreadID == self)
+            continue;
+        HANDLE thread = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT, FALSE, entry.th32ThreadID);
+        if (thread != NULL)
+            m_threads.push_back(thread);
+    }
+    CloseHandle(snapshot);
+
+    if (m_threads.empty())
+    {
+        DBG_WARN(L"No threads of process " + std::to_wstring(processId) + L" could be opened");
+        return false;
+    }
+#endif
+
+    m_processId = processId;
+    return true;
+}
+
+void ProcessPause::Release()
+{
+    if (m_paused)
+        Resume();
+#ifndef __linux__
+    for (HANDLE thread : m_threads)
+    {
+        CloseHandle(thread);
+    }
+    m_threads.clear();
+#endif
+    m_processId = 0;
+}
+
+bool ProcessPause::Suspend()
+{
+    if (!IsPrepared() || m_paused)
+        return false;
+
+    m_suspendStart = std::chrono::steady_clock::now();
+
+#ifdef __linux__
+    if (!m_wasStopped)
+    {
+        if (kill(static_cast<pid_t>(m_processId), SIGSTOP) != 0)
+            return false;
+
+        // SIGSTOP is asynchronous, reads are consistent only once every thread stopped
+        while (!AllThreadsStopped(m_processId))
+        {
+            if (std::chrono::steady_clock::now() - m_suspendStart > std::chrono::milliseconds(STOP_TIMEOUT_MS))
+            {
+                kill(static_cast<pid_t>(m_processId), SIGCONT);
+                DBG_WARN(L"Threads of process " + std::to_wstring(m_processId) + L" did not stop");
+                return false;
+            }
+            std::this_thread::yield();
+        }
+    }
+#else
+    m_suspended.clear();
+    for (HANDLE thread : m_threads)
+    {
+        // Threads that exited since Prepare fail here and are skipped
+        if (SuspendThread(thread) == static_cast<DWORD>(-1))
+            continue;
+        m_suspended.push_back(thread);
+
+        // SuspendThread is asynchronous, reading the context waits until the thread is stopped
+        CONTEXT context;
+        context.ContextFlags = CONTEXT_CONTROL;
+        GetThreadContext(thread, &context);
+    }
+#endif
+
+    m_paused = true;
+    return true;
+}
+
+void ProcessPause::Resume()
+{
+    if (!m_paused)
+        return;
+
+#ifdef __linux__
+    if (!m_wasStopped)
+        kill(static_cast<pid_t>(m_processId), SIGCONT);
+#else
+    for (HANDLE thread : m_suspended)
+    {
+        ResumeThread(thread);
+    }
+    m_suspended.clear();
+#endif
+
+    m_paused = false;
+    m_lastPauseUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_suspendStart).count();
+    m_histogram.Add(m_lastPauseUs);
+}
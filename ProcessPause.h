@@ -0,0 +1,74 @@
+#pragma once
+#include "Platform.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// ProcessPause: Stops every thread of a target for one batch of reads
+// Purpose: Read related values (x/y/z, ammo/max ammo) from one moment
+// - Windows: Prepare opens the target's threads up front, Suspend only calls
+//   SuspendThread (plus GetThreadContext, which returns once the thread has
+//   really stopped); the calling thread is skipped when the target is this
+//   process, threads started after Prepare keep running
+// - Linux: SIGSTOP, then waits until every thread in /proc/<pid>/task is
+//   stopped; SIGCONT resumes. This process cannot stop itself, and a target
+//   that was already stopped is neither stopped nor continued
+// - every Suspend..Resume interval goes into a log2 histogram
+// ============================================================================
+
+struct PauseHistogram
+{
+    static constexpr size_t BUCKETS = 22; // < 1 us, [1, 2) us, [2, 4) us ... >= 2^20 us
+
+    uint64_t counts[BUCKETS] = {};
+    uint64_t count = 0;
+    double totalUs = 0;
+    double minUs = 0;
+    double maxUs = 0;
+
+    void Add(double microseconds);
+    void Clear();
+    void Print() const;
+};
+
+class ProcessPause
+{
+public:
+    static constexpr unsigned STOP_TIMEOUT_MS = 100; // Linux: give up if threads do not stop
+
+    ProcessPause();
+    ~ProcessPause();
+
+    ProcessPause(const ProcessPause &) = delete;
+    ProcessPause &operator=(const ProcessPause &) = delete;
+
+    // Look up the target's threads, false if it cannot be paused
+    bool Prepare(DWORD processId);
+    void Release();
+    bool IsPrepared() const { return m_processId != 0; }
+
+    // Stop the target, false (target left running) on failure
+    bool Suspend();
+
+    // Let the target run again and record the pause
+    void Resume();
+
+    double GetLastPauseUs() const { return m_lastPauseUs; }
+    const PauseHistogram &GetHistogram() const { return m_histogram; }
+    void ClearHistogram() { m_histogram.Clear(); }
+
+private:
+    DWORD m_processId;
+    bool m_paused;
+    std::chrono::steady_clock::time_point m_suspendStart;
+    double m_lastPauseUs;
+    PauseHistogram m_histogram;
+#ifdef __linux__
+    bool m_wasStopped; // Target stopped by someone else, leave it alone
+#else
+    std::vector<HANDLE> m_threads;   // Opened by Prepare
+    std::vector<HANDLE> m_suspended; // Suspended by the last Suspend
+#endif
+};
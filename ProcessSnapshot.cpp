@@ -0,0 +1,272 @@
+#include "ProcessSnapshot.h"
+#include "DebugLog.h"
+#include "Lz4Block.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+static constexpr uint64_t NO_CHUNK = ~uint64_t(0);
+
+static_assert(ProcessSnapshot::CHUNK_SIZE / ProcessSnapshot::PAGE_BYTES <= 16, "badPages mask holds 16 pages");
+
+ProcessSnapshot::ProcessSnapshot()
+    : m_header(nullptr), m_regions(nullptr), m_chunks(nullptr), m_regionCount(0), m_cacheNext(0)
+{
+    std::fill(m_cacheChunks, m_cacheChunks + CACHE_CHUNKS, NO_CHUNK);
+}
+
+bool ProcessSnapshot::IsSnapshot(const uint8_t *data, size_t size)
+{
+    return size >= sizeof(ProcessSnapshotHeader) &&
+           memcmp(data, PROCESS_SNAPSHOT_MAGIC, sizeof(PROCESS_SNAPSHOT_MAGIC)) == 0;
+}
+
+bool ProcessSnapshot::Open(const std::wstring &filename)
+{
+    Close();
+
+    if (!m_file.Open(filename))
+    {
+        std::wcerr << L"[-] Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    const uint8_t *data = m_file.Data();
+    uint64_t size = m_file.Size();
+
+    if (!IsSnapshot(data, static_cast<size_t>(size)))
+    {
+        std::wcerr << L"[-] Not a process snapshot: " << filename << std::endl;
+        m_file.Close();
+        return false;
+    }
+
+    const ProcessSnapshotHeader *header = reinterpret_cast<const ProcessSnapshotHeader *>(data);
+    if (header->version == 0 || header->version > PROCESS_SNAPSHOT_VERSION || header->chunkSize != CHUNK_SIZE)
+    {
+        std::wcerr << L"[-] Unsupported process snapshot version: " << header->version << std::endl;
+        m_file.Close();
+        return false;
+    }
+
+    // Every table must lie inside the file (checked without overflow)
+    auto tableFits = [size](uint64_t offset, uint64_t count, uint64_t elementSize)
+    {
+        return offset <= size && offset % 8 == 0 && count <= (size - offset) / elementSize;
+    };
+
+    if (!tableFits(header->moduleTableOffset, header->moduleCount, sizeof(SnapshotModule)) ||
+        !tableFits(header->regionTableOffset, header->regionCount, sizeof(SnapshotRegion)) ||
+        !tableFits(header->chunkIndexOffset, header->chunkCount, sizeof(SnapshotChunk)) ||
+        !tableFits(header->stringTableOffset, header->stringTableSize, 1))
+    {
+        std::wcerr << L"[-] Corrupted process snapshot (table out of bounds): " << filename << std::endl;
+        m_file.Close();
+        return false;
+    }
+
+    // Regions must be sorted, disjoint and own their chunk index range, Read relies on it
+    const SnapshotRegion *regions = reinterpret_cast<const SnapshotRegion *>(data + header->regionTableOffset);
+    uint64_t previousEnd = 0;
+    for (uint32_t i = 0; i < header->regionCount; ++i)
+    {
+        const SnapshotRegion &region = regions[i];
+        uint64_t chunks = (region.size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        if (region.size == 0 || region.baseAddress < previousEnd || region.baseAddress + region.size < region.baseAddress ||
+            region.firstChunk > header->chunkCount || chunks > header->chunkCount - region.firstChunk)
+        {
+            std::wcerr << L"[-] Corrupted process snapshot (region " << i << L"): " << filename << std::endl;
+            m_file.Close();
+            return false;
+        }
+        previousEnd = region.baseAddress + region.size;
+    }
+
+    // Module names are copied out once, chunk data stays in the mapping
+    const SnapshotModule *modules = reinterpret_cast<const SnapshotModule *>(data + header->moduleTableOffset);
+    const uint8_t *strings = data + header->stringTableOffset;
+    for (uint32_t i = 0; i < header->moduleCount; ++i)
+    {
+        ModuleInfo info;
+        info.baseAddress = static_cast<uintptr_t>(modules[i].baseAddress);
+        info.size = static_cast<uintptr_t>(modules[i].size);
+        info.fingerprint = modules[i].fingerprint;
+
+        uint64_t ref = modules[i].nameRef;
+        uint32_t length = 0;
+        if (ref > header->stringTableSize || header->stringTableSize - ref < sizeof(uint32_t))
+        {
+            std::wcerr << L"[-] Corrupted process snapshot (module name): " << filename << std::endl;
+            Close();
+            return false;
+        }
+        memcpy(&length, strings + ref, sizeof(length));
+        uint64_t charsOffset = ref + sizeof(uint32_t);
+        if (length > (header->stringTableSize - charsOffset) / sizeof(char16_t))
+        {
+            std::wcerr << L"[-] Corrupted process snapshot (module name): " << filename << std::endl;
+            Close();
+            return false;
+        }
+        info.name.resize(length);
+        for (uint32_t c = 0; c < length; ++c)
+        {
+            char16_t ch;
+            memcpy(&ch, strings + charsOffset + c * sizeof(char16_t), sizeof(ch));
+            info.name[c] = static_cast<wchar_t>(ch);
+        }
+        m_modules.push_back(info);
+    }
+
+    m_header = header;
+    m_regions = regions;
+    m_chunks = reinterpret_cast<const SnapshotChunk *>(data + header->chunkIndexOffset);
+    m_regionCount = header->regionCount;
+    m_filename = filename;
+    m_cacheData.resize(CACHE_CHUNKS * CHUNK_SIZE);
+
+    DBG_OK(L"Mapped process snapshot: " + std::to_wstring(header->regionCount) + L" regions, " +
+           std::to_wstring(header->capturedBytes >> 20) + L" MB, " + std::to_wstring(header->moduleCount) +
+           L" modules");
+    return true;
+}
+
+void ProcessSnapshot::Close()
+{
+    m_file.Close();
+    m_filename.clear();
+    m_header = nullptr;
+    m_regions = nullptr;
+    m_chunks = nullptr;
+    m_regionCount = 0;
+    m_modules.clear();
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_cacheData.clear();
+    m_cacheData.shrink_to_fit();
+    std::fill(m_cacheChunks, m_cacheChunks + CACHE_CHUNKS, NO_CHUNK);
+    m_cacheNext = 0;
+}
+
+bool ProcessSnapshot::FindChunk(uintptr_t address, SnapshotChunkView &out) const
+{
+    if (!IsOpen())
+        return false;
+
+    // Last region starting at or below the address
+    const SnapshotRegion *region =
+        std::upper_bound(m_regions, m_regions + m_regionCount, static_cast<uint64_t>(address),
+                         [](uint64_t value, const SnapshotRegion &r) { return value < r.baseAddress; });
+    if (region == m_regions)
+        return false;
+    region--;
+    uint64_t regionOffset = address - region->baseAddress;
+    if (regionOffset >= region->size)
+        return false;
+
+    uint64_t chunkStart = regionOffset / CHUNK_SIZE * CHUNK_SIZE;
+    out.index = region->firstChunk + regionOffset / CHUNK_SIZE;
+    out.address = static_cast<uintptr_t>(region->baseAddress + chunkStart);
+    out.length = static_cast<size_t>((std::min)(static_cast<uint64_t>(CHUNK_SIZE), region->size - chunkStart));
+
+    const SnapshotChunk &entry = m_chunks[out.index];
+    const uint64_t fileSize = m_file.Size();
+    if (entry.dataOffset > fileSize || entry.storedSize > fileSize - entry.dataOffset ||
+        (entry.encoding == SNAPSHOT_RAW && entry.storedSize != out.length))
+    {
+        DBG_WARN(L"Corrupted snapshot chunk " + std::to_wstring(out.index));
+        return false;
+    }
+    out.encoding = entry.encoding;
+    out.badPages = entry.badPages;
+    out.stored = m_file.Data() + entry.dataOffset;
+    out.storedSize = entry.storedSize;
+    return true;
+}
+
+bool ProcessSnapshot::DecodeChunk(const SnapshotChunkView &chunk, uint8_t *out) const
+{
+    switch (chunk.encoding)
+    {
+    case SNAPSHOT_ZERO:
+        memset(out, 0, chunk.length);
+        return true;
+    case SNAPSHOT_RAW:
+        memcpy(out, chunk.stored, chunk.length);
+        return true;
+    case SNAPSHOT_LZ4:
+        if (Lz4Block::Decompress(chunk.stored, chunk.storedSize, out, chunk.length))
+            return true;
+        break;
+    }
+
+    DBG_WARN(L"Corrupted snapshot chunk " + std::to_wstring(chunk.index));
+    return false;
+}
+
+bool ProcessSnapshot::ReadChunk(const SnapshotChunkView &chunk, size_t offset, uint8_t *out, size_t size) const
+{
+    // Reads never touch a page that was unreadable at capture time
+    uint32_t pages = 0;
+    for (size_t page = offset / PAGE_BYTES; page <= (offset + size - 1) / PAGE_BYTES; ++page)
+    {
+        pages |= 1u << page;
+    }
+    if ((chunk.badPages & pages) != 0)
+        return false;
+
+    switch (chunk.encoding)
+    {
+    case SNAPSHOT_ZERO:
+        memset(out, 0, size);
+        return true;
+    case SNAPSHOT_RAW:
+        memcpy(out, chunk.stored + offset, size);
+        return true;
+    case SNAPSHOT_LZ4:
+        break;
+    default:
+        DBG_WARN(L"Corrupted snapshot chunk " + std::to_wstring(chunk.index));
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    size_t slot = 0;
+    while (slot < CACHE_CHUNKS && m_cacheChunks[slot] != chunk.index)
+    {
+        slot++;
+    }
+    if (slot == CACHE_CHUNKS)
+    {
+        slot = m_cacheNext;
+        m_cacheNext = (m_cacheNext + 1) % CACHE_CHUNKS;
+        m_cacheChunks[slot] = NO_CHUNK;
+        if (!DecodeChunk(chunk, &m_cacheData[slot * CHUNK_SIZE]))
+            return false;
+        m_cacheChunks[slot] = chunk.index;
+    }
+    memcpy(out, &m_cacheData[slot * CHUNK_SIZE + offset], size);
+    return true;
+}
+
+bool ProcessSnapshot::Read(uintptr_t address, void *buffer, size_t size) const
+{
+    uint8_t *out = static_cast<uint8_t *>(buffer);
+    uintptr_t current = address;
+    while (size > 0)
+    {
+        SnapshotChunkView chunk;
+        if (!FindChunk(current, chunk))
+            return false;
+
+        size_t offset = current - chunk.address;
+        size_t length = (std::min)(size, chunk.length - offset);
+        if (!ReadChunk(chunk, offset, out, length))
+            return false;
+
+        out += length;
+        current += length;
+        size -= length;
+    }
+    return true;
+}
@@ -0,0 +1,182 @@
+#pragma once
+#include "Platform.h"
+#include "MappedFile.h"
+#include "ModuleRegistry.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// ProcessSnapshot: Captured memory of one target run (.psnap)
+// Purpose: Resolve chains offline, after the target exited or on another host
+// - capture reads the committed regions in 64 KB chunks on a worker pool,
+//   each worker compresses its chunk (LZ4 block, Lz4Block.h) and appends it
+//   to the file, only one chunk per worker is held in memory
+// - all-zero chunks take no space, chunks that do not compress are stored raw
+// - pages that could not be read are flagged per chunk, reads touching them fail
+// - opened snapshots are a read-only source for MemoryReader (SetSnapshot),
+//   chunks are decompressed on demand into a small cache
+// - the reader (ProcessSnapshot.cpp) needs only MappedFile and Lz4Block, so
+//   analysis hosts without the target's OS open snapshots; Capture
+//   (ProcessSnapshotCapture.cpp) reads the live process through MemoryReader
+//
+// File layout (little-endian, all tables 8-byte aligned):
+//   ProcessSnapshotHeader
+//   Chunk data                    - per chunk: LZ4 block or raw bytes, in
+//                                   the order workers finished them
+//   SnapshotModule[moduleCount]   - module list at capture time
+//   SnapshotRegion[regionCount]   - captured regions, sorted by base
+//   SnapshotChunk[chunkCount]     - chunk index, region by region
+//   String table                  - [uint32 length][UTF-16 chars], 4-aligned
+// The header is written last, an interrupted capture leaves no valid magic
+// ============================================================================
+
+constexpr char PROCESS_SNAPSHOT_MAGIC[4] = {'P', 'S', 'N', 'P'};
+constexpr uint32_t PROCESS_SNAPSHOT_VERSION = 1;
+
+enum SnapshotEncoding : uint16_t
+{
+    SNAPSHOT_ZERO = 0, // All bytes zero, no data stored
+    SNAPSHOT_RAW = 1,  // Stored as is
+    SNAPSHOT_LZ4 = 2   // LZ4 block
+};
+
+struct ProcessSnapshotHeader
+{
+    char magic[4];              // "PSNP"
+    uint32_t version;           // PROCESS_SNAPSHOT_VERSION
+    uint32_t moduleCount;       // Entries in module table
+    uint32_t regionCount;       // Entries in region table
+    uint32_t chunkSize;         // Bytes per chunk (last chunk of a region may be short)
+    uint32_t processId;         // Target process at capture time
+    uint64_t chunkCount;        // Entries in chunk index
+    uint64_t timestamp;         // Capture time, seconds since 1970
+    uint64_t capturedBytes;     // Sum of region sizes
+    uint64_t storedBytes;       // Chunk data size in bytes
+    uint64_t moduleTableOffset; // File offset of module table
+    uint64_t regionTableOffset; // File offset of region table
+    uint64_t chunkIndexOffset;  // File offset of chunk index
+    uint64_t stringTableOffset; // File offset of string table
+    uint64_t stringTableSize;   // String table size in bytes
+};
+
+struct SnapshotModule
+{
+    uint64_t baseAddress;
+    uint64_t size;
+    uint64_t fingerprint; // ModuleInfo::fingerprint, 0 if not hashed
+    uint32_t nameRef;     // String table offset of module name
+    uint32_t reserved;    // Always 0
+};
+
+struct SnapshotRegion
+{
+    uint64_t baseAddress;
+    uint64_t size;
+    uint64_t firstChunk; // Chunk index entry of the region's first chunk
+};
+
+struct SnapshotChunk
+{
+    uint64_t dataOffset; // File offset of the stored bytes
+    uint32_t storedSize; // Stored bytes, 0 for SNAPSHOT_ZERO
+    uint16_t encoding;   // SnapshotEncoding
+    uint16_t badPages;   // Bit per 4 KB page that could not be read
+};
+
+// One chunk of an opened snapshot, stored bytes point into the mapping
+struct SnapshotChunkView
+{
+    uint64_t index;        // Chunk index entry
+    uintptr_t address;     // First byte of the chunk
+    size_t length;         // Bytes in the chunk
+    uint16_t encoding;     // SnapshotEncoding
+    uint16_t badPages;     // Bit per 4 KB page that could not be read
+    const uint8_t *stored; // Stored bytes
+    uint32_t storedSize;
+};
+
+static_assert(sizeof(ProcessSnapshotHeader) == 96, "ProcessSnapshotHeader layout changed");
+static_assert(sizeof(SnapshotModule) == 32, "SnapshotModule layout changed");
+static_assert(sizeof(SnapshotRegion) == 24, "SnapshotRegion layout changed");
+static_assert(sizeof(SnapshotChunk) == 16, "SnapshotChunk layout changed");
+
+struct SnapshotCaptureStats
+{
+    size_t regionCount = 0;
+    uint64_t chunkCount = 0;
+    uint64_t capturedBytes = 0; // Region bytes
+    uint64_t storedBytes = 0;   // Chunk data bytes in the file
+    uint64_t zeroChunks = 0;
+    uint64_t rawChunks = 0;
+    size_t unreadablePages = 0;
+    double captureMs = 0;
+};
+
+class ProcessSnapshot
+{
+public:
+    static constexpr size_t CHUNK_SIZE = 0x10000;
+    static constexpr size_t PAGE_BYTES = 0x1000;
+    static constexpr size_t CACHE_CHUNKS = 16; // Decompressed chunks kept for reads
+
+    ProcessSnapshot();
+
+    ProcessSnapshot(const ProcessSnapshot &) = delete;
+    ProcessSnapshot &operator=(const ProcessSnapshot &) = delete;
+
+    // Map a snapshot file and validate its tables
+    bool Open(const std::wstring &filename);
+    void Close();
+    bool IsOpen() const { return m_header != nullptr; }
+
+    const std::wstring &GetFilename() const { return m_filename; }
+    uint64_t GetTimestamp() const { return m_header ? m_header->timestamp : 0; }
+    uint32_t GetProcessId() const { return m_header ? m_header->processId : 0; }
+    uint64_t CapturedBytes() const { return m_header ? m_header->capturedBytes : 0; }
+    uint64_t StoredBytes() const { return m_header ? m_header->storedBytes : 0; }
+    size_t RegionCount() const { return m_regionCount; }
+    const SnapshotRegion *GetRegions() const { return m_regions; }
+    uint64_t FileSize() const { return m_file.Size(); }
+
+    // Modules at capture time
+    const std::vector<ModuleInfo> &GetModules() const { return m_modules; }
+
+    // Copy captured bytes, false if any byte lies outside the captured regions
+    // or on a page that could not be read (thread-safe)
+    bool Read(uintptr_t address, void *buffer, size_t size) const;
+
+    // Chunk holding address, false outside the captured regions
+    bool FindChunk(uintptr_t address, SnapshotChunkView &out) const;
+
+    // Decompress a whole chunk into out (chunk.length bytes), bypasses the
+    // read cache so workers can decode in parallel
+    bool DecodeChunk(const SnapshotChunkView &chunk, uint8_t *out) const;
+
+    // Check for snapshot magic at the start of a buffer
+    static bool IsSnapshot(const uint8_t *data, size_t size);
+
+    // Capture the readable committed memory and the module list of a process
+    static bool Capture(HANDLE hProcess, const std::vector<ModuleInfo> &modules, const std::wstring &filename,
+                        unsigned threadCount = 0, SnapshotCaptureStats *stats = nullptr);
+
+private:
+    MappedFile m_file;
+    std::wstring m_filename;
+    const ProcessSnapshotHeader *m_header;
+    const SnapshotRegion *m_regions;
+    const SnapshotChunk *m_chunks;
+    size_t m_regionCount;
+    std::vector<ModuleInfo> m_modules;
+
+    // Decompressed LZ4 chunks, replaced round robin
+    mutable std::mutex m_cacheMutex;
+    mutable std::vector<uint8_t> m_cacheData;
+    mutable uint64_t m_cacheChunks[CACHE_CHUNKS];
+    mutable size_t m_cacheNext;
+
+    // Copy [offset, offset + size) of one chunk
+    bool ReadChunk(const SnapshotChunkView &chunk, size_t offset, uint8_t *out, size_t size) const;
+};
@@ -0,0 +1,242 @@
+#include "ProcessSnapshot.h"
+#include "DebugLog.h"
+#include "Lz4Block.h"
+#include "MemoryReader.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Append [uint32 length][UTF-16 chars] padded to 4 bytes, returns its offset
+static uint32_t AppendString(std::vector<uint8_t> &table, const std::wstring &str)
+{
+    uint32_t ref = static_cast<uint32_t>(table.size());
+    uint32_t length = static_cast<uint32_t>(str.size());
+
+    size_t pos = table.size();
+    table.resize(AlignUp(pos + sizeof(uint32_t) + length * sizeof(char16_t), 4));
+    memcpy(&table[pos], &length, sizeof(length));
+
+    char16_t *chars = reinterpret_cast<char16_t *>(&table[pos + sizeof(uint32_t)]);
+    for (uint32_t i = 0; i < length; ++i)
+    {
+        chars[i] = static_cast<char16_t>(str[i]);
+    }
+    return ref;
+}
+
+static bool IsZero(const uint8_t *data, size_t size)
+{
+    uint64_t bits = 0;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        bits |= word;
+    }
+    for (; i < size; ++i)
+    {
+        bits |= data[i];
+    }
+    return bits == 0;
+}
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool ProcessSnapshot::Capture(HANDLE hProcess, const std::vector<ModuleInfo> &modules, const std::wstring &filename,
+                              unsigned threadCount, SnapshotCaptureStats *stats)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<MemoryRegion> regions;
+    MemoryReader::EnumerateRegions(hProcess, regions);
+    if (regions.empty())
+    {
+        std::wcerr << L"[-] No readable memory regions found" << std::endl;
+        return false;
+    }
+
+    // Chunk index entries are filled by the workers, the table is written after the data
+    struct ChunkTask
+    {
+        uintptr_t address;
+        uint32_t length;
+    };
+    std::vector<SnapshotRegion> fileRegions;
+    std::vector<ChunkTask> tasks;
+    uint64_t capturedBytes = 0;
+    for (const MemoryRegion &region : regions)
+    {
+        fileRegions.push_back({region.base, region.size, tasks.size()});
+        for (uint64_t offset = 0; offset < region.size; offset += CHUNK_SIZE)
+        {
+            uint32_t length = static_cast<uint32_t>((std::min)(static_cast<uint64_t>(CHUNK_SIZE), region.size - offset));
+            tasks.push_back({static_cast<uintptr_t>(region.base + offset), length});
+        }
+        capturedBytes += region.size;
+    }
+    std::vector<SnapshotChunk> chunks(tasks.size());
+
+    std::ofstream file(std::filesystem::path(filename), std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::wcerr << L"[-] Failed to create file: " << filename << std::endl;
+        return false;
+    }
+
+    // Placeholder header without magic, replaced once the tables are written
+    ProcessSnapshotHeader header = {};
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    uint64_t dataEnd = sizeof(header);
+
+    if (threadCount == 0)
+        threadCount = (std::max)(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<unsigned>((std::max)(size_t(1), (std::min)(static_cast<size_t>(threadCount), tasks.size())));
+
+    std::mutex fileMutex;
+    std::atomic<size_t> nextTask(0);
+    std::atomic<size_t> unreadablePages(0);
+    std::atomic<uint64_t> zeroChunks(0);
+    std::atomic<uint64_t> rawChunks(0);
+
+    auto worker = [&]()
+    {
+        std::vector<uint8_t> buffer(CHUNK_SIZE);
+        std::vector<uint8_t> packed(Lz4Block::Bound(CHUNK_SIZE));
+        std::vector<uint32_t> badPages;
+        for (size_t t = nextTask++; t < tasks.size(); t = nextTask++)
+        {
+            const ChunkTask &task = tasks[t];
+            SnapshotChunk &chunk = chunks[t];
+
+            badPages.clear();
+            unreadablePages += MemoryReader::ReadRangePadded(hProcess, task.address, buffer.data(), task.length, &badPages);
+            for (uint32_t page : badPages)
+            {
+                chunk.badPages |= static_cast<uint16_t>(1u << page);
+            }
+
+            // Unreadable pages are zero-filled, so a chunk of only those is stored as zero too
+            if (IsZero(buffer.data(), task.length))
+            {
+                chunk.encoding = SNAPSHOT_ZERO;
+                zeroChunks++;
+                continue;
+            }
+
+            const uint8_t *stored = packed.data();
+            size_t storedSize = Lz4Block::Compress(buffer.data(), task.length, packed.data(), task.length - 1);
+            chunk.encoding = SNAPSHOT_LZ4;
+            if (storedSize == 0)
+            {
+                stored = buffer.data();
+                storedSize = task.length;
+                chunk.encoding = SNAPSHOT_RAW;
+                rawChunks++;
+            }
+            chunk.storedSize = static_cast<uint32_t>(storedSize);
+
+            std::lock_guard<std::mutex> lock(fileMutex);
+            chunk.dataOffset = dataEnd;
+            file.write(reinterpret_cast<const char *>(stored), static_cast<std::streamsize>(storedSize));
+            dataEnd += storedSize;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<uint8_t> strings;
+    std::vector<SnapshotModule> fileModules;
+    for (const ModuleInfo &info : modules)
+    {
+        SnapshotModule module = {};
+        module.baseAddress = info.baseAddress;
+        module.size = info.size;
+        module.fingerprint = info.fingerprint;
+        module.nameRef = AppendString(strings, info.name);
+        fileModules.push_back(module);
+    }
+
+    memcpy(header.magic, PROCESS_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = PROCESS_SNAPSHOT_VERSION;
+    header.moduleCount = static_cast<uint32_t>(fileModules.size());
+    header.regionCount = static_cast<uint32_t>(fileRegions.size());
+    header.chunkSize = CHUNK_SIZE;
+    header.processId = ::GetProcessId(hProcess);
+    header.chunkCount = chunks.size();
+    header.timestamp = static_cast<uint64_t>(time(nullptr));
+    header.capturedBytes = capturedBytes;
+    header.storedBytes = dataEnd - sizeof(header);
+    header.moduleTableOffset = AlignUp(dataEnd, 8);
+    header.regionTableOffset = AlignUp(header.moduleTableOffset + fileModules.size() * sizeof(SnapshotModule), 8);
+    header.chunkIndexOffset = AlignUp(header.regionTableOffset + fileRegions.size() * sizeof(SnapshotRegion), 8);
+    header.stringTableOffset = AlignUp(header.chunkIndexOffset + chunks.size() * sizeof(SnapshotChunk), 8);
+    header.stringTableSize = strings.size();
+
+    // All table offsets are already aligned, only padding after the data/tables is needed
+    auto writePadded = [&file](const void *data, size_t bytes, uint64_t nextOffset, uint64_t currentOffset)
+    {
+        file.write(static_cast<const char *>(data), bytes);
+        static const char zeros[8] = {};
+        file.write(zeros, static_cast<std::streamsize>(nextOffset - (currentOffset + bytes)));
+    };
+
+    writePadded(nullptr, 0, header.moduleTableOffset, dataEnd);
+    writePadded(fileModules.data(), fileModules.size() * sizeof(SnapshotModule), header.regionTableOffset,
+                header.moduleTableOffset);
+    writePadded(fileRegions.data(), fileRegions.size() * sizeof(SnapshotRegion), header.chunkIndexOffset,
+                header.regionTableOffset);
+    writePadded(chunks.data(), chunks.size() * sizeof(SnapshotChunk), header.stringTableOffset,
+                header.chunkIndexOffset);
+    file.write(reinterpret_cast<const char *>(strings.data()), strings.size());
+
+    file.seekp(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    if (!file.good())
+    {
+        std::wcerr << L"[-] Failed to write process snapshot: " << filename << std::endl;
+        return false;
+    }
+
+    if (stats != nullptr)
+    {
+        stats->regionCount = fileRegions.size();
+        stats->chunkCount = chunks.size();
+        stats->capturedBytes = capturedBytes;
+        stats->storedBytes = header.storedBytes;
+        stats->zeroChunks = zeroChunks;
+        stats->rawChunks = rawChunks;
+        stats->unreadablePages = unreadablePages;
+        stats->captureMs = ElapsedMs(start);
+    }
+
+    DBG_OK(L"Wrote process snapshot: " + std::to_wstring(capturedBytes >> 20) + L" MB in " +
+           std::to_wstring(chunks.size()) + L" chunks, " + std::to_wstring(header.storedBytes >> 20) +
+           L" MB stored");
+    return true;
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// ReloadDiff: Incremental merge of a re-read config into live entries
+// Purpose: Hot reload keeps runtime state (resolved addresses, values) of
+// entries that did not change in the file
+// - unchanged: same definition key, the existing entry (with its state) is kept
+// - updated:   same identity (description) but new definition, state is reset
+// - added / removed: everything else
+// ============================================================================
+
+struct ReloadStats
+{
+    size_t added = 0;
+    size_t removed = 0;
+    size_t updated = 0;
+    size_t unchanged = 0;
+
+    bool HasChanges() const { return added != 0 || removed != 0 || updated != 0; }
+};
+
+// Replace current with incoming (file order), moving over unchanged entries
+// keyOf:      full definition key, equal keys mean the entry is unchanged
+// identityOf: stable name used to pair updated entries (empty = no pairing)
+template <typename Entry, typename KeyFn, typename IdentityFn>
+ReloadStats MergeReload(std::vector<Entry> &current, std::vector<Entry> &&incoming, KeyFn keyOf, IdentityFn identityOf)
+{
+    ReloadStats stats;
+
+    std::unordered_multimap<std::wstring, size_t> byKey;
+    byKey.reserve(current.size());
+    for (size_t i = 0; i < current.size(); ++i)
+    {
+        byKey.emplace(keyOf(current[i]), i);
+    }
+
+    std::vector<uint8_t> used(current.size(), 0);
+    std::vector<uint8_t> matched(incoming.size(), 0);
+
+    // Pass 1: identical definitions keep their live entry
+    for (size_t i = 0; i < incoming.size(); ++i)
+    {
+        auto range = byKey.equal_range(keyOf(incoming[i]));
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (used[it->second])
+                continue;
+
+            used[it->second] = 1;
+            matched[i] = 1;
+            incoming[i] = std::move(current[it->second]);
+            stats.unchanged++;
+            break;
+        }
+    }
+
+    // Pass 2: pair leftovers by identity to tell updates from add + remove
+    std::unordered_multimap<std::wstring, size_t> byIdentity;
+    for (size_t i = 0; i < current.size(); ++i)
+    {
+        if (!used[i] && !identityOf(current[i]).empty())
+            byIdentity.emplace(identityOf(current[i]), i);
+    }
+
+    for (size_t i = 0; i < incoming.size(); ++i)
+    {
+        if (matched[i])
+            continue;
+
+        bool paired = false;
+        auto range = byIdentity.equal_range(identityOf(incoming[i]));
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (used[it->second])
+                continue;
+
+            used[it->second] = 1;
+            paired = true;
+            break;
+        }
+
+        if (paired)
+            stats.updated++;
+        else
+            stats.added++;
+    }
+
+    for (uint8_t wasUsed : used)
+    {
+        if (!wasUsed)
+            stats.removed++;
+    }
+
+    current = std::move(incoming);
+    return stats;
+}
@@ -0,0 +1,511 @@
+#include "SignatureGenerator.h"
+#include "MemoryReader.h"
+#include "ModuleHeaders.h"
+#include "X86Decoder.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+
+uint32_t SignatureGenerator::Read32(const uint8_t *p)
+{
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+bool SignatureGenerator::IsSkippedGram(uint32_t gram)
+{
+    return gram == 0x00000000 || gram == 0xCCCCCCCC || gram == 0x90909090 || gram == 0xFFFFFFFF;
+}
+
+std::vector<GeneratedSignature> SignatureGenerator::Generate(HANDLE hProcess, const ModuleRegistry &registry,
+                                                             const std::vector<OffsetEntry> &entries)
+{
+    std::vector<GeneratedSignature> results(entries.size());
+
+    // Symbol-relative entries are converted to module offsets, signatures always yield those
+    MemoryReader reader(hProcess);
+    std::vector<OffsetEntry> moduleRelative(entries);
+
+    // Group by module, each image is read and indexed once
+    std::map<uintptr_t, std::pair<ModuleInfo, std::vector<size_t>>> groups;
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        ModuleInfo info;
+        if (!registry.FindModule(entries[i].moduleName, info))
+        {
+            results[i].error = L"module not loaded";
+            continue;
+        }
+
+        if (!entries[i].symbol.empty())
+        {
+            uintptr_t symbolRva;
+            if (!registry.FindSymbol(entries[i].moduleName, entries[i].symbol, reader, symbolRva))
+            {
+                results[i].error = L"symbol not exported";
+                continue;
+            }
+            moduleRelative[i].symbol.clear();
+            moduleRelative[i].offset += symbolRva;
+        }
+
+        auto &group = groups[info.baseAddress];
+        group.first = info;
+        group.second.push_back(i);
+    }
+
+    for (const auto &[base, group] : groups)
+    {
+        if (!LoadImage(hProcess, group.first))
+        {
+            for (size_t index : group.second)
+            {
+                results[index].error = L"module image could not be read";
+            }
+            continue;
+        }
+
+        std::vector<const OffsetEntry *> moduleEntries;
+        for (size_t index : group.second)
+        {
+            moduleEntries.push_back(&moduleRelative[index]);
+        }
+
+        std::vector<GeneratedSignature> moduleResults = GenerateForImage(moduleEntries);
+        for (size_t i = 0; i < group.second.size(); ++i)
+        {
+            results[group.second[i]] = std::move(moduleResults[i]);
+        }
+    }
+
+    return results;
+}
+
+bool SignatureGenerator::LoadImage(HANDLE hProcess, const ModuleInfo &module)
+{
+    // Position lists are 32-bit
+    if (module.size == 0 || module.size > 0xFFFFFFFFu)
+        return false;
+
+    m_moduleName = module.name;
+    m_imageBase = module.baseAddress;
+    m_image.resize(static_cast<size_t>(module.size));
+    size_t unreadablePages = MemoryReader::ReadRangePadded(hProcess, module.baseAddress, m_image.data(), m_image.size());
+    if (unreadablePages * 0x1000 >= m_image.size())
+        return false;
+
+    FindCodeRanges();
+    FindInstructionStarts();
+    BuildIndex();
+    return true;
+}
+
+void SignatureGenerator::LoadImage(const std::wstring &moduleName, const uint8_t *data, size_t size)
+{
+    m_moduleName = moduleName;
+    m_imageBase = 0;
+    m_image.assign(data, data + size);
+    FindCodeRanges();
+    FindInstructionStarts();
+    BuildIndex();
+}
+
+void SignatureGenerator::FindCodeRanges()
+{
+    m_codeRanges.clear();
+    ModuleHeaders headers;
+    if (!headers.ParsePe(m_image.data(), m_image.size()))
+    {
+        m_codeRanges.emplace_back(0, m_image.size());
+        return;
+    }
+
+    // An image copied in memory is taken to sit at its link-time base
+    if (m_imageBase == 0)
+        m_imageBase = static_cast<uintptr_t>(headers.GetPreferredBase());
+
+    for (const ImageSection &section : headers.GetSections())
+    {
+        if (!section.executable || section.rva >= m_image.size())
+            continue;
+        size_t end = section.rva + (std::min)(static_cast<size_t>(section.size), m_image.size() - section.rva);
+        m_codeRanges.emplace_back(section.rva, end);
+    }
+    DBG_INFO(m_moduleName + L": " + std::to_wstring(m_codeRanges.size()) + L" executable sections searched for references");
+}
+
+void SignatureGenerator::FindInstructionStarts()
+{
+    // Linear sweep, an undecodable byte is skipped like XrefIndex does
+    m_instructionStarts.assign(m_image.size(), false);
+    const uint8_t *image = m_image.data();
+    for (const auto &range : m_codeRanges)
+    {
+        size_t position = range.first;
+        while (position < range.second)
+        {
+            X86Instruction instruction;
+            if (!X86Decoder::Decode(image + position, range.second - position, instruction))
+            {
+                position++;
+                continue;
+            }
+            m_instructionStarts[position] = true;
+            position += instruction.length;
+        }
+    }
+}
+
+void SignatureGenerator::BuildIndex()
+{
+    const size_t bucketCount = size_t(1) << BUCKET_BITS;
+    const size_t partitionCount = size_t(1) << PARTITION_BITS;
+    const unsigned localBits = BUCKET_BITS - PARTITION_BITS;
+    const uint32_t localMask = (1u << localBits) - 1;
+
+    m_bucketStart.assign(bucketCount + 1, 0);
+    m_positions.clear();
+    if (m_image.size() < 4)
+        return;
+
+    const uint8_t *image = m_image.data();
+    const size_t last = m_image.size() - 4;
+
+    // Pass 1: scatter positions by the top bucket bits (few write streams, cache friendly)
+    std::vector<uint32_t> partitionStart(partitionCount + 1, 0);
+    for (size_t q = 0; q <= last; ++q)
+    {
+        uint32_t gram = Read32(image + q);
+        if (!IsSkippedGram(gram))
+            partitionStart[(BucketOf(gram) >> localBits) + 1]++;
+    }
+    for (size_t p = 0; p < partitionCount; ++p)
+    {
+        partitionStart[p + 1] += partitionStart[p];
+    }
+
+    // The remaining bucket bits travel with each position, pass 2 never touches the image
+    m_positions.resize(partitionStart[partitionCount]);
+    std::vector<uint16_t> localKeys(m_positions.size());
+    std::vector<uint32_t> cursor(partitionStart.begin(), partitionStart.end() - 1);
+    for (size_t q = 0; q <= last; ++q)
+    {
+        uint32_t gram = Read32(image + q);
+        if (IsSkippedGram(gram))
+            continue;
+
+        uint32_t bucket = BucketOf(gram);
+        uint32_t slot = cursor[bucket >> localBits]++;
+        m_positions[slot] = static_cast<uint32_t>(q);
+        localKeys[slot] = static_cast<uint16_t>(bucket & localMask);
+    }
+
+    // Pass 2: counting sort of each partition by the remaining bits, positions stay in image order
+    std::vector<uint32_t> scratch;
+    for (size_t p = 0; p < partitionCount; ++p)
+    {
+        uint32_t begin = partitionStart[p];
+        uint32_t end = partitionStart[p + 1];
+        uint32_t *local = &m_bucketStart[p << localBits];
+
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            local[localKeys[i] + 1]++;
+        }
+
+        // local[localMask + 1] is the next partition's first slot, overwritten by its begin
+        local[0] = begin;
+        for (size_t b = 0; b < localMask; ++b)
+        {
+            local[b + 1] += local[b];
+        }
+
+        scratch.assign(m_positions.begin() + begin, m_positions.begin() + end);
+        std::vector<uint32_t> localCursor(local, local + localMask + 1);
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            m_positions[localCursor[localKeys[i]]++] = scratch[i - begin];
+        }
+    }
+    m_bucketStart[bucketCount] = partitionStart[partitionCount];
+
+    DBG_OK(m_moduleName + L": 4-gram index of " + std::to_wstring(m_image.size()) + L" bytes, " +
+           std::to_wstring(m_positions.size()) + L" positions");
+}
+
+size_t SignatureGenerator::CountMatches(const uint8_t *bytes, const uint8_t *mask, size_t length, size_t limit) const
+{
+    // Anchor on the fixed 4-gram with the shortest bucket
+    size_t anchor = SIZE_MAX;
+    uint32_t anchorGram = 0;
+    size_t anchorCount = SIZE_MAX;
+    for (size_t j = 0; j + 4 <= length; ++j)
+    {
+        if (Read32(mask + j) != 0xFFFFFFFFu)
+            continue;
+
+        uint32_t gram = Read32(bytes + j);
+        if (IsSkippedGram(gram))
+            continue;
+
+        uint32_t bucket = BucketOf(gram);
+        size_t count = m_bucketStart[bucket + 1] - m_bucketStart[bucket];
+        if (count < anchorCount)
+        {
+            anchor = j;
+            anchorGram = gram;
+            anchorCount = count;
+        }
+    }
+
+    // Without a fixed 4-byte run the pattern is too weak to be trusted as unique
+    if (anchor == SIZE_MAX)
+        return limit;
+
+    const uint8_t *image = m_image.data();
+    const uint32_t bucket = BucketOf(anchorGram);
+    size_t matches = 0;
+    for (uint32_t i = m_bucketStart[bucket]; i < m_bucketStart[bucket + 1]; ++i)
+    {
+        size_t position = m_positions[i];
+        if (position < anchor || Read32(image + position) != anchorGram)
+            continue;
+
+        size_t start = position - anchor;
+        if (start + length > m_image.size())
+            continue;
+
+        size_t k = 0;
+        while (k < length && ((image[start + k] ^ bytes[k]) & mask[k]) == 0)
+            ++k;
+        if (k == length && ++matches >= limit)
+            return matches;
+    }
+    return matches;
+}
+
+void SignatureGenerator::FindReferences(const std::vector<uintptr_t> &targets,
+                                        std::vector<std::vector<Reference>> &outReferences) const
+{
+    outReferences.assign(targets.size(), {});
+    const size_t size = m_image.size();
+    if (size < 5)
+        return;
+
+    // Bitmap rejects almost every candidate before the map lookup
+    std::vector<uint8_t> isTarget(size, 0);
+    std::unordered_map<uintptr_t, std::vector<size_t>> slots;
+    for (size_t i = 0; i < targets.size(); ++i)
+    {
+        if (targets[i] < size)
+        {
+            isTarget[targets[i]] = 1;
+            slots[targets[i]].push_back(i);
+        }
+    }
+
+    // Instructions found by the sweep in FindInstructionStarts
+    const uint8_t *image = m_image.data();
+    for (const auto &range : m_codeRanges)
+    {
+        for (size_t position = range.first; position < range.second; ++position)
+        {
+            X86Instruction instruction;
+            if (!m_instructionStarts[position] ||
+                !X86Decoder::Decode(image + position, range.second - position, instruction))
+                continue;
+
+            uint64_t target;
+            if ((instruction.ripRelative || instruction.relSize == 4) &&
+                X86Decoder::GetTarget(image + position, instruction, position, target) && target < size &&
+                isTarget[static_cast<size_t>(target)])
+            {
+                size_t displacement = position + (instruction.ripRelative ? instruction.dispOffset : instruction.relOffset);
+                for (size_t slot : slots[static_cast<uintptr_t>(target)])
+                {
+                    outReferences[slot].push_back({position, displacement, position + instruction.length});
+                }
+            }
+        }
+    }
+}
+
+bool SignatureGenerator::IsImageAddress(const uint8_t *value, size_t size) const
+{
+    if (size != 4 && size != 8)
+        return false;
+    uint64_t address = 0;
+    memcpy(&address, value, size);
+    return m_imageBase != 0 && address >= m_imageBase && address - m_imageBase < m_image.size();
+}
+
+void SignatureGenerator::MaskVolatileOperands(size_t begin, size_t end, uint8_t *mask) const
+{
+    // An instruction starting up to MAX_LENGTH - 1 bytes before the window can reach into it
+    const uint8_t *image = m_image.data();
+    size_t first = begin;
+    while (first > 0 && begin - first < X86Decoder::MAX_LENGTH - 1 && !m_instructionStarts[first])
+        first--;
+
+    auto wildcard = [&](size_t fieldBegin, size_t fieldSize)
+    {
+        for (size_t k = (std::max)(fieldBegin, begin); k < fieldBegin + fieldSize && k < end; ++k)
+        {
+            mask[k - begin] = 0x00;
+        }
+    };
+
+    for (size_t position = first; position < end; ++position)
+    {
+        X86Instruction instruction;
+        if (!m_instructionStarts[position] ||
+            !X86Decoder::Decode(image + position, m_image.size() - position, instruction))
+            continue;
+
+        // rel32 and RIP disp32 change whenever code or data moves, absolute addresses with the base
+        if (instruction.relSize == 4)
+            wildcard(position + instruction.relOffset, 4);
+        if (instruction.ripRelative || instruction.absoluteDisp)
+            wildcard(position + instruction.dispOffset, 4);
+        if (instruction.immAddress || IsImageAddress(image + position + instruction.immOffset, instruction.immSize))
+            wildcard(position + instruction.immOffset, instruction.immSize);
+    }
+}
+
+bool SignatureGenerator::BuildAround(const Reference &reference, Signature &outSignature) const
+{
+    const size_t size = m_image.size();
+    const size_t coreBegin = reference.instructionStart;
+    const size_t coreLength = reference.instructionEnd - coreBegin;
+    if (reference.instructionEnd > size)
+        return false;
+
+    std::vector<uint8_t> mask(MAX_SIGNATURE_LENGTH);
+    for (size_t length = coreLength; length <= MAX_SIGNATURE_LENGTH; ++length)
+    {
+        // Every window of this length that still covers the instruction, most suffix first
+        size_t lowest = reference.instructionEnd >= length ? reference.instructionEnd - length : 0;
+        for (size_t start = coreBegin + 1; start-- > lowest;)
+        {
+            if (start + length > size)
+                continue;
+
+            std::fill(mask.begin(), mask.begin() + length, 0xFF);
+            MaskVolatileOperands(start, start + length, mask.data());
+            for (size_t k = reference.displacement; k < reference.displacement + 4; ++k)
+            {
+                mask[k - start] = 0x00;
+            }
+
+            if (CountMatches(m_image.data() + start, mask.data(), length, 2) != 1)
+                continue;
+
+            outSignature.bytes.assign(m_image.begin() + start, m_image.begin() + start + length);
+            outSignature.mask.assign(mask.begin(), mask.begin() + length);
+            for (size_t k = 0; k < length; ++k)
+            {
+                outSignature.bytes[k] &= outSignature.mask[k];
+            }
+            outSignature.extract = SignatureExtract::RipRelative;
+            outSignature.extractOffset = reference.displacement - start;
+            outSignature.instructionLength = reference.instructionEnd - start;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<GeneratedSignature> SignatureGenerator::GenerateForImage(const std::vector<const OffsetEntry *> &entries) const
+{
+    std::vector<GeneratedSignature> results(entries.size());
+
+    std::vector<uintptr_t> targets;
+    for (const OffsetEntry *entry : entries)
+    {
+        targets.push_back(entry->offset);
+    }
+
+    std::vector<std::vector<Reference>> references;
+    FindReferences(targets, references);
+
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        GeneratedSignature &result = results[i];
+        result.referenceCount = references[i].size();
+        if (targets[i] >= m_image.size())
+        {
+            result.error = L"offset outside the module image";
+            continue;
+        }
+        if (references[i].empty())
+        {
+            result.error = L"no code reference found";
+            continue;
+        }
+
+        // Shortest signature over the first few references
+        size_t tried = (std::min)(references[i].size(), MAX_REFERENCES_TRIED);
+        for (size_t r = 0; r < tried; ++r)
+        {
+            Signature candidate;
+            if (!BuildAround(references[i][r], candidate))
+                continue;
+
+            if (!result.found || candidate.bytes.size() < result.signature.bytes.size())
+            {
+                result.found = true;
+                result.signature = std::move(candidate);
+                result.referenceOffset = references[i][r].displacement;
+            }
+        }
+
+        if (result.found)
+        {
+            result.signature.moduleName = entries[i]->moduleName;
+            result.signature.description = entries[i]->description;
+        }
+        else
+        {
+            result.error = L"no unique pattern within " + std::to_wstring(MAX_SIGNATURE_LENGTH) + L" bytes";
+        }
+    }
+
+    return results;
+}
+
+void SignatureGenerator::PrintResults(const std::vector<OffsetEntry> &entries,
+                                      const std::vector<GeneratedSignature> &results)
+{
+    std::wcout << L"\n=== Generated Signatures ===\n";
+    std::wcout << std::left << std::setw(25) << L"Description"
+               << L" | " << std::setw(6) << L"Bytes"
+               << L" | " << std::setw(5) << L"Refs"
+               << L" | " << L"Pattern / Notes" << std::endl;
+    std::wcout << std::wstring(75, L'-') << std::endl;
+
+    for (size_t i = 0; i < entries.size() && i < results.size(); ++i)
+    {
+        const GeneratedSignature &result = results[i];
+        std::wcout << std::left << std::setw(25) << entries[i].description << L" | " << std::setw(6)
+                   << (result.found ? std::to_wstring(result.signature.bytes.size()) : L"-") << L" | "
+                   << std::setw(5) << result.referenceCount << L" | ";
+
+        if (result.found)
+        {
+            std::string pattern;
+            SignatureScanner::FormatPattern(result.signature, pattern);
+            std::wcout << std::wstring(pattern.begin(), pattern.end());
+        }
+        else
+        {
+            std::wcout << result.error;
+        }
+        std::wcout << std::endl;
+    }
+    std::wcout << std::endl;
+}
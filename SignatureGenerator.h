@@ -0,0 +1,113 @@
+#pragma once
+#include <windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ModuleRegistry.h"
+#include "OffsetStorage.h"
+#include "SignatureScanner.h"
+
+// ============================================================================
+// SignatureGenerator: Shortest unique signatures for stored offsets
+// Purpose: Re-find offsets after a target update without manual pattern work
+// - code references to an offset are RIP-relative operands (ModRM mod=00 rm=101)
+//   and call/jmp rel32 whose target is module base + offset, found by decoding
+//   the executable sections (X86Decoder linear sweep; an image without PE
+//   headers is decoded whole), so every reference is a real instruction
+// - around each reference the window grows until the pattern is unique in the
+//   image; the window is decoded from instruction starts (the same sweep) and
+//   the reference's own disp32, other rel32/RIP/absolute displacements and
+//   immediates holding an address inside the image are wildcarded (they
+//   change with every build or load address)
+// - uniqueness is checked against a 4-gram index of the image (positions
+//   bucketed by gram), only occurrences of the pattern's rarest fixed 4-gram
+//   are compared, the image is never rescanned per candidate
+// - the index is built by a two-pass radix partition (cache-sized passes),
+//   memory: 4 bytes per image byte + 16 MB of buckets (6 while building),
+//   1 bit per image byte for instruction starts
+// ============================================================================
+
+struct GeneratedSignature
+{
+    bool found = false;
+    Signature signature;        // rip:D:L extraction, ready for SignatureScanner
+    size_t referenceCount = 0;  // Code references to the offset in the image
+    uintptr_t referenceOffset = 0; // Reference the signature was built around
+    std::wstring error;         // Reason if not found
+};
+
+class SignatureGenerator
+{
+public:
+    static constexpr size_t MAX_SIGNATURE_LENGTH = 64;
+    static constexpr size_t MAX_REFERENCES_TRIED = 16;
+
+    // Generate for every entry, modules are read and indexed once each
+    // Results are indexed like entries
+    std::vector<GeneratedSignature> Generate(HANDLE hProcess, const ModuleRegistry &registry,
+                                             const std::vector<OffsetEntry> &entries);
+
+    // Read a module image and build its 4-gram index
+    bool LoadImage(HANDLE hProcess, const ModuleInfo &module);
+
+    // Use an image already in memory (copied) and build its 4-gram index
+    void LoadImage(const std::wstring &moduleName, const uint8_t *data, size_t size);
+
+    // Generate for entries of the loaded module (entry module names are not checked)
+    std::vector<GeneratedSignature> GenerateForImage(const std::vector<const OffsetEntry *> &entries) const;
+
+    // Occurrences of a masked pattern in the loaded image, counting stops at limit
+    size_t CountMatches(const uint8_t *bytes, const uint8_t *mask, size_t length, size_t limit) const;
+
+    size_t GetImageSize() const { return m_image.size(); }
+
+    // Print a generation summary to console
+    static void PrintResults(const std::vector<OffsetEntry> &entries, const std::vector<GeneratedSignature> &results);
+
+private:
+    static constexpr unsigned BUCKET_BITS = 22;
+    static constexpr unsigned PARTITION_BITS = 8; // Top bucket bits, first radix pass (rest fits uint16_t)
+
+    // Operand that encodes a target relative to the end of its instruction
+    struct Reference
+    {
+        size_t instructionStart;  // Offset of the referencing instruction
+        size_t displacement;      // Offset of the rel32/disp32 field
+        size_t instructionEnd;    // Offset of the next instruction
+    };
+
+    std::wstring m_moduleName;
+    uintptr_t m_imageBase = 0; // Address the image is loaded at (PE ImageBase for a copied image)
+    std::vector<uint8_t> m_image;
+    std::vector<std::pair<size_t, size_t>> m_codeRanges; // [begin, end) of executable sections
+    std::vector<bool> m_instructionStarts;               // Linear sweep of the code ranges
+    std::vector<uint32_t> m_bucketStart; // 2^BUCKET_BITS + 1 prefix sums into m_positions
+    std::vector<uint32_t> m_positions;   // Gram start positions, grouped by bucket
+
+    void BuildIndex();
+
+    // Executable sections of the PE image in m_image, the whole image without headers
+    void FindCodeRanges();
+
+    // Mark every instruction start of a linear sweep over the code ranges
+    void FindInstructionStarts();
+
+    static uint32_t Read32(const uint8_t *p);
+    static uint32_t BucketOf(uint32_t gram) { return (gram * 0x9E3779B1u) >> (32 - BUCKET_BITS); }
+
+    // Padding and zero runs are not indexed (never useful as anchors)
+    static bool IsSkippedGram(uint32_t gram);
+
+    // Collect code references to every target in one decoding pass over the code ranges
+    void FindReferences(const std::vector<uintptr_t> &targets, std::vector<std::vector<Reference>> &outReferences) const;
+
+    // Shortest unique pattern around one reference (false if none up to MAX_SIGNATURE_LENGTH)
+    bool BuildAround(const Reference &reference, Signature &outSignature) const;
+
+    // 4 or 8 byte value inside [m_imageBase, m_imageBase + image size)
+    bool IsImageAddress(const uint8_t *value, size_t size) const;
+
+    // Wildcard rel32, RIP and absolute disp32 and address immediates of the instructions in [begin, end)
+    void MaskVolatileOperands(size_t begin, size_t end, uint8_t *mask) const;
+};
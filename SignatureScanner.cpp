@@ -0,0 +1,650 @@
+#include "SignatureScanner.h"
+#include "MappedFile.h"
+#include "MemoryReader.h"
+#include "StringUtils.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <fstream>
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static inline bool IsTrimChar(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static inline void TrimRange(const char *&begin, const char *&end)
+{
+    while (begin < end && IsTrimChar(*begin))
+        ++begin;
+    while (end > begin && IsTrimChar(end[-1]))
+        --end;
+}
+
+// Index of the lowest set bit (value != 0)
+static inline unsigned LowestBit(unsigned value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(value));
+#endif
+}
+
+static inline bool MatchesAt(const uint8_t *data, const Signature &signature)
+{
+    const size_t length = signature.bytes.size();
+    for (size_t k = 0; k < length; ++k)
+    {
+        if ((data[k] ^ signature.bytes[k]) & signature.mask[k])
+            return false;
+    }
+    return true;
+}
+
+bool SignatureScanner::ParsePattern(const char *begin, const char *end, std::vector<uint8_t> &outBytes,
+                                    std::vector<uint8_t> &outMask)
+{
+    outBytes.clear();
+    outMask.clear();
+    bool hasFixed = false;
+
+    const char *cursor = begin;
+    while (cursor < end)
+    {
+        while (cursor < end && IsTrimChar(*cursor))
+            ++cursor;
+        if (cursor == end)
+            break;
+
+        const char *tokenEnd = cursor;
+        while (tokenEnd < end && !IsTrimChar(*tokenEnd))
+            ++tokenEnd;
+
+        size_t length = tokenEnd - cursor;
+        if ((length == 1 && cursor[0] == '?') || (length == 2 && cursor[0] == '?' && cursor[1] == '?'))
+        {
+            outBytes.push_back(0);
+            outMask.push_back(0x00);
+        }
+        else
+        {
+            uintptr_t value;
+            if (length != 2 || !StringUtils::ParseHex(cursor, tokenEnd, value))
+                return false;
+            outBytes.push_back(static_cast<uint8_t>(value));
+            outMask.push_back(0xFF);
+            hasFixed = true;
+        }
+        cursor = tokenEnd;
+    }
+
+    return hasFixed;
+}
+
+bool SignatureScanner::ParseLine(const char *begin, const char *end, Signature &signature, std::wstring &error)
+{
+    // module|pattern|extract|description, the description may contain '|'
+    const char *fields[3][2];
+    const char *cursor = begin;
+    for (int i = 0; i < 3; ++i)
+    {
+        const char *separator = static_cast<const char *>(memchr(cursor, '|', end - cursor));
+        if (separator == nullptr)
+        {
+            error = L"Expected module|pattern|extract|description";
+            return false;
+        }
+        fields[i][0] = cursor;
+        fields[i][1] = separator;
+        TrimRange(fields[i][0], fields[i][1]);
+        cursor = separator + 1;
+    }
+    const char *descBegin = cursor;
+    const char *descEnd = end;
+    TrimRange(descBegin, descEnd);
+
+    if (fields[0][0] == fields[0][1])
+    {
+        error = L"Missing module name";
+        return false;
+    }
+    signature.moduleName = StringUtils::Utf8ToWide(fields[0][0], fields[0][1] - fields[0][0]);
+    signature.description = StringUtils::Utf8ToWide(descBegin, descEnd - descBegin);
+
+    if (!ParsePattern(fields[1][0], fields[1][1], signature.bytes, signature.mask))
+    {
+        error = L"Invalid pattern (hex bytes and ?? wildcards, at least one fixed byte)";
+        return false;
+    }
+
+    const char *extract = fields[2][0];
+    const char *extractEnd = fields[2][1];
+    signature.extract = SignatureExtract::Match;
+    signature.extractOffset = 0;
+    signature.instructionLength = 0;
+
+    if (extract == extractEnd)
+        return true;
+
+    if (*extract == '+')
+    {
+        if (!StringUtils::ParseHex(extract + 1, extractEnd, signature.extractOffset))
+        {
+            error = L"Invalid extract offset (expected +N in hex)";
+            return false;
+        }
+        return true;
+    }
+
+    if (extractEnd - extract > 4 && memcmp(extract, "rip:", 4) == 0)
+    {
+        const char *displacement = extract + 4;
+        const char *colon = static_cast<const char *>(memchr(displacement, ':', extractEnd - displacement));
+        const char *displacementEnd = colon != nullptr ? colon : extractEnd;
+
+        signature.extract = SignatureExtract::RipRelative;
+        if (!StringUtils::ParseHex(displacement, displacementEnd, signature.extractOffset) ||
+            (colon != nullptr && !StringUtils::ParseHex(colon + 1, extractEnd, signature.instructionLength)))
+        {
+            error = L"Invalid RIP extract (expected rip:D or rip:D:L in hex)";
+            return false;
+        }
+        if (colon == nullptr)
+            signature.instructionLength = signature.extractOffset + 4;
+
+        // The displacement is read from the verified match, it must lie inside the pattern
+        if (signature.extractOffset + 4 > signature.bytes.size())
+        {
+            error = L"RIP displacement lies outside the pattern";
+            return false;
+        }
+        return true;
+    }
+
+    error = L"Unknown extract '" + StringUtils::Utf8ToWide(extract, extractEnd - extract) + L"'";
+    return false;
+}
+
+bool SignatureScanner::LoadFromFile(const std::wstring &filename, std::vector<Signature> &outSignatures)
+{
+    MappedFile file;
+    if (!file.Open(filename))
+    {
+        std::wcerr << L"[-] Failed to open file: " << filename << std::endl;
+        return false;
+    }
+
+    const char *cursor = reinterpret_cast<const char *>(file.Data());
+    const char *bufferEnd = cursor + file.Size();
+
+    // Skip UTF-8 BOM
+    if (file.Size() >= 3 && memcmp(cursor, "\xEF\xBB\xBF", 3) == 0)
+        cursor += 3;
+
+    int lineNumber = 0;
+    while (cursor < bufferEnd)
+    {
+        const char *lineEnd = static_cast<const char *>(memchr(cursor, '\n', bufferEnd - cursor));
+        if (lineEnd == nullptr)
+            lineEnd = bufferEnd;
+
+        const char *lineBegin = cursor;
+        cursor = lineEnd < bufferEnd ? lineEnd + 1 : bufferEnd;
+        lineNumber++;
+
+        TrimRange(lineBegin, lineEnd);
+        if (lineBegin == lineEnd || *lineBegin == '#' || *lineBegin == ';')
+            continue;
+
+        Signature &signature = outSignatures.emplace_back();
+        std::wstring error;
+        if (!ParseLine(lineBegin, lineEnd, signature, error))
+        {
+            std::wcerr << L"[!] " << error << L" at line " << lineNumber << std::endl;
+            outSignatures.pop_back();
+        }
+    }
+
+    DBG_OK(L"Loaded " + std::to_wstring(outSignatures.size()) + L" signatures from " + filename);
+    return true;
+}
+
+bool SignatureScanner::SaveToFile(const std::wstring &filename, const std::vector<Signature> &signatures)
+{
+    std::string text = "# Signature file: module|pattern|extract|description\n";
+    for (const Signature &signature : signatures)
+    {
+        FormatLine(signature, text);
+        text += '\n';
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open() || !file.write(text.data(), static_cast<std::streamsize>(text.size())))
+    {
+        std::wcerr << L"[-] Failed to write file: " << filename << std::endl;
+        return false;
+    }
+
+    std::wcout << L"[+] Saved " << signatures.size() << L" signatures to " << filename << std::endl;
+    return true;
+}
+
+void SignatureScanner::FormatPattern(const Signature &signature, std::string &out)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    for (size_t k = 0; k < signature.bytes.size(); ++k)
+    {
+        if (k != 0)
+            out += ' ';
+        if (signature.mask[k] == 0)
+        {
+            out += "??";
+            continue;
+        }
+        out += digits[signature.bytes[k] >> 4];
+        out += digits[signature.bytes[k] & 0x0F];
+    }
+}
+
+void SignatureScanner::FormatLine(const Signature &signature, std::string &out)
+{
+    StringUtils::AppendUtf8(signature.moduleName, out);
+    out += '|';
+    FormatPattern(signature, out);
+    out += '|';
+
+    // ParseHex accepts the 0x prefix AppendHex writes
+    if (signature.extract == SignatureExtract::RipRelative)
+    {
+        out += "rip:";
+        StringUtils::AppendHex(signature.extractOffset, out);
+        out += ':';
+        StringUtils::AppendHex(signature.instructionLength, out);
+    }
+    else if (signature.extractOffset != 0)
+    {
+        out += '+';
+        StringUtils::AppendHex(signature.extractOffset, out);
+    }
+    out += '|';
+    StringUtils::AppendUtf8(signature.description, out);
+}
+
+std::vector<SignatureResult> SignatureScanner::Scan(HANDLE hProcess, const ModuleRegistry &registry,
+                                                    const std::vector<Signature> &signatures, const std::wstring &section)
+{
+    std::vector<SignatureResult> results(signatures.size());
+
+    // Group by module so every image is read once for all of its signatures
+    std::map<uintptr_t, std::pair<ModuleInfo, std::vector<size_t>>> groups;
+    for (size_t i = 0; i < signatures.size(); ++i)
+    {
+        ModuleInfo info;
+        if (!registry.FindModule(signatures[i].moduleName, info))
+            continue;
+
+        auto &group = groups[info.baseAddress];
+        group.first = info;
+        group.second.push_back(i);
+    }
+
+    uint64_t bytesScanned = 0;
+    for (const auto &[base, group] : groups)
+    {
+        std::vector<const Signature *> moduleSignatures;
+        for (size_t index : group.second)
+        {
+            moduleSignatures.push_back(&signatures[index]);
+        }
+
+        const ImageSection *range = nullptr;
+        if (!section.empty())
+        {
+            MemoryReader reader(hProcess);
+            const ModuleHeaders *headers = registry.GetHeaders(group.first.name, reader);
+            range = headers ? headers->FindSection(section) : nullptr;
+            if (range == nullptr)
+            {
+                std::wcerr << L"[!] No " << section << L" section in " << group.first.name
+                           << L", scanning the whole image" << std::endl;
+            }
+        }
+
+        std::vector<SignatureResult> moduleResults = ScanModule(hProcess, group.first, moduleSignatures, range);
+        bytesScanned += m_lastBytesScanned;
+        for (size_t i = 0; i < group.second.size(); ++i)
+        {
+            results[group.second[i]] = moduleResults[i];
+        }
+    }
+
+    m_lastBytesScanned = bytesScanned;
+    return results;
+}
+
+std::vector<SignatureResult> SignatureScanner::ScanModule(HANDLE hProcess, const ModuleInfo &module,
+                                                          const std::vector<const Signature *> &signatures,
+                                                          const ImageSection *section)
+{
+    std::vector<SignatureResult> results(signatures.size());
+    m_lastBytesScanned = 0;
+
+    size_t longest = 0;
+    for (size_t i = 0; i < signatures.size(); ++i)
+    {
+        results[i].moduleFound = true;
+        longest = (std::max)(longest, signatures[i]->bytes.size());
+    }
+
+    size_t rangeBegin = 0;
+    size_t rangeEnd = static_cast<size_t>(module.size);
+    if (section != nullptr)
+    {
+        rangeBegin = (std::min)(static_cast<size_t>(section->rva), rangeEnd);
+        rangeEnd = rangeBegin + (std::min)(static_cast<size_t>(section->size), rangeEnd - rangeBegin);
+    }
+    if (signatures.empty() || rangeBegin == rangeEnd)
+        return results;
+
+    // Byte frequencies sampled across the whole range pick the anchors
+    size_t histogram[256] = {};
+    SampleHistogram(hProcess, module.baseAddress + rangeBegin, rangeEnd - rangeBegin, histogram);
+
+    std::vector<Compiled> compiled;
+    DispatchTable dispatch;
+    std::vector<size_t> solo;
+    for (const Signature *signature : signatures)
+    {
+        compiled.push_back(Compile(*signature, histogram));
+    }
+    if (compiled.size() > DISPATCH_THRESHOLD)
+    {
+        BuildDispatch(compiled, histogram, dispatch, solo);
+    }
+    else
+    {
+        for (size_t i = 0; i < compiled.size(); ++i)
+        {
+            solo.push_back(i);
+        }
+    }
+
+    // Chunks overlap by (longest pattern - 1) so matches across a boundary are not lost
+    std::vector<uint8_t> buffer(CHUNK_SIZE + longest - 1);
+    size_t unreadablePages = 0;
+
+    for (size_t offset = rangeBegin; offset < rangeEnd; offset += CHUNK_SIZE)
+    {
+        size_t length = (std::min)(buffer.size(), rangeEnd - offset);
+        unreadablePages += MemoryReader::ReadRangePadded(hProcess, module.baseAddress + offset, buffer.data(), length);
+
+        if (!dispatch.entries.empty())
+            ScanBufferDispatch(buffer.data(), length, CHUNK_SIZE, offset, compiled, dispatch, results);
+        for (size_t i : solo)
+        {
+            ScanBuffer(buffer.data(), length, CHUNK_SIZE, offset, compiled[i], results[i]);
+        }
+    }
+
+    m_lastBytesScanned = rangeEnd - rangeBegin;
+    if (unreadablePages != 0)
+    {
+        DBG_WARN(module.name + L": " + std::to_wstring(unreadablePages) + L" unreadable pages scanned as zeros");
+    }
+    return results;
+}
+
+void SignatureScanner::SampleHistogram(HANDLE hProcess, uintptr_t address, size_t size, size_t (&histogram)[256])
+{
+    const size_t pageSize = 0x1000;
+    const size_t pageCount = (size + pageSize - 1) / pageSize;
+    const size_t samples = (std::min)(HISTOGRAM_SAMPLES, pageCount);
+    uint8_t page[pageSize];
+
+    for (size_t s = 0; s < samples; ++s)
+    {
+        size_t offset = pageCount * s / samples * pageSize;
+        size_t length = (std::min)(pageSize, size - offset);
+        MemoryReader::ReadRangePadded(hProcess, address + offset, page, length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            histogram[page[i]]++;
+        }
+    }
+}
+
+SignatureScanner::Compiled SignatureScanner::Compile(const Signature &signature, const size_t (&histogram)[256])
+{
+    Compiled compiled = {&signature, 0, 0};
+
+    size_t best = SIZE_MAX;
+    size_t second = SIZE_MAX;
+    bool hasFirst = false;
+    bool hasSecond = false;
+    for (size_t k = 0; k < signature.bytes.size(); ++k)
+    {
+        if (signature.mask[k] == 0)
+            continue;
+
+        size_t count = histogram[signature.bytes[k]];
+        if (!hasFirst || count < best)
+        {
+            if (hasFirst)
+            {
+                second = best;
+                compiled.anchor2 = compiled.anchor1;
+                hasSecond = true;
+            }
+            best = count;
+            compiled.anchor1 = k;
+            hasFirst = true;
+        }
+        else if (!hasSecond || count < second)
+        {
+            second = count;
+            compiled.anchor2 = k;
+            hasSecond = true;
+        }
+    }
+
+    if (!hasSecond)
+        compiled.anchor2 = compiled.anchor1;
+    return compiled;
+}
+
+void SignatureScanner::ScanBuffer(const uint8_t *data, size_t size, size_t limit, uintptr_t baseOffset,
+                                  const Compiled &compiled, SignatureResult &result)
+{
+    const Signature &signature = *compiled.signature;
+    const size_t length = signature.bytes.size();
+    if (size < length)
+        return;
+
+    // Candidate starts are [0, end), every start reads length bytes
+    const size_t end = (std::min)(size - length + 1, limit);
+    const uint8_t *first = data + compiled.anchor1;
+    const uint8_t *second = data + compiled.anchor2;
+    const uint8_t firstByte = signature.bytes[compiled.anchor1];
+    const uint8_t secondByte = signature.bytes[compiled.anchor2];
+
+    // 16 starts per step: both anchor bytes must match before the full compare
+    const __m128i firstVector = _mm_set1_epi8(static_cast<char>(firstByte));
+    const __m128i secondVector = _mm_set1_epi8(static_cast<char>(secondByte));
+    size_t position = 0;
+    for (; position + 16 <= end; position += 16)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first + position));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(second + position));
+        unsigned bits = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, firstVector), _mm_cmpeq_epi8(b, secondVector))));
+
+        while (bits != 0)
+        {
+            size_t candidate = position + LowestBit(bits);
+            bits &= bits - 1;
+            if (MatchesAt(data + candidate, signature))
+                RecordMatch(data, candidate, baseOffset, signature, result);
+        }
+    }
+
+    for (; position < end; ++position)
+    {
+        if (first[position] == firstByte && second[position] == secondByte && MatchesAt(data + position, signature))
+            RecordMatch(data, position, baseOffset, signature, result);
+    }
+}
+
+void SignatureScanner::BuildDispatch(const std::vector<Compiled> &compiled, const size_t (&histogram)[256],
+                                     DispatchTable &table, std::vector<size_t> &outSolo)
+{
+    // Rarest pair by the product of its byte frequencies
+    std::vector<std::pair<uint32_t, uint32_t>> keyed; // (key, pair offset) per signature, key > 0xFFFF = none
+    for (const Compiled &entry : compiled)
+    {
+        const Signature &signature = *entry.signature;
+        uint32_t bestKey = 0x10000;
+        uint32_t bestOffset = 0;
+        uint64_t bestScore = UINT64_MAX;
+        for (size_t k = 0; k + 1 < signature.bytes.size(); ++k)
+        {
+            if (signature.mask[k] == 0 || signature.mask[k + 1] == 0)
+                continue;
+
+            uint64_t score = static_cast<uint64_t>(histogram[signature.bytes[k]] + 1) * (histogram[signature.bytes[k + 1]] + 1);
+            if (score < bestScore)
+            {
+                bestScore = score;
+                bestKey = signature.bytes[k] | (static_cast<uint32_t>(signature.bytes[k + 1]) << 8);
+                bestOffset = static_cast<uint32_t>(k);
+            }
+        }
+        keyed.push_back({bestKey, bestOffset});
+    }
+
+    table.keyStart.assign(0x10000 + 1, 0);
+    for (size_t i = 0; i < keyed.size(); ++i)
+    {
+        if (keyed[i].first > 0xFFFF)
+            outSolo.push_back(i);
+        else
+            table.keyStart[keyed[i].first + 1]++;
+    }
+    for (size_t key = 0; key < 0x10000; ++key)
+    {
+        table.keyStart[key + 1] += table.keyStart[key];
+    }
+
+    table.entries.resize(table.keyStart[0x10000]);
+    std::vector<uint32_t> cursor(table.keyStart.begin(), table.keyStart.end() - 1);
+    for (size_t i = 0; i < keyed.size(); ++i)
+    {
+        if (keyed[i].first <= 0xFFFF)
+            table.entries[cursor[keyed[i].first]++] = {static_cast<uint32_t>(i), keyed[i].second};
+    }
+}
+
+void SignatureScanner::ScanBufferDispatch(const uint8_t *data, size_t size, size_t limit, uintptr_t baseOffset,
+                                          const std::vector<Compiled> &compiled, const DispatchTable &table,
+                                          std::vector<SignatureResult> &results)
+{
+    if (size < 2)
+        return;
+
+    // Starts are position - pair offset; starts before 0 were matched by the previous chunk
+    const uint32_t *keyStart = table.keyStart.data();
+    for (size_t position = 0; position + 1 < size; ++position)
+    {
+        uint32_t key = data[position] | (static_cast<uint32_t>(data[position + 1]) << 8);
+        uint32_t begin = keyStart[key];
+        uint32_t end = keyStart[key + 1];
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const auto &entry = table.entries[i];
+            if (position < entry.second)
+                continue;
+
+            size_t start = position - entry.second;
+            const Signature &signature = *compiled[entry.first].signature;
+            if (start >= limit || start + signature.bytes.size() > size)
+                continue;
+
+            if (MatchesAt(data + start, signature))
+                RecordMatch(data, start, baseOffset, signature, results[entry.first]);
+        }
+    }
+}
+
+void SignatureScanner::RecordMatch(const uint8_t *data, size_t position, uintptr_t baseOffset,
+                                   const Signature &signature, SignatureResult &result)
+{
+    if (result.matchCount++ != 0)
+        return;
+
+    result.matchOffset = baseOffset + position;
+    if (signature.extract == SignatureExtract::RipRelative)
+    {
+        int32_t displacement;
+        memcpy(&displacement, data + position + signature.extractOffset, sizeof(displacement));
+        result.offset = result.matchOffset + signature.instructionLength + static_cast<intptr_t>(displacement);
+    }
+    else
+    {
+        result.offset = result.matchOffset + signature.extractOffset;
+    }
+}
+
+bool SignatureScanner::ToOffsetEntry(const Signature &signature, const SignatureResult &result, OffsetEntry &outEntry)
+{
+    if (!result.IsFound())
+        return false;
+
+    outEntry = OffsetEntry();
+    outEntry.moduleName = signature.moduleName;
+    outEntry.offset = result.offset;
+    outEntry.description = signature.description;
+    return true;
+}
+
+void SignatureScanner::PrintResults(const std::vector<Signature> &signatures,
+                                    const std::vector<SignatureResult> &results)
+{
+    std::wcout << L"\n=== Signature Scan Results ===\n";
+    std::wcout << std::left << std::setw(25) << L"Description"
+               << L" | " << std::setw(35) << L"Module + Offset"
+               << L" | " << L"Notes" << std::endl;
+    std::wcout << std::wstring(75, L'-') << std::endl;
+
+    for (size_t i = 0; i < signatures.size() && i < results.size(); ++i)
+    {
+        const Signature &signature = signatures[i];
+        const SignatureResult &result = results[i];
+
+        std::wstring location = signature.moduleName;
+        if (result.IsFound())
+        {
+            std::string text;
+            StringUtils::AppendHex(result.offset, text);
+            location += L"+" + StringUtils::Utf8ToWide(text.data(), text.size());
+        }
+
+        std::wcout << std::left << std::setw(25) << signature.description << L" | " << std::setw(35) << location
+                   << L" | ";
+        if (!result.moduleFound)
+            std::wcout << L"module not loaded";
+        else if (!result.IsFound())
+            std::wcout << L"not found";
+        else if (result.matchCount > 1)
+            std::wcout << L"ambiguous (" << result.matchCount << L" matches)";
+        std::wcout << std::endl;
+    }
+    std::wcout << std::endl;
+}
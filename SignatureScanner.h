@@ -0,0 +1,152 @@
+#pragma once
+#include <windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ModuleRegistry.h"
+#include "OffsetStorage.h"
+
+// ============================================================================
+// SignatureScanner: Byte pattern (AOB) scanner over module images
+// Purpose: Find offsets by code signatures, e.g. "48 8B 05 ?? ?? ?? ?? 48 85 C0"
+// - each module is read once in 1 MB chunks, all of its signatures are matched
+//   against a chunk while it is in cache
+// - per signature the two rarest fixed bytes (byte histogram of pages sampled
+//   across the scanned range) are compared 16 positions at a time (SSE2),
+//   only hits are verified in full
+// - large sets (generated signatures) use one pass per chunk instead: every
+//   position looks up its byte pair in a table of the signatures' rarest
+//   fixed pairs, cost no longer grows with the signature count
+// - results are module-relative, either the match itself (+N) or the target of
+//   a RIP-relative operand, and convert directly to OffsetEntry
+// - a scan can be limited to one section (".text" for code signatures), taken
+//   from the module headers cached in ModuleRegistry
+//
+// Signature file (UTF-8 text, one per line, # and ; start comments):
+//   module|pattern|extract|description
+//   extract: empty   - match address
+//            +N      - match + N (hex)
+//            rip:D   - disp32 at match + D, instruction ends at D + 4
+//            rip:D:L - disp32 at match + D, instruction length L (hex)
+// ============================================================================
+
+enum class SignatureExtract
+{
+    Match,      // match + extractOffset
+    RipRelative // match + instructionLength + disp32 at match + extractOffset
+};
+
+struct Signature
+{
+    std::wstring moduleName;
+    std::wstring description;
+    std::vector<uint8_t> bytes;
+    std::vector<uint8_t> mask; // 0xFF = fixed byte, 0x00 = wildcard
+    SignatureExtract extract = SignatureExtract::Match;
+    size_t extractOffset = 0;
+    size_t instructionLength = 0;
+};
+
+struct SignatureResult
+{
+    bool moduleFound = false;
+    size_t matchCount = 0;     // > 1 means the signature is ambiguous, first match is used
+    uintptr_t matchOffset = 0; // First match, module-relative
+    uintptr_t offset = 0;      // Extracted result, module-relative
+
+    bool IsFound() const { return matchCount != 0; }
+};
+
+class SignatureScanner
+{
+public:
+    static constexpr size_t CHUNK_SIZE = 1 << 20;
+
+    // Parse "48 8B 05 ?? ??" style text, ? and ?? are whole-byte wildcards
+    // Returns false if the pattern is empty, malformed or has no fixed byte
+    static bool ParsePattern(const char *begin, const char *end, std::vector<uint8_t> &outBytes,
+                             std::vector<uint8_t> &outMask);
+
+    // Parse one signature file line (trimmed, not a comment)
+    static bool ParseLine(const char *begin, const char *end, Signature &signature, std::wstring &error);
+
+    // Load a signature file, malformed lines are reported and skipped
+    static bool LoadFromFile(const std::wstring &filename, std::vector<Signature> &outSignatures);
+
+    // Write a signature file (UTF-8, one line per signature)
+    static bool SaveToFile(const std::wstring &filename, const std::vector<Signature> &signatures);
+
+    // Append "48 8B 05 ?? ?? ?? ??" text of the pattern
+    static void FormatPattern(const Signature &signature, std::string &out);
+
+    // Append one signature file line (UTF-8, no newline)
+    static void FormatLine(const Signature &signature, std::string &out);
+
+    // Scan the modules named by the signatures, results are indexed like signatures
+    // section: only this section of each module (whole image if empty, or if a module lacks it)
+    std::vector<SignatureResult> Scan(HANDLE hProcess, const ModuleRegistry &registry,
+                                      const std::vector<Signature> &signatures, const std::wstring &section = L"");
+
+    // Scan a single module for the given signatures (all must belong to it)
+    // section: range to scan, the whole image if null
+    std::vector<SignatureResult> ScanModule(HANDLE hProcess, const ModuleInfo &module,
+                                            const std::vector<const Signature *> &signatures,
+                                            const ImageSection *section = nullptr);
+
+    // Image bytes read by the last Scan/ScanModule call
+    uint64_t GetLastBytesScanned() const { return m_lastBytesScanned; }
+
+    // Offset entry for a found result (false if not found)
+    static bool ToOffsetEntry(const Signature &signature, const SignatureResult &result, OffsetEntry &outEntry);
+
+    // Print a result table to console
+    static void PrintResults(const std::vector<Signature> &signatures, const std::vector<SignatureResult> &results);
+
+private:
+    // Signature prepared for one scan: anchor positions picked from the image histogram
+    struct Compiled
+    {
+        const Signature *signature;
+        size_t anchor1; // Rarest fixed byte
+        size_t anchor2; // Second rarest fixed byte (same as anchor1 if only one)
+    };
+
+    // Signatures keyed by their rarest adjacent fixed byte pair
+    struct DispatchTable
+    {
+        std::vector<uint32_t> keyStart; // 65536 + 1 prefix sums into entries
+        std::vector<std::pair<uint32_t, uint32_t>> entries; // (signature index, pair offset)
+    };
+
+    // Above this many signatures per module one dispatch pass beats a SIMD pass per signature
+    static constexpr size_t DISPATCH_THRESHOLD = 24;
+
+    // Pages read, evenly spaced over the scanned range, for the byte histogram
+    static constexpr size_t HISTOGRAM_SAMPLES = 64;
+
+    uint64_t m_lastBytesScanned = 0;
+
+    // Byte counts of HISTOGRAM_SAMPLES pages spread over [address, address + size)
+    static void SampleHistogram(HANDLE hProcess, uintptr_t address, size_t size, size_t (&histogram)[256]);
+
+    // Pick anchors by byte frequency (counts of a sample of the image)
+    static Compiled Compile(const Signature &signature, const size_t (&histogram)[256]);
+
+    // Match one signature over data, starts at or past limit are left to the next chunk
+    static void ScanBuffer(const uint8_t *data, size_t size, size_t limit, uintptr_t baseOffset,
+                           const Compiled &compiled, SignatureResult &result);
+
+    // Key every signature with a fixed byte pair, the others go to outSolo
+    static void BuildDispatch(const std::vector<Compiled> &compiled, const size_t (&histogram)[256],
+                              DispatchTable &table, std::vector<size_t> &outSolo);
+
+    // Match all dispatched signatures in one pass over data
+    static void ScanBufferDispatch(const uint8_t *data, size_t size, size_t limit, uintptr_t baseOffset,
+                                   const std::vector<Compiled> &compiled, const DispatchTable &table,
+                                   std::vector<SignatureResult> &results);
+
+    // Record a verified match at data + position
+    static void RecordMatch(const uint8_t *data, size_t position, uintptr_t baseOffset, const Signature &signature,
+                            SignatureResult &result);
+};
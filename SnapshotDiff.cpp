@@ -0,0 +1,418 @@
+#include "SnapshotDiff.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static unsigned TrailingZeros(unsigned mask)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+// Add one changed byte, joining the last range if it ends less than MERGE_GAP before it
+static void MarkChanged(std::vector<SnapshotDiffRange> &out, uintptr_t address)
+{
+    if (!out.empty())
+    {
+        SnapshotDiffRange &last = out.back();
+        if (last.kind == DiffKind::Changed && address - (last.address + last.size) < SnapshotDiff::MERGE_GAP)
+        {
+            last.size = address + 1 - last.address;
+            return;
+        }
+    }
+    out.push_back({address, 1, DiffKind::Changed});
+}
+
+// Changed bytes of a against b, equal 64-byte blocks are skipped with one mask test
+static void AppendChanges(const uint8_t *a, const uint8_t *b, size_t size, uintptr_t address,
+                          std::vector<SnapshotDiffRange> &out)
+{
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64)
+    {
+        __m128i equal[4];
+        for (int k = 0; k < 4; ++k)
+        {
+            equal[k] = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i + k * 16)),
+                                      _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i + k * 16)));
+        }
+        __m128i all = _mm_and_si128(_mm_and_si128(equal[0], equal[1]), _mm_and_si128(equal[2], equal[3]));
+        if (_mm_movemask_epi8(all) == 0xFFFF)
+            continue;
+
+        for (int k = 0; k < 4; ++k)
+        {
+            unsigned diff = ~static_cast<unsigned>(_mm_movemask_epi8(equal[k])) & 0xFFFF;
+            for (; diff != 0; diff &= diff - 1)
+            {
+                MarkChanged(out, address + i + k * 16 + TrailingZeros(diff));
+            }
+        }
+    }
+    for (; i < size; ++i)
+    {
+        if (a[i] != b[i])
+            MarkChanged(out, address + i);
+    }
+}
+
+// 4-byte value that reads as a float of magnitude ~1e-6 .. 1e9 (small integers are denormals)
+static bool LooksLikeFloat(uint32_t bits)
+{
+    uint32_t exponent = (bits >> 23) & 0xFF;
+    return (bits & 0x7FFFFFFF) == 0 || (exponent >= 127 - 20 && exponent <= 127 + 30);
+}
+
+std::wstring DiffValue::ToString() const
+{
+    std::wostringstream out;
+    switch (kind)
+    {
+    case DiffValueKind::Int:
+        out << L"int " << static_cast<int32_t>(before) << L" -> " << static_cast<int32_t>(after);
+        break;
+    case DiffValueKind::Float:
+    {
+        float from, to;
+        uint32_t fromBits = static_cast<uint32_t>(before), toBits = static_cast<uint32_t>(after);
+        memcpy(&from, &fromBits, sizeof(from));
+        memcpy(&to, &toBits, sizeof(to));
+        out << L"float " << from << L" -> " << to;
+        break;
+    }
+    case DiffValueKind::Pointer:
+        out << L"ptr 0x" << std::hex << std::uppercase << before << L" -> 0x" << after;
+        break;
+    case DiffValueKind::Bytes:
+        break;
+    }
+    return out.str();
+}
+
+void SnapshotDiff::Clear()
+{
+    m_before = nullptr;
+    m_after = nullptr;
+    m_ranges.clear();
+    m_ranges.shrink_to_fit();
+    m_stats = SnapshotDiffStats();
+}
+
+bool SnapshotDiff::Compare(const ProcessSnapshot &before, const ProcessSnapshot &after, unsigned threadCount)
+{
+    Clear();
+    if (!before.IsOpen() || !after.IsOpen())
+    {
+        std::wcerr << L"[-] Both snapshots must be open" << std::endl;
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Sweep both region lists: overlaps become pieces inside one chunk of each
+    // file, memory captured on one side only becomes an added / removed range
+    struct Piece
+    {
+        uintptr_t address;
+        uint32_t size;
+    };
+    std::vector<Piece> pieces;
+    std::vector<SnapshotDiffRange> oneSided;
+
+    const SnapshotRegion *ra = before.GetRegions();
+    const SnapshotRegion *rb = after.GetRegions();
+    const size_t na = before.RegionCount();
+    const size_t nb = after.RegionCount();
+    const uint64_t none = ~uint64_t(0);
+    const uint64_t chunk = ProcessSnapshot::CHUNK_SIZE;
+    uint64_t position = 0; // Everything below is handled
+    size_t i = 0, j = 0;
+    while (i < na || j < nb)
+    {
+        uint64_t aStart = i < na ? (std::max)(ra[i].baseAddress, position) : none;
+        uint64_t aEnd = i < na ? ra[i].baseAddress + ra[i].size : none;
+        uint64_t bStart = j < nb ? (std::max)(rb[j].baseAddress, position) : none;
+        uint64_t bEnd = j < nb ? rb[j].baseAddress + rb[j].size : none;
+        if (i < na && aStart >= aEnd)
+        {
+            i++;
+            continue;
+        }
+        if (j < nb && bStart >= bEnd)
+        {
+            j++;
+            continue;
+        }
+
+        uint64_t from = (std::min)(aStart, bStart);
+        uint64_t to;
+        if (aStart == from && bStart == from)
+        {
+            to = (std::min)(aEnd, bEnd);
+            for (uint64_t p = from; p < to;)
+            {
+                uint64_t aChunkEnd = ra[i].baseAddress + ((p - ra[i].baseAddress) / chunk + 1) * chunk;
+                uint64_t bChunkEnd = rb[j].baseAddress + ((p - rb[j].baseAddress) / chunk + 1) * chunk;
+                uint64_t next = (std::min)({to, aChunkEnd, bChunkEnd});
+                pieces.push_back({static_cast<uintptr_t>(p), static_cast<uint32_t>(next - p)});
+                p = next;
+            }
+            m_stats.comparedBytes += to - from;
+        }
+        else if (aStart == from)
+        {
+            to = (std::min)(aEnd, bStart);
+            oneSided.push_back({static_cast<uintptr_t>(from), to - from, DiffKind::Removed});
+            m_stats.removedBytes += to - from;
+        }
+        else
+        {
+            to = (std::min)(bEnd, aStart);
+            oneSided.push_back({static_cast<uintptr_t>(from), to - from, DiffKind::Added});
+            m_stats.addedBytes += to - from;
+        }
+        position = to;
+    }
+
+    if (threadCount == 0)
+        threadCount = (std::max)(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<unsigned>((std::max)(size_t(1), (std::min)(static_cast<size_t>(threadCount), pieces.size())));
+
+    std::vector<std::vector<SnapshotDiffRange>> found(pieces.size());
+    std::atomic<size_t> nextPiece(0);
+    std::atomic<size_t> keptRanges(oneSided.size());
+    std::atomic<uint64_t> decodedBytes(0);
+    std::atomic<uint64_t> droppedBytes(0);
+    std::atomic<bool> truncated(false);
+    std::atomic<bool> corrupted(false);
+
+    auto worker = [&]()
+    {
+        // One decoded chunk per side, reused while pieces stay inside it
+        std::vector<uint8_t> bufferA(ProcessSnapshot::CHUNK_SIZE);
+        std::vector<uint8_t> bufferB(ProcessSnapshot::CHUNK_SIZE);
+        uint64_t decodedA = ~uint64_t(0);
+        uint64_t decodedB = ~uint64_t(0);
+        std::vector<SnapshotDiffRange> local;
+
+        for (size_t p = nextPiece++; p < pieces.size(); p = nextPiece++)
+        {
+            const Piece &piece = pieces[p];
+            SnapshotChunkView ca, cb;
+            if (!before.FindChunk(piece.address, ca) || !after.FindChunk(piece.address, cb))
+            {
+                corrupted = true;
+                continue;
+            }
+
+            // LZ4 output is deterministic, equal stored blocks hold equal bytes
+            if (ca.address == cb.address && ca.length == cb.length && ca.encoding == cb.encoding &&
+                ca.storedSize == cb.storedSize && ca.badPages == cb.badPages &&
+                memcmp(ca.stored, cb.stored, ca.storedSize) == 0)
+                continue;
+
+            if (decodedA != ca.index)
+            {
+                decodedA = ~uint64_t(0);
+                if (!before.DecodeChunk(ca, bufferA.data()))
+                {
+                    corrupted = true;
+                    continue;
+                }
+                decodedA = ca.index;
+            }
+            if (decodedB != cb.index)
+            {
+                decodedB = ~uint64_t(0);
+                if (!after.DecodeChunk(cb, bufferB.data()))
+                {
+                    corrupted = true;
+                    continue;
+                }
+                decodedB = cb.index;
+            }
+
+            // Page by page, pages unreadable on either side are not compared
+            local.clear();
+            const size_t offsetA = piece.address - ca.address;
+            const size_t offsetB = piece.address - cb.address;
+            for (size_t offset = 0; offset < piece.size;)
+            {
+                size_t pageA = (offsetA + offset) / ProcessSnapshot::PAGE_BYTES;
+                size_t pageB = (offsetB + offset) / ProcessSnapshot::PAGE_BYTES;
+                size_t length = (std::min)(static_cast<size_t>(piece.size) - offset,
+                                           (pageA + 1) * ProcessSnapshot::PAGE_BYTES - (offsetA + offset));
+                if ((ca.badPages & (1u << pageA)) == 0 && (cb.badPages & (1u << pageB)) == 0)
+                {
+                    AppendChanges(&bufferA[offsetA + offset], &bufferB[offsetB + offset], length,
+                                  piece.address + offset, local);
+                    decodedBytes += length;
+                }
+                offset += length;
+            }
+
+            if (local.empty())
+                continue;
+            if (keptRanges.fetch_add(local.size()) + local.size() > MAX_RANGES)
+            {
+                keptRanges -= local.size();
+                truncated = true;
+                uint64_t bytes = 0;
+                for (const SnapshotDiffRange &range : local)
+                {
+                    bytes += range.size;
+                }
+                droppedBytes += bytes;
+                continue;
+            }
+            found[p] = local;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    // Pieces are in address order, ranges split at piece ends are joined again
+    m_ranges.reserve(keptRanges);
+    for (const std::vector<SnapshotDiffRange> &ranges : found)
+    {
+        for (const SnapshotDiffRange &range : ranges)
+        {
+            if (!m_ranges.empty() && m_ranges.back().kind == DiffKind::Changed &&
+                range.address - (m_ranges.back().address + m_ranges.back().size) < MERGE_GAP)
+            {
+                m_ranges.back().size = range.address + range.size - m_ranges.back().address;
+                continue;
+            }
+            m_ranges.push_back(range);
+        }
+    }
+    for (const SnapshotDiffRange &range : m_ranges)
+    {
+        m_stats.changedBytes += range.size;
+    }
+    m_stats.changedBytes += droppedBytes;
+
+    m_ranges.insert(m_ranges.end(), oneSided.begin(), oneSided.end());
+    std::sort(m_ranges.begin(), m_ranges.end(), [](const SnapshotDiffRange &a, const SnapshotDiffRange &b)
+              { return a.address < b.address; });
+
+    m_before = &before;
+    m_after = &after;
+    m_stats.decodedBytes = decodedBytes;
+    m_stats.pieceCount = pieces.size();
+    m_stats.rangeCount = m_ranges.size();
+    m_stats.truncated = truncated;
+    m_stats.threadCount = threadCount;
+    m_stats.diffMs = ElapsedMs(start);
+
+    if (corrupted)
+        std::wcerr << L"[!] Corrupted chunks were skipped, the diff is incomplete" << std::endl;
+    if (m_stats.truncated)
+        std::wcerr << L"[!] More than " << MAX_RANGES << L" changed ranges, later ranges are only counted" << std::endl;
+
+    DBG_OK(L"Snapshot diff: " + std::to_wstring(m_ranges.size()) + L" ranges, " +
+           std::to_wstring(m_stats.changedBytes) + L" changed bytes");
+    return true;
+}
+
+bool SnapshotDiff::IsCaptured(uint64_t address) const
+{
+    SnapshotChunkView chunk;
+    return m_after->FindChunk(static_cast<uintptr_t>(address), chunk) ||
+           m_before->FindChunk(static_cast<uintptr_t>(address), chunk);
+}
+
+DiffValue SnapshotDiff::Interpret(const SnapshotDiffRange &range) const
+{
+    DiffValue value;
+    value.address = range.address;
+    if (m_before == nullptr || range.kind != DiffKind::Changed || range.size > 8)
+        return value;
+
+    // Pointer: aligned 8-byte slot, both values null or inside captured memory
+    uintptr_t slot = range.address & ~uintptr_t(7);
+    uint64_t before = 0, after = 0;
+    if (range.address + range.size <= slot + 8 && m_before->Read(slot, &before, sizeof(before)) &&
+        m_after->Read(slot, &after, sizeof(after)) && (before == 0 || IsCaptured(before)) &&
+        (after == 0 || IsCaptured(after)))
+    {
+        value.kind = DiffValueKind::Pointer;
+        value.address = slot;
+        value.before = before;
+        value.after = after;
+        return value;
+    }
+
+    slot = range.address & ~uintptr_t(3);
+    uint32_t before32 = 0, after32 = 0;
+    if (range.address + range.size <= slot + 4 && m_before->Read(slot, &before32, sizeof(before32)) &&
+        m_after->Read(slot, &after32, sizeof(after32)))
+    {
+        value.kind = LooksLikeFloat(before32) && LooksLikeFloat(after32) ? DiffValueKind::Float : DiffValueKind::Int;
+        value.address = slot;
+        value.before = before32;
+        value.after = after32;
+    }
+    return value;
+}
+
+void SnapshotDiff::PrintRanges(size_t maxLines) const
+{
+    static const wchar_t *const kindNames[] = {L"changed", L"added  ", L"removed"};
+    size_t count = (std::min)(maxLines, m_ranges.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+        const SnapshotDiffRange &range = m_ranges[i];
+        std::wcout << L"  " << std::setw(4) << (i + 1) << L". 0x" << std::hex << std::uppercase << range.address
+                   << std::dec << L"  " << kindNames[static_cast<int>(range.kind)] << L"  " << std::setw(8)
+                   << range.size << L" bytes";
+        DiffValue value = Interpret(range);
+        if (value.kind != DiffValueKind::Bytes)
+            std::wcout << L"  " << value.ToString();
+        std::wcout << std::endl;
+    }
+    if (m_ranges.size() > count)
+    {
+        std::wcout << L"  ... " << (m_ranges.size() - count) << L" more" << std::endl;
+    }
+}
+
+void SnapshotDiff::PrintStats() const
+{
+    std::wcout << L"[+] Diff: " << m_stats.rangeCount << L" ranges, " << m_stats.changedBytes
+               << L" changed bytes in " << (m_stats.comparedBytes >> 20) << L" MB compared ("
+               << (m_stats.decodedBytes >> 20) << L" MB decoded, rest identical chunks), "
+               << (m_stats.addedBytes >> 10) << L" KB added, " << (m_stats.removedBytes >> 10) << L" KB removed; "
+               << std::fixed << std::setprecision(1) << m_stats.diffMs << L" ms on " << m_stats.threadCount
+               << L" threads" << std::defaultfloat << std::endl;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include "ProcessSnapshot.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// SnapshotDiff: What changed in a process between two snapshots
+// Purpose: Localize the fields a game action touched, with both values
+// - address ranges are split along the chunk grids of both files, workers
+//   take one piece at a time and decode at most one chunk per side
+// - chunks with identical stored bytes (same compressed block) are equal
+//   without decoding, others are compared 64 bytes at a time (SSE2)
+// - changed bytes closer than MERGE_GAP are reported as one range, pages
+//   unreadable in either snapshot are skipped
+// - memory captured in only one snapshot is reported as added / removed
+// ============================================================================
+
+enum class DiffKind : uint8_t
+{
+    Changed, // Captured in both, bytes differ
+    Added,   // Captured only in the second snapshot
+    Removed  // Captured only in the first snapshot
+};
+
+struct SnapshotDiffRange
+{
+    uintptr_t address;
+    uint64_t size;
+    DiffKind kind;
+};
+
+// Type guess for a short changed range
+enum class DiffValueKind : uint8_t
+{
+    Bytes,   // Longer than one value, or no type fits
+    Int,     // 4-byte integer
+    Float,   // 4-byte float
+    Pointer  // 8-byte value pointing into captured memory
+};
+
+struct DiffValue
+{
+    DiffValueKind kind = DiffValueKind::Bytes;
+    uintptr_t address = 0; // Aligned slot holding the range
+    uint64_t before = 0;   // Slot bits in the first snapshot
+    uint64_t after = 0;    // Slot bits in the second snapshot
+
+    std::wstring ToString() const;
+};
+
+struct SnapshotDiffStats
+{
+    uint64_t comparedBytes = 0; // Captured in both
+    uint64_t decodedBytes = 0;  // Compared byte by byte (rest: identical stored chunks)
+    uint64_t changedBytes = 0;  // Inside changed ranges, merge gaps included
+    uint64_t addedBytes = 0;
+    uint64_t removedBytes = 0;
+    size_t pieceCount = 0;
+    size_t rangeCount = 0;
+    bool truncated = false; // Range limit reached, byte counts stay exact
+    unsigned threadCount = 0;
+    double diffMs = 0;
+};
+
+class SnapshotDiff
+{
+public:
+    static constexpr size_t MERGE_GAP = 8;           // Changed bytes closer than this form one range
+    static constexpr size_t MAX_RANGES = 1000000;    // Ranges kept, later ones are only counted
+
+    // Diff two opened snapshots, both must stay open while ranges are interpreted
+    bool Compare(const ProcessSnapshot &before, const ProcessSnapshot &after, unsigned threadCount = 0);
+    void Clear();
+
+    // Ranges in address order
+    const std::vector<SnapshotDiffRange> &GetRanges() const { return m_ranges; }
+    const SnapshotDiffStats &GetStats() const { return m_stats; }
+
+    // Type guess and both values of a changed range of at most 8 bytes
+    DiffValue Interpret(const SnapshotDiffRange &range) const;
+
+    void PrintRanges(size_t maxLines) const;
+    void PrintStats() const;
+
+private:
+    const ProcessSnapshot *m_before = nullptr;
+    const ProcessSnapshot *m_after = nullptr;
+    std::vector<SnapshotDiffRange> m_ranges;
+    SnapshotDiffStats m_stats;
+
+    bool IsCaptured(uint64_t address) const;
+};
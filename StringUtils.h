@@ -0,0 +1,200 @@
+#pragma once
+#include "Platform.h"
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ============================================================================
+// StringUtils: UTF-8 <-> UTF-16 and hex helpers for the narrow file parsers
+// Pure ASCII input (the common case for module names) skips the WinAPI call
+// Outside Windows wchar_t is UTF-32 and the conversion is done here
+// ============================================================================
+
+namespace StringUtils
+{
+    inline void Utf8ToWide(const char *data, size_t length, std::wstring &out)
+    {
+        out.resize(length);
+        size_t i = 0;
+        for (; i < length; ++i)
+        {
+            unsigned char c = static_cast<unsigned char>(data[i]);
+            if (c >= 0x80)
+                break;
+            out[i] = static_cast<wchar_t>(c);
+        }
+        if (i == length)
+            return;
+
+#ifdef _WIN32
+        int needed = MultiByteToWideChar(CP_UTF8, 0, data, static_cast<int>(length), nullptr, 0);
+        out.resize(needed > 0 ? needed : 0);
+        if (needed > 0)
+            MultiByteToWideChar(CP_UTF8, 0, data, static_cast<int>(length), &out[0], needed);
+#else
+        // Malformed sequences become U+FFFD, one per bad byte
+        size_t written = i;
+        while (i < length)
+        {
+            unsigned char c = static_cast<unsigned char>(data[i]);
+            size_t extra;
+            uint32_t code;
+            uint32_t minimum;
+            if (c < 0x80)
+            {
+                extra = 0, code = c, minimum = 0;
+            }
+            else if (c >= 0xC2 && c < 0xE0)
+            {
+                extra = 1, code = c & 0x1Fu, minimum = 0x80;
+            }
+            else if (c >= 0xE0 && c < 0xF0)
+            {
+                extra = 2, code = c & 0x0Fu, minimum = 0x800;
+            }
+            else if (c >= 0xF0 && c < 0xF5)
+            {
+                extra = 3, code = c & 0x07u, minimum = 0x10000;
+            }
+            else
+            {
+                out[written++] = static_cast<wchar_t>(0xFFFD);
+                ++i;
+                continue;
+            }
+
+            bool valid = length - i > extra;
+            for (size_t k = 1; valid && k <= extra; ++k)
+            {
+                unsigned char next = static_cast<unsigned char>(data[i + k]);
+                valid = (next & 0xC0) == 0x80;
+                code = (code << 6) | (next & 0x3Fu);
+            }
+            if (code < minimum || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF))
+                valid = false;
+
+            out[written++] = valid ? static_cast<wchar_t>(code) : static_cast<wchar_t>(0xFFFD);
+            i += valid ? extra + 1 : 1;
+        }
+        out.resize(written);
+#endif
+    }
+
+    inline std::wstring Utf8ToWide(const char *data, size_t length)
+    {
+        std::wstring out;
+        Utf8ToWide(data, length, out);
+        return out;
+    }
+
+    inline void AppendUtf8(const std::wstring &str, std::string &out)
+    {
+        size_t i = 0;
+        for (; i < str.size(); ++i)
+        {
+            if (str[i] >= 0x80)
+                break;
+        }
+        if (i == str.size())
+        {
+            out.append(str.begin(), str.end());
+            return;
+        }
+
+#ifdef _WIN32
+        int needed = WideCharToMultiByte(CP_UTF8, 0, str.c_str(), static_cast<int>(str.size()), nullptr, 0, nullptr, nullptr);
+        if (needed <= 0)
+            return;
+        size_t start = out.size();
+        out.resize(start + needed);
+        WideCharToMultiByte(CP_UTF8, 0, str.c_str(), static_cast<int>(str.size()), &out[start], needed, nullptr, nullptr);
+#else
+        for (wchar_t wc : str)
+        {
+            uint32_t code = static_cast<uint32_t>(wc);
+            if (code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF))
+                code = 0xFFFD;
+            if (code < 0x80)
+            {
+                out.push_back(static_cast<char>(code));
+            }
+            else if (code < 0x800)
+            {
+                out.push_back(static_cast<char>(0xC0 | (code >> 6)));
+                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            else if (code < 0x10000)
+            {
+                out.push_back(static_cast<char>(0xE0 | (code >> 12)));
+                out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+            else
+            {
+                out.push_back(static_cast<char>(0xF0 | (code >> 18)));
+                out.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+                out.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+            }
+        }
+#endif
+    }
+
+    inline std::string WideToUtf8(const std::wstring &str)
+    {
+        std::string out;
+        AppendUtf8(str, out);
+        return out;
+    }
+
+    // Parse hex value ("0x" prefix optional) without allocations
+    inline bool ParseHex(const char *begin, const char *end, uintptr_t &outValue)
+    {
+        // Strip 0x or 0X prefix if present
+        if (end - begin >= 2 && begin[0] == '0' && (begin[1] == 'x' || begin[1] == 'X'))
+        {
+            begin += 2;
+        }
+
+        if (begin == end)
+            return false;
+
+        uintptr_t value = 0;
+        for (const char *p = begin; p < end; ++p)
+        {
+            unsigned digit;
+            char c = *p;
+            if (c >= '0' && c <= '9')
+                digit = c - '0';
+            else if (c >= 'a' && c <= 'f')
+                digit = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                digit = c - 'A' + 10;
+            else
+                return false;
+
+            // Overflow: value would not fit after shifting in another digit
+            if (value >> (sizeof(uintptr_t) * 8 - 4))
+                return false;
+
+            value = (value << 4) | digit;
+        }
+
+        outValue = value;
+        return true;
+    }
+
+    // Append "0x" + uppercase hex digits, same text as std::hex << std::uppercase
+    inline void AppendHex(uintptr_t value, std::string &out)
+    {
+        char digits[2 + sizeof(uintptr_t) * 2] = {'0', 'x'};
+        char *end = std::to_chars(digits + 2, digits + sizeof(digits), value, 16).ptr;
+        for (char *p = digits + 2; p < end; ++p)
+        {
+            if (*p >= 'a')
+                *p = static_cast<char>(*p - 'a' + 'A');
+        }
+        out.append(digits, end);
+    }
+}
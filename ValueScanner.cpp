@@ -0,0 +1,730 @@
+#include "ValueScanner.h"
+#include "PointerChainResolver.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static inline unsigned PopCount(uint64_t value)
+{
+#ifdef _MSC_VER
+    return static_cast<unsigned>(__popcnt64(value));
+#else
+    return static_cast<unsigned>(__builtin_popcountll(value));
+#endif
+}
+
+// Index of the lowest set bit (value != 0)
+static inline unsigned LowestBit(uint64_t value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+}
+
+// SSE2 lanes per value type, compares return all-ones lanes for matches
+
+struct Int32Lanes
+{
+    using Type = int32_t;
+    using Vector = __m128i;
+    static constexpr size_t COUNT = 4;
+
+    static Type FromDouble(double value)
+    {
+        value = (std::max)(value, static_cast<double>((std::numeric_limits<int32_t>::min)()));
+        value = (std::min)(value, static_cast<double>((std::numeric_limits<int32_t>::max)()));
+        return static_cast<Type>(value);
+    }
+    static Vector Set(Type value) { return _mm_set1_epi32(value); }
+    static Vector Load(const uint8_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+    static unsigned Mask(Vector m) { return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(m))); }
+    static Vector Equal(Vector a, Vector b) { return _mm_cmpeq_epi32(a, b); }
+    static Vector Greater(Vector a, Vector b) { return _mm_cmpgt_epi32(a, b); }
+    static Vector Less(Vector a, Vector b) { return _mm_cmplt_epi32(a, b); }
+    static Vector InRange(Vector v, Vector low, Vector high)
+    {
+        return _mm_andnot_si128(_mm_or_si128(_mm_cmplt_epi32(v, low), _mm_cmpgt_epi32(v, high)), _mm_set1_epi32(-1));
+    }
+    static Vector SameBits(Vector a, Vector b) { return _mm_cmpeq_epi32(a, b); }
+};
+
+struct FloatLanes
+{
+    using Type = float;
+    using Vector = __m128;
+    static constexpr size_t COUNT = 4;
+
+    static Type FromDouble(double value) { return static_cast<Type>(value); }
+    static Vector Set(Type value) { return _mm_set1_ps(value); }
+    static Vector Load(const uint8_t *p) { return _mm_loadu_ps(reinterpret_cast<const float *>(p)); }
+    static unsigned Mask(Vector m) { return static_cast<unsigned>(_mm_movemask_ps(m)); }
+    static Vector Equal(Vector a, Vector b) { return _mm_cmpeq_ps(a, b); }
+    static Vector Greater(Vector a, Vector b) { return _mm_cmpgt_ps(a, b); }
+    static Vector Less(Vector a, Vector b) { return _mm_cmplt_ps(a, b); }
+    static Vector InRange(Vector v, Vector low, Vector high) { return _mm_and_ps(_mm_cmpge_ps(v, low), _mm_cmple_ps(v, high)); }
+    static Vector SameBits(Vector a, Vector b)
+    {
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_castps_si128(a), _mm_castps_si128(b)));
+    }
+};
+
+struct DoubleLanes
+{
+    using Type = double;
+    using Vector = __m128d;
+    static constexpr size_t COUNT = 2;
+
+    static Type FromDouble(double value) { return value; }
+    static Vector Set(Type value) { return _mm_set1_pd(value); }
+    static Vector Load(const uint8_t *p) { return _mm_loadu_pd(reinterpret_cast<const double *>(p)); }
+    static unsigned Mask(Vector m) { return static_cast<unsigned>(_mm_movemask_pd(m)); }
+    static Vector Equal(Vector a, Vector b) { return _mm_cmpeq_pd(a, b); }
+    static Vector Greater(Vector a, Vector b) { return _mm_cmpgt_pd(a, b); }
+    static Vector Less(Vector a, Vector b) { return _mm_cmplt_pd(a, b); }
+    static Vector InRange(Vector v, Vector low, Vector high) { return _mm_and_pd(_mm_cmpge_pd(v, low), _mm_cmple_pd(v, high)); }
+    static Vector SameBits(Vector a, Vector b)
+    {
+        // No 64-bit integer compare in SSE2: both 32-bit halves must match
+        __m128i equal = _mm_cmpeq_epi32(_mm_castpd_si128(a), _mm_castpd_si128(b));
+        equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_castsi128_pd(equal);
+    }
+};
+
+// Changed is computed as Unchanged and inverted
+template <typename Lanes, ScanCompare C>
+static inline typename Lanes::Vector CompareVector(typename Lanes::Vector value, typename Lanes::Vector previous,
+                                                   typename Lanes::Vector low, typename Lanes::Vector high)
+{
+    if constexpr (C == ScanCompare::Exact)
+        return Lanes::Equal(value, low);
+    else if constexpr (C == ScanCompare::Range)
+        return Lanes::InRange(value, low, high);
+    else if constexpr (C == ScanCompare::Changed || C == ScanCompare::Unchanged)
+        return Lanes::SameBits(value, previous);
+    else if constexpr (C == ScanCompare::Increased)
+        return Lanes::Greater(value, previous);
+    else
+        return Lanes::Less(value, previous);
+}
+
+template <typename Lanes, ScanCompare C>
+static inline bool CompareScalar(const uint8_t *current, const uint8_t *previous, typename Lanes::Type low,
+                                 typename Lanes::Type high)
+{
+    using Type = typename Lanes::Type;
+    Type value;
+    memcpy(&value, current, sizeof(value));
+    if constexpr (C == ScanCompare::Exact)
+        return value == low;
+    else if constexpr (C == ScanCompare::Range)
+        return value >= low && value <= high;
+    else if constexpr (C == ScanCompare::Changed)
+        return memcmp(current, previous, sizeof(Type)) != 0;
+    else if constexpr (C == ScanCompare::Unchanged)
+        return memcmp(current, previous, sizeof(Type)) == 0;
+    else
+    {
+        Type old;
+        memcpy(&old, previous, sizeof(old));
+        return C == ScanCompare::Increased ? value > old : value < old;
+    }
+}
+
+// Match bits for slots values at current (previous: values of the last scan, same layout),
+// written to outBits, one bit per slot, 64 slots per word
+using CompareFunction = void (*)(const uint8_t *current, const uint8_t *previous, size_t slots, double low, double high,
+                                 uint64_t *outBits);
+
+template <typename Lanes, ScanCompare C>
+static void CompareSlots(const uint8_t *current, const uint8_t *previous, size_t slots, double lowValue,
+                         double highValue, uint64_t *outBits)
+{
+    using Type = typename Lanes::Type;
+    constexpr size_t size = sizeof(Type);
+    const Type low = Lanes::FromDouble(lowValue);
+    const Type high = Lanes::FromDouble(highValue);
+    const typename Lanes::Vector lowVector = Lanes::Set(low);
+    const typename Lanes::Vector highVector = Lanes::Set(high);
+
+    size_t slot = 0;
+    for (; slot + 64 <= slots; slot += 64)
+    {
+        uint64_t word = 0;
+        for (size_t k = 0; k < 64; k += Lanes::COUNT)
+        {
+            const size_t offset = (slot + k) * size;
+            typename Lanes::Vector value = Lanes::Load(current + offset);
+            typename Lanes::Vector old = value;
+            if constexpr (C != ScanCompare::Exact && C != ScanCompare::Range)
+                old = Lanes::Load(previous + offset);
+            word |= static_cast<uint64_t>(Lanes::Mask(CompareVector<Lanes, C>(value, old, lowVector, highVector))) << k;
+        }
+        outBits[slot / 64] = C == ScanCompare::Changed ? ~word : word;
+    }
+
+    if (slot < slots)
+    {
+        uint64_t word = 0;
+        for (size_t k = 0; slot + k < slots; ++k)
+        {
+            const size_t offset = (slot + k) * size;
+            if (CompareScalar<Lanes, C>(current + offset, previous ? previous + offset : nullptr, low, high))
+                word |= uint64_t(1) << k;
+        }
+        outBits[slot / 64] = word;
+    }
+}
+
+template <typename Lanes>
+static CompareFunction SelectCompare(ScanCompare compare)
+{
+    switch (compare)
+    {
+    case ScanCompare::Exact:
+        return CompareSlots<Lanes, ScanCompare::Exact>;
+    case ScanCompare::Range:
+        return CompareSlots<Lanes, ScanCompare::Range>;
+    case ScanCompare::Changed:
+        return CompareSlots<Lanes, ScanCompare::Changed>;
+    case ScanCompare::Unchanged:
+        return CompareSlots<Lanes, ScanCompare::Unchanged>;
+    case ScanCompare::Increased:
+        return CompareSlots<Lanes, ScanCompare::Increased>;
+    case ScanCompare::Decreased:
+        return CompareSlots<Lanes, ScanCompare::Decreased>;
+    default:
+        return nullptr;
+    }
+}
+
+static CompareFunction SelectCompare(ValueType type, ScanCompare compare)
+{
+    switch (type)
+    {
+    case ValueType::FLOAT:
+        return SelectCompare<FloatLanes>(compare);
+    case ValueType::DOUBLE:
+        return SelectCompare<DoubleLanes>(compare);
+    default:
+        return SelectCompare<Int32Lanes>(compare);
+    }
+}
+
+// Read the dirty pages of a chunk, take the clean ones from its previous bytes
+// Unreadable pages are zero-filled and appended to badPages, returns their count
+static size_t ReadDirtyPages(HANDLE process, uintptr_t address, size_t size, const std::vector<uint8_t> &dirty,
+                             const uint8_t *previous, uint8_t *buffer, std::vector<uint32_t> &badPages,
+                             uint64_t &bytesRead, uint64_t &bytesSkipped)
+{
+    const size_t pageSize = DirtyPageTracker::PAGE_BYTES;
+    size_t unreadable = 0;
+    for (size_t page = 0; page < dirty.size();)
+    {
+        size_t end = page + 1;
+        while (end < dirty.size() && dirty[end] == dirty[page])
+        {
+            end++;
+        }
+        const size_t offset = page * pageSize;
+        const size_t length = (std::min)(end * pageSize, size) - offset;
+        if (dirty[page])
+        {
+            size_t before = badPages.size();
+            unreadable += MemoryReader::ReadRangePadded(process, address + offset, buffer + offset, length, &badPages);
+            for (size_t i = before; i < badPages.size(); ++i)
+            {
+                badPages[i] += static_cast<uint32_t>(page);
+            }
+            bytesRead += length;
+        }
+        else
+        {
+            memcpy(buffer + offset, previous + offset, length);
+            bytesSkipped += length;
+        }
+        page = end;
+    }
+    return unreadable;
+}
+
+bool ValueScanner::FirstScan(HANDLE hProcess, ValueType type, const ScanCondition &condition, bool writableOnly,
+                             unsigned threadCount)
+{
+    if (condition.compare != ScanCompare::Exact && condition.compare != ScanCompare::Range &&
+        condition.compare != ScanCompare::Unknown)
+    {
+        std::wcerr << L"[-] A first scan needs an exact value, a range or an unknown value" << std::endl;
+        return false;
+    }
+    if (!CheckCondition(type, condition))
+        return false;
+
+    Reset();
+    std::vector<MemoryRegion> regions;
+    MemoryReader::EnumerateRegions(hProcess, regions, writableOnly);
+    if (regions.empty())
+    {
+        std::wcerr << L"[-] No readable memory regions in target process" << std::endl;
+        return false;
+    }
+
+    for (const MemoryRegion &region : regions)
+    {
+        for (uintptr_t offset = 0; offset < region.size; offset += CHUNK_SIZE)
+        {
+            Chunk chunk;
+            chunk.address = region.base + offset;
+            chunk.size = static_cast<uint32_t>((std::min)(static_cast<uintptr_t>(CHUNK_SIZE), region.size - offset));
+            m_chunks.push_back(std::move(chunk));
+        }
+    }
+
+    // Reset before the first read, writes racing with it count as dirty
+    if (m_trackWrites && m_dirtyPages.Begin(GetProcessId(hProcess)) && !m_dirtyPages.Reset())
+        m_dirtyPages.End();
+
+    m_process = hProcess;
+    m_type = type;
+    m_stats.regionCount = regions.size();
+    return Scan(condition, true, threadCount);
+}
+
+bool ValueScanner::NextScan(const ScanCondition &condition, unsigned threadCount)
+{
+    if (!HasScan())
+    {
+        std::wcerr << L"[-] No first scan to refine" << std::endl;
+        return false;
+    }
+    if (condition.compare == ScanCompare::Unknown)
+    {
+        std::wcerr << L"[-] Unknown value is a first scan only" << std::endl;
+        return false;
+    }
+    if (!CheckCondition(m_type, condition))
+        return false;
+    return Scan(condition, false, threadCount);
+}
+
+bool ValueScanner::CheckCondition(ValueType type, const ScanCondition &condition)
+{
+    if (type != ValueType::INT || (condition.compare != ScanCompare::Exact && condition.compare != ScanCompare::Range))
+        return true;
+
+    // Converting 2.5 to an int would silently match 2
+    const double low = static_cast<double>((std::numeric_limits<int32_t>::min)());
+    const double high = static_cast<double>((std::numeric_limits<int32_t>::max)());
+    const double values[] = {condition.value, condition.high};
+    size_t count = condition.compare == ScanCompare::Range ? 2 : 1;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (values[i] != std::floor(values[i]) || values[i] < low || values[i] > high)
+        {
+            std::wcerr << L"[-] Not a 32-bit integer: " << std::setprecision(15) << values[i] << std::setprecision(6)
+                       << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void ValueScanner::Reset()
+{
+    m_process = nullptr;
+    m_dirtyPages.End();
+    m_chunks.clear();
+    m_chunks.shrink_to_fit();
+    m_stats = ValueScanStats();
+}
+
+bool ValueScanner::Scan(const ScanCondition &condition, bool first, unsigned threadCount)
+{
+    auto start = std::chrono::steady_clock::now();
+    const size_t valueSize = PointerChainResolver::ValueSize(m_type);
+    const size_t pageSize = DirtyPageTracker::PAGE_BYTES;
+    const size_t slotsPerPage = pageSize / valueSize;
+    const CompareFunction compare = SelectCompare(m_type, condition.compare);
+
+    if (threadCount == 0)
+        threadCount = (std::max)(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<unsigned>((std::min)(static_cast<size_t>(threadCount), (std::max)(m_chunks.size(), size_t(1))));
+
+    // Pages written since the previous scan, queried before the tracker is reset for the next one
+    std::vector<std::vector<uint8_t>> dirty;
+    bool tracking = !first && m_dirtyPages.IsActive();
+    if (tracking)
+    {
+        dirty.resize(m_chunks.size());
+        for (size_t c = 0; c < m_chunks.size() && tracking; ++c)
+        {
+            tracking = m_dirtyPages.Query(m_chunks[c].address, (m_chunks[c].size + pageSize - 1) / pageSize, dirty[c]);
+        }
+        if (!tracking || !m_dirtyPages.Reset())
+        {
+            DBG_WARN(L"Dirty page query failed, rereading all hits");
+            m_dirtyPages.End();
+            tracking = false;
+        }
+    }
+
+    std::atomic<size_t> nextChunk(0);
+    std::atomic<uint64_t> bytesRead(0);
+    std::atomic<uint64_t> bytesSkipped(0);
+    std::atomic<size_t> unreadablePages(0);
+
+    auto worker = [&]()
+    {
+        std::vector<uint8_t> buffer;
+        std::vector<uint8_t> current;
+        std::vector<uint64_t> bits;
+        std::vector<uint64_t> valid;
+        std::vector<uint32_t> badPages;
+        uint64_t read = 0;
+        uint64_t skipped = 0;
+        size_t unreadable = 0;
+
+        for (size_t c = nextChunk++; c < m_chunks.size(); c = nextChunk++)
+        {
+            Chunk &chunk = m_chunks[c];
+            const std::vector<uint8_t> *dirtyPages = tracking ? &dirty[c] : nullptr;
+            badPages.clear();
+
+            if (first || chunk.dense)
+            {
+                // Whole chunk, compared slot by slot against the condition or the stored copy
+                const size_t slots = chunk.size / valueSize;
+                const size_t words = (slots + 63) / 64;
+                bits.resize(words);
+
+                // A chunk without written pages is compared against its own copy
+                std::vector<uint8_t> *chunkBytes = &buffer;
+                if (dirtyPages == nullptr)
+                {
+                    buffer.resize(chunk.size);
+                    unreadable += MemoryReader::ReadRangePadded(m_process, chunk.address, buffer.data(), chunk.size, &badPages);
+                    read += chunk.size;
+                }
+                else if (std::find(dirtyPages->begin(), dirtyPages->end(), 1) == dirtyPages->end())
+                {
+                    chunkBytes = &chunk.data;
+                    skipped += chunk.size;
+                }
+                else
+                {
+                    buffer.resize(chunk.size);
+                    unreadable += ReadDirtyPages(m_process, chunk.address, chunk.size, *dirtyPages, chunk.data.data(),
+                                                 buffer.data(), badPages, read, skipped);
+                }
+
+                if (compare == nullptr)
+                {
+                    std::fill(bits.begin(), bits.end(), ~uint64_t(0));
+                    if (slots % 64 != 0)
+                        bits.back() = (uint64_t(1) << (slots % 64)) - 1;
+                }
+                else
+                {
+                    compare(chunkBytes->data(), first ? nullptr : chunk.data.data(), slots, condition.value, condition.high,
+                            bits.data());
+                    if (!first)
+                    {
+                        for (size_t w = 0; w < words; ++w)
+                        {
+                            bits[w] &= chunk.bits[w];
+                        }
+                    }
+                }
+
+                // Chunks are page aligned, a page covers whole bitmap words
+                for (uint32_t page : badPages)
+                {
+                    size_t begin = page * slotsPerPage / 64;
+                    size_t end = (std::min)((page + 1) * slotsPerPage / 64, words);
+                    std::fill(bits.begin() + begin, bits.begin() + end, 0);
+                }
+                StoreHits(chunk, bits, *chunkBytes);
+                continue;
+            }
+
+            // Sparse: gather the current values next to the stored ones, then compare both lists
+            // Hits on pages not written since the previous scan keep their stored value
+            const size_t count = chunk.count;
+            current.assign(chunk.values.begin(), chunk.values.end());
+            valid.assign((count + 63) / 64, ~uint64_t(0));
+            auto needsRead = [&](size_t i)
+            { return dirtyPages == nullptr || (*dirtyPages)[chunk.offsets[i] / pageSize] != 0; };
+            size_t readCount = 0;
+            size_t firstRead = count;
+            size_t lastRead = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!needsRead(i))
+                    continue;
+                readCount++;
+                firstRead = (std::min)(firstRead, i);
+                lastRead = i;
+            }
+            skipped += (count - readCount) * valueSize;
+
+            if (readCount != 0 && readCount <= INDIVIDUAL_READS)
+            {
+                for (size_t i = firstRead; i <= lastRead; ++i)
+                {
+                    if (!needsRead(i))
+                        continue;
+                    if (MemoryReader::ReadRangePadded(m_process, chunk.address + chunk.offsets[i],
+                                                      current.data() + i * valueSize, valueSize) != 0)
+                    {
+                        valid[i / 64] &= ~(uint64_t(1) << (i % 64));
+                        unreadable++;
+                    }
+                }
+                read += readCount * valueSize;
+            }
+            else if (readCount != 0)
+            {
+                const size_t spanBegin = chunk.offsets[firstRead] & ~(pageSize - 1);
+                const size_t spanEnd = (std::min)((chunk.offsets[lastRead] + valueSize + pageSize - 1) & ~(pageSize - 1),
+                                                  static_cast<size_t>(chunk.size));
+                buffer.resize(spanEnd - spanBegin);
+                unreadable += MemoryReader::ReadRangePadded(m_process, chunk.address + spanBegin, buffer.data(),
+                                                            buffer.size(), &badPages);
+                read += buffer.size();
+                for (size_t i = firstRead; i <= lastRead; ++i)
+                {
+                    if (needsRead(i))
+                        memcpy(current.data() + i * valueSize, buffer.data() + chunk.offsets[i] - spanBegin, valueSize);
+                }
+                for (uint32_t page : badPages)
+                {
+                    // Offsets are sorted, hits on the page are one run
+                    auto from = std::lower_bound(chunk.offsets.begin(), chunk.offsets.end(), spanBegin + page * pageSize);
+                    auto to = std::lower_bound(from, chunk.offsets.end(), spanBegin + (page + 1) * pageSize);
+                    for (auto it = from; it != to; ++it)
+                    {
+                        size_t i = it - chunk.offsets.begin();
+                        if (needsRead(i))
+                            valid[i / 64] &= ~(uint64_t(1) << (i % 64));
+                    }
+                }
+            }
+
+            bits.resize(valid.size());
+            compare(current.data(), chunk.values.data(), count, condition.value, condition.high, bits.data());
+
+            // Compact in place, hits keep their order
+            size_t kept = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (((bits[i / 64] & valid[i / 64]) >> (i % 64) & 1) == 0)
+                    continue;
+                chunk.offsets[kept] = chunk.offsets[i];
+                memcpy(chunk.values.data() + kept * valueSize, current.data() + i * valueSize, valueSize);
+                kept++;
+            }
+            chunk.count = static_cast<uint32_t>(kept);
+            chunk.offsets.resize(kept);
+            chunk.values.resize(kept * valueSize);
+            if (kept == 0)
+            {
+                std::vector<uint32_t>().swap(chunk.offsets);
+                std::vector<uint8_t>().swap(chunk.values);
+            }
+        }
+        bytesRead += read;
+        bytesSkipped += skipped;
+        unreadablePages += unreadable;
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    m_chunks.erase(std::remove_if(m_chunks.begin(), m_chunks.end(), [](const Chunk &chunk)
+                                  { return chunk.count == 0; }),
+                   m_chunks.end());
+
+    m_stats.scanCount++;
+    m_stats.denseChunks = 0;
+    m_stats.sparseChunks = 0;
+    m_stats.resultCount = 0;
+    m_stats.memoryBytes = 0;
+    for (const Chunk &chunk : m_chunks)
+    {
+        (chunk.dense ? m_stats.denseChunks : m_stats.sparseChunks)++;
+        m_stats.resultCount += chunk.count;
+        m_stats.memoryBytes += ChunkMemory(chunk);
+    }
+    m_stats.bytesRead = bytesRead;
+    m_stats.bytesSkipped = bytesSkipped;
+    m_stats.writeTracking = m_dirtyPages.IsActive();
+    m_stats.unreadablePages = unreadablePages;
+    m_stats.scanMs = ElapsedMs(start);
+
+    DBG_OK(L"Value scan " + std::to_wstring(m_stats.scanCount) + L": " + std::to_wstring(m_stats.resultCount) +
+           L" hits, " + std::to_wstring(m_stats.bytesRead >> 20) + L" MB read");
+    return true;
+}
+
+void ValueScanner::StoreHits(Chunk &chunk, std::vector<uint64_t> &bits, std::vector<uint8_t> &data) const
+{
+    const size_t valueSize = PointerChainResolver::ValueSize(m_type);
+    size_t count = 0;
+    for (uint64_t word : bits)
+    {
+        count += PopCount(word);
+    }
+
+    chunk.count = static_cast<uint32_t>(count);
+    if (count == 0)
+    {
+        // No hits left, only the range is kept
+        chunk.dense = false;
+        std::vector<uint64_t>().swap(chunk.bits);
+        std::vector<uint8_t>().swap(chunk.data);
+        std::vector<uint32_t>().swap(chunk.offsets);
+        std::vector<uint8_t>().swap(chunk.values);
+        return;
+    }
+
+    // Bitmap plus chunk copy, or offset plus value per hit
+    const size_t denseBytes = chunk.size + bits.size() * sizeof(uint64_t);
+    const size_t sparseBytes = count * (sizeof(uint32_t) + valueSize);
+    if (denseBytes <= sparseBytes)
+    {
+        chunk.dense = true;
+        chunk.bits.swap(bits);
+        chunk.data.swap(data);
+        std::vector<uint32_t>().swap(chunk.offsets);
+        std::vector<uint8_t>().swap(chunk.values);
+        return;
+    }
+
+    chunk.dense = false;
+    std::vector<uint32_t> offsets;
+    std::vector<uint8_t> values;
+    offsets.reserve(count);
+    values.reserve(count * valueSize);
+    for (size_t w = 0; w < bits.size(); ++w)
+    {
+        for (uint64_t word = bits[w]; word != 0; word &= word - 1)
+        {
+            uint32_t offset = static_cast<uint32_t>((w * 64 + LowestBit(word)) * valueSize);
+            offsets.push_back(offset);
+            values.insert(values.end(), data.begin() + offset, data.begin() + offset + valueSize);
+        }
+    }
+    chunk.offsets.swap(offsets);
+    chunk.values.swap(values);
+    std::vector<uint64_t>().swap(chunk.bits);
+    std::vector<uint8_t>().swap(chunk.data);
+}
+
+size_t ValueScanner::ChunkMemory(const Chunk &chunk) const
+{
+    return chunk.bits.capacity() * sizeof(uint64_t) + chunk.data.capacity() +
+           chunk.offsets.capacity() * sizeof(uint32_t) + chunk.values.capacity();
+}
+
+std::vector<ValueScanResult> ValueScanner::GetResults(size_t maxCount) const
+{
+    std::vector<ValueScanResult> results;
+    const size_t valueSize = PointerChainResolver::ValueSize(m_type);
+
+    auto add = [&](uintptr_t address, const uint8_t *bytes)
+    {
+        ValueScanResult result;
+        result.address = address;
+        result.value.type = m_type;
+        result.value.data.doubleValue = 0;
+        memcpy(&result.value.data, bytes, valueSize);
+        result.value.isValid = true;
+        results.push_back(result);
+    };
+
+    for (const Chunk &chunk : m_chunks)
+    {
+        if (chunk.dense)
+        {
+            for (size_t w = 0; w < chunk.bits.size(); ++w)
+            {
+                for (uint64_t word = chunk.bits[w]; word != 0; word &= word - 1)
+                {
+                    if (results.size() >= maxCount)
+                        return results;
+                    size_t offset = (w * 64 + LowestBit(word)) * valueSize;
+                    add(chunk.address + offset, chunk.data.data() + offset);
+                }
+            }
+            continue;
+        }
+        for (size_t i = 0; i < chunk.count; ++i)
+        {
+            if (results.size() >= maxCount)
+                return results;
+            add(chunk.address + chunk.offsets[i], chunk.values.data() + i * valueSize);
+        }
+    }
+    return results;
+}
+
+void ValueScanner::PrintResults(size_t maxLines) const
+{
+    std::vector<ValueScanResult> results = GetResults(maxLines);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        std::wcout << L"  " << std::setw(4) << (i + 1) << L". 0x" << std::hex << std::uppercase
+                   << results[i].address << std::dec << L" = " << results[i].value.ToString() << std::endl;
+    }
+    if (m_stats.resultCount > results.size())
+    {
+        std::wcout << L"  ... " << (m_stats.resultCount - results.size()) << L" more" << std::endl;
+    }
+}
+
+void ValueScanner::PrintStats() const
+{
+    std::wcout << L"[+] Scan " << m_stats.scanCount << L": " << m_stats.resultCount << L" hits in "
+               << std::fixed << std::setprecision(1) << m_stats.scanMs << L" ms, "
+               << (m_stats.bytesRead >> 20) << L" MB read, ";
+    if (m_stats.writeTracking && m_stats.scanCount > 1)
+        std::wcout << (m_stats.bytesSkipped >> 20) << L" MB unchanged (not reread), ";
+    std::wcout << m_stats.denseChunks << L" dense / "
+               << m_stats.sparseChunks << L" sparse chunks, " << (m_stats.memoryBytes >> 10) << L" KB of results"
+               << std::endl;
+    if (m_stats.writeTracking && m_stats.scanCount == 1)
+        std::wcout << L"[*] Tracking page writes, next scans reread written pages only" << std::endl;
+    if (m_stats.unreadablePages != 0)
+    {
+        std::wcout << L"[!] " << m_stats.unreadablePages << L" pages could not be read, hits there were dropped"
+                   << std::endl;
+    }
+}
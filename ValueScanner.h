@@ -0,0 +1,124 @@
+#pragma once
+#include "Platform.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "DirtyPageTracker.h"
+#include "MemoryReader.h"
+
+// ============================================================================
+// ValueScanner: Finds addresses holding a value, narrowed down scan by scan
+// Purpose: Locate "Player HP" style fields to start pointer scans from
+// - first scan: exact value, value range or unknown initial value over the
+//   committed regions of the target, in 1 MB chunks on a worker pool
+// - next scan: keeps hits that are exact/in range, or changed, unchanged,
+//   increased or decreased compared to the value of the previous scan
+// - slots are aligned to the value size, compared 16 bytes at a time (SSE2)
+// - per chunk, hits are a bitmap plus a copy of the chunk (dense) or offset
+//   and value lists (sparse), whichever is smaller; chunks without hits are
+//   released
+// - hits on pages that cannot be read are dropped
+// - where the system tracks page writes (DirtyPageTracker), next scans
+//   reread only pages written since the previous scan
+// ============================================================================
+
+enum class ScanCompare : uint8_t
+{
+    Exact,     // value == condition value
+    Range,     // value in [condition value, condition high]
+    Unknown,   // Any value, first scan only
+    Changed,   // Bits differ from the previous scan
+    Unchanged, // Bits equal the previous scan
+    Increased, // value > previous
+    Decreased  // value < previous
+};
+
+struct ScanCondition
+{
+    ScanCompare compare = ScanCompare::Exact;
+    double value = 0; // Exact value, low end of Range
+    double high = 0;  // High end of Range
+};
+
+struct ValueScanResult
+{
+    uintptr_t address;
+    MemoryValue value; // Value at the last scan
+};
+
+struct ValueScanStats
+{
+    size_t scanCount = 0;       // Scans since the first scan
+    size_t regionCount = 0;
+    size_t denseChunks = 0;
+    size_t sparseChunks = 0;
+    uint64_t bytesRead = 0;     // Read by the last scan
+    uint64_t bytesSkipped = 0;  // Not reread by the last scan, pages were not written
+    bool writeTracking = false; // Dirty page tracking active
+    size_t unreadablePages = 0; // Hits there were dropped
+    uint64_t resultCount = 0;
+    size_t memoryBytes = 0;     // Result set size
+    double scanMs = 0;
+};
+
+class ValueScanner
+{
+public:
+    static constexpr size_t CHUNK_SIZE = 1 << 20;
+    static constexpr size_t INDIVIDUAL_READS = 32; // Sparse chunks with fewer hits read them one by one
+
+    // Start a new scan, Exact / Range / Unknown only
+    // writableOnly: skip read-only and executable-only regions (code, constants)
+    bool FirstScan(HANDLE hProcess, ValueType type, const ScanCondition &condition, bool writableOnly = true,
+                   unsigned threadCount = 0);
+
+    // Refine the hits of the previous scan, any compare but Unknown
+    bool NextScan(const ScanCondition &condition, unsigned threadCount = 0);
+
+    void Reset();
+
+    // Reread only written pages on next scans where supported (default on),
+    // takes effect at the next first scan
+    void SetTrackWrites(bool enable) { m_trackWrites = enable; }
+    bool HasScan() const { return m_process != nullptr; }
+    ValueType GetValueType() const { return m_type; }
+    uint64_t GetResultCount() const { return m_stats.resultCount; }
+    const ValueScanStats &GetStats() const { return m_stats; }
+
+    // First maxCount hits in address order
+    std::vector<ValueScanResult> GetResults(size_t maxCount) const;
+
+    void PrintResults(size_t maxLines) const;
+    void PrintStats() const;
+
+private:
+    struct Chunk
+    {
+        uintptr_t address = 0;
+        uint32_t size = 0;
+        uint32_t count = 0;            // Hits
+        bool dense = false;
+        std::vector<uint64_t> bits;    // Dense: one bit per slot
+        std::vector<uint8_t> data;     // Dense: chunk bytes at the last scan
+        std::vector<uint32_t> offsets; // Sparse: byte offsets of hits
+        std::vector<uint8_t> values;   // Sparse: hit values, back to back
+    };
+
+    HANDLE m_process = nullptr;
+    ValueType m_type = ValueType::INT;
+    std::vector<Chunk> m_chunks;
+    ValueScanStats m_stats;
+    bool m_trackWrites = true;
+    DirtyPageTracker m_dirtyPages;
+
+    bool Scan(const ScanCondition &condition, bool first, unsigned threadCount);
+
+    // Exact/Range values an int scan can represent: integral and within int32
+    static bool CheckCondition(ValueType type, const ScanCondition &condition);
+
+    // Store the hits of a chunk (bits over the chunk bytes in data) in the smaller
+    // form, bits and data are swapped into the chunk when it stays dense
+    void StoreHits(Chunk &chunk, std::vector<uint64_t> &bits, std::vector<uint8_t> &data) const;
+
+    size_t ChunkMemory(const Chunk &chunk) const;
+};
@@ -0,0 +1,302 @@
+#include "X86Decoder.h"
+#include <cstring>
+
+// Operand layout flags of an opcode
+enum : uint16_t
+{
+    OP_MODRM = 1 << 0,
+    OP_IMM8 = 1 << 1,
+    OP_IMMZ = 1 << 2,   // imm16 with 66 prefix, else imm32
+    OP_IMMV = 1 << 3,   // imm64 with REX.W, else like OP_IMMZ (mov r, imm)
+    OP_IMM16 = 1 << 4,
+    OP_ENTER = 1 << 5,  // imm16 + imm8
+    OP_MOFFS = 1 << 6,  // 64-bit address, 32-bit with 67 prefix
+    OP_REL8 = 1 << 7,
+    OP_REL32 = 1 << 8,
+    OP_GROUP3 = 1 << 9, // F6/F7: immediate only for /0 and /1 (test)
+    OP_INVALID = 1 << 10
+};
+
+static uint16_t OneByteFlags(uint8_t op)
+{
+    if (op < 0x40)
+    {
+        switch (op)
+        {
+        case 0x06: case 0x07: case 0x0E: case 0x16: case 0x17: case 0x1E: case 0x1F:
+        case 0x27: case 0x2F: case 0x37: case 0x3F:
+            return OP_INVALID;
+        }
+        uint8_t low = op & 7;
+        if (low < 4)
+            return OP_MODRM;
+        if (low == 4)
+            return OP_IMM8;
+        return low == 5 ? OP_IMMZ : OP_INVALID;
+    }
+
+    if (op >= 0x50 && op <= 0x5F)
+        return 0;
+    if (op >= 0x70 && op <= 0x7F)
+        return OP_REL8;
+    if (op >= 0x84 && op <= 0x8F)
+        return OP_MODRM;
+    if (op >= 0x90 && op <= 0x9F)
+        return op == 0x9A ? OP_INVALID : 0;
+    if (op >= 0xA0 && op <= 0xA3)
+        return OP_MOFFS;
+    if (op >= 0xB0 && op <= 0xB7)
+        return OP_IMM8;
+    if (op >= 0xB8 && op <= 0xBF)
+        return OP_IMMV;
+    if (op >= 0xD8 && op <= 0xDF)
+        return OP_MODRM;
+
+    switch (op)
+    {
+    case 0x63: case 0xD0: case 0xD1: case 0xD2: case 0xD3: case 0xFE: case 0xFF:
+        return OP_MODRM;
+    case 0x69: case 0x81: case 0xC7:
+        return OP_MODRM | OP_IMMZ;
+    case 0x6B: case 0x80: case 0x83: case 0xC0: case 0xC1: case 0xC6:
+        return OP_MODRM | OP_IMM8;
+    case 0x68: case 0xA9:
+        return OP_IMMZ;
+    case 0x6A: case 0xA8: case 0xCD: case 0xE4: case 0xE5: case 0xE6: case 0xE7:
+        return OP_IMM8;
+    case 0xC2: case 0xCA:
+        return OP_IMM16;
+    case 0xC8:
+        return OP_ENTER;
+    case 0xE0: case 0xE1: case 0xE2: case 0xE3: case 0xEB:
+        return OP_REL8;
+    case 0xE8: case 0xE9:
+        return OP_REL32;
+    case 0xF6: case 0xF7:
+        return OP_MODRM | OP_GROUP3;
+    case 0x60: case 0x61: case 0x82: case 0xCE: case 0xD4: case 0xD5: case 0xD6: case 0xEA:
+        return OP_INVALID;
+    }
+    return 0;
+}
+
+static uint16_t TwoByteFlags(uint8_t op)
+{
+    if ((op >= 0x10 && op <= 0x1F) || (op >= 0x40 && op <= 0x6F) || (op >= 0x90 && op <= 0x9F) ||
+        (op >= 0xB0 && op <= 0xB9) || (op >= 0xBB && op <= 0xBF) || op >= 0xD0)
+        return OP_MODRM;
+    if (op >= 0x80 && op <= 0x8F)
+        return OP_REL32;
+    if (op >= 0xC8 && op <= 0xCF)
+        return 0;
+
+    switch (op)
+    {
+    case 0x00: case 0x01: case 0x02: case 0x03: case 0x0D: case 0x20: case 0x21: case 0x22: case 0x23:
+    case 0x28: case 0x29: case 0x2A: case 0x2B: case 0x2C: case 0x2D: case 0x2E: case 0x2F:
+    case 0x74: case 0x75: case 0x76: case 0x78: case 0x79: case 0x7C: case 0x7D: case 0x7E: case 0x7F:
+    case 0xA3: case 0xA5: case 0xAB: case 0xAD: case 0xAE: case 0xAF: case 0xC0: case 0xC1: case 0xC3: case 0xC7:
+        return OP_MODRM;
+    case 0x0F: case 0x70: case 0x71: case 0x72: case 0x73: case 0xA4: case 0xAC: case 0xBA:
+    case 0xC2: case 0xC4: case 0xC5: case 0xC6:
+        return OP_MODRM | OP_IMM8;
+    case 0x05: case 0x06: case 0x07: case 0x08: case 0x09: case 0x0B: case 0x0E:
+    case 0x30: case 0x31: case 0x32: case 0x33: case 0x34: case 0x35: case 0x37:
+    case 0x77: case 0xA0: case 0xA1: case 0xA2: case 0xA8: case 0xA9: case 0xAA:
+        return 0;
+    }
+    return OP_INVALID;
+}
+
+// VEX/EVEX opcode in map 1/2/3: always ModRM, imm8 for map 3 and the map 1 shuffles/compares
+static uint16_t VexFlags(unsigned map, uint8_t op)
+{
+    if (map == 1 && op == 0x77)
+        return 0; // vzeroupper / vzeroall
+    if (map == 3 || (map == 1 && ((op >= 0x70 && op <= 0x73) || op == 0xC2 || (op >= 0xC4 && op <= 0xC6))))
+        return OP_MODRM | OP_IMM8;
+    return OP_MODRM;
+}
+
+bool X86Decoder::Decode(const uint8_t *code, size_t available, X86Instruction &out)
+{
+    out = X86Instruction();
+    size_t limit = available < MAX_LENGTH ? available : MAX_LENGTH;
+    size_t pos = 0;
+    bool operandSize16 = false;
+    bool addressSize32 = false;
+    bool rexW = false;
+
+    // Legacy prefixes
+    for (; pos < limit; ++pos)
+    {
+        uint8_t b = code[pos];
+        if (b == 0x66)
+            operandSize16 = true;
+        else if (b == 0x67)
+            addressSize32 = true;
+        else if (b != 0xF0 && b != 0xF2 && b != 0xF3 && b != 0x2E && b != 0x36 && b != 0x3E && b != 0x26 &&
+                 b != 0x64 && b != 0x65)
+            break;
+    }
+    if (pos >= limit)
+        return false;
+
+    // REX must directly precede the opcode
+    if ((code[pos] & 0xF0) == 0x40)
+    {
+        rexW = (code[pos] & 0x08) != 0;
+        if (++pos >= limit)
+            return false;
+    }
+
+    uint16_t flags;
+    uint8_t op = code[pos++];
+    bool twoByteMap = false;
+    if (op == 0xC4 || op == 0xC5 || op == 0x62)
+    {
+        // VEX3: C4 RXBmmmmm WvvvvLpp / VEX2: C5 RvvvvLpp / EVEX: 62 P0 P1 P2
+        size_t payload = op == 0xC5 ? 1 : (op == 0xC4 ? 2 : 3);
+        if (pos + payload >= limit)
+            return false;
+        unsigned map = op == 0xC5 ? 1 : (op == 0xC4 ? (code[pos] & 0x1F) : (code[pos] & 0x03));
+        if (map < 1 || map > 3)
+            return false;
+        pos += payload;
+        op = code[pos++];
+        flags = VexFlags(map, op);
+    }
+    else if (op == 0x0F)
+    {
+        if (pos >= limit)
+            return false;
+        op = code[pos++];
+        if (op == 0x38 || op == 0x3A)
+        {
+            if (pos >= limit)
+                return false;
+            flags = op == 0x3A ? (OP_MODRM | OP_IMM8) : OP_MODRM;
+            pos++;
+        }
+        else
+        {
+            flags = TwoByteFlags(op);
+            twoByteMap = true;
+        }
+    }
+    else
+    {
+        flags = OneByteFlags(op);
+    }
+
+    if (flags & OP_INVALID)
+        return false;
+
+    // ModRM, SIB and displacement
+    if (flags & OP_MODRM)
+    {
+        if (pos >= limit)
+            return false;
+        uint8_t modrm = code[pos++];
+        uint8_t mod = modrm >> 6;
+        uint8_t rm = modrm & 7;
+
+        if ((flags & OP_GROUP3) && ((modrm >> 3) & 7) < 2)
+            flags |= (op == 0xF6) ? OP_IMM8 : OP_IMMZ;
+
+        if (mod != 3)
+        {
+            if (rm == 4)
+            {
+                if (pos >= limit)
+                    return false;
+                uint8_t sib = code[pos++];
+                if (mod == 0 && (sib & 7) == 5)
+                {
+                    out.absoluteDisp = true;
+                    out.dispOffset = static_cast<uint8_t>(pos);
+                    pos += 4;
+                }
+            }
+            else if (mod == 0 && rm == 5)
+            {
+                out.ripRelative = true;
+                out.dispOffset = static_cast<uint8_t>(pos);
+                pos += 4;
+            }
+
+            if (mod == 1)
+                pos += 1;
+            else if (mod == 2)
+                pos += 4;
+        }
+    }
+
+    // Immediates and relative branches
+    out.immOffset = static_cast<uint8_t>(pos);
+    if (flags & OP_IMM8)
+        pos += 1;
+    if (flags & OP_IMM16)
+        pos += 2;
+    if (flags & OP_ENTER)
+        pos += 3;
+    if (flags & OP_IMMZ)
+        pos += operandSize16 ? 2 : 4;
+    if (flags & OP_IMMV)
+        pos += rexW ? 8 : (operandSize16 ? 2 : 4);
+    if (flags & OP_MOFFS)
+    {
+        out.immAddress = true;
+        pos += addressSize32 ? 4 : 8;
+    }
+    out.immSize = static_cast<uint8_t>(pos - out.immOffset);
+    if (out.immSize == 0)
+        out.immOffset = 0;
+    if (flags & (OP_REL8 | OP_REL32))
+    {
+        out.relOffset = static_cast<uint8_t>(pos);
+        out.relSize = (flags & OP_REL8) ? 1 : 4;
+        pos += out.relSize;
+
+        if (op == 0xE8 && !twoByteMap)
+            out.branch = X86Branch::Call;
+        else if ((op == 0xE9 || op == 0xEB) && !twoByteMap)
+            out.branch = X86Branch::Jump;
+        else
+            out.branch = X86Branch::Conditional;
+    }
+
+    if (pos > limit)
+        return false;
+
+    out.length = static_cast<uint8_t>(pos);
+    return true;
+}
+
+bool X86Decoder::GetTarget(const uint8_t *code, const X86Instruction &instruction, uint64_t address, uint64_t &outTarget)
+{
+    int64_t displacement;
+    if (instruction.ripRelative)
+    {
+        int32_t value;
+        memcpy(&value, code + instruction.dispOffset, sizeof(value));
+        displacement = value;
+    }
+    else if (instruction.relSize == 4)
+    {
+        int32_t value;
+        memcpy(&value, code + instruction.relOffset, sizeof(value));
+        displacement = value;
+    }
+    else if (instruction.relSize == 1)
+    {
+        displacement = static_cast<int8_t>(code[instruction.relOffset]);
+    }
+    else
+    {
+        return false;
+    }
+
+    outTarget = address + instruction.length + static_cast<uint64_t>(displacement);
+    return true;
+}
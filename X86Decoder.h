@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// ============================================================================
+// X86Decoder: Minimal x86-64 instruction length decoder
+// Purpose: Walk code and locate RIP-relative operands, rel32 branches and immediates
+// - legacy prefixes, REX, VEX (C4/C5), EVEX (62), maps 0F / 0F38 / 0F3A
+// - only lengths and operand positions are decoded, no mnemonics
+// - 64-bit mode only (no 16/32-bit code segments)
+// ============================================================================
+
+enum class X86Branch : uint8_t
+{
+    None,
+    Call,       // E8 rel32
+    Jump,       // E9 rel32 / EB rel8
+    Conditional // 7x rel8 / 0F 8x rel32, loop/jrcxz
+};
+
+struct X86Instruction
+{
+    uint8_t length = 0;
+    uint8_t dispOffset = 0;   // Offset of disp32 in the instruction if ripRelative or absoluteDisp
+    bool ripRelative = false; // ModRM mod=00 rm=101: target = end + disp32
+    X86Branch branch = X86Branch::None;
+    uint8_t relOffset = 0;    // Offset of the branch displacement
+    uint8_t relSize = 0;      // 1 or 4 (0 = no relative branch)
+    bool absoluteDisp = false; // SIB without base (mod=00 base=101): disp32 at dispOffset is an address
+    uint8_t immOffset = 0;    // Offset of the immediate or moffs address
+    uint8_t immSize = 0;      // 1, 2, 3 (enter), 4 or 8 (0 = none)
+    bool immAddress = false;  // moffs: the immediate is an absolute address
+};
+
+class X86Decoder
+{
+public:
+    static constexpr size_t MAX_LENGTH = 15;
+
+    // Decode one instruction, false if invalid in 64-bit mode or truncated
+    static bool Decode(const uint8_t *code, size_t available, X86Instruction &out);
+
+    // Target offset of a RIP operand or relative branch, relative to the code start
+    // address is the instruction's own offset; false if the instruction has neither
+    static bool GetTarget(const uint8_t *code, const X86Instruction &instruction, uint64_t address, uint64_t &outTarget);
+};
@@ -0,0 +1,116 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// ============================================================================
+// XXHash64: Fast non-cryptographic 64-bit hash (xxHash XXH64 algorithm)
+// Purpose: Content fingerprints of large memory ranges at memory bandwidth
+// Output matches the reference XXH64 implementation
+// ============================================================================
+
+namespace XXHash64
+{
+    constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+    constexpr uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+    constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+    constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+    inline uint64_t RotateLeft(uint64_t value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    inline uint64_t Read64(const uint8_t *p)
+    {
+        uint64_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint32_t Read32(const uint8_t *p)
+    {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline uint64_t Round(uint64_t acc, uint64_t input)
+    {
+        acc += input * PRIME2;
+        acc = RotateLeft(acc, 31);
+        return acc * PRIME1;
+    }
+
+    inline uint64_t MergeRound(uint64_t acc, uint64_t value)
+    {
+        acc ^= Round(0, value);
+        return acc * PRIME1 + PRIME4;
+    }
+
+    inline uint64_t Hash(const void *data, size_t length, uint64_t seed = 0)
+    {
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+        const uint8_t *end = p + length;
+        uint64_t hash;
+
+        if (length >= 32)
+        {
+            // Four independent lanes keep the multipliers busy
+            uint64_t v1 = seed + PRIME1 + PRIME2;
+            uint64_t v2 = seed + PRIME2;
+            uint64_t v3 = seed;
+            uint64_t v4 = seed - PRIME1;
+
+            const uint8_t *limit = end - 32;
+            do
+            {
+                v1 = Round(v1, Read64(p));
+                v2 = Round(v2, Read64(p + 8));
+                v3 = Round(v3, Read64(p + 16));
+                v4 = Round(v4, Read64(p + 24));
+                p += 32;
+            } while (p <= limit);
+
+            hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+            hash = MergeRound(hash, v1);
+            hash = MergeRound(hash, v2);
+            hash = MergeRound(hash, v3);
+            hash = MergeRound(hash, v4);
+        }
+        else
+        {
+            hash = seed + PRIME5;
+        }
+
+        hash += static_cast<uint64_t>(length);
+
+        while (p + 8 <= end)
+        {
+            hash ^= Round(0, Read64(p));
+            hash = RotateLeft(hash, 27) * PRIME1 + PRIME4;
+            p += 8;
+        }
+        if (p + 4 <= end)
+        {
+            hash ^= static_cast<uint64_t>(Read32(p)) * PRIME1;
+            hash = RotateLeft(hash, 23) * PRIME2 + PRIME3;
+            p += 4;
+        }
+        while (p < end)
+        {
+            hash ^= (*p) * PRIME5;
+            hash = RotateLeft(hash, 11) * PRIME1;
+            p++;
+        }
+
+        // Final avalanche
+        hash ^= hash >> 33;
+        hash *= PRIME2;
+        hash ^= hash >> 29;
+        hash *= PRIME3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+}
@@ -0,0 +1,187 @@
+#include "XrefIndex.h"
+#include "X86Decoder.h"
+#include "DebugLog.h"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+void XrefIndex::Build(const ModuleImage &image, unsigned threadCount)
+{
+    Clear();
+    m_moduleName = image.GetName();
+
+    // One task per slice of every executable section
+    struct Slice
+    {
+        size_t sectionBegin;
+        size_t begin;
+        size_t end;
+        size_t sectionEnd;
+    };
+    std::vector<Slice> slices;
+    for (const ImageSection &section : image.GetSections())
+    {
+        if (!section.executable || section.size == 0)
+            continue;
+
+        size_t sectionBegin = section.rva;
+        size_t sectionEnd = section.rva + section.size;
+        for (size_t begin = sectionBegin; begin < sectionEnd; begin += SLICE_SIZE)
+        {
+            slices.push_back({sectionBegin, begin, (std::min)(begin + SLICE_SIZE, sectionEnd), sectionEnd});
+        }
+        m_codeBytes += section.size;
+    }
+    if (slices.empty())
+        return;
+
+    if (threadCount == 0)
+        threadCount = (std::max)(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<unsigned>((std::min)(static_cast<size_t>(threadCount), slices.size()));
+
+    std::vector<std::vector<Xref>> found(slices.size());
+    std::vector<uint64_t> decoded(slices.size(), 0);
+    const uint8_t *data = image.Data();
+    const uint64_t imageSize = image.Size();
+
+    std::atomic<size_t> nextSlice(0);
+    auto worker = [&]()
+    {
+        for (size_t s = nextSlice++; s < slices.size(); s = nextSlice++)
+        {
+            const Slice &slice = slices[s];
+            std::vector<Xref> &out = found[s];
+
+            // Decoding a little before the slice resynchronizes with the previous slice's stream
+            size_t position = slice.begin - (std::min)(SYNC_BYTES, slice.begin - slice.sectionBegin);
+            while (position < slice.end)
+            {
+                X86Instruction instruction;
+                if (!X86Decoder::Decode(data + position, slice.sectionEnd - position, instruction))
+                {
+                    position++;
+                    continue;
+                }
+
+                if (position >= slice.begin)
+                {
+                    decoded[s]++;
+
+                    uint64_t target;
+                    bool relative32 = instruction.relSize == 4;
+                    if ((instruction.ripRelative || relative32) &&
+                        X86Decoder::GetTarget(data + position, instruction, position, target) && target < imageSize)
+                    {
+                        XrefKind kind = XrefKind::Data;
+                        if (!instruction.ripRelative)
+                        {
+                            kind = instruction.branch == X86Branch::Call   ? XrefKind::Call
+                                   : instruction.branch == X86Branch::Jump ? XrefKind::Jump
+                                                                           : XrefKind::Branch;
+                        }
+                        out.push_back({static_cast<uint32_t>(target), static_cast<uint32_t>(position), kind,
+                                       instruction.length});
+                    }
+                }
+                position += instruction.length;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount; ++t)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    size_t total = 0;
+    for (size_t s = 0; s < slices.size(); ++s)
+    {
+        total += found[s].size();
+        m_instructionCount += decoded[s];
+    }
+    m_xrefs.reserve(total);
+    for (auto &list : found)
+    {
+        m_xrefs.insert(m_xrefs.end(), list.begin(), list.end());
+    }
+
+    // Slices are in source order, a stable sort by target keeps sources ordered per target
+    std::stable_sort(m_xrefs.begin(), m_xrefs.end(), [](const Xref &a, const Xref &b)
+                     { return a.target < b.target; });
+
+    DBG_OK(m_moduleName + L": " + std::to_wstring(m_instructionCount) + L" instructions in " +
+           std::to_wstring(slices.size()) + L" slices, " + std::to_wstring(m_xrefs.size()) + L" xrefs");
+}
+
+void XrefIndex::Clear()
+{
+    m_moduleName.clear();
+    m_xrefs.clear();
+    m_xrefs.shrink_to_fit();
+    m_instructionCount = 0;
+    m_codeBytes = 0;
+}
+
+std::vector<Xref> XrefIndex::FindReferences(uintptr_t target) const
+{
+    if (target > 0xFFFFFFFFu)
+        return {};
+
+    auto range = std::equal_range(m_xrefs.begin(), m_xrefs.end(), Xref{static_cast<uint32_t>(target), 0, XrefKind::Data, 0},
+                                  [](const Xref &a, const Xref &b)
+                                  { return a.target < b.target; });
+    return std::vector<Xref>(range.first, range.second);
+}
+
+size_t XrefIndex::CountReferencesInRange(uintptr_t begin, uintptr_t end) const
+{
+    auto first = std::lower_bound(m_xrefs.begin(), m_xrefs.end(), begin, [](const Xref &xref, uintptr_t value)
+                                  { return xref.target < value; });
+    auto last = std::lower_bound(first, m_xrefs.end(), end, [](const Xref &xref, uintptr_t value)
+                                 { return xref.target < value; });
+    return static_cast<size_t>(last - first);
+}
+
+const wchar_t *XrefIndex::KindName(XrefKind kind)
+{
+    switch (kind)
+    {
+    case XrefKind::Data:
+        return L"data";
+    case XrefKind::Call:
+        return L"call";
+    case XrefKind::Jump:
+        return L"jmp";
+    case XrefKind::Branch:
+        return L"jcc";
+    }
+    return L"?";
+}
+
+void XrefIndex::PrintReferences(const ModuleImage &image, uintptr_t target, const std::vector<Xref> &xrefs)
+{
+    std::wcout << L"\n=== References to " << image.GetName() << L"+0x" << std::hex << std::uppercase << target
+               << std::dec << L" (" << xrefs.size() << L") ===\n";
+
+    for (const Xref &xref : xrefs)
+    {
+        std::wcout << L"  " << image.GetName() << L"+0x" << std::hex << std::uppercase << std::setw(8)
+                   << std::setfill(L'0') << xref.source << std::setfill(L' ') << L"  " << std::setw(4) << std::left
+                   << KindName(xref.kind) << std::right << L" ";
+        for (uint8_t i = 0; i < xref.length && xref.source + i < image.Size(); ++i)
+        {
+            std::wcout << std::setw(2) << std::setfill(L'0') << static_cast<unsigned>(image.Data()[xref.source + i])
+                       << std::setfill(L' ') << L" ";
+        }
+        std::wcout << std::dec << std::endl;
+    }
+    std::wcout << std::endl;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "ModuleImage.h"
+
+// ============================================================================
+// XrefIndex: Code cross-references of a module image
+// Purpose: Answer "who references module+0xDEA964" to re-derive offsets after
+// an update
+// - executable sections are split into 1 MB slices and decoded on a worker
+//   pool (X86Decoder, linear sweep); a slice starts decoding 64 bytes early
+//   so it is in sync with the instruction stream at its first byte
+// - recorded: RIP-relative operands and rel32 call/jmp/jcc that land inside
+//   the image, sorted by target for binary-search queries
+// ============================================================================
+
+enum class XrefKind : uint8_t
+{
+    Data, // RIP-relative memory operand (mov/lea/cmp ... [rip + disp32])
+    Call,
+    Jump,
+    Branch // Conditional jump
+};
+
+struct Xref
+{
+    uint32_t target;      // Referenced offset (module-relative)
+    uint32_t source;      // Referencing instruction (module-relative)
+    XrefKind kind;
+    uint8_t length;       // Instruction length
+};
+
+class XrefIndex
+{
+public:
+    static constexpr size_t SLICE_SIZE = 1 << 20;
+    static constexpr size_t SYNC_BYTES = 64;
+
+    // Decode the executable sections of image, threadCount 0 = one worker per hardware thread
+    void Build(const ModuleImage &image, unsigned threadCount = 0);
+
+    void Clear();
+
+    // References to a module-relative target, ordered by source
+    std::vector<Xref> FindReferences(uintptr_t target) const;
+
+    // Number of distinct instructions referencing anything in [begin, end)
+    size_t CountReferencesInRange(uintptr_t begin, uintptr_t end) const;
+
+    const std::wstring &GetModuleName() const { return m_moduleName; }
+    size_t GetXrefCount() const { return m_xrefs.size(); }
+    uint64_t GetInstructionCount() const { return m_instructionCount; }
+    uint64_t GetCodeBytes() const { return m_codeBytes; }
+
+    static const wchar_t *KindName(XrefKind kind);
+
+    // Print references to target with their instruction bytes
+    static void PrintReferences(const ModuleImage &image, uintptr_t target, const std::vector<Xref> &xrefs);
+
+private:
+    std::wstring m_moduleName;
+    std::vector<Xref> m_xrefs; // Sorted by (target, source)
+    uint64_t m_instructionCount = 0;
+    uint64_t m_codeBytes = 0;
+};
@@ -18,7 +18,33 @@ $sources = @(
     "PointerChainResolver.cpp",
     "PointerChainStorage.cpp",
     "ConsoleUI.cpp",
-    "DebugLog.cpp"
+    "DebugLog.cpp",
+    "ProcessGroup.cpp",
+    "MappedFile.cpp",
+    "Benchmark.cpp",
+    "OffsetDatabase.cpp",
+    "PointerChainTable.cpp",
+    "JsonSaxParser.cpp",
+    "FileWatcher.cpp",
+    "HotReload.cpp",
+    "EditJournal.cpp",
+    "ModuleHasher.cpp",
+    "SignatureScanner.cpp",
+    "SignatureGenerator.cpp",
+    "X86Decoder.cpp",
+    "ModuleImage.cpp",
+    "ModuleImageProcess.cpp",
+    "XrefIndex.cpp",
+    "ModuleHeaders.cpp",
+    "PointerScanner.cpp",
+    "PointerMapFile.cpp",
+    "ChainValidator.cpp",
+    "ValueScanner.cpp",
+    "DirtyPageTracker.cpp",
+    "ProcessSnapshot.cpp",
+    "ProcessSnapshotCapture.cpp",
+    "SnapshotDiff.cpp",
+    "ProcessPause.cpp"
 )
 
 $output = "ProcessModuleManager.exe"
@@ -4,12 +4,31 @@
 //
 // ARCHITECTURE:
 // - ProcessManager    : Process search and attachment
+// - ProcessGroup      : Attachment to all processes sharing a name
 // - ModuleRegistry    : Module information storage (ImageBase)
 // - AddressResolver   : Absolute address resolution with ASLR support
 // - OffsetStorage     : Load/save offsets (module+offset format)
 // - MemoryReader      : Type-safe memory reading with validation
 // - PointerChainResolver : Multi-level pointer chain resolution
-// - PointerChainStorage  : JSON persistence for pointer chains
+// - PointerChainStorage  : Pipe/JSON persistence for pointer chains
+// - EditJournal       : Append-only save journal for both storages
+// - BuildSets         : Per-build offset/chain sets keyed by module fingerprint
+// - ModuleHasher      : Parallel full-content hashes of module images
+// - SignatureScanner  : SIMD-prefiltered AOB scan of module images (RIP targets)
+// - SignatureGenerator: Shortest unique signatures for stored offsets (4-gram index)
+// - X86Decoder        : x86-64 instruction length decoder (RIP/rel operand positions)
+// - ModuleHeaders     : Cached PE/ELF sections and exports (symbol+delta offsets)
+// - ModuleImage       : Module laid out by RVA from a process, captured image or ELF
+// - XrefIndex         : Parallel RIP-relative/branch cross-reference index
+// - PointerScanner    : Parallel reverse pointer map and chain search to an address
+// - PointerMapFile    : Saved pointer maps (.ptrmap), mmap + block delta coding
+// - ChainValidator    : Scores chains across saved runs, prunes unstable ones
+// - ValueScanner      : First/next value scans, SIMD compares, bitmap or list hits
+// - DirtyPageTracker  : Pages written since the last scan (Linux soft-dirty bits)
+// - ProcessSnapshot   : Compressed memory capture, offline source for MemoryReader
+// - SnapshotDiff      : Changed ranges between two snapshots, SIMD compares
+// - ProcessPause      : Suspend/resume target for consistent chain reads
+// - HotReload         : Watches loaded files and merges edits incrementally
 // - ConsoleUI         : User interface
 //
 // PURPOSE:
@@ -25,9 +44,12 @@
 //
 // OFFSET FILE FORMAT:
 // app.dll+0xDEA964=DataPointer
+// app.dll!CreateInterface+0x20=Interface   (relative to an export)
 // module2.dll+0x58EFC4=ViewAngles
 //
-// POINTER CHAIN JSON FORMAT:
+// POINTER CHAIN FILE FORMATS (detected on load, *.json saves JSON):
+// app.dll|0x1000|0x18,0x70,0x2D0|int|Health
+//
 // {
 //   "pointer_chains": [
 //     {
@@ -50,6 +72,9 @@
 #include "MemoryReader.h"
 #include "PointerChainResolver.h"
 #include "PointerChainStorage.h"
+#include "ProcessGroup.h"
+#include "HotReload.h"
+#include "ModuleHasher.h"
 #include "ConsoleUI.h"
 #include <iostream>
 #include <windows.h>
@@ -68,10 +93,14 @@ int main()
     MemoryReader memoryReader(processManager.GetHandle());
     PointerChainResolver pointerChainResolver(&moduleRegistry, &memoryReader);
     PointerChainStorage pointerChainStorage;
+    ProcessGroup processGroup;
+    HotReload hotReload(offsetStorage, pointerChainStorage);
+    ModuleHasher moduleHasher;
 
     // Initialize UI with all dependencies
     ConsoleUI ui(processManager, moduleRegistry, addressResolver, offsetStorage,
-                 memoryReader, pointerChainResolver, pointerChainStorage);
+                 memoryReader, pointerChainResolver, pointerChainStorage, processGroup, hotReload,
+                 moduleHasher);
 
     // Launch main menu
     ui.ShowMainMenu();
@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// ============================================================================
+// ChildProcess: Forked target for the process-side tests
+// - the child maps a block of memory, lets the test fill it (prepare runs in
+//   the child) and then writes the values the parent asks for, one request at
+//   a time over a pipe; Write returns once the child wrote the value
+// - the destructor asks the child to exit and waits for it
+// ============================================================================
+
+class ChildProcess
+{
+public:
+    typedef void (*PrepareFunction)(uint8_t *block, size_t size);
+
+    ChildProcess() = default;
+    ChildProcess(const ChildProcess &) = delete;
+    ChildProcess &operator=(const ChildProcess &) = delete;
+
+    bool Start(size_t size, PrepareFunction prepare)
+    {
+        int requests[2];
+        int replies[2];
+        if (pipe(requests) != 0 || pipe(replies) != 0)
+            return false;
+        m_size = size;
+        m_pid = fork();
+        if (m_pid == 0)
+        {
+            close(requests[1]);
+            close(replies[0]);
+            Run(requests[0], replies[1], size, prepare);
+        }
+        close(requests[0]);
+        close(replies[1]);
+        m_requests = requests[1];
+        m_replies = replies[0];
+        return m_pid > 0 && read(m_replies, &m_block, sizeof(m_block)) == sizeof(m_block);
+    }
+
+    // Write value at block + offset in the child
+    bool Write(size_t offset, int32_t value)
+    {
+        Request request = {offset, value};
+        char done = 0;
+        return write(m_requests, &request, sizeof(request)) == sizeof(request) && read(m_replies, &done, 1) == 1;
+    }
+
+    ~ChildProcess()
+    {
+        if (m_pid <= 0)
+            return;
+        Request request = {EXIT, 0};
+        if (write(m_requests, &request, sizeof(request)) != sizeof(request))
+            kill(m_pid, SIGKILL);
+        waitpid(m_pid, nullptr, 0);
+        close(m_requests);
+        close(m_replies);
+    }
+
+    uint32_t Pid() const { return static_cast<uint32_t>(m_pid); }
+    uintptr_t Block() const { return m_block; }
+    size_t Size() const { return m_size; }
+
+private:
+    static constexpr uint64_t EXIT = ~uint64_t(0);
+
+    struct Request
+    {
+        uint64_t offset; // Into the block, EXIT = exit
+        int32_t value;
+    };
+
+    static void Run(int requests, int replies, size_t size, PrepareFunction prepare)
+    {
+        uint8_t *block = static_cast<uint8_t *>(
+            mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (block == MAP_FAILED)
+            _exit(1);
+        prepare(block, size);
+
+        uintptr_t address = reinterpret_cast<uintptr_t>(block);
+        if (write(replies, &address, sizeof(address)) != sizeof(address))
+            _exit(1);
+
+        Request request;
+        while (read(requests, &request, sizeof(request)) == sizeof(request) && request.offset != EXIT)
+        {
+            memcpy(block + request.offset, &request.value, sizeof(request.value));
+            char done = 1;
+            if (write(replies, &done, 1) != 1)
+                _exit(1);
+        }
+        _exit(0);
+    }
+
+    pid_t m_pid = -1;
+    int m_requests = -1;
+    int m_replies = -1;
+    uintptr_t m_block = 0;
+    size_t m_size = 0;
+};
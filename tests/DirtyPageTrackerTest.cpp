@@ -0,0 +1,145 @@
+#include "ChildProcess.h"
+#include "DirtyPageTracker.h"
+#include "ValueScanner.h"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <vector>
+
+// ============================================================================
+// DirtyPageTrackerTest: Tracked next scans against a child process
+// - the child (ChildProcess.h) maps a block of pages, marks some with a
+//   value and then writes the pages the parent asks for
+// - DirtyPageTracker must report the written pages dirty, and clean the
+//   others where the kernel sets soft-dirty bits
+// - ValueScanner next scans must find exactly the written values whether or
+//   not the tracker is active; with tracking, the bytes not reread are printed
+// ============================================================================
+
+static constexpr size_t BLOCK_PAGES = 4096; // 16 MB
+static constexpr size_t MARK_STRIDE = 16;   // Every 16th page holds the marker
+static constexpr int32_t MARKER = 0x5EED1234;
+
+static constexpr size_t PAGE = DirtyPageTracker::PAGE_BYTES;
+
+// Runs in the child: every page written once, marker pages carry MARKER
+static void FillBlock(uint8_t *block, size_t size)
+{
+    for (size_t page = 0; page < size / PAGE; ++page)
+    {
+        int32_t value = page % MARK_STRIDE == 0 ? MARKER : 0;
+        memcpy(block + page * PAGE, &value, sizeof(value));
+    }
+}
+
+// Hit addresses of the last scan inside the child's block
+static std::set<uintptr_t> BlockHits(const ValueScanner &scanner, const ChildProcess &child)
+{
+    std::set<uintptr_t> hits;
+    for (const ValueScanResult &result : scanner.GetResults(SIZE_MAX))
+    {
+        if (result.address >= child.Block() && result.address < child.Block() + child.Size())
+            hits.insert(result.address);
+    }
+    return hits;
+}
+
+static bool Check(bool condition, const wchar_t *what)
+{
+    std::wcout << (condition ? L"[+] " : L"[-] ") << what << std::endl;
+    return condition;
+}
+
+static bool TestTracker(ChildProcess &child)
+{
+    DirtyPageTracker tracker;
+    if (!tracker.Begin(child.Pid()))
+        return Check(!DirtyPageTracker::IsSupported(), L"Tracker inactive only without soft-dirty support");
+
+    bool passed = Check(tracker.Reset(), L"Reset clears the soft-dirty bits");
+    passed &= child.Write(100 * PAGE, 1) && child.Write(3000 * PAGE, 2);
+
+    std::vector<uint8_t> dirty;
+    passed &= Check(tracker.Query(child.Block(), BLOCK_PAGES, dirty), L"Query reads the pagemap");
+    size_t dirtyCount = 0;
+    for (uint8_t flag : dirty)
+    {
+        dirtyCount += flag;
+    }
+    passed &= Check(dirty[100] && dirty[3000], L"Written pages are dirty");
+    // The child wrote every page once before the reset, all of them are present
+    passed &= Check(dirtyCount == 2, L"Pages not written since the reset are clean");
+    return passed;
+}
+
+static bool TestScanner(ChildProcess &child, bool trackWrites)
+{
+    ValueScanner scanner;
+    scanner.SetTrackWrites(trackWrites);
+    HANDLE process = ProcessHandleFromId(child.Pid());
+    bool passed = true;
+
+    // Sparse chunks: marker pages only
+    ScanCondition exact;
+    exact.value = MARKER;
+    passed &= scanner.FirstScan(process, ValueType::INT, exact, true, 2);
+    passed &= Check(BlockHits(scanner, child).size() == BLOCK_PAGES / MARK_STRIDE, L"First scan finds every marker");
+
+    std::set<uintptr_t> expected;
+    for (uint32_t page = 0; page < BLOCK_PAGES; page += 512)
+    {
+        passed &= child.Write(page * PAGE, MARKER + 1);
+        expected.insert(child.Block() + page * PAGE);
+    }
+    ScanCondition changed;
+    changed.compare = ScanCompare::Changed;
+    passed &= scanner.NextScan(changed, 2);
+    passed &= Check(BlockHits(scanner, child) == expected, L"Changed keeps exactly the rewritten markers");
+
+    const ValueScanStats &stats = scanner.GetStats();
+    if (stats.writeTracking)
+    {
+        std::wcout << L"[*] Tracked next scan: " << stats.bytesRead << L" bytes read, " << stats.bytesSkipped
+                   << L" bytes not reread" << std::endl;
+        passed &= Check(stats.bytesSkipped > 0, L"Clean pages are not reread");
+    }
+    else
+    {
+        passed &= Check(!trackWrites || !DirtyPageTracker::IsSupported(), L"Full reads only without soft-dirty support");
+    }
+
+    // Dense chunks: every slot of the block
+    ScanCondition unknown;
+    unknown.compare = ScanCompare::Unknown;
+    passed &= scanner.FirstScan(process, ValueType::INT, unknown, true, 2);
+    passed &= child.Write(7 * PAGE, 42) && child.Write(4095 * PAGE, -1);
+    passed &= scanner.NextScan(changed, 2);
+    expected = {child.Block() + 7 * PAGE, child.Block() + 4095 * PAGE};
+    passed &= Check(BlockHits(scanner, child) == expected, L"Changed after an unknown first scan");
+
+    // Restore the block for the next run
+    for (uint32_t page = 0; page < BLOCK_PAGES; page += 512)
+    {
+        passed &= child.Write(page * PAGE, MARKER);
+    }
+    passed &= child.Write(7 * PAGE, 0) && child.Write(4095 * PAGE, 0);
+    return passed;
+}
+
+int main()
+{
+    ChildProcess child;
+    if (!child.Start(BLOCK_PAGES * PAGE, FillBlock))
+    {
+        std::wcerr << L"[-] Cannot start the child process" << std::endl;
+        return 1;
+    }
+
+    std::wcout << L"[*] Soft-dirty bits " << (DirtyPageTracker::IsSupported() ? L"supported" : L"not supported")
+               << std::endl;
+    bool passed = TestTracker(child);
+    passed &= TestScanner(child, true);
+    passed &= TestScanner(child, false);
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+#include "ChildProcess.h"
+#include "ModuleRegistry.h"
+#include "PointerChainResolver.h"
+#include "PointerChainTable.h"
+#include "ProcessPause.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+
+// ============================================================================
+// ProcessPauseTest: SIGSTOP pauses and consistent chain reads on a child
+// - the child keeps x/y/z triples behind two pointers and a writer thread
+//   rewrites them without locking (y == 2x, z == -3x after a full round)
+// - Suspend must stop every thread of the child, Resume must restart them,
+//   a child that was already stopped must stay stopped
+// - ResolveTableConsistent must resolve every chain from one moment of the
+//   child: at most the one triple the writer was stopped in the middle of is
+//   torn per round; the live ResolveTable count is printed for comparison
+// ============================================================================
+
+static constexpr size_t OBJECTS = 256;
+static constexpr size_t NODES = 0x10000;  // Root nodes, 0x40 bytes each
+static constexpr size_t LEAVES = 0x20000; // Leaves with x, y, z at +0x10
+static constexpr size_t BLOCK = 0x30000;  // Root slots at the start
+
+static void Writer(uint8_t *block)
+{
+    for (uint32_t counter = 1;; ++counter)
+    {
+        for (size_t i = 0; i < OBJECTS; ++i)
+        {
+            volatile uint32_t *leaf = reinterpret_cast<volatile uint32_t *>(block + LEAVES + i * 0x40 + 0x10);
+            leaf[0] = counter;
+            leaf[1] = counter * 2;
+            leaf[2] = counter * static_cast<uint32_t>(-3);
+        }
+    }
+}
+
+// Runs in the child: root slot -> +0x18 -> leaf, then the writer thread
+static void BuildObjects(uint8_t *block, size_t)
+{
+    for (size_t i = 0; i < OBJECTS; ++i)
+    {
+        uintptr_t node = reinterpret_cast<uintptr_t>(block + NODES + i * 0x40);
+        uintptr_t leaf = reinterpret_cast<uintptr_t>(block + LEAVES + i * 0x40);
+        memcpy(block + i * sizeof(uintptr_t), &node, sizeof(node));
+        memcpy(block + NODES + i * 0x40 + 0x18, &leaf, sizeof(leaf));
+    }
+    std::thread(Writer, block).detach();
+}
+
+static bool Check(bool condition, const wchar_t *what)
+{
+    std::wcout << (condition ? L"[+] " : L"[-] ") << what << std::endl;
+    return condition;
+}
+
+// Threads of the process in a stopped state, and threads in total
+static void CountStopped(uint32_t pid, size_t &stopped, size_t &total)
+{
+    stopped = 0;
+    total = 0;
+    const std::string taskDir = "/proc/" + std::to_string(pid) + "/task";
+    DIR *dir = opendir(taskDir.c_str());
+    if (dir == nullptr)
+        return;
+    while (dirent *entry = readdir(dir))
+    {
+        if (entry->d_name[0] == '.')
+            continue;
+        FILE *file = fopen((taskDir + "/" + entry->d_name + "/stat").c_str(), "r");
+        if (file == nullptr)
+            continue;
+        char buffer[512] = {};
+        size_t length = fread(buffer, 1, sizeof(buffer) - 1, file);
+        fclose(file);
+        const char *paren = length > 0 ? strrchr(buffer, ')') : nullptr;
+        total++;
+        if (paren != nullptr && (paren[2] == 'T' || paren[2] == 't'))
+            stopped++;
+    }
+    closedir(dir);
+}
+
+static bool WaitStopped(uint32_t pid, bool wantStopped)
+{
+    for (int i = 0; i < 1000; ++i)
+    {
+        size_t stopped;
+        size_t total;
+        CountStopped(pid, stopped, total);
+        if (total > 0 && (wantStopped ? stopped == total : stopped == 0))
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+static bool TestPause(const ChildProcess &child)
+{
+    ProcessPause pause;
+    bool passed = Check(!pause.Prepare(static_cast<DWORD>(getpid())), L"This process is not paused");
+    passed &= Check(pause.Prepare(child.Pid()), L"Child prepared");
+
+    MemoryReader reader(ProcessHandleFromId(child.Pid()));
+    reader.SetLogErrors(false);
+    const uintptr_t x = child.Block() + LEAVES + 0x10;
+    bool success = false;
+
+    passed &= Check(pause.Suspend(), L"Suspend");
+    size_t stopped;
+    size_t total;
+    CountStopped(child.Pid(), stopped, total);
+    passed &= Check(total >= 2 && stopped == total, L"Every thread of the child is stopped");
+    int32_t first = reader.ReadInt(x, success);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    passed &= Check(success && reader.ReadInt(x, success) == first, L"The writer does not run while paused");
+    pause.Resume();
+    passed &= Check(WaitStopped(child.Pid(), false), L"Resume restarts every thread");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    passed &= Check(reader.ReadInt(x, success) != first, L"The writer runs again");
+
+    // Stopped by someone else: paused reads work, Resume leaves it stopped
+    kill(static_cast<pid_t>(child.Pid()), SIGSTOP);
+    passed &= WaitStopped(child.Pid(), true);
+    passed &= Check(pause.Prepare(child.Pid()) && pause.Suspend(), L"Already stopped child prepared and suspended");
+    pause.Resume();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CountStopped(child.Pid(), stopped, total);
+    passed &= Check(stopped == total, L"Resume leaves an already stopped child stopped");
+    kill(static_cast<pid_t>(child.Pid()), SIGCONT);
+    passed &= WaitStopped(child.Pid(), false);
+
+    passed &= Check(pause.GetHistogram().count == 2, L"Both pauses recorded");
+    return passed;
+}
+
+static bool TestConsistentReads(const ChildProcess &child)
+{
+    ModuleInfo module;
+    module.name = L"child_block";
+    module.baseAddress = child.Block();
+    module.size = OBJECTS * sizeof(uintptr_t);
+    ModuleRegistry registry;
+    registry.AddModule(module);
+
+    std::vector<PointerChain> chains(OBJECTS * 3);
+    for (size_t i = 0; i < chains.size(); ++i)
+    {
+        chains[i].moduleName = module.name;
+        chains[i].baseOffset = (i / 3) * sizeof(uintptr_t);
+        chains[i].offsets = {0x18, 0x10 + (i % 3) * sizeof(int32_t)};
+        chains[i].valueType = ValueType::INT;
+    }
+    PointerChainTable table;
+    table.Build(chains);
+
+    MemoryReader reader(ProcessHandleFromId(child.Pid()));
+    reader.SetLogErrors(false);
+    PointerChainResolver resolver(&registry, &reader);
+
+    auto countTorn = [&table]()
+    {
+        size_t torn = 0;
+        for (size_t i = 0; i < OBJECTS; ++i)
+        {
+            uint32_t x = static_cast<uint32_t>(table.GetValue(i * 3).data.intValue);
+            uint32_t y = static_cast<uint32_t>(table.GetValue(i * 3 + 1).data.intValue);
+            uint32_t z = static_cast<uint32_t>(table.GetValue(i * 3 + 2).data.intValue);
+            if (y != x * 2 || z != x * static_cast<uint32_t>(-3))
+                torn++;
+        }
+        return torn;
+    };
+
+    const size_t rounds = 20;
+    size_t liveTorn = 0;
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        resolver.ResolveTable(table);
+        liveTorn += countTorn();
+    }
+
+    ProcessPause pause;
+    ConsistentReadStats stats;
+    size_t pausedTorn = 0;
+    size_t worstRound = 0;
+    bool resolved = true;
+    bool paused = true;
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        resolved &= resolver.ResolveTableConsistent(table, pause, &stats) == static_cast<int>(chains.size());
+        paused &= stats.passes >= 1 && stats.unpaused == 0;
+        size_t torn = countTorn();
+        pausedTorn += torn;
+        worstRound = (std::max)(worstRound, torn);
+    }
+
+    std::wcout << L"[*] Torn triples: live " << liveTorn << L"/" << OBJECTS * rounds << L", paused " << pausedTorn
+               << L"/" << OBJECTS * rounds << L", " << stats.spanCount << L" spans per pass" << std::endl;
+    bool passed = Check(resolved, L"ResolveTableConsistent resolves every chain");
+    passed &= Check(paused && pause.GetHistogram().count >= rounds, L"Every round read while the child was paused");
+    passed &= Check(worstRound <= 1, L"Paused reads are torn only where the writer was stopped");
+    pause.GetHistogram().Print();
+    return passed;
+}
+
+int main()
+{
+    ChildProcess child;
+    if (!child.Start(BLOCK, BuildObjects))
+    {
+        std::wcerr << L"[-] Cannot start the child process" << std::endl;
+        return 1;
+    }
+
+    bool passed = TestPause(child);
+    passed &= TestConsistentReads(child);
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+#include "ChildProcess.h"
+#include "MemoryReader.h"
+#include "ModuleRegistry.h"
+#include "ProcessSnapshot.h"
+#include "SnapshotFile.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// ProcessSnapshotTest: .psnap reader and capture
+// - a hand-built file (SnapshotFile.h) with zero, raw and LZ4 chunks, a
+//   short last chunk, a page flagged unreadable and a module table must open
+//   and read back byte for byte; corrupted copies must be rejected
+// - a capture of a child process must read back the child's memory through
+//   MemoryReader and keep its module list
+// ============================================================================
+
+static constexpr size_t CHUNK = ProcessSnapshot::CHUNK_SIZE;
+static constexpr uintptr_t REGION0 = 0x10000000; // Zero, raw, LZ4 chunk
+static constexpr uintptr_t REGION1 = 0x20000000; // One short raw chunk
+static constexpr size_t REGION1_SIZE = 0x1800;
+static constexpr uint16_t BAD_PAGE = 3; // Of the LZ4 chunk
+
+static bool Check(bool condition, const wchar_t *what)
+{
+    std::wcout << (condition ? L"[+] " : L"[-] ") << what << std::endl;
+    return condition;
+}
+
+// Expected bytes of both regions, back to back
+static std::vector<uint8_t> MakeContent()
+{
+    std::vector<uint8_t> content(3 * CHUNK + REGION1_SIZE, 0);
+    uint32_t state = 12345;
+    for (size_t i = CHUNK; i < 2 * CHUNK; ++i)
+    {
+        state = state * 1103515245 + 12345;
+        content[i] = static_cast<uint8_t>(state >> 24);
+    }
+    for (size_t i = 2 * CHUNK; i < 3 * CHUNK; ++i)
+    {
+        content[i] = static_cast<uint8_t>(i % 251 < 32 ? i : 0);
+    }
+    for (size_t i = 3 * CHUNK; i < content.size(); ++i)
+    {
+        content[i] = static_cast<uint8_t>(i * 7);
+    }
+    return content;
+}
+
+static std::vector<uint8_t> BuildSnapshot(const std::vector<uint8_t> &content)
+{
+    SnapshotFile builder;
+    builder.AddRegion(REGION0, content.data(), 3 * CHUNK, {SNAPSHOT_ZERO, SNAPSHOT_RAW, SNAPSHOT_LZ4},
+                      {0, 0, 1 << BAD_PAGE});
+    builder.AddRegion(REGION1, content.data() + 3 * CHUNK, REGION1_SIZE, {SNAPSHOT_RAW});
+    builder.AddModule(REGION0, 3 * CHUNK, 0x1234567800003000ull, u"game.exe");
+    builder.AddModule(REGION1, REGION1_SIZE, 0, u"libc.so.6");
+    return builder.Build(4242);
+}
+
+static bool TestReader()
+{
+    const std::vector<uint8_t> content = MakeContent();
+    const std::vector<uint8_t> file = BuildSnapshot(content);
+    const std::string name = "ProcessSnapshotTest.psnap";
+    if (!SnapshotFile::Write(name, file))
+        return Check(false, L"Test snapshot written");
+
+    ProcessSnapshot snapshot;
+    bool passed = Check(snapshot.Open(L"ProcessSnapshotTest.psnap"), L"Hand-built snapshot opens");
+    if (!passed)
+        return false;
+    passed &= Check(snapshot.GetProcessId() == 4242 && snapshot.RegionCount() == 2 &&
+                        snapshot.CapturedBytes() == content.size(),
+                    L"Header fields");
+
+    const std::vector<ModuleInfo> &modules = snapshot.GetModules();
+    passed &= Check(modules.size() == 2 && modules[0].name == L"game.exe" && modules[0].baseAddress == REGION0 &&
+                        modules[0].fingerprint == 0x1234567800003000ull && modules[1].name == L"libc.so.6" &&
+                        modules[1].size == REGION1_SIZE,
+                    L"Module table");
+
+    // Every chunk decodes to its bytes, whatever its encoding
+    const uint16_t encodings[] = {SNAPSHOT_ZERO, SNAPSHOT_RAW, SNAPSHOT_LZ4, SNAPSHOT_RAW};
+    const uintptr_t starts[] = {REGION0, REGION0 + CHUNK, REGION0 + 2 * CHUNK, REGION1};
+    bool decoded = true;
+    for (size_t c = 0; c < 4; ++c)
+    {
+        SnapshotChunkView view;
+        std::vector<uint8_t> bytes(CHUNK);
+        decoded &= snapshot.FindChunk(starts[c] + 0x100, view) && view.encoding == encodings[c] &&
+                   view.address == starts[c] && view.length == (c == 3 ? REGION1_SIZE : CHUNK) &&
+                   snapshot.DecodeChunk(view, bytes.data()) &&
+                   memcmp(bytes.data(), content.data() + c * CHUNK, view.length) == 0;
+    }
+    passed &= Check(decoded, L"FindChunk and DecodeChunk for zero, raw and LZ4 chunks");
+
+    // Reads across chunk borders, skipping the unreadable page
+    uint8_t buffer[0x2000];
+    bool reads = snapshot.Read(REGION0 + CHUNK - 0x800, buffer, 0x1000) &&
+                 memcmp(buffer, content.data() + CHUNK - 0x800, 0x1000) == 0;
+    reads &= snapshot.Read(REGION0 + 2 * CHUNK - 0x10, buffer, 0x2000) &&
+             memcmp(buffer, content.data() + 2 * CHUNK - 0x10, 0x2000) == 0;
+    reads &= snapshot.Read(REGION1 + REGION1_SIZE - 8, buffer, 8) &&
+             memcmp(buffer, content.data() + 3 * CHUNK + REGION1_SIZE - 8, 8) == 0;
+    passed &= Check(reads, L"Reads across chunk borders match");
+
+    const uintptr_t badPage = REGION0 + 2 * CHUNK + BAD_PAGE * ProcessSnapshot::PAGE_BYTES;
+    passed &= Check(!snapshot.Read(badPage + 0x10, buffer, 4) && !snapshot.Read(badPage - 2, buffer, 4) &&
+                        snapshot.Read(badPage - 4, buffer, 4),
+                    L"Reads touching the unreadable page fail");
+    passed &= Check(!snapshot.Read(REGION0 - 4, buffer, 8) && !snapshot.Read(REGION1 + REGION1_SIZE - 4, buffer, 8) &&
+                        !snapshot.Read(REGION0 + 3 * CHUNK, buffer, 4),
+                    L"Reads outside the regions fail");
+
+    MemoryReader reader(nullptr);
+    reader.SetLogErrors(false);
+    reader.SetSnapshot(&snapshot);
+    bool success = false;
+    int32_t value = reader.ReadInt(REGION1 + 0x10, success);
+    int32_t expected;
+    memcpy(&expected, content.data() + 3 * CHUNK + 0x10, sizeof(expected));
+    passed &= Check(success && value == expected, L"MemoryReader reads the snapshot");
+    snapshot.Close();
+
+    // Corrupted copies
+    std::vector<uint8_t> broken = file;
+    broken[0] = 'X';
+    bool rejected = SnapshotFile::Write(name, broken) && !snapshot.Open(L"ProcessSnapshotTest.psnap");
+    broken = file;
+    broken.resize(file.size() - 8);
+    rejected &= SnapshotFile::Write(name, broken) && !snapshot.Open(L"ProcessSnapshotTest.psnap");
+    broken = file;
+    ProcessSnapshotHeader header;
+    memcpy(&header, file.data(), sizeof(header));
+    SnapshotRegion swapped[2];
+    memcpy(swapped, file.data() + header.regionTableOffset, sizeof(swapped));
+    std::swap(swapped[0], swapped[1]);
+    memcpy(broken.data() + header.regionTableOffset, swapped, sizeof(swapped));
+    rejected &= SnapshotFile::Write(name, broken) && !snapshot.Open(L"ProcessSnapshotTest.psnap");
+    passed &= Check(rejected, L"Bad magic, truncated file and unsorted regions are rejected");
+    std::remove(name.c_str());
+    return passed;
+}
+
+// Runs in the child: a pattern that is neither zero nor incompressible
+static void FillPattern(uint8_t *block, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        block[i] = static_cast<uint8_t>(i / 64 % 3 == 0 ? i : 0);
+    }
+}
+
+static bool TestCapture()
+{
+    ChildProcess child;
+    if (!child.Start(1 << 20, FillPattern))
+        return Check(false, L"Child process started");
+    child.Write(0x1230, 0x5EED);
+
+    ModuleRegistry registry;
+    HANDLE process = ProcessHandleFromId(child.Pid());
+    bool passed = Check(registry.LoadModules(child.Pid()), L"Modules of the child listed");
+
+    SnapshotCaptureStats stats;
+    const std::wstring name = L"ProcessSnapshotCapture.psnap";
+    passed &= Check(ProcessSnapshot::Capture(process, registry.GetModules(), name, 2, &stats) &&
+                        stats.capturedBytes >= child.Size(),
+                    L"Child captured");
+
+    ProcessSnapshot snapshot;
+    passed &= Check(snapshot.Open(name) && snapshot.GetProcessId() == child.Pid() &&
+                        snapshot.GetModules().size() == registry.GetModules().size(),
+                    L"Capture opens with the child's modules");
+
+    std::vector<uint8_t> expected(child.Size());
+    FillPattern(expected.data(), expected.size());
+    int32_t written = 0x5EED;
+    memcpy(expected.data() + 0x1230, &written, sizeof(written));
+    std::vector<uint8_t> captured(child.Size());
+    passed &= Check(snapshot.Read(child.Block(), captured.data(), captured.size()) && captured == expected,
+                    L"Captured block matches the child's memory");
+    snapshot.Close();
+    std::remove("ProcessSnapshotCapture.psnap");
+    return passed;
+}
+
+int main()
+{
+    bool passed = TestReader();
+    passed &= TestCapture();
+    return passed ? 0 : 1;
+}
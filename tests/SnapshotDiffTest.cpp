@@ -0,0 +1,142 @@
+#include "SnapshotDiff.h"
+#include "SnapshotFile.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// SnapshotDiffTest: SnapshotDiff on two hand-built snapshots
+// - chunks with identical stored bytes (LZ4 and raw) are equal without
+//   decoding, only the others count as decoded
+// - changed bytes closer than MERGE_GAP form one range, also across a chunk
+//   border; a page unreadable in one snapshot is not compared
+// - memory captured in only one snapshot is an added / removed range
+// - one worker and several workers report the same ranges
+// ============================================================================
+
+static constexpr size_t CHUNK = ProcessSnapshot::CHUNK_SIZE;
+static constexpr size_t PAGE = ProcessSnapshot::PAGE_BYTES;
+static constexpr uintptr_t SHARED = 0x10000000;  // 4 chunks in both
+static constexpr uintptr_t GROWN = 0x20000000;   // 1 chunk, 1.5 chunks after
+static constexpr uintptr_t REMOVED = 0x30000000; // Before only
+static constexpr uintptr_t ADDED = 0x40000000;   // After only
+static constexpr uint16_t BAD_PAGE = 5;          // Of the last shared chunk, after only
+
+static bool Check(bool condition, const wchar_t *what)
+{
+    std::wcout << (condition ? L"[+] " : L"[-] ") << what << std::endl;
+    return condition;
+}
+
+static void Set32(std::vector<uint8_t> &bytes, size_t offset, uint32_t value)
+{
+    memcpy(bytes.data() + offset, &value, sizeof(value));
+}
+
+static bool SameRanges(const std::vector<SnapshotDiffRange> &a, const std::vector<SnapshotDiffRange> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (a[i].address != b[i].address || a[i].size != b[i].size || a[i].kind != b[i].kind)
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    // Shared region: compressible chunk, incompressible chunk, then the chunks that change
+    std::vector<uint8_t> shared(4 * CHUNK, 0);
+    uint32_t state = 12345;
+    for (size_t i = 0; i < CHUNK; ++i)
+    {
+        shared[i] = static_cast<uint8_t>(i % 251 < 32 ? i : 0);
+        state = state * 1103515245 + 12345;
+        shared[CHUNK + i] = static_cast<uint8_t>(state >> 24);
+    }
+    Set32(shared, 3 * CHUNK + 6 * PAGE + 0x10, 100);
+    std::vector<uint8_t> sharedAfter = shared;
+
+    const size_t changing = 2 * CHUNK;
+    sharedAfter[changing + 0x100] = 1;     // 3 bytes apart: one range of 5
+    sharedAfter[changing + 0x104] = 1;
+    sharedAfter[changing + 0x200] = 1;     // 7 bytes apart: one range of 9
+    sharedAfter[changing + 0x208] = 1;
+    sharedAfter[changing + 0x300] = 1;     // 8 bytes apart: two ranges
+    sharedAfter[changing + 0x309] = 1;
+    sharedAfter[3 * CHUNK - 1] = 1;        // Across the chunk border: one range of 2
+    sharedAfter[3 * CHUNK] = 1;
+    Set32(sharedAfter, 3 * CHUNK + 6 * PAGE + 0x10, 250);
+    shared[3 * CHUNK + BAD_PAGE * PAGE + 0x20] = 7; // Unreadable after, zero-filled there
+
+    std::vector<uint8_t> grown(CHUNK + CHUNK / 2, 0);
+    for (size_t i = 0; i < grown.size(); ++i)
+    {
+        grown[i] = static_cast<uint8_t>(i / 16);
+    }
+    std::vector<uint8_t> removed(2 * PAGE, 0x11);
+    std::vector<uint8_t> added(3 * PAGE, 0x22);
+
+    SnapshotFile before;
+    before.AddRegion(SHARED, shared.data(), shared.size());
+    before.AddRegion(GROWN, grown.data(), CHUNK);
+    before.AddRegion(REMOVED, removed.data(), removed.size());
+    SnapshotFile after;
+    after.AddRegion(SHARED, sharedAfter.data(), sharedAfter.size(), {}, {0, 0, 0, 1 << BAD_PAGE});
+    after.AddRegion(GROWN, grown.data(), grown.size());
+    after.AddRegion(ADDED, added.data(), added.size());
+
+    const std::string beforeName = "SnapshotDiffBefore.psnap";
+    const std::string afterName = "SnapshotDiffAfter.psnap";
+    ProcessSnapshot first;
+    ProcessSnapshot second;
+    if (!SnapshotFile::Write(beforeName, before.Build(1)) || !SnapshotFile::Write(afterName, after.Build(1)) ||
+        !first.Open(L"SnapshotDiffBefore.psnap") || !second.Open(L"SnapshotDiffAfter.psnap"))
+    {
+        std::wcerr << L"[-] Cannot write and open the test snapshots" << std::endl;
+        return 1;
+    }
+
+    const std::vector<SnapshotDiffRange> expected = {
+        {SHARED + changing + 0x100, 5, DiffKind::Changed},
+        {SHARED + changing + 0x200, 9, DiffKind::Changed},
+        {SHARED + changing + 0x300, 1, DiffKind::Changed},
+        {SHARED + changing + 0x309, 1, DiffKind::Changed},
+        {SHARED + 3 * CHUNK - 1, 2, DiffKind::Changed},
+        {SHARED + 3 * CHUNK + 6 * PAGE + 0x10, 1, DiffKind::Changed},
+        {GROWN + CHUNK, CHUNK / 2, DiffKind::Added},
+        {REMOVED, removed.size(), DiffKind::Removed},
+        {ADDED, added.size(), DiffKind::Added}};
+
+    SnapshotDiff diff;
+    bool passed = Check(diff.Compare(first, second, 4), L"Compare on 4 workers");
+    passed &= Check(SameRanges(diff.GetRanges(), expected), L"Changed, added and removed ranges");
+    diff.PrintRanges(20);
+
+    const SnapshotDiffStats &stats = diff.GetStats();
+    passed &= Check(stats.comparedBytes == 5 * CHUNK && stats.decodedBytes == 2 * CHUNK - PAGE,
+                    L"Identical stored chunks and the unreadable page are not decoded");
+    passed &= Check(stats.changedBytes == 5 + 9 + 1 + 1 + 2 + 1 && stats.addedBytes == CHUNK / 2 + added.size() &&
+                        stats.removedBytes == removed.size(),
+                    L"Byte counts");
+
+    DiffValue value = diff.Interpret(diff.GetRanges()[5]);
+    passed &= Check(value.kind == DiffValueKind::Int && value.address == SHARED + 3 * CHUNK + 6 * PAGE + 0x10 &&
+                        value.before == 100 && value.after == 250,
+                    L"A changed int is interpreted with both values");
+
+    SnapshotDiff single;
+    passed &= Check(single.Compare(first, second, 1) && SameRanges(single.GetRanges(), expected),
+                    L"One worker reports the same ranges");
+
+    first.Close();
+    second.Close();
+    std::remove(beforeName.c_str());
+    std::remove(afterName.c_str());
+    return passed ? 0 : 1;
+}
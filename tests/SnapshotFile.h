@@ -0,0 +1,148 @@
+#pragma once
+#include "Lz4Block.h"
+#include "ProcessSnapshot.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// SnapshotFile: Hand-built .psnap files for the snapshot tests
+// - regions are cut into CHUNK_SIZE chunks; each chunk is stored like Capture
+//   does (zero, LZ4, raw if LZ4 does not shrink it) unless an encoding is given
+// - pages can be flagged unreadable per chunk, their bytes are kept as given
+// - Build lays the file out as ProcessSnapshot.h describes
+// ============================================================================
+
+class SnapshotFile
+{
+public:
+    static constexpr uint16_t AUTO = 0xFFFF; // Encoding chosen like Capture
+
+    // Regions must be added in address order; encodings and badPages per chunk (missing = AUTO / 0)
+    void AddRegion(uintptr_t address, const uint8_t *bytes, size_t size, const std::vector<uint16_t> &encodings = {},
+                   const std::vector<uint16_t> &badPages = {})
+    {
+        m_regions.push_back({address, size, m_chunks.size()});
+        for (size_t offset = 0, c = 0; offset < size; offset += ProcessSnapshot::CHUNK_SIZE, ++c)
+        {
+            size_t length = size - offset < ProcessSnapshot::CHUNK_SIZE ? size - offset : ProcessSnapshot::CHUNK_SIZE;
+            uint16_t encoding = c < encodings.size() ? encodings[c] : AUTO;
+            AddChunk(bytes + offset, length, encoding, c < badPages.size() ? badPages[c] : 0);
+        }
+        m_capturedBytes += size;
+    }
+
+    void AddModule(uintptr_t baseAddress, uint64_t size, uint64_t fingerprint, const std::u16string &name)
+    {
+        m_modules.push_back({baseAddress, size, fingerprint, AddString(name), 0});
+    }
+
+    std::vector<uint8_t> Build(uint32_t processId) const
+    {
+        std::vector<uint8_t> file(sizeof(ProcessSnapshotHeader), 0);
+        std::vector<SnapshotChunk> chunks = m_chunks;
+        for (SnapshotChunk &chunk : chunks)
+        {
+            chunk.dataOffset += sizeof(ProcessSnapshotHeader);
+        }
+        Append(file, m_data.data(), m_data.size());
+
+        ProcessSnapshotHeader header = {};
+        memcpy(header.magic, PROCESS_SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = PROCESS_SNAPSHOT_VERSION;
+        header.moduleCount = static_cast<uint32_t>(m_modules.size());
+        header.regionCount = static_cast<uint32_t>(m_regions.size());
+        header.chunkSize = static_cast<uint32_t>(ProcessSnapshot::CHUNK_SIZE);
+        header.processId = processId;
+        header.chunkCount = chunks.size();
+        header.capturedBytes = m_capturedBytes;
+        header.storedBytes = m_data.size();
+
+        Align(file, 8);
+        header.moduleTableOffset = file.size();
+        Append(file, m_modules.data(), m_modules.size() * sizeof(SnapshotModule));
+        header.regionTableOffset = file.size();
+        Append(file, m_regions.data(), m_regions.size() * sizeof(SnapshotRegion));
+        header.chunkIndexOffset = file.size();
+        Append(file, chunks.data(), chunks.size() * sizeof(SnapshotChunk));
+        header.stringTableOffset = file.size();
+        header.stringTableSize = m_strings.size();
+        Append(file, m_strings.data(), m_strings.size());
+
+        memcpy(file.data(), &header, sizeof(header));
+        return file;
+    }
+
+    static bool Write(const std::string &name, const std::vector<uint8_t> &data)
+    {
+        std::ofstream file(name, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        return file.good();
+    }
+
+private:
+    std::vector<SnapshotModule> m_modules;
+    std::vector<SnapshotRegion> m_regions;
+    std::vector<SnapshotChunk> m_chunks; // dataOffset relative to the chunk data
+    std::vector<uint8_t> m_data;
+    std::vector<uint8_t> m_strings;
+    uint64_t m_capturedBytes = 0;
+
+    static void Append(std::vector<uint8_t> &out, const void *data, size_t size)
+    {
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    }
+
+    static void Align(std::vector<uint8_t> &out, size_t alignment)
+    {
+        out.resize((out.size() + alignment - 1) / alignment * alignment, 0);
+    }
+
+    // String table entry: [uint32 length][UTF-16 chars], 4-aligned
+    uint32_t AddString(const std::u16string &text)
+    {
+        uint32_t ref = static_cast<uint32_t>(m_strings.size());
+        uint32_t length = static_cast<uint32_t>(text.size());
+        Append(m_strings, &length, sizeof(length));
+        Append(m_strings, text.data(), text.size() * sizeof(char16_t));
+        Align(m_strings, 4);
+        return ref;
+    }
+
+    void AddChunk(const uint8_t *bytes, size_t length, uint16_t encoding, uint16_t badPages)
+    {
+        std::vector<uint8_t> packed(Lz4Block::Bound(length));
+        size_t packedSize = 0;
+        if (encoding == AUTO)
+        {
+            bool zero = true;
+            for (size_t i = 0; i < length && zero; ++i)
+            {
+                zero = bytes[i] == 0;
+            }
+            packedSize = zero ? 0 : Lz4Block::Compress(bytes, length, packed.data(), length - 1);
+            encoding = zero ? SNAPSHOT_ZERO : (packedSize != 0 ? SNAPSHOT_LZ4 : SNAPSHOT_RAW);
+        }
+        else if (encoding == SNAPSHOT_LZ4)
+        {
+            packedSize = Lz4Block::Compress(bytes, length, packed.data(), packed.size());
+        }
+
+        SnapshotChunk chunk = {m_data.size(), 0, encoding, badPages};
+        if (encoding == SNAPSHOT_LZ4)
+        {
+            chunk.storedSize = static_cast<uint32_t>(packedSize);
+            Append(m_data, packed.data(), packedSize);
+        }
+        else if (encoding == SNAPSHOT_RAW)
+        {
+            chunk.storedSize = static_cast<uint32_t>(length);
+            Append(m_data, bytes, length);
+        }
+        m_chunks.push_back(chunk);
+    }
+};
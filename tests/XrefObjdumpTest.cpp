@@ -0,0 +1,172 @@
+#include "ModuleImage.h"
+#include "X86Decoder.h"
+#include "XrefIndex.h"
+#include "StringUtils.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// XrefObjdumpTest: X86Decoder and XrefIndex checked against objdump
+// Usage: XrefObjdumpTest <objdump> <elf file>...
+// - every executable section is decoded by linear sweep, the instruction
+//   starts must be exactly the ones objdump -d prints
+// - every RIP-relative operand objdump resolves inside the image must be in
+//   the xref index as a Data reference from that instruction
+// ============================================================================
+
+struct ObjdumpInstruction
+{
+    bool ripRelative = false;
+    uint64_t target = 0; // Absolute address from the "# <target>" comment
+};
+
+// Instruction lines of "objdump -d -w", keyed by absolute address
+static bool RunObjdump(const std::string &objdump, const std::string &file,
+                       std::map<uint64_t, ObjdumpInstruction> &out)
+{
+    std::string command = "\"" + objdump + "\" -d -w --no-show-raw-insn \"" + file + "\"";
+    FILE *pipe = popen(command.c_str(), "r");
+    if (pipe == nullptr)
+        return false;
+
+    char line[4096];
+    while (fgets(line, sizeof(line), pipe) != nullptr)
+    {
+        // "    9004:\tmov    0x4ef8d(%rip),%rax        # 57f98 <__gmon_start__@Base>"
+        char *p = line;
+        while (*p == ' ')
+            p++;
+        char *end;
+        uint64_t address = strtoull(p, &end, 16);
+        if (end == p || end[0] != ':' || end[1] != '\t')
+            continue;
+
+        std::string text(end + 2);
+        if (text.compare(0, 5, "(bad)") == 0)
+            continue;
+
+        ObjdumpInstruction instruction;
+        size_t hash = text.find("# ");
+        if (text.find("(%rip)") != std::string::npos && hash != std::string::npos)
+        {
+            instruction.ripRelative = true;
+            instruction.target = strtoull(text.c_str() + hash + 2, nullptr, 16);
+        }
+        out[address] = instruction;
+    }
+    return pclose(pipe) == 0;
+}
+
+static bool CheckFile(const std::string &objdump, const std::string &file)
+{
+    ModuleImage image;
+    if (!image.LoadFromFile(StringUtils::Utf8ToWide(file.data(), file.size())))
+        return false;
+    if (image.GetFormat() != ImageFormat::ELF)
+    {
+        std::wcerr << L"[-] Not an ELF file: " << image.GetName() << std::endl;
+        return false;
+    }
+
+    std::map<uint64_t, ObjdumpInstruction> reference;
+    if (!RunObjdump(objdump, file, reference) || reference.empty())
+    {
+        std::wcerr << L"[-] objdump failed on " << image.GetName() << std::endl;
+        return false;
+    }
+
+    XrefIndex index;
+    index.Build(image);
+
+    const uint64_t base = image.GetPreferredBase();
+    size_t decoded = 0;
+    size_t matched = 0;
+    size_t listed = 0;
+    size_t extra = 0;
+    size_t missing = 0;
+    size_t ripChecked = 0;
+    size_t ripMissing = 0;
+    for (const ImageSection &section : image.GetSections())
+    {
+        if (!section.executable || section.size == 0)
+            continue;
+
+        size_t position = section.rva;
+        size_t sectionEnd = section.rva + section.size;
+        while (position < sectionEnd)
+        {
+            X86Instruction instruction;
+            if (!X86Decoder::Decode(image.Data() + position, sectionEnd - position, instruction))
+            {
+                position++;
+                continue;
+            }
+
+            decoded++;
+            if (reference.count(base + position) != 0)
+                matched++;
+            else if (extra++ < 5)
+                std::wcerr << L"[-] Extra instruction start at 0x" << std::hex << base + position << std::dec
+                           << std::endl;
+            position += instruction.length;
+        }
+
+        auto first = reference.lower_bound(base + section.rva);
+        auto last = reference.lower_bound(base + sectionEnd);
+        for (auto it = first; it != last; ++it)
+        {
+            listed++;
+            uintptr_t rva = static_cast<uintptr_t>(it->first - base);
+            X86Instruction instruction;
+            if (!X86Decoder::Decode(image.Data() + rva, sectionEnd - rva, instruction))
+            {
+                if (missing++ < 5)
+                    std::wcerr << L"[-] Undecodable instruction at 0x" << std::hex << it->first << std::dec
+                               << std::endl;
+                continue;
+            }
+
+            if (!it->second.ripRelative || it->second.target < base || it->second.target - base >= image.Size())
+                continue;
+
+            ripChecked++;
+            bool found = false;
+            for (const Xref &xref : index.FindReferences(static_cast<uintptr_t>(it->second.target - base)))
+            {
+                found |= xref.source == rva && xref.kind == XrefKind::Data;
+            }
+            if (!found && ripMissing++ < 5)
+                std::wcerr << L"[-] No xref from 0x" << std::hex << it->first << L" to 0x" << it->second.target
+                           << std::dec << std::endl;
+        }
+    }
+
+    // Instruction starts objdump printed that the sweep stepped over
+    size_t skipped = listed - matched;
+
+    std::wcout << (extra + missing + skipped + ripMissing == 0 ? L"[+] " : L"[-] ") << image.GetName() << L": "
+               << decoded << L" instructions, " << extra << L" extra, " << skipped << L" skipped, " << missing
+               << L" undecodable, " << ripChecked << L" RIP operands, " << ripMissing << L" without xref"
+               << std::endl;
+    return extra + missing + skipped + ripMissing == 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        std::wcerr << L"Usage: XrefObjdumpTest <objdump> <elf file>..." << std::endl;
+        return 2;
+    }
+
+    bool passed = true;
+    for (int i = 2; i < argc; ++i)
+    {
+        passed &= CheckFile(argv[1], argv[i]);
+    }
+    return passed ? 0 : 1;
+}